@@ -383,37 +383,80 @@ cuda_utils::ExternalMemory* Buffer::getCudaMemory() const
 }
 #endif
 
-inline pybind11::ndarray<pybind11::numpy> buffer_to_numpy(const Buffer& self)
+/**
+ * Validate a byte range of a buffer that is read into a numpy array.
+ * A size of 0 selects the rest of the buffer. Typed buffers can only be read in whole elements.
+ */
+inline void check_numpy_range(const Buffer& self, size_t offset, size_t& size)
 {
-    size_t bufferSize = self.getSize();
-    void* cpuData = new uint8_t[bufferSize];
-    self.getBlob(cpuData, 0, bufferSize);
+    FALCOR_CHECK(offset <= self.getSize(), "'offset' ({}) is larger than the buffer size {}.", offset, self.getSize());
+    if (size == 0)
+        size = self.getSize() - offset;
+    FALCOR_CHECK(
+        offset + size <= self.getSize(), "'offset' ({}) and 'size' ({}) don't fit the buffer size {}.", offset, size, self.getSize()
+    );
 
-    pybind11::capsule owner(cpuData, [](void* p) noexcept { delete[] reinterpret_cast<uint8_t*>(p); });
+    if (resourceFormatToDtype(self.getFormat()))
+    {
+        uint32_t elementSize = getFormatBytesPerBlock(self.getFormat());
+        FALCOR_CHECK(
+            offset % elementSize == 0 && size % elementSize == 0,
+            "'offset' ({}) and 'size' ({}) must be multiples of the element size {}.",
+            offset,
+            size,
+            elementSize
+        );
+    }
+}
 
-    if (auto dtype = resourceFormatToDtype(self.getFormat()))
+/**
+ * Get the numpy dtype and shape for 'size' bytes of buffer data.
+ * Typed buffers use the dtype of their format, all other buffers are returned as bytes.
+ */
+inline std::vector<size_t> get_numpy_shape(const Buffer& self, size_t size, pybind11::dlpack::dtype& dtype)
+{
+    if (auto formatDtype = resourceFormatToDtype(self.getFormat()))
     {
+        dtype = *formatDtype;
         uint32_t channelCount = getFormatChannelCount(self.getFormat());
+        size_t elementCount = size / getFormatBytesPerBlock(self.getFormat());
         if (channelCount == 1)
-        {
-            pybind11::size_t shape[1] = {self.getElementCount()};
-            return pybind11::ndarray<pybind11::numpy>(cpuData, 1, shape, owner, nullptr, *dtype, pybind11::device::cpu::value);
-        }
+            return {elementCount};
         else
-        {
-            pybind11::size_t shape[2] = {self.getElementCount(), channelCount};
-            return pybind11::ndarray<pybind11::numpy>(cpuData, 2, shape, owner, nullptr, *dtype, pybind11::device::cpu::value);
-        }
+            return {elementCount, channelCount};
     }
     else
     {
-        pybind11::size_t shape[1] = {bufferSize};
-        return pybind11::ndarray<pybind11::numpy>(
-            cpuData, 1, shape, owner, nullptr, pybind11::dtype<uint8_t>(), pybind11::device::cpu::value
-        );
+        dtype = pybind11::dtype<uint8_t>();
+        return {size};
     }
 }
 
+inline pybind11::ndarray<pybind11::numpy> buffer_to_numpy(const Buffer& self, size_t offset, size_t size)
+{
+    check_numpy_range(self, offset, size);
+
+    void* cpuData = new uint8_t[size];
+    self.getBlob(cpuData, offset, size);
+
+    pybind11::capsule owner(cpuData, [](void* p) noexcept { delete[] reinterpret_cast<uint8_t*>(p); });
+
+    pybind11::dlpack::dtype dtype;
+    std::vector<size_t> shape = get_numpy_shape(self, size, dtype);
+    return pybind11::ndarray<pybind11::numpy>(cpuData, shape.size(), shape.data(), owner, nullptr, dtype, pybind11::device::cpu::value);
+}
+
+inline NumpyReadback buffer_to_numpy_async(const Buffer& self, size_t offset, size_t size, ref<Buffer> readback_buffer)
+{
+    check_numpy_range(self, offset, size);
+
+    auto pTask = self.getDevice()->getRenderContext()->asyncReadBuffer(&self, offset, size, std::move(readback_buffer));
+
+    pybind11::dlpack::dtype dtype;
+    std::vector<size_t> shape = get_numpy_shape(self, size, dtype);
+    return NumpyReadback(pTask, dtype, std::move(shape));
+}
+
 inline void buffer_from_numpy(Buffer& self, pybind11::ndarray<pybind11::numpy> data)
 {
     FALCOR_CHECK(isNdarrayContiguous(data), "numpy array is not contiguous");
@@ -466,6 +509,7 @@ FALCOR_SCRIPT_BINDING(Buffer)
 
     FALCOR_SCRIPT_BINDING_DEPENDENCY(Types)
     FALCOR_SCRIPT_BINDING_DEPENDENCY(Resource)
+    FALCOR_SCRIPT_BINDING_DEPENDENCY(NumpyReadback)
 
     pybind11::falcor_enum<MemoryType>(m, "MemoryType");
 
@@ -478,7 +522,8 @@ FALCOR_SCRIPT_BINDING(Buffer)
     buffer.def_property_readonly("element_count", &Buffer::getElementCount);
     buffer.def_property_readonly("struct_size", &Buffer::getStructSize);
 
-    buffer.def("to_numpy", buffer_to_numpy);
+    buffer.def("to_numpy", buffer_to_numpy, "offset"_a = 0, "size"_a = 0);
+    buffer.def("to_numpy_async", buffer_to_numpy_async, "offset"_a = 0, "size"_a = 0, "readback_buffer"_a = nullptr);
     buffer.def("from_numpy", buffer_from_numpy, "data"_a);
 #if FALCOR_HAS_CUDA
     buffer.def("to_torch", buffer_to_torch, "shape"_a, "dtype"_a = DataType::float32);
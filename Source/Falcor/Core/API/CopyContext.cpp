@@ -137,9 +137,39 @@ void CopyContext::waitForFalcor(cudaStream_t stream)
 }
 #endif
 
-CopyContext::ReadTextureTask::SharedPtr CopyContext::asyncReadTextureSubresource(const Texture* pTexture, uint32_t subresourceIndex)
+CopyContext::ReadTextureTask::SharedPtr CopyContext::asyncReadTextureSubresource(
+    const Texture* pTexture,
+    uint32_t subresourceIndex,
+    ref<Buffer> pBuffer
+)
 {
-    return CopyContext::ReadTextureTask::create(this, pTexture, subresourceIndex);
+    return CopyContext::ReadTextureTask::create(this, pTexture, subresourceIndex, std::move(pBuffer));
+}
+
+CopyContext::ReadBufferTask::SharedPtr CopyContext::asyncReadBuffer(
+    const Buffer* pBuffer,
+    size_t offset,
+    size_t numBytes,
+    ref<Buffer> pReadbackBuffer
+)
+{
+    FALCOR_CHECK(
+        pBuffer->getMemoryType() != MemoryType::ReadBack,
+        "Cannot asynchronously read from a buffer that was created with MemoryType::ReadBack."
+    );
+    FALCOR_CHECK(offset <= pBuffer->getSize(), "'offset' ({}) is larger than the buffer size {}.", offset, pBuffer->getSize());
+    if (numBytes == 0)
+        numBytes = pBuffer->getSize() - offset;
+    FALCOR_CHECK(
+        offset + numBytes <= pBuffer->getSize(),
+        "'offset' ({}) and 'numBytes' ({}) don't fit the buffer size {}.",
+        offset,
+        numBytes,
+        pBuffer->getSize()
+    );
+    FALCOR_CHECK(numBytes > 0, "Nothing to read.");
+
+    return CopyContext::ReadBufferTask::create(this, pBuffer, offset, numBytes, std::move(pReadbackBuffer));
 }
 
 std::vector<uint8_t> CopyContext::readTextureSubresource(const Texture* pTexture, uint32_t subresourceIndex)
@@ -320,7 +350,8 @@ void CopyContext::updateTextureSubresources(
 CopyContext::ReadTextureTask::SharedPtr CopyContext::ReadTextureTask::create(
     CopyContext* pCtx,
     const Texture* pTexture,
-    uint32_t subresourceIndex
+    uint32_t subresourceIndex,
+    ref<Buffer> pBuffer
 )
 {
     SharedPtr pThis = SharedPtr(new ReadTextureTask);
@@ -339,8 +370,11 @@ CopyContext::ReadTextureTask::SharedPtr CopyContext::ReadTextureTask::create(
     uint64_t rowCount = (pTexture->getHeight(mipLevel) + formatInfo.blockHeight - 1) / formatInfo.blockHeight;
     uint64_t size = pTexture->getDepth(mipLevel) * rowCount * pThis->mRowSize;
 
-    // Create buffer
-    pThis->mpBuffer = pCtx->getDevice()->createBuffer(size, ResourceBindFlags::None, MemoryType::ReadBack, nullptr);
+    // Create buffer (or reuse the provided one if large enough)
+    if (pBuffer && pBuffer->getMemoryType() == MemoryType::ReadBack && pBuffer->getSize() >= size)
+        pThis->mpBuffer = std::move(pBuffer);
+    else
+        pThis->mpBuffer = pCtx->getDevice()->createBuffer(size, ResourceBindFlags::None, MemoryType::ReadBack, nullptr);
 
     // Copy from texture to buffer
     pCtx->resourceBarrier(pTexture, Resource::State::CopySource);
@@ -400,6 +434,17 @@ void CopyContext::ReadTextureTask::getData(void* pData, size_t size) const
     mpBuffer->unmap();
 }
 
+bool CopyContext::ReadTextureTask::isReady() const
+{
+    return mpFence->getCurrentValue() >= mpFence->getSignaledValue();
+}
+
+const void* CopyContext::ReadTextureTask::getMappedData() const
+{
+    mpFence->wait();
+    return mpBuffer->map();
+}
+
 std::vector<uint8_t> CopyContext::ReadTextureTask::getData() const
 {
     std::vector<uint8_t> result(size_t(mRowCount) * mActualRowSize * mDepth);
@@ -407,6 +452,60 @@ std::vector<uint8_t> CopyContext::ReadTextureTask::getData() const
     return result;
 }
 
+CopyContext::ReadBufferTask::SharedPtr CopyContext::ReadBufferTask::create(
+    CopyContext* pCtx,
+    const Buffer* pBuffer,
+    size_t offset,
+    size_t size,
+    ref<Buffer> pReadbackBuffer
+)
+{
+    SharedPtr pThis = SharedPtr(new ReadBufferTask);
+    pThis->mSize = size;
+
+    // Create buffer (or reuse the provided one if large enough)
+    if (pReadbackBuffer && pReadbackBuffer->getMemoryType() == MemoryType::ReadBack && pReadbackBuffer->getSize() >= size)
+        pThis->mpBuffer = std::move(pReadbackBuffer);
+    else
+        pThis->mpBuffer = pCtx->getDevice()->createBuffer(size, ResourceBindFlags::None, MemoryType::ReadBack, nullptr);
+
+    // Copy the requested range to the start of the readback buffer
+    pCtx->copyBufferRegion(pThis->mpBuffer.get(), 0, pBuffer, offset, size);
+
+    // Create a fence and signal
+    pThis->mpFence = pCtx->getDevice()->createFence();
+    pThis->mpFence->breakStrongReferenceToDevice();
+    pCtx->submit(false);
+    pCtx->signal(pThis->mpFence.get());
+    return pThis;
+}
+
+void CopyContext::ReadBufferTask::getData(void* pData, size_t size) const
+{
+    FALCOR_ASSERT(size == mSize);
+
+    std::memcpy(pData, getMappedData(), size);
+    mpBuffer->unmap();
+}
+
+std::vector<uint8_t> CopyContext::ReadBufferTask::getData() const
+{
+    std::vector<uint8_t> result(mSize);
+    getData(result.data(), result.size());
+    return result;
+}
+
+bool CopyContext::ReadBufferTask::isReady() const
+{
+    return mpFence->getCurrentValue() >= mpFence->getSignaledValue();
+}
+
+const void* CopyContext::ReadBufferTask::getMappedData() const
+{
+    mpFence->wait();
+    return mpBuffer->map();
+}
+
 bool CopyContext::textureBarrier(const Texture* pTexture, Resource::State newState)
 {
     auto resourceEncoder = getLowLevelData()->getResourceCommandEncoder();
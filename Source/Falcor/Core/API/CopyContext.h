@@ -53,9 +53,23 @@ public:
     {
     public:
         using SharedPtr = std::shared_ptr<ReadTextureTask>;
-        static SharedPtr create(CopyContext* pCtx, const Texture* pTexture, uint32_t subresourceIndex);
+        static SharedPtr create(CopyContext* pCtx, const Texture* pTexture, uint32_t subresourceIndex, ref<Buffer> pBuffer = nullptr);
         void getData(void* pData, size_t size) const;
         std::vector<uint8_t> getData() const;
+        /// Size of the data returned by getData().
+        size_t getDataSize() const { return size_t(mRowCount) * mActualRowSize * mDepth; }
+        /// Check if the readback has completed on the GPU (non-blocking).
+        bool isReady() const;
+        /// Get the readback buffer (can be reused for later reads once the task has completed).
+        const ref<Buffer>& getBuffer() const { return mpBuffer; }
+        /// Wait for the readback to complete and return the mapped readback buffer.
+        /// Rows are getRowPitch() bytes apart. The pointer is valid until the readback buffer is unmapped or reused.
+        const void* getMappedData() const;
+        /// Distance in bytes between rows in the readback buffer.
+        uint32_t getRowPitch() const { return mRowSize; }
+        /// Number of rows (of blocks for compressed formats) per depth slice.
+        uint32_t getRowCount() const { return mRowCount; }
+        uint32_t getDepth() const { return mDepth; }
 
     private:
         ReadTextureTask() = default;
@@ -68,6 +82,36 @@ public:
         uint32_t mDepth;
     };
 
+    class FALCOR_API ReadBufferTask
+    {
+    public:
+        using SharedPtr = std::shared_ptr<ReadBufferTask>;
+        static SharedPtr create(
+            CopyContext* pCtx,
+            const Buffer* pBuffer,
+            size_t offset,
+            size_t size,
+            ref<Buffer> pReadbackBuffer = nullptr
+        );
+        void getData(void* pData, size_t size) const;
+        std::vector<uint8_t> getData() const;
+        /// Size of the data returned by getData().
+        size_t getDataSize() const { return mSize; }
+        /// Check if the readback has completed on the GPU (non-blocking).
+        bool isReady() const;
+        /// Get the readback buffer (can be reused for later reads once the task has completed).
+        const ref<Buffer>& getBuffer() const { return mpBuffer; }
+        /// Wait for the readback to complete and return the mapped readback buffer.
+        /// The pointer is valid until the readback buffer is unmapped or reused.
+        const void* getMappedData() const;
+
+    private:
+        ReadBufferTask() = default;
+        ref<Fence> mpFence;
+        ref<Buffer> mpBuffer;
+        size_t mSize;
+    };
+
     /**
      * Constructor.
      * Throws an exception if creation failed.
@@ -214,6 +258,20 @@ public:
         return result;
     }
 
+    /**
+     * Read buffer data asynchronously. The data is copied to a readback buffer and can be accessed once the returned task is ready.
+     * @param[in] pBuffer Buffer to read from. Must not be a readback buffer.
+     * @param[in] offset Offset in bytes of the first byte to read.
+     * @param[in] numBytes Number of bytes to read. If 0, the rest of the buffer is read.
+     * @param[in] pReadbackBuffer Optional readback buffer to reuse. A new buffer is created if nullptr or too small.
+     */
+    ReadBufferTask::SharedPtr asyncReadBuffer(
+        const Buffer* pBuffer,
+        size_t offset = 0,
+        size_t numBytes = 0,
+        ref<Buffer> pReadbackBuffer = nullptr
+    );
+
     /**
      * Read texture data synchronously. Calling this command will flush the pipeline and wait for the GPU to finish execution
      */
@@ -221,8 +279,11 @@ public:
 
     /**
      * Read texture data Asynchronously
+     * @param[in] pTexture Texture to read from.
+     * @param[in] subresourceIndex Subresource to read.
+     * @param[in] pBuffer Optional readback buffer to reuse. A new buffer is created if nullptr or too small.
      */
-    ReadTextureTask::SharedPtr asyncReadTextureSubresource(const Texture* pTexture, uint32_t subresourceIndex);
+    ReadTextureTask::SharedPtr asyncReadTextureSubresource(const Texture* pTexture, uint32_t subresourceIndex, ref<Buffer> pBuffer = nullptr);
 
     /**
      * Get the low-level context data
@@ -165,4 +165,44 @@ ProgramDesc programDescFromPython(const pybind11::kwargs& kwargs)
     return desc;
 }
 
+pybind11::ndarray<pybind11::numpy> NumpyReadback::getResult() const
+{
+    const void* pData = nullptr;
+    {
+        pybind11::gil_scoped_release release;
+        pData = mGetMappedData();
+    }
+
+    // The array keeps the readback buffer alive.
+    ref<Buffer>* pOwner = new ref<Buffer>(mpReadbackBuffer);
+    pybind11::capsule owner(pOwner, [](void* p) noexcept { delete reinterpret_cast<ref<Buffer>*>(p); });
+
+    return pybind11::ndarray<pybind11::numpy>(
+        const_cast<void*>(pData),
+        mShape.size(),
+        mShape.data(),
+        owner,
+        mStrides.empty() ? nullptr : mStrides.data(),
+        mDtype,
+        pybind11::device::cpu::value
+    );
+}
+
+FALCOR_SCRIPT_BINDING(NumpyReadback)
+{
+    pybind11::class_<NumpyReadback> readback(m, "NumpyReadback");
+    readback.def("done", &NumpyReadback::isReady);
+    readback.def("result", &NumpyReadback::getResult);
+    readback.def_property_readonly("readback_buffer", &NumpyReadback::getReadbackBuffer);
+    readback.def(
+        "__await__",
+        [](pybind11::object self)
+        {
+            // Wait on a worker thread so the event loop keeps running while the GPU finishes.
+            pybind11::object loop = pybind11::module_::import("asyncio").attr("get_running_loop")();
+            return loop.attr("run_in_executor")(pybind11::none(), self.attr("result")).attr("__await__")();
+        }
+    );
+}
+
 } // namespace Falcor
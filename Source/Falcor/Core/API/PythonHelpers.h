@@ -27,12 +27,16 @@
  **************************************************************************/
 #pragma once
 
+#include "Core/API/Buffer.h"
 #include "Core/API/Formats.h"
 #include "Core/Program/Program.h"
 #include "Utils/Scripting/ScriptBindings.h"
 #include "Utils/Scripting/ndarray.h"
 
+#include <functional>
+#include <memory>
 #include <optional>
+#include <vector>
 
 namespace Falcor
 {
@@ -86,4 +90,47 @@ TypeConformanceList typeConformanceListFromPython(const pybind11::dict& dict);
 
 ProgramDesc programDescFromPython(const pybind11::kwargs& kwargs);
 
+/**
+ * Asynchronous readback of GPU data to a numpy array, exposed to Python as a future.
+ * The resulting array is a view into the mapped readback buffer and does not copy the data.
+ * The view is only valid until the readback buffer is reused for another read.
+ */
+class NumpyReadback
+{
+public:
+    /**
+     * Create a readback from a pending read task (CopyContext::ReadBufferTask or CopyContext::ReadTextureTask).
+     * @param[in] pTask The read task.
+     * @param[in] dtype Element type of the array.
+     * @param[in] shape Shape of the array.
+     * @param[in] strides Strides of the array in elements. If empty, the array is C-contiguous.
+     */
+    template<typename Task>
+    NumpyReadback(std::shared_ptr<Task> pTask, pybind11::dlpack::dtype dtype, std::vector<size_t> shape, std::vector<int64_t> strides = {})
+        : mIsReady([pTask]() { return pTask->isReady(); })
+        , mGetMappedData([pTask]() { return pTask->getMappedData(); })
+        , mpReadbackBuffer(pTask->getBuffer())
+        , mDtype(dtype)
+        , mShape(std::move(shape))
+        , mStrides(std::move(strides))
+    {}
+
+    /// Check if the readback has completed on the GPU (non-blocking).
+    bool isReady() const { return mIsReady(); }
+
+    /// Wait for the readback to complete and return the data. The GIL is released while waiting.
+    pybind11::ndarray<pybind11::numpy> getResult() const;
+
+    /// Get the readback buffer. It can be passed to a later readback once the result is no longer used.
+    const ref<Buffer>& getReadbackBuffer() const { return mpReadbackBuffer; }
+
+private:
+    std::function<bool()> mIsReady;
+    std::function<const void*()> mGetMappedData;
+    ref<Buffer> mpReadbackBuffer;
+    pybind11::dlpack::dtype mDtype;
+    std::vector<size_t> mShape;
+    std::vector<int64_t> mStrides;
+};
+
 } // namespace Falcor
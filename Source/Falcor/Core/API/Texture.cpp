@@ -750,10 +750,7 @@ uint64_t Texture::getTextureSizeInBytes() const
     return outSizeBytes;
 }
 
-/**
- * Python binding wrapper for returning the content of a texture as a numpy array.
- */
-inline pybind11::ndarray<pybind11::numpy> texture_to_numpy(const Texture& self, uint32_t mip_level, uint32_t array_slice)
+inline void check_subresource(const Texture& self, uint32_t mip_level, uint32_t array_slice)
 {
     FALCOR_CHECK(
         mip_level < self.getMipCount(), "'mip_level' ({}) is out of bounds. Only {} level(s) available.", mip_level, self.getMipCount()
@@ -764,6 +761,14 @@ inline pybind11::ndarray<pybind11::numpy> texture_to_numpy(const Texture& self,
         array_slice,
         self.getArraySize()
     );
+}
+
+/**
+ * Python binding wrapper for returning the content of a texture as a numpy array.
+ */
+inline pybind11::ndarray<pybind11::numpy> texture_to_numpy(const Texture& self, uint32_t mip_level, uint32_t array_slice)
+{
+    check_subresource(self, mip_level, array_slice);
 
     // Get image dimensions.
     uint32_t width = self.getWidth(mip_level);
@@ -803,17 +808,52 @@ inline pybind11::ndarray<pybind11::numpy> texture_to_numpy(const Texture& self,
     }
 }
 
+/**
+ * Python binding wrapper for asynchronously reading a texture to a numpy array.
+ * The result is a strided view into the readback buffer, which skips the row padding required by the copy.
+ */
+inline NumpyReadback texture_to_numpy_async(const Texture& self, uint32_t mip_level, uint32_t array_slice, ref<Buffer> readback_buffer)
+{
+    check_subresource(self, mip_level, array_slice);
+
+    auto dtype = resourceFormatToDtype(self.getFormat());
+    FALCOR_CHECK(dtype, "Texture format '{}' is not supported. Use to_numpy() instead.", to_string(self.getFormat()));
+
+    uint32_t subresource = self.getSubresourceIndex(array_slice, mip_level);
+    auto pTask = self.getDevice()->getRenderContext()->asyncReadTextureSubresource(&self, subresource, std::move(readback_buffer));
+
+    size_t elementSize = getDtypeByteSize(*dtype);
+    FALCOR_ASSERT(pTask->getRowPitch() % elementSize == 0);
+    int64_t rowStride = pTask->getRowPitch() / elementSize;
+    uint32_t channelCount = getFormatChannelCount(self.getFormat());
+
+    // Same shape as texture_to_numpy().
+    std::vector<size_t> shape;
+    std::vector<int64_t> strides;
+    if (pTask->getDepth() > 1)
+    {
+        shape.push_back(pTask->getDepth());
+        strides.push_back(rowStride * pTask->getRowCount());
+    }
+    if (pTask->getRowCount() > 1)
+    {
+        shape.push_back(pTask->getRowCount());
+        strides.push_back(rowStride);
+    }
+    shape.push_back(self.getWidth(mip_level));
+    strides.push_back(channelCount);
+    if (channelCount > 1)
+    {
+        shape.push_back(channelCount);
+        strides.push_back(1);
+    }
+
+    return NumpyReadback(pTask, *dtype, std::move(shape), std::move(strides));
+}
+
 inline void texture_from_numpy(Texture& self, pybind11::ndarray<pybind11::numpy> data, uint32_t mip_level, uint32_t array_slice)
 {
-    FALCOR_CHECK(
-        mip_level < self.getMipCount(), "'mip_level' ({}) is out of bounds. Only {} level(s) available.", mip_level, self.getMipCount()
-    );
-    FALCOR_CHECK(
-        array_slice < self.getArraySize(),
-        "'array_slice' ({}) is out of bounds. Only {} slice(s) available.",
-        array_slice,
-        self.getArraySize()
-    );
+    check_subresource(self, mip_level, array_slice);
     FALCOR_CHECK(isNdarrayContiguous(data), "numpy array is not contiguous");
 
     uint32_t subresource = self.getSubresourceIndex(array_slice, mip_level);
@@ -831,6 +871,7 @@ FALCOR_SCRIPT_BINDING(Texture)
     using namespace pybind11::literals;
 
     FALCOR_SCRIPT_BINDING_DEPENDENCY(Resource)
+    FALCOR_SCRIPT_BINDING_DEPENDENCY(NumpyReadback)
 
     pybind11::class_<Texture, Resource, ref<Texture>> texture(m, "Texture");
     texture.def_property_readonly("format", &Texture::getFormat);
@@ -842,6 +883,7 @@ FALCOR_SCRIPT_BINDING(Texture)
     texture.def_property_readonly("sample_count", &Texture::getSampleCount);
 
     texture.def("to_numpy", texture_to_numpy, "mip_level"_a = 0, "array_slice"_a = 0);
+    texture.def("to_numpy_async", texture_to_numpy_async, "mip_level"_a = 0, "array_slice"_a = 0, "readback_buffer"_a = nullptr);
     texture.def("from_numpy", texture_from_numpy, "data"_a, "mip_level"_a = 0, "array_slice"_a = 0);
 }
 } // namespace Falcor
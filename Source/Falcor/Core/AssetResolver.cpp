@@ -29,8 +29,230 @@
 #include "Core/Platform/OS.h"
 #include "Utils/Scripting/ScriptBindings.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 namespace Falcor
 {
+namespace
+{
+std::atomic<uint64_t> sFilesystemCalls{0};
+std::atomic<uint64_t> sDirectoryScans{0};
+std::atomic<uint64_t> sCacheHits{0};
+
+/// Cached listings are checked against the directory modification time at most this often.
+/// Lookups failing on a cached listing are retried on the filesystem, so only removed files can be missed.
+constexpr auto kValidationInterval = std::chrono::seconds(1);
+
+/// Directories modified less than this long before being listed are considered racy: further modifications
+/// within the filesystem timestamp granularity would not change the modification time and go unnoticed.
+/// Racy listings are only trusted for existing entries and are listed again once the interval has passed.
+constexpr auto kRacyInterval = std::chrono::seconds(2);
+
+/// Cached listing of a single directory.
+struct DirectoryListing
+{
+    struct Entry
+    {
+        std::string name;   ///< Entry name as stored on disk.
+        bool isRegularFile; ///< True if the entry is a regular file (after following symlinks).
+        bool isSymlink;     ///< True if the entry is a symlink.
+    };
+
+    bool exists = false;      ///< True if the path exists.
+    bool isDirectory = false; ///< True if the path is a directory that could be listed.
+    bool isRacy = false;      ///< True if the directory was modified shortly before being listed.
+    std::filesystem::file_time_type modificationTime;
+    std::filesystem::path canonicalPath;
+    std::unordered_map<std::string, Entry> entries; ///< Entries by (normalized) name.
+    std::vector<std::string> regularFiles;          ///< Names of regular files in listing order.
+};
+
+/// Normalize an entry name for lookups (the filesystem is case-insensitive on Windows).
+std::string normalizeName(std::string name)
+{
+#if FALCOR_WINDOWS
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+#endif
+    return name;
+}
+
+/// Returns true if the path has '..' components, which can not be resolved lexically in the presence of symlinks.
+bool hasParentReference(const std::filesystem::path& path)
+{
+    return std::any_of(path.begin(), path.end(), [](const std::filesystem::path& p) { return p == ".."; });
+}
+
+/**
+ * Process-wide cache of directory listings.
+ * Listings are validated against the directory modification time and listed again if changed.
+ */
+class DirectoryCache
+{
+public:
+    static DirectoryCache& get()
+    {
+        static DirectoryCache cache;
+        return cache;
+    }
+
+    std::shared_ptr<const DirectoryListing> getListing(const std::filesystem::path& dir)
+    {
+        std::string key = dir.lexically_normal().string();
+        auto now = std::chrono::steady_clock::now();
+
+        // Serve recently validated listings without touching the filesystem.
+        std::shared_ptr<const DirectoryListing> pCached;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto it = mListings.find(key);
+            if (it != mListings.end())
+            {
+                if (now - it->second.validationTime < kValidationInterval)
+                {
+                    sCacheHits++;
+                    return it->second.pListing;
+                }
+                pCached = it->second.pListing;
+            }
+        }
+
+        // Otherwise check the modification time and list the directory again if it has changed.
+        std::error_code err;
+        sFilesystemCalls++;
+        auto modificationTime = std::filesystem::last_write_time(dir, err);
+        bool exists = !err;
+
+        std::shared_ptr<const DirectoryListing> pListing;
+        if (pCached && pCached->exists == exists && (!exists || pCached->modificationTime == modificationTime) &&
+            !(pCached->isRacy && std::filesystem::file_time_type::clock::now() >= pCached->modificationTime + kRacyInterval))
+        {
+            sCacheHits++;
+            pListing = pCached;
+        }
+        else
+        {
+            pListing = scan(dir, exists, modificationTime);
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mListings[key] = CacheEntry{pListing, now};
+        return pListing;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mListings.clear();
+    }
+
+private:
+    static std::shared_ptr<const DirectoryListing> scan(
+        const std::filesystem::path& dir,
+        bool exists,
+        std::filesystem::file_time_type modificationTime
+    )
+    {
+        auto pListing = std::make_shared<DirectoryListing>();
+        pListing->exists = exists;
+        pListing->modificationTime = modificationTime;
+        if (!exists)
+            return pListing;
+
+        pListing->isRacy = modificationTime + kRacyInterval >= std::filesystem::file_time_type::clock::now();
+
+        std::error_code err;
+        sDirectoryScans++;
+        sFilesystemCalls++;
+        std::filesystem::directory_iterator it(dir, err);
+        if (err)
+            return pListing;
+        for (; it != std::filesystem::directory_iterator(); it.increment(err))
+        {
+            if (err)
+                return pListing;
+            DirectoryListing::Entry entry;
+            entry.name = it->path().filename().string();
+            entry.isSymlink = it->is_symlink(err);
+            if (entry.isSymlink)
+                sFilesystemCalls++;
+            entry.isRegularFile = it->is_regular_file(err);
+            if (entry.isRegularFile)
+                pListing->regularFiles.push_back(entry.name);
+            pListing->entries.emplace(normalizeName(entry.name), std::move(entry));
+        }
+
+        sFilesystemCalls++;
+        pListing->canonicalPath = std::filesystem::canonical(dir, err);
+        pListing->isDirectory = !err;
+        return pListing;
+    }
+
+    struct CacheEntry
+    {
+        std::shared_ptr<const DirectoryListing> pListing;
+        std::chrono::steady_clock::time_point validationTime; ///< Time the listing was last checked against the filesystem.
+    };
+
+    std::mutex mMutex;
+    std::unordered_map<std::string, CacheEntry> mListings;
+};
+
+/// Resolve an absolute path to its canonical form if it exists. Returns an empty path otherwise.
+std::filesystem::path resolveExistingPath(const std::filesystem::path& path, bool useCache)
+{
+    std::filesystem::path filename = path.filename();
+    if (useCache && !filename.empty() && filename != "." && !hasParentReference(path))
+    {
+        auto pListing = DirectoryCache::get().getListing(path.parent_path());
+        if (!pListing->isDirectory)
+            return {};
+        auto it = pListing->entries.find(normalizeName(filename.string()));
+        if (it != pListing->entries.end() && !it->second.isSymlink)
+            return pListing->canonicalPath / it->second.name;
+        if (it == pListing->entries.end() && !pListing->isRacy)
+            return {};
+        // Symlinks and entries missing from racy listings are checked on the filesystem below.
+    }
+
+    sFilesystemCalls++;
+    if (!std::filesystem::exists(path))
+        return {};
+    sFilesystemCalls++;
+    return std::filesystem::canonical(path);
+}
+
+/// List files in an absolute directory path matching a regular expression.
+std::vector<std::filesystem::path> globFiles(const std::filesystem::path& dir, const std::regex& regex, bool firstMatchOnly, bool useCache)
+{
+    std::shared_ptr<const DirectoryListing> pListing;
+    if (useCache && !hasParentReference(dir))
+        pListing = DirectoryCache::get().getListing(dir);
+
+    if (!pListing || pListing->isRacy)
+    {
+        sFilesystemCalls += 2;
+        return globFilesInDirectory(dir, regex, firstMatchOnly);
+    }
+
+    std::vector<std::filesystem::path> result;
+    for (const auto& name : pListing->regularFiles)
+    {
+        if (std::regex_match(name, regex))
+        {
+            result.push_back(dir / name);
+            if (firstMatchOnly)
+                break;
+        }
+    }
+    return result;
+}
+} // namespace
 
 AssetResolver::AssetResolver()
 {
@@ -41,18 +263,10 @@ std::filesystem::path AssetResolver::resolvePath(const std::filesystem::path& pa
 {
     FALCOR_CHECK(category < AssetCategory::Count, "Invalid asset category.");
 
-    // If this is an existing absolute path, or a relative path to the working directory, return it.
-    std::filesystem::path absolute = std::filesystem::absolute(path);
-    if (std::filesystem::exists(absolute))
-        return std::filesystem::canonical(absolute);
-
-    // Otherwise, try to resolve using search paths.
-    // First try resolving for the specified asset category.
-    std::filesystem::path resolved = mSearchContexts[size_t(category)].resolvePath(path);
-
-    // If not resolved, try resolving for the Any asset category.
-    if (category != AssetCategory::Any && resolved.empty())
-        resolved = mSearchContexts[size_t(AssetCategory::Any)].resolvePath(path);
+    // Cached listings may miss files created since they were last validated, so retry uncached before failing.
+    std::filesystem::path resolved = resolvePathImpl(path, category, mUseDirectoryCache);
+    if (resolved.empty() && mUseDirectoryCache)
+        resolved = resolvePathImpl(path, category, false);
 
     if (resolved.empty())
         logWarning("Failed to resolve path '{}' for asset type '{}'.", path, category);
@@ -71,22 +285,56 @@ std::vector<std::filesystem::path> AssetResolver::resolvePathPattern(
 
     std::regex regex(pattern);
 
+    // Cached listings may miss files created since they were last validated, so retry uncached before failing.
+    std::vector<std::filesystem::path> resolved = resolvePathPatternImpl(path, regex, firstMatchOnly, category, mUseDirectoryCache);
+    if (resolved.empty() && mUseDirectoryCache)
+        resolved = resolvePathPatternImpl(path, regex, firstMatchOnly, category, false);
+
+    if (resolved.empty())
+        logWarning("Failed to resolve path pattern '{}/{}' for asset type '{}'.", path, pattern, category);
+
+    return resolved;
+}
+
+std::filesystem::path AssetResolver::resolvePathImpl(const std::filesystem::path& path, AssetCategory category, bool useCache) const
+{
+    // If this is an existing absolute path, or a relative path to the working directory, return it.
+    std::filesystem::path absolute = std::filesystem::absolute(path);
+    if (std::filesystem::path resolved = resolveExistingPath(absolute, useCache); !resolved.empty())
+        return resolved;
+
+    // Otherwise, try to resolve using search paths.
+    // First try resolving for the specified asset category.
+    std::filesystem::path resolved = mSearchContexts[size_t(category)].resolvePath(path, useCache);
+
+    // If not resolved, try resolving for the Any asset category.
+    if (category != AssetCategory::Any && resolved.empty())
+        resolved = mSearchContexts[size_t(AssetCategory::Any)].resolvePath(path, useCache);
+
+    return resolved;
+}
+
+std::vector<std::filesystem::path> AssetResolver::resolvePathPatternImpl(
+    const std::filesystem::path& path,
+    const std::regex& regex,
+    bool firstMatchOnly,
+    AssetCategory category,
+    bool useCache
+) const
+{
     // If this is an existing absolute path, or a relative path to the working directory, search it.
     std::filesystem::path absolute = std::filesystem::absolute(path);
-    std::vector<std::filesystem::path> resolved = globFilesInDirectory(absolute, regex, firstMatchOnly);
+    std::vector<std::filesystem::path> resolved = globFiles(absolute, regex, firstMatchOnly, useCache);
     if (!resolved.empty())
         return resolved;
 
     // Otherwise, try to resolve using search paths.
     // First try resolving for the specified asset category.
-    resolved = mSearchContexts[size_t(category)].resolvePathPattern(path, regex, firstMatchOnly);
+    resolved = mSearchContexts[size_t(category)].resolvePathPattern(path, regex, firstMatchOnly, useCache);
 
     // If not resolved, try resolving for the Any asset category.
     if (category != AssetCategory::Any && resolved.empty())
-        resolved = mSearchContexts[size_t(AssetCategory::Any)].resolvePathPattern(path, regex, firstMatchOnly);
-
-    if (resolved.empty())
-        logWarning("Failed to resolve path pattern '{}/{}' for asset type '{}'.", path, pattern, category);
+        resolved = mSearchContexts[size_t(AssetCategory::Any)].resolvePathPattern(path, regex, firstMatchOnly, useCache);
 
     return resolved;
 }
@@ -98,19 +346,40 @@ void AssetResolver::addSearchPath(const std::filesystem::path& path, SearchPathP
     mSearchContexts[size_t(category)].addSearchPath(path, priority);
 }
 
+void AssetResolver::clearDirectoryCache()
+{
+    DirectoryCache::get().clear();
+}
+
+AssetResolver::Stats AssetResolver::getStats()
+{
+    Stats stats;
+    stats.filesystemCalls = sFilesystemCalls.load();
+    stats.directoryScans = sDirectoryScans.load();
+    stats.cacheHits = sCacheHits.load();
+    return stats;
+}
+
+void AssetResolver::resetStats()
+{
+    sFilesystemCalls = 0;
+    sDirectoryScans = 0;
+    sCacheHits = 0;
+}
+
 AssetResolver& AssetResolver::getDefaultResolver()
 {
     static AssetResolver defaultResolver;
     return defaultResolver;
 }
 
-std::filesystem::path AssetResolver::SearchContext::resolvePath(const std::filesystem::path& path) const
+std::filesystem::path AssetResolver::SearchContext::resolvePath(const std::filesystem::path& path, bool useCache) const
 {
     for (const auto& searchPath : searchPaths)
     {
-        std::filesystem::path absolutePath = searchPath / path;
-        if (std::filesystem::exists(absolutePath))
-            return std::filesystem::canonical(absolutePath);
+        std::filesystem::path resolved = resolveExistingPath(searchPath / path, useCache);
+        if (!resolved.empty())
+            return resolved;
     }
 
     return {};
@@ -119,13 +388,14 @@ std::filesystem::path AssetResolver::SearchContext::resolvePath(const std::files
 std::vector<std::filesystem::path> AssetResolver::SearchContext::resolvePathPattern(
     const std::filesystem::path& path,
     const std::regex& regex,
-    bool firstMatchOnly
+    bool firstMatchOnly,
+    bool useCache
 ) const
 {
     for (const auto& searchPath : searchPaths)
     {
         std::filesystem::path absolutePath = searchPath / path;
-        std::vector<std::filesystem::path> resolved = globFilesInDirectory(absolutePath, regex, firstMatchOnly);
+        std::vector<std::filesystem::path> resolved = globFiles(absolutePath, regex, firstMatchOnly, useCache);
         if (!resolved.empty())
             return resolved;
     }
@@ -176,6 +446,11 @@ FALCOR_SCRIPT_BINDING(AssetResolver)
         "category"_a = AssetCategory::Any
     );
 
+    assetResolver.def_property(
+        "directory_cache_enabled", &AssetResolver::isDirectoryCacheEnabled, &AssetResolver::setDirectoryCacheEnabled
+    );
+    assetResolver.def_static("clear_directory_cache", &AssetResolver::clearDirectoryCache);
+
     assetResolver.def_property_readonly_static("default_resolver", [](pybind11::object) { return AssetResolver::getDefaultResolver(); });
 }
 
@@ -29,6 +29,7 @@
 
 #include "Macros.h"
 #include "Enum.h"
+#include <cstdint>
 #include <filesystem>
 #include <regex>
 #include <string>
@@ -84,10 +85,23 @@ FALCOR_ENUM_REGISTER(SearchPathPriority);
  * search paths. When resolving a path, the resolver will first try to resolve the path
  * for the specified category, and if that fails, it will try to resolve it for the \c AssetCategory::Any category.
  * If no asset category is specified, the \c AssetCategory::Any category is used by default.
+ *
+ * Lookups are served from a process-wide directory cache. The first lookup in a directory lists its entries,
+ * later lookups check the directory modification time (at most once a second) to detect changes. This avoids
+ * most filesystem queries when resolving many assets, which is especially costly on network filesystems.
+ * Lookups that fail are retried without the cache, so newly created files are always found.
  */
 class FALCOR_API AssetResolver
 {
 public:
+    /// Directory cache statistics.
+    struct Stats
+    {
+        uint64_t filesystemCalls = 0; ///< Number of filesystem queries (stat, canonicalize, directory listing).
+        uint64_t directoryScans = 0;  ///< Number of directories listed.
+        uint64_t cacheHits = 0;       ///< Number of directory lookups served from the cache.
+    };
+
     /// Default constructor.
     AssetResolver();
 
@@ -137,26 +151,56 @@ public:
         AssetCategory category = AssetCategory::Any
     );
 
+    /**
+     * Enable/disable the directory cache for this resolver.
+     * If disabled, every lookup queries the filesystem directly.
+     */
+    void setDirectoryCacheEnabled(bool enabled) { mUseDirectoryCache = enabled; }
+
+    /// Returns true if the directory cache is enabled for this resolver.
+    bool isDirectoryCacheEnabled() const { return mUseDirectoryCache; }
+
+    /// Clear the directory cache.
+    static void clearDirectoryCache();
+
+    /// Get filesystem and cache statistics (accumulated over all resolvers).
+    static Stats getStats();
+
+    /// Reset filesystem and cache statistics.
+    static void resetStats();
+
     /// Return the global default asset resolver.
     static AssetResolver& getDefaultResolver();
 
 private:
+    std::filesystem::path resolvePathImpl(const std::filesystem::path& path, AssetCategory category, bool useCache) const;
+
+    std::vector<std::filesystem::path> resolvePathPatternImpl(
+        const std::filesystem::path& path,
+        const std::regex& regex,
+        bool firstMatchOnly,
+        AssetCategory category,
+        bool useCache
+    ) const;
+
     struct SearchContext
     {
         /// List of search paths. Resolving is done by searching these paths in order.
         std::vector<std::filesystem::path> searchPaths;
 
-        std::filesystem::path resolvePath(const std::filesystem::path& path) const;
+        std::filesystem::path resolvePath(const std::filesystem::path& path, bool useCache) const;
 
         std::vector<std::filesystem::path> resolvePathPattern(
             const std::filesystem::path& path,
             const std::regex& regex,
-            bool firstMatchOnly
+            bool firstMatchOnly,
+            bool useCache
         ) const;
 
         void addSearchPath(const std::filesystem::path& path, SearchPathPriority priority);
     };
 
     std::vector<SearchContext> mSearchContexts;
+    bool mUseDirectoryCache = true;
 };
 } // namespace Falcor
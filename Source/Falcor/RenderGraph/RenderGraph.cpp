@@ -119,6 +119,7 @@ void RenderGraph::setScene(const ref<Scene>& pScene)
     for (auto& it : mNodeData)
     {
         it.second.pPass->setScene(mpDevice->getRenderContext(), pScene);
+        mChangedPasses.insert(it.second.pPass.get());
     }
     mRecompile = true;
 }
@@ -139,7 +140,11 @@ uint32_t RenderGraph::addPass(const ref<RenderPass>& pPass, const std::string& p
     uint32_t passIndex = mpGraph->addNode();
     mNameToIndex[passName] = passIndex;
 
-    pPass->mPassChangedCB = [this]() { mRecompile = true; };
+    pPass->mPassChangedCB = [this, pChangedPass = pPass.get()]()
+    {
+        mChangedPasses.insert(pChangedPass);
+        mRecompile = true;
+    };
     pPass->mName = passName;
 
     if (mpScene)
@@ -168,6 +173,7 @@ void RenderGraph::removePass(const std::string& name)
     for (const auto& outputName : outputsToDelete)
         unmarkOutput(outputName);
     mNameToIndex.erase(name);
+    mChangedPasses.erase(mNodeData[index].pPass.get());
     mNodeData.erase(index);
     const auto& removedEdges = mpGraph->removeNode(index);
     for (const auto& e : removedEdges)
@@ -187,7 +193,11 @@ void RenderGraph::updatePass(const std::string& passName, const Properties& prop
     std::string passTypeName = pOldPass->getType();
     auto pPass = RenderPass::create(passTypeName, mpDevice, props);
     pPassIt->second.pPass = pPass;
-    pPass->mPassChangedCB = [this]() { mRecompile = true; };
+    pPass->mPassChangedCB = [this, pChangedPass = pPass.get()]()
+    {
+        mChangedPasses.insert(pChangedPass);
+        mRecompile = true;
+    };
     pPass->mName = pOldPass->getName();
 
     if (mpScene)
@@ -425,16 +435,28 @@ bool RenderGraph::compile(RenderContext* pRenderContext, std::string& log)
 {
     if (!mRecompile)
         return true;
-    mpExe = nullptr;
 
     try
     {
-        mpExe = RenderGraphCompiler::compile(*this, pRenderContext, mCompilerDeps);
+        // Recompile incrementally, keeping the compiled passes and resources of the previous compilation that didn't change.
+        mpExe = RenderGraphCompiler::compile(*this, pRenderContext, mCompilerDeps, mpExe.get());
         mRecompile = false;
+        mChangedPasses.clear();
+
+        const auto& stats = mpExe->getCompileStats();
+        logDebug(
+            "Compiled render graph '{}': {} passes compiled, {} unchanged. {} resources allocated, {} reused.",
+            mName,
+            stats.compiledPassCount,
+            stats.skippedPassCount,
+            stats.allocatedResourceCount,
+            stats.reusedResourceCount
+        );
         return true;
     }
     catch (const std::exception& e)
     {
+        mpExe = nullptr;
         log = e.what();
         return false;
     }
@@ -378,6 +378,7 @@ private:
     std::unique_ptr<RenderGraphExe> mpExe;           ///< Helper for allocating resources and executing the graph.
     RenderGraphCompiler::Dependencies mCompilerDeps; ///< Data needed by the graph compiler.
     bool mRecompile = false; ///< Set to true to trigger a recompilation after any graph changes (topology/scene/size/passes/etc.)
+    std::unordered_set<const RenderPass*> mChangedPasses; ///< Passes that need to be compiled on the next recompilation.
 
     friend class RenderGraphUI;
     friend class RenderGraphExporter;
@@ -40,19 +40,26 @@ bool canAutoResolve(const RenderPassReflection::Field& src, const RenderPassRefl
 {
     return src.getSampleCount() > 1 && dst.getSampleCount() == 1;
 }
+
+bool isCompileDataEqual(const RenderPass::CompileData& lhs, const RenderPass::CompileData& rhs)
+{
+    return all(lhs.defaultTexDims == rhs.defaultTexDims) && lhs.defaultTexFormat == rhs.defaultTexFormat &&
+           lhs.connectedResources == rhs.connectedResources;
+}
 } // namespace
 
-RenderGraphCompiler::RenderGraphCompiler(RenderGraph& graph, const Dependencies& dependencies)
-    : mGraph(graph), mpDevice(graph.getDevice()), mDependencies(dependencies)
+RenderGraphCompiler::RenderGraphCompiler(RenderGraph& graph, const Dependencies& dependencies, RenderGraphExe* pPreviousExe)
+    : mGraph(graph), mpDevice(graph.getDevice()), mDependencies(dependencies), mpPreviousExe(pPreviousExe)
 {}
 
 std::unique_ptr<RenderGraphExe> RenderGraphCompiler::compile(
     RenderGraph& graph,
     RenderContext* pRenderContext,
-    const Dependencies& dependencies
+    const Dependencies& dependencies,
+    RenderGraphExe* pPreviousExe
 )
 {
-    RenderGraphCompiler c = RenderGraphCompiler(graph, dependencies);
+    RenderGraphCompiler c = RenderGraphCompiler(graph, dependencies, pPreviousExe);
 
     // Register the external resources
     auto pResourcesCache = std::make_unique<ResourceCache>();
@@ -64,17 +71,33 @@ std::unique_ptr<RenderGraphExe> RenderGraphCompiler::compile(
     if (c.insertAutoPasses())
         c.resolveExecutionOrder();
     c.validateGraph();
-    c.allocateResources(pRenderContext->getDevice(), pResourcesCache.get());
+    auto allocationStats = c.allocateResources(pRenderContext->getDevice(), pResourcesCache.get());
 
     auto pExe = std::make_unique<RenderGraphExe>();
     pExe->mExecutionList.reserve(c.mExecutionList.size());
 
-    for (auto e : c.mExecutionList)
+    for (const auto& e : c.mExecutionList)
     {
-        pExe->insertPass(e.name, e.pPass);
+        // Resolve the pass fields to resource slots, so the pass can look up its resources without string formatting.
+        std::vector<ResourceCache::FieldSlot> slots;
+        slots.reserve(e.reflector.getFieldCount());
+        for (size_t f = 0; f < e.reflector.getFieldCount(); f++)
+        {
+            const std::string& fieldName = e.reflector.getField(f)->getName();
+            slots.push_back({fieldName, pResourcesCache->getSlot(e.name + '.' + fieldName)});
+        }
+        auto compileDataIt = c.mPassCompileData.find(e.pPass.get());
+        RenderPass::CompileData compileData = compileDataIt != c.mPassCompileData.end() ? compileDataIt->second : RenderPass::CompileData{};
+        pExe->insertPass(e.name, e.pPass, std::move(slots), e.reflector, std::move(compileData));
     }
     c.restoreCompilationChanges();
     pExe->mpResourceCache = std::move(pResourcesCache);
+
+    auto& stats = pExe->mCompileStats;
+    stats.compiledPassCount = (uint32_t)c.mCompiledPasses.size();
+    stats.skippedPassCount = (uint32_t)(c.mPassCompileData.size() - c.mCompiledPasses.size());
+    stats.allocatedResourceCount = allocationStats.allocatedCount;
+    stats.reusedResourceCount = allocationStats.reusedCount;
     return pExe;
 }
 
@@ -261,7 +284,7 @@ bool RenderGraphCompiler::insertAutoPasses()
     return addedPasses;
 }
 
-void RenderGraphCompiler::allocateResources(ref<Device> pDevice, ResourceCache* pResourceCache)
+ResourceCache::AllocationStats RenderGraphCompiler::allocateResources(ref<Device> pDevice, ResourceCache* pResourceCache)
 {
     // Build list to look up execution order index from the pass
     std::unordered_map<RenderPass*, uint32_t> passToIndex;
@@ -342,7 +365,8 @@ void RenderGraphCompiler::allocateResources(ref<Device> pDevice, ResourceCache*
         }
     }
 
-    pResourceCache->allocateResources(pDevice, mDependencies.defaultResourceProps);
+    ResourceCache* pPreviousCache = mpPreviousExe ? mpPreviousExe->mpResourceCache.get() : nullptr;
+    return pResourceCache->allocateResources(pDevice, mDependencies.defaultResourceProps, pPreviousCache);
 }
 
 void RenderGraphCompiler::restoreCompilationChanges()
@@ -440,29 +464,51 @@ RenderPass::CompileData RenderGraphCompiler::prepPassCompilationData(const PassD
     return compileData;
 }
 
+bool RenderGraphCompiler::isPassChanged(const PassData& passData, const RenderPass::CompileData& compileData) const
+{
+    if (mGraph.mChangedPasses.count(passData.pPass.get()) > 0)
+        return true;
+
+    const RenderGraphExe::Pass* pPrevPass = mpPreviousExe ? mpPreviousExe->findPass(passData.pPass.get()) : nullptr;
+    return !pPrevPass || pPrevPass->reflection != passData.reflector || !isCompileDataEqual(pPrevPass->compileData, compileData);
+}
+
 void RenderGraphCompiler::compilePasses(RenderContext* pRenderContext)
 {
+    // Only compile passes that changed since the previous compilation. If compilation fails, compile all passes on retry.
+    bool incremental = mpPreviousExe != nullptr;
+
     while (1)
     {
         std::string log;
         bool success = true;
         for (auto& p : mExecutionList)
         {
+            RenderPass::CompileData compileData = prepPassCompilationData(p);
+            if (incremental && !isPassChanged(p, compileData))
+            {
+                mPassCompileData[p.pPass.get()] = std::move(compileData);
+                continue;
+            }
+
             try
             {
-                p.pPass->compile(pRenderContext, prepPassCompilationData(p));
+                p.pPass->compile(pRenderContext, compileData);
+                mCompiledPasses.insert(p.pPass.get());
             }
             catch (const std::exception& e)
             {
                 log += std::string(e.what()) + "\n";
                 success = false;
             }
+            mPassCompileData[p.pPass.get()] = std::move(compileData);
         }
 
         if (success)
             return;
 
         // Retry
+        incremental = false;
         bool changed = false;
         for (auto& p : mExecutionList)
         {
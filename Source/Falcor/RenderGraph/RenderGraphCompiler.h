@@ -32,6 +32,8 @@
 #include "RenderGraphExe.h"
 #include "Core/Macros.h"
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -47,14 +49,31 @@ public:
         ResourceCache::DefaultProperties defaultResourceProps;
         ResourceCache::ResourcesMap externalResources;
     };
-    static std::unique_ptr<RenderGraphExe> compile(RenderGraph& graph, RenderContext* pRenderContext, const Dependencies& dependencies);
+
+    /**
+     * Compile a render graph.
+     * @param[in] graph The render graph.
+     * @param[in] pRenderContext The render context.
+     * @param[in] dependencies Data needed by the compiler.
+     * @param[in] pPreviousExe Optional. Result of the previous compilation of the graph. If specified, the graph is recompiled
+     * incrementally: only passes whose reflection or compile data changed (or which requested a recompile) are compiled, and
+     * resources with unchanged field descriptions are taken over from the previous compilation.
+     * @return The compiled graph.
+     */
+    static std::unique_ptr<RenderGraphExe> compile(
+        RenderGraph& graph,
+        RenderContext* pRenderContext,
+        const Dependencies& dependencies,
+        RenderGraphExe* pPreviousExe = nullptr
+    );
 
 private:
-    RenderGraphCompiler(RenderGraph& graph, const Dependencies& dependencies);
+    RenderGraphCompiler(RenderGraph& graph, const Dependencies& dependencies, RenderGraphExe* pPreviousExe);
 
     RenderGraph& mGraph;
     ref<Device> mpDevice;
     const Dependencies& mDependencies;
+    RenderGraphExe* mpPreviousExe;
 
     struct PassData
     {
@@ -65,6 +84,10 @@ private:
     };
     std::vector<PassData> mExecutionList;
 
+    // Data each pass was compiled with, and the passes that were compiled during this compilation
+    std::unordered_map<const RenderPass*, RenderPass::CompileData> mPassCompileData;
+    std::unordered_set<const RenderPass*> mCompiledPasses;
+
     // TODO Better way to track history, or avoid changing the original graph altogether?
     struct
     {
@@ -75,9 +98,10 @@ private:
     void resolveExecutionOrder();
     void compilePasses(RenderContext* pRenderContext);
     bool insertAutoPasses();
-    void allocateResources(ref<Device> pDevice, ResourceCache* pResourceCache);
+    ResourceCache::AllocationStats allocateResources(ref<Device> pDevice, ResourceCache* pResourceCache);
     void validateGraph() const;
     void restoreCompilationChanges();
     RenderPass::CompileData prepPassCompilationData(const PassData& passData);
+    bool isPassChanged(const PassData& passData, const RenderPass::CompileData& compileData) const;
 };
 } // namespace Falcor
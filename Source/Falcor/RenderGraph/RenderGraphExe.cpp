@@ -38,7 +38,7 @@ void RenderGraphExe::execute(const Context& ctx)
     {
         FALCOR_PROFILE(ctx.pRenderContext, pass.name);
 
-        RenderData renderData(pass.name, *mpResourceCache, ctx.passesDictionary, ctx.defaultTexDims, ctx.defaultTexFormat);
+        RenderData renderData(pass.name, *mpResourceCache, ctx.passesDictionary, ctx.defaultTexDims, ctx.defaultTexFormat, pass.slots);
         pass.pPass->execute(ctx.pRenderContext, renderData);
     }
 }
@@ -102,9 +102,25 @@ void RenderGraphExe::onHotReload(HotReloadFlags reloaded)
     }
 }
 
-void RenderGraphExe::insertPass(const std::string& name, const ref<RenderPass>& pPass)
+void RenderGraphExe::insertPass(
+    const std::string& name,
+    const ref<RenderPass>& pPass,
+    std::vector<ResourceCache::FieldSlot> slots,
+    RenderPassReflection reflection,
+    RenderPass::CompileData compileData
+)
 {
-    mExecutionList.push_back(Pass(name, pPass));
+    mExecutionList.push_back(Pass(name, pPass, std::move(slots), std::move(reflection), std::move(compileData)));
+}
+
+const RenderGraphExe::Pass* RenderGraphExe::findPass(const RenderPass* pPass) const
+{
+    for (const auto& pass : mExecutionList)
+    {
+        if (pass.pPass.get() == pPass)
+            return &pass;
+    }
+    return nullptr;
 }
 
 ref<Resource> RenderGraphExe::getResource(const std::string& name) const
@@ -54,6 +54,17 @@ public:
         ResourceFormat defaultTexFormat;
     };
 
+    /**
+     * Statistics of the graph compilation that created this object.
+     */
+    struct CompileStats
+    {
+        uint32_t compiledPassCount = 0;      ///< Number of passes that were compiled.
+        uint32_t skippedPassCount = 0;       ///< Number of passes that were unchanged since the previous compilation.
+        uint32_t allocatedResourceCount = 0; ///< Number of newly allocated resources.
+        uint32_t reusedResourceCount = 0;    ///< Number of resources reused from the previous compilation.
+    };
+
     /**
      * Execute the graph
      */
@@ -99,22 +110,55 @@ public:
      */
     void setInput(const std::string& name, const ref<Resource>& pResource);
 
+    /**
+     * Get the statistics of the graph compilation.
+     */
+    const CompileStats& getCompileStats() const { return mCompileStats; }
+
 private:
     friend class RenderGraphCompiler;
 
-    void insertPass(const std::string& name, const ref<RenderPass>& pPass);
+    void insertPass(
+        const std::string& name,
+        const ref<RenderPass>& pPass,
+        std::vector<ResourceCache::FieldSlot> slots = {},
+        RenderPassReflection reflection = {},
+        RenderPass::CompileData compileData = {}
+    );
 
     struct Pass
     {
         std::string name;
         ref<RenderPass> pPass;
+        std::vector<ResourceCache::FieldSlot> slots; ///< Resource slots of the pass fields.
+        RenderPassReflection reflection;             ///< Reflection of the pass at compile time.
+        RenderPass::CompileData compileData;         ///< Data the pass was compiled with.
 
     private:
         friend class RenderGraphExe; // Force RenderGraphCompiler to use insertPass() by hiding this Ctor from it
-        Pass(const std::string& name_, const ref<RenderPass>& pPass_) : name(name_), pPass(pPass_) {}
+        Pass(
+            const std::string& name_,
+            const ref<RenderPass>& pPass_,
+            std::vector<ResourceCache::FieldSlot> slots_,
+            RenderPassReflection reflection_,
+            RenderPass::CompileData compileData_
+        )
+            : name(name_)
+            , pPass(pPass_)
+            , slots(std::move(slots_))
+            , reflection(std::move(reflection_))
+            , compileData(std::move(compileData_))
+        {}
     };
 
+    /**
+     * Find a pass in the execution list.
+     * @return The pass, or nullptr if the pass is not part of the execution list.
+     */
+    const Pass* findPass(const RenderPass* pPass) const;
+
     std::vector<Pass> mExecutionList;
     std::unique_ptr<ResourceCache> mpResourceCache;
+    CompileStats mCompileStats;
 };
 } // namespace Falcor
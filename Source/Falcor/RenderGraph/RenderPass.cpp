@@ -34,13 +34,25 @@ RenderData::RenderData(
     ResourceCache& resources,
     Dictionary& dictionary,
     const uint2& defaultTexDims,
-    ResourceFormat defaultTexFormat
+    ResourceFormat defaultTexFormat,
+    fstd::span<const ResourceCache::FieldSlot> slots
 )
-    : mName(passName), mResources(resources), mDictionary(dictionary), mDefaultTexDims(defaultTexDims), mDefaultTexFormat(defaultTexFormat)
+    : mName(passName)
+    , mResources(resources)
+    , mSlots(slots)
+    , mDictionary(dictionary)
+    , mDefaultTexDims(defaultTexDims)
+    , mDefaultTexFormat(defaultTexFormat)
 {}
 
 const ref<Resource>& RenderData::getResource(const std::string_view name) const
 {
+    // Look up the slot resolved at compile time, fall back to looking up the full resource name.
+    for (const auto& fieldSlot : mSlots)
+    {
+        if (fieldSlot.field == name)
+            return mResources.getSlotResource(fieldSlot.slot);
+    }
     return mResources.getResource(fmt::format("{}.{}", mName, name));
 }
 
@@ -38,6 +38,7 @@
 #include "Utils/Dictionary.h"
 #include "Utils/Scripting/ScriptBindings.h"
 #include "Utils/UI/Gui.h"
+#include <fstd/span.h>
 #include <functional>
 #include <memory>
 #include <string_view>
@@ -93,11 +94,13 @@ protected:
         ResourceCache& resources,
         Dictionary& dictionary,
         const uint2& defaultTexDims,
-        ResourceFormat defaultTexFormat
+        ResourceFormat defaultTexFormat,
+        fstd::span<const ResourceCache::FieldSlot> slots = {}
     );
 
     const std::string& mName;
     ResourceCache& mResources;
+    fstd::span<const ResourceCache::FieldSlot> mSlots; ///< Resource slots of the pass fields, resolved at compile time.
     Dictionary& mDictionary;
     uint2 mDefaultTexDims;
     ResourceFormat mDefaultTexFormat;
@@ -169,7 +172,10 @@ public:
     virtual RenderPassReflection reflect(const CompileData& compileData) = 0;
 
     /**
-     * Will be called during graph compilation. You should throw an exception in case the compilation failed
+     * Will be called during graph compilation. You should throw an exception in case the compilation failed.
+     * When the graph is recompiled, the function is only called if the pass requested the recompile, or if its
+     * reflection or compile data changed. Graph-allocated resources whose description didn't change are kept
+     * across recompilations and are not cleared, so passes must not assume that their resources are cleared.
      */
     virtual void compile(RenderContext* pRenderContext, const CompileData& compileData) {}
 
@@ -37,6 +37,8 @@ void ResourceCache::reset()
 {
     mNameToIndex.clear();
     mResourceData.clear();
+    mNameToSlot.clear();
+    mSlots.clear();
 }
 
 const ref<Resource>& ResourceCache::getResource(const std::string& name) const
@@ -56,6 +58,17 @@ const ref<Resource>& ResourceCache::getResource(const std::string& name) const
     return extIt->second;
 }
 
+uint32_t ResourceCache::getSlot(const std::string& name)
+{
+    auto [it, inserted] = mNameToSlot.try_emplace(name, (uint32_t)mSlots.size());
+    if (inserted)
+    {
+        mSlots.push_back({name, nullptr});
+        updateSlot(mSlots.back());
+    }
+    return it->second;
+}
+
 const RenderPassReflection::Field& ResourceCache::getResourceReflection(const std::string& name) const
 {
     uint32_t i = mNameToIndex.at(name);
@@ -77,6 +90,10 @@ void ResourceCache::registerExternalResource(const std::string& name, const ref<
 
         mExternalResources.erase(it);
     }
+
+    // Re-resolve the slot, removing an external resource falls back to the render graph resource.
+    if (auto slotIt = mNameToSlot.find(name); slotIt != mNameToSlot.end())
+        updateSlot(mSlots[slotIt->second]);
 }
 
 void mergeTimePoint(std::pair<uint32_t, uint32_t>& range, uint32_t newTime)
@@ -191,14 +208,64 @@ inline ref<Resource> createResourceForPass(
     return pResource;
 }
 
-void ResourceCache::allocateResources(ref<Device> pDevice, const DefaultProperties& params)
+ref<Resource> ResourceCache::takeReusableResource(const ResourceData& data, const DefaultProperties& params)
+{
+    auto it = mNameToIndex.find(data.name);
+    if (it == mNameToIndex.end())
+        return nullptr;
+
+    // Each resource can only be taken over once, the previous data is cleared below.
+    ResourceData& prevData = mResourceData[it->second];
+    if (!prevData.pResource || prevData.field != data.field || prevData.resolveBindFlags != data.resolveBindFlags)
+        return nullptr;
+
+    // Fields that don't fully specify their resource depend on the default properties.
+    const auto& field = data.field;
+    bool usesDefaults = field.getWidth() == 0 || field.getHeight() == 0 ||
+                        (field.getType() != RenderPassReflection::Field::Type::RawBuffer && field.getFormat() == ResourceFormat::Unknown);
+    if (usesDefaults && (any(params.dims != mDefaultProperties.dims) || params.format != mDefaultProperties.format))
+        return nullptr;
+
+    return std::move(prevData.pResource);
+}
+
+ResourceCache::AllocationStats ResourceCache::allocateResources(
+    ref<Device> pDevice,
+    const DefaultProperties& params,
+    ResourceCache* pPreviousCache
+)
 {
+    AllocationStats stats;
+
+    if (pPreviousCache)
+    {
+        for (auto& data : mResourceData)
+        {
+            if ((data.pResource == nullptr) && (data.field.isValid()))
+            {
+                data.pResource = pPreviousCache->takeReusableResource(data, params);
+                if (data.pResource)
+                    stats.reusedCount++;
+            }
+        }
+
+        // Release the remaining resources before creating new ones to keep the peak memory usage down.
+        pPreviousCache->reset();
+    }
+
     for (auto& data : mResourceData)
     {
         if ((data.pResource == nullptr) && (data.field.isValid()))
         {
             data.pResource = createResourceForPass(pDevice, params, data.field, data.resolveBindFlags, data.name);
+            stats.allocatedCount++;
         }
     }
+    mDefaultProperties = params;
+
+    for (auto& slot : mSlots)
+        updateSlot(slot);
+
+    return stats;
 }
 } // namespace Falcor
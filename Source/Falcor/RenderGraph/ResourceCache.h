@@ -28,6 +28,7 @@
 #pragma once
 #include "RenderPassReflection.h"
 #include "Core/Macros.h"
+#include "Core/Error.h"
 #include "Core/API/fwd.h"
 #include "Core/API/Resource.h"
 #include <string>
@@ -42,6 +43,17 @@ class FALCOR_API ResourceCache
 public:
     using ResourcesMap = std::unordered_map<std::string, ref<Resource>>;
 
+    static constexpr uint32_t kInvalidSlot = uint32_t(-1);
+
+    /**
+     * Resource slot of a render pass field, resolved when the render graph is compiled.
+     */
+    struct FieldSlot
+    {
+        std::string field; ///< Name of the field, without the pass name.
+        uint32_t slot;     ///< Slot in the resource cache.
+    };
+
     /**
      * Properties to use during resource creation when its property has not been fully specified.
      */
@@ -78,16 +90,50 @@ public:
      */
     const ref<Resource>& getResource(const std::string& name) const;
 
+    /**
+     * Get a slot for looking up a resource by index instead of by name.
+     * The slot resolves to the same resource as getResource(name), and is updated when resources are allocated or
+     * external resources are registered. Slots remain valid until the cache is reset.
+     * @param[in] name String in the format of PassName.FieldName
+     * @return The slot index.
+     */
+    uint32_t getSlot(const std::string& name);
+
+    /**
+     * Get a resource by slot.
+     * @param[in] slot Slot index as returned by getSlot().
+     */
+    const ref<Resource>& getSlotResource(uint32_t slot) const
+    {
+        FALCOR_ASSERT(slot < mSlots.size());
+        return mSlots[slot].pResource;
+    }
+
     /**
      * Get the field-reflection of a resource
      */
     const RenderPassReflection::Field& getResourceReflection(const std::string& name) const;
 
+    /**
+     * Statistics of a call to allocateResources().
+     */
+    struct AllocationStats
+    {
+        uint32_t allocatedCount = 0; ///< Number of newly created resources.
+        uint32_t reusedCount = 0;    ///< Number of resources taken over from the previous cache.
+    };
+
     /**
      * Allocate all resources that need to be created/updated.
      * This includes new resources, resources whose properties have been updated since last allocation call.
+     * @param[in] pDevice GPU device.
+     * @param[in] params Default properties for fields that don't fully specify their resource.
+     * @param[in] pPreviousCache Optional. Cache of the previous graph compilation. Resources of fields with the same name and
+     * description are moved over from it instead of being recreated. All other resources of the previous cache are released.
+     * Resources that are moved over keep their contents from the previous compilation; they are not cleared.
+     * @return Allocation statistics.
      */
-    void allocateResources(ref<Device> pDevice, const DefaultProperties& params);
+    AllocationStats allocateResources(ref<Device> pDevice, const DefaultProperties& params, ResourceCache* pPreviousCache = nullptr);
 
     /**
      * Clears all registered field/resource properties and allocated resources.
@@ -104,12 +150,33 @@ private:
         std::string name;                       // Full name of the resource, including the pass name
     };
 
+    struct Slot
+    {
+        std::string name;        // Full name of the resource, including the pass name
+        ref<Resource> pResource; // The resource the name currently resolves to
+    };
+
+    void updateSlot(Slot& slot) const { slot.pResource = getResource(slot.name); }
+
+    /**
+     * Take over the resource of a field from this cache if it was created for the same field description.
+     * The resource is returned as is, including its contents.
+     */
+    ref<Resource> takeReusableResource(const ResourceData& data, const DefaultProperties& params);
+
+    // Default properties used for the last allocation
+    DefaultProperties mDefaultProperties;
+
     // Resources and properties for fields within (and therefore owned by) a render graph
     std::unordered_map<std::string, uint32_t> mNameToIndex;
     std::vector<ResourceData> mResourceData;
 
     // References to output resources not to be allocated by the render graph
     ResourcesMap mExternalResources;
+
+    // Resolved resources for fast lookups by slot
+    std::unordered_map<std::string, uint32_t> mNameToSlot;
+    std::vector<Slot> mSlots;
 };
 
 } // namespace Falcor
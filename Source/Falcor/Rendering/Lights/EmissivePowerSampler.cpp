@@ -26,6 +26,7 @@
  # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  **************************************************************************/
 #include "EmissivePowerSampler.h"
+#include "Utils/Sampling/AliasTable.h"
 #include "Utils/Timing/Profiler.h"
 #include <algorithm>
 
@@ -88,55 +89,20 @@ namespace Falcor
         uint32_t N = uint32_t(weights.size());
         std::uniform_int_distribution<uint32_t> rngDist;
 
-        double sum = 0.0f;
-        for (float f : weights)
-        {
-            sum += f;
-        }
-        for (float& f : weights)
-        {
-            f *= N / float(sum);
-        }
-
-        std::vector<uint32_t> permutation(N);
-        for (uint32_t i = 0; i < N; ++i)
-        {
-            permutation[i] = i;
-        }
-        std::sort(permutation.begin(), permutation.end(), [&](uint32_t a, uint32_t b) { return weights[a] < weights[b]; });
+        // Build the table with the parallel builder of the generic alias table. Each entry is indexed by its own item.
+        double sum = Falcor::AliasTable::computeWeightSum(weights);
+        std::vector<Falcor::AliasTable::Item> items = Falcor::AliasTable::buildItems(weights, sum);
 
         std::vector<float> thresholds(N);
         std::vector<uint32_t> redirect(N);
+        std::vector<uint32_t> permutation(N);
         std::vector<uint2> merged(N);
         std::vector<uint2> fullTable(N);
 
-        uint32_t head = 0;
-        uint32_t tail = N - 1;
-
-        while (head != tail)
+        for (const auto& item : items)
         {
-            int i = permutation[head];
-            int j = permutation[tail];
-
-            thresholds[i] = weights[i];
-            redirect[i] = j;
-            weights[j] -= 1.0f - weights[i];
-
-            if (head == tail - 1)
-            {
-                thresholds[j] = 1.0f;
-                redirect[j] = j;
-                break;
-            }
-            else if (weights[j] < 1.0f)
-            {
-                std::swap(permutation[head], permutation[tail]);
-                tail--;
-            }
-            else
-            {
-                head++;
-            }
+            thresholds[item.indexB] = item.threshold;
+            redirect[item.indexB] = item.indexA;
         }
 
         for (uint32_t i = 0; i < N; ++i)
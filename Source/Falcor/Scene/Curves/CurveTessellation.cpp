@@ -32,7 +32,11 @@
 #include "Utils/Math/CubicSpline.h"
 #include "Utils/Math/Matrix.h"
 #include "Utils/Math/Quaternion.h"
+#include "Utils/NumericRange.h"
+#include <algorithm>
 #include <cmath>
+#include <execution>
+#include <numeric>
 
 namespace Falcor
 {
@@ -98,7 +102,20 @@ namespace Falcor
             return std::max(w, (float)std::numeric_limits<float16_t>::min());
         }
 
-        void optimizeStrandGeometry(CubicSplineCache& splineCache, const CurveArrays& curveArrays, StrandArrays& strandArrays, StrandArrays& optimizedStrandArrays, uint32_t pointOffset, uint32_t subdivPerSegment, uint32_t keepOneEveryXVerticesPerStrand, float widthScale)
+        /// Count the control points of a strand that remain after removing consecutive duplicates.
+        uint32_t getUniqueVertexCount(const float3* controlPoints, uint32_t vertexCount)
+        {
+            uint32_t uniqueCount = 1;
+            for (uint32_t j = 0; j < vertexCount - 1; j++)
+            {
+                if (any(controlPoints[j] != controlPoints[j + 1])) uniqueCount++;
+            }
+            return uniqueCount;
+        }
+
+        /// Copy the control points of a strand to strandArrays, removing consecutive duplicates.
+        /// Returns the number of remaining control points.
+        uint32_t removeDuplicateVertices(const CurveArrays& curveArrays, StrandArrays& strandArrays, uint32_t pointOffset)
         {
             strandArrays.controlPoints.clear();
             strandArrays.UVs.clear();
@@ -120,7 +137,15 @@ namespace Falcor
             strandArrays.widths.push_back(curveArrays.widths[pointOffset + strandArrays.vertexCount - 1]);
             if (curveArrays.UVs) strandArrays.UVs.push_back(curveArrays.UVs[pointOffset + strandArrays.vertexCount - 1]);
 
-            optimizedStrandArrays.vertexCount = static_cast<uint32_t>(strandArrays.controlPoints.size());
+            return static_cast<uint32_t>(strandArrays.controlPoints.size());
+        }
+
+        void optimizeStrandGeometry(CubicSplineCache& splineCache, const CurveArrays& curveArrays, StrandArrays& strandArrays, StrandArrays& optimizedStrandArrays, uint32_t pointOffset, uint32_t subdivPerSegment, uint32_t keepOneEveryXVerticesPerStrand, float widthScale)
+        {
+            optimizedStrandArrays.controlPoints.clear();
+            optimizedStrandArrays.UVs.clear();
+            optimizedStrandArrays.widths.clear();
+            optimizedStrandArrays.vertexCount = removeDuplicateVertices(curveArrays, strandArrays, pointOffset);
 
             const CubicSpline<float3>& splinePoints = splineCache.optSplinePoints.setup(strandArrays.controlPoints.data(), optimizedStrandArrays.vertexCount);
             const CubicSpline<float>& splineWidths = splineCache.optSplineWidths.setup(strandArrays.widths.data(), optimizedStrandArrays.vertexCount);
@@ -203,7 +228,7 @@ namespace Falcor
             FALCOR_ASSERT_LT(std::abs(length(t) - 1.f), 1e-3f);
         }
 
-        void updateMeshResultBuffers(CurveTessellation::MeshResult& result, const CurveArrays& curveArrays, StrandArrays& optimizedStrandArrays, const float3& fwd, const float3& s, const float3& t, uint32_t pointCountPerCrossSection, uint32_t j)
+        void updateMeshResultBuffers(CurveTessellation::MeshResult& result, const CurveArrays& curveArrays, StrandArrays& optimizedStrandArrays, const float3& fwd, const float3& s, const float3& t, uint32_t pointCountPerCrossSection, uint32_t j, uint32_t& vertexIndex)
         {
             // Mesh vertices, normals, tangents, and texCrds (if any).
             for (uint32_t k = 0; k < pointCountPerCrossSection; k++)
@@ -212,33 +237,99 @@ namespace Falcor
                 float3 vNormal = std::cos(phi) * s + std::sin(phi) * t;
 
                 float curveRadius = 0.5f * optimizedStrandArrays.widths[j];
-                result.vertices.push_back(optimizedStrandArrays.controlPoints[j] + curveRadius * vNormal);
-                result.normals.push_back(vNormal);
-                result.tangents.push_back(float4(fwd.x, fwd.y, fwd.z, 1));
-                result.radii.push_back(curveRadius);
+                result.vertices[vertexIndex] = optimizedStrandArrays.controlPoints[j] + curveRadius * vNormal;
+                result.normals[vertexIndex] = vNormal;
+                result.tangents[vertexIndex] = float4(fwd.x, fwd.y, fwd.z, 1);
+                result.radii[vertexIndex] = curveRadius;
 
                 if (curveArrays.UVs)
                 {
-                    result.texCrds.push_back(optimizedStrandArrays.UVs[j]);
+                    result.texCrds[vertexIndex] = optimizedStrandArrays.UVs[j];
                 }
+                vertexIndex++;
             }
         }
 
-        void connectFaceVertices(CurveTessellation::MeshResult& result, uint32_t meshVertexOffset, uint32_t pointCountPerCrossSection, uint32_t quadCountLimit, uint32_t nextCrossSectionVertexOffset, uint32_t multiplier, uint32_t j)
+        void connectFaceVertices(CurveTessellation::MeshResult& result, uint32_t meshVertexOffset, uint32_t pointCountPerCrossSection, uint32_t quadCountLimit, uint32_t nextCrossSectionVertexOffset, uint32_t multiplier, uint32_t j, uint32_t& faceIndex)
         {
             for (uint32_t k = 0; k < quadCountLimit; k++)
             {
-                result.faceVertexCounts.push_back(3);
-                result.faceVertexIndices.push_back(meshVertexOffset + multiplier * j * pointCountPerCrossSection + k);
-                result.faceVertexIndices.push_back(meshVertexOffset + multiplier * j * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection);
-                result.faceVertexIndices.push_back(meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection);
-
-                result.faceVertexCounts.push_back(3);
-                result.faceVertexIndices.push_back(meshVertexOffset + multiplier * j * pointCountPerCrossSection + k);
-                result.faceVertexIndices.push_back(meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection);
-                result.faceVertexIndices.push_back(meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + k);
+                uint32_t* indices = &result.faceVertexIndices[3 * faceIndex];
+
+                indices[0] = meshVertexOffset + multiplier * j * pointCountPerCrossSection + k;
+                indices[1] = meshVertexOffset + multiplier * j * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection;
+                indices[2] = meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection;
+
+                indices[3] = meshVertexOffset + multiplier * j * pointCountPerCrossSection + k;
+                indices[4] = meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection;
+                indices[5] = meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + k;
+
+                faceIndex += 2;
             }
         }
+
+        /// Number of strands tessellated by one parallel task. Each task owns its scratch arrays and spline cache.
+        const uint32_t kStrandsPerTask = 256;
+
+        /// Layout of the tessellated strands in the output arrays.
+        /// Only the kept strands (one of every keepOneEveryXStrands) are included.
+        struct StrandLayout
+        {
+            std::vector<uint32_t> inputOffsets;     ///< Index of the first control point of each kept strand in the input arrays.
+            std::vector<uint32_t> outputOffsets;    ///< Index of the first tessellated point of each kept strand. Has one extra entry holding the total.
+            uint32_t maxVertexCount = 0;            ///< Max number of control points per kept strand.
+
+            uint32_t getStrandCount() const { return (uint32_t)inputOffsets.size(); }
+            uint32_t getPointCount() const { return outputOffsets.back(); }
+            uint32_t getPointCount(uint32_t strandIndex) const { return outputOffsets[strandIndex + 1] - outputOffsets[strandIndex]; }
+        };
+
+        /** Compute the number of tessellated points of all kept strands and their offsets in the output arrays.
+            This is the first pass of the tessellation. It allows the second pass to fill preallocated arrays in parallel.
+        */
+        StrandLayout computeStrandLayout(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand)
+        {
+            StrandLayout layout;
+            const uint32_t keptStrandCount = div_round_up(strandCount, keepOneEveryXStrands);
+            layout.inputOffsets.resize(keptStrandCount);
+            layout.outputOffsets.resize(keptStrandCount + 1);
+
+            uint32_t pointOffset = 0;
+            for (uint32_t i = 0; i < strandCount; i++)
+            {
+                if (i % keepOneEveryXStrands == 0)
+                {
+                    layout.inputOffsets[i / keepOneEveryXStrands] = pointOffset;
+                    layout.maxVertexCount = std::max(layout.maxVertexCount, vertexCountsPerStrand[i]);
+                }
+                pointOffset += vertexCountsPerStrand[i];
+            }
+
+            // Count the tessellated points of each strand. This has to match the output of optimizeStrandGeometry().
+            layout.outputOffsets[0] = 0;
+            auto range = NumericRange<uint32_t>(0, keptStrandCount);
+            std::for_each(std::execution::par, range.begin(), range.end(), [&](uint32_t strandIndex)
+            {
+                uint32_t vertexCount = vertexCountsPerStrand[strandIndex * keepOneEveryXStrands];
+                uint32_t uniqueVertexCount = getUniqueVertexCount(controlPoints + layout.inputOffsets[strandIndex], vertexCount);
+                layout.outputOffsets[strandIndex + 1] = div_round_up(subdivPerSegment * (uniqueVertexCount - 1), keepOneEveryXVerticesPerStrand) + 1;
+            });
+            std::partial_sum(layout.outputOffsets.begin(), layout.outputOffsets.end(), layout.outputOffsets.begin());
+
+            return layout;
+        }
+
+        /// Call func(firstStrand, lastStrand) in parallel for consecutive ranges of kept strands.
+        template<typename Func>
+        void forEachStrandRange(uint32_t keptStrandCount, Func func)
+        {
+            auto range = NumericRange<uint32_t>(0, div_round_up(keptStrandCount, kStrandsPerTask));
+            std::for_each(std::execution::par, range.begin(), range.end(), [&](uint32_t taskIndex)
+            {
+                uint32_t firstStrand = taskIndex * kStrandsPerTask;
+                func(firstStrand, std::min(keptStrandCount, firstStrand + kStrandsPerTask));
+            });
+        }
     }
 
     CurveTessellation::SweptSphereResult CurveTessellation::convertToLinearSweptSphere(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, const float* widths, const float2* UVs, uint32_t degree, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand, float widthScale, const float4x4& xform)
@@ -250,93 +341,88 @@ namespace Falcor
         FALCOR_ASSERT(degree == 1);
         result.degree = degree;
 
-        uint32_t pointCounts = 0;
-        uint32_t segCounts = 0;
-        uint32_t maxVertexCountsPerStrand = 0;
-        for (uint32_t i = 0; i < strandCount; i += keepOneEveryXStrands)
-        {
-            uint32_t tmpPointCount = div_round_up(subdivPerSegment * (vertexCountsPerStrand[i] - 1), keepOneEveryXVerticesPerStrand) + 1;
-            pointCounts += tmpPointCount;
-            segCounts += tmpPointCount - 1;
-            maxVertexCountsPerStrand = std::max(maxVertexCountsPerStrand, vertexCountsPerStrand[i]);
-        }
-        result.indices.reserve(segCounts);
-        result.points.reserve(pointCounts);
-        result.radius.reserve(pointCounts);
-        result.texCrds.reserve(pointCounts);
+        const StrandLayout layout = computeStrandLayout(strandCount, vertexCountsPerStrand, controlPoints, subdivPerSegment, keepOneEveryXStrands, keepOneEveryXVerticesPerStrand);
+        const uint32_t keptStrandCount = layout.getStrandCount();
+        const uint32_t pointCount = layout.getPointCount();
 
-        uint32_t pointOffset = 0;
+        // Each strand with n points contributes n - 1 segments.
+        result.indices.resize(pointCount - keptStrandCount);
+        result.points.resize(pointCount);
+        result.radius.resize(pointCount);
+        if (UVs) result.texCrds.resize(pointCount);
 
-        StrandArrays strandArrays;
-        strandArrays.controlPoints.reserve(maxVertexCountsPerStrand);
-        strandArrays.widths.reserve(maxVertexCountsPerStrand);
-        strandArrays.UVs.reserve(maxVertexCountsPerStrand);
         CurveArrays curveArrays(controlPoints, widths, UVs);
 
-        StrandArrays optimizedStrandArrays;
-        CubicSplineCache splineCache;
-        for (uint32_t i = 0; i < strandCount; i += keepOneEveryXStrands)
+        forEachStrandRange(keptStrandCount, [&](uint32_t firstStrand, uint32_t lastStrand)
         {
-            optimizedStrandArrays.controlPoints.clear();
-            optimizedStrandArrays.UVs.clear();
-            optimizedStrandArrays.widths.clear();
-            optimizedStrandArrays.vertexCount = 0;
-            strandArrays.vertexCount = vertexCountsPerStrand[i];
+            StrandArrays strandArrays;
+            strandArrays.controlPoints.reserve(layout.maxVertexCount);
+            strandArrays.widths.reserve(layout.maxVertexCount);
+            strandArrays.UVs.reserve(layout.maxVertexCount);
+            CubicSplineCache splineCache;
 
-            optimizeStrandGeometry(splineCache, curveArrays, strandArrays, optimizedStrandArrays, pointOffset, subdivPerSegment, keepOneEveryXVerticesPerStrand, widthScale);
+            for (uint32_t strandIndex = firstStrand; strandIndex < lastStrand; strandIndex++)
+            {
+                strandArrays.vertexCount = vertexCountsPerStrand[strandIndex * keepOneEveryXStrands];
+                const uint32_t uniqueVertexCount = removeDuplicateVertices(curveArrays, strandArrays, layout.inputOffsets[strandIndex]);
 
-            const CubicSpline<float3>& splinePoints = splineCache.splinePoints.setup(strandArrays.controlPoints.data(), optimizedStrandArrays.vertexCount);
-            const CubicSpline<float>& splineWidths = splineCache.splineWidths.setup(strandArrays.widths.data(), optimizedStrandArrays.vertexCount);
+                const CubicSpline<float3>& splinePoints = splineCache.splinePoints.setup(strandArrays.controlPoints.data(), uniqueVertexCount);
+                const CubicSpline<float>& splineWidths = splineCache.splineWidths.setup(strandArrays.widths.data(), uniqueVertexCount);
 
-            uint32_t tmpCount = 0;
-            for (uint32_t j = 0; j < optimizedStrandArrays.vertexCount - 1; j++)
-            {
-                for (uint32_t k = 0; k < subdivPerSegment; k++)
+                const uint32_t pointOffset = layout.outputOffsets[strandIndex];
+                uint32_t pointIndex = pointOffset;
+                uint32_t segmentIndex = pointOffset - strandIndex;
+                uint32_t tmpCount = 0;
+                for (uint32_t j = 0; j < uniqueVertexCount - 1; j++)
                 {
-                    if (tmpCount % keepOneEveryXVerticesPerStrand == 0)
+                    for (uint32_t k = 0; k < subdivPerSegment; k++)
                     {
-                        float t = (float)k / (float)subdivPerSegment;
-                        result.indices.push_back((uint32_t)result.points.size());
+                        if (tmpCount % keepOneEveryXVerticesPerStrand == 0)
+                        {
+                            float t = (float)k / (float)subdivPerSegment;
+                            result.indices[segmentIndex++] = pointIndex;
 
-                        // Pre-transform curve points.
-                        float4 sph = transformSphere(xform, float4(splinePoints.interpolate(j, t), sanitizeWidth(splineWidths.interpolate(j, t) * 0.5f * widthScale)));
+                            // Pre-transform curve points.
+                            float4 sph = transformSphere(xform, float4(splinePoints.interpolate(j, t), sanitizeWidth(splineWidths.interpolate(j, t) * 0.5f * widthScale)));
 
-                        result.points.push_back(sph.xyz());
-                        result.radius.push_back(sph.w);
+                            result.points[pointIndex] = sph.xyz();
+                            result.radius[pointIndex] = sph.w;
+                            pointIndex++;
+                        }
+                        tmpCount++;
                     }
-                    tmpCount++;
                 }
-            }
 
-            // Always keep the last vertex.
-            float4 sph = transformSphere(xform, float4(splinePoints.interpolate(optimizedStrandArrays.vertexCount - 2, 1.f), sanitizeWidth(splineWidths.interpolate(optimizedStrandArrays.vertexCount - 2, 1.f) * 0.5f * widthScale)));
-            result.points.push_back(sph.xyz());
-            result.radius.push_back(sph.w);
+                // Always keep the last vertex.
+                float4 sph = transformSphere(xform, float4(splinePoints.interpolate(uniqueVertexCount - 2, 1.f), sanitizeWidth(splineWidths.interpolate(uniqueVertexCount - 2, 1.f) * 0.5f * widthScale)));
+                result.points[pointIndex] = sph.xyz();
+                result.radius[pointIndex] = sph.w;
+                FALCOR_ASSERT(pointIndex + 1 == layout.outputOffsets[strandIndex + 1]);
 
-            // Texture coordinates.
-            if (UVs)
-            {
-                const CubicSpline<float2>& splineUVs = splineCache.splineUVs.setup(strandArrays.UVs.data(), optimizedStrandArrays.vertexCount);
-                tmpCount = 0;
-                for (uint32_t j = 0; j < optimizedStrandArrays.vertexCount - 1; j++)
+                // Texture coordinates.
+                if (UVs)
                 {
-                    for (uint32_t k = 0; k < subdivPerSegment; k++)
+                    const CubicSpline<float2>& splineUVs = splineCache.splineUVs.setup(strandArrays.UVs.data(), uniqueVertexCount);
+                    pointIndex = pointOffset;
+                    tmpCount = 0;
+                    for (uint32_t j = 0; j < uniqueVertexCount - 1; j++)
                     {
-                        if (tmpCount % keepOneEveryXVerticesPerStrand == 0)
+                        for (uint32_t k = 0; k < subdivPerSegment; k++)
                         {
-                            float t = (float)k / (float)subdivPerSegment;
-                            result.texCrds.push_back(splineUVs.interpolate(j, t));
+                            if (tmpCount % keepOneEveryXVerticesPerStrand == 0)
+                            {
+                                float t = (float)k / (float)subdivPerSegment;
+                                result.texCrds[pointIndex++] = splineUVs.interpolate(j, t);
+                            }
+                            tmpCount++;
                         }
-                        tmpCount++;
                     }
-                }
 
-                // Always keep the last vertex.
-                result.texCrds.push_back(splineUVs.interpolate(optimizedStrandArrays.vertexCount - 2, 1.f));
+                    // Always keep the last vertex.
+                    result.texCrds[pointIndex] = splineUVs.interpolate(uniqueVertexCount - 2, 1.f);
+                }
             }
-
-            for (uint32_t j = i; j < std::min(strandCount, i + keepOneEveryXStrands); j++) pointOffset += vertexCountsPerStrand[j];
-        }
+        });
 
         return result;
     }
@@ -344,73 +430,68 @@ namespace Falcor
     CurveTessellation::MeshResult CurveTessellation::convertToPolytube(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, const float* widths, const float2* UVs, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand, float widthScale, uint32_t pointCountPerCrossSection)
     {
         MeshResult result;
-        uint32_t vertexCounts = 0;
-        uint32_t faceCounts = 0;
-        uint32_t maxVertexCountsPerStrand = 0;
-        for (uint32_t i = 0; i < strandCount; i += keepOneEveryXStrands)
-        {
-            uint32_t tmpPointCount = div_round_up(subdivPerSegment * (vertexCountsPerStrand[i] - 1), keepOneEveryXVerticesPerStrand) + 1;
-            vertexCounts += pointCountPerCrossSection * tmpPointCount;
-            faceCounts += 2 * pointCountPerCrossSection * (tmpPointCount - 1);
-            maxVertexCountsPerStrand = std::max(maxVertexCountsPerStrand, vertexCountsPerStrand[i]);
-        }
-        result.vertices.reserve(vertexCounts);
-        result.normals.reserve(vertexCounts);
-        result.tangents.reserve(vertexCounts);
-        result.texCrds.reserve(vertexCounts);
-        result.radii.reserve(vertexCounts);
-        result.faceVertexCounts.reserve(faceCounts);
-        result.faceVertexIndices.reserve(faceCounts * 3);
-
-        uint32_t pointOffset = 0;
-        uint32_t meshVertexOffset = 0;
-
-        StrandArrays strandArrays;
-        strandArrays.controlPoints.reserve(maxVertexCountsPerStrand);
-        strandArrays.widths.reserve(maxVertexCountsPerStrand);
-        strandArrays.UVs.reserve(maxVertexCountsPerStrand);
+
+        const StrandLayout layout = computeStrandLayout(strandCount, vertexCountsPerStrand, controlPoints, subdivPerSegment, keepOneEveryXStrands, keepOneEveryXVerticesPerStrand);
+        const uint32_t keptStrandCount = layout.getStrandCount();
+
+        // Each point is a cross-section with pointCountPerCrossSection vertices.
+        // Consecutive cross-sections of a strand are connected by 2 * pointCountPerCrossSection triangles.
+        const uint32_t vertexCount = pointCountPerCrossSection * layout.getPointCount();
+        const uint32_t faceCount = 2 * pointCountPerCrossSection * (layout.getPointCount() - keptStrandCount);
+        result.vertices.resize(vertexCount);
+        result.normals.resize(vertexCount);
+        result.tangents.resize(vertexCount);
+        if (UVs) result.texCrds.resize(vertexCount);
+        result.radii.resize(vertexCount);
+        result.faceVertexCounts.resize(faceCount, 3);
+        result.faceVertexIndices.resize(faceCount * 3);
+
         CurveArrays curveArrays(controlPoints, widths, UVs);
 
-        StrandArrays optimizedStrandArrays;
-        CubicSplineCache splineCache;
-        for (uint32_t i = 0; i < strandCount; i += keepOneEveryXStrands)
+        forEachStrandRange(keptStrandCount, [&](uint32_t firstStrand, uint32_t lastStrand)
         {
-            optimizedStrandArrays.controlPoints.clear();
-            optimizedStrandArrays.UVs.clear();
-            optimizedStrandArrays.widths.clear();
-            optimizedStrandArrays.vertexCount = 0;
-
-            strandArrays.vertexCount = vertexCountsPerStrand[i];
+            StrandArrays strandArrays;
+            strandArrays.controlPoints.reserve(layout.maxVertexCount);
+            strandArrays.widths.reserve(layout.maxVertexCount);
+            strandArrays.UVs.reserve(layout.maxVertexCount);
+
+            StrandArrays optimizedStrandArrays;
+            CubicSplineCache splineCache;
+            for (uint32_t strandIndex = firstStrand; strandIndex < lastStrand; strandIndex++)
+            {
+                strandArrays.vertexCount = vertexCountsPerStrand[strandIndex * keepOneEveryXStrands];
 
-            optimizeStrandGeometry(splineCache, curveArrays, strandArrays, optimizedStrandArrays, pointOffset, subdivPerSegment, keepOneEveryXVerticesPerStrand, widthScale);
+                optimizeStrandGeometry(splineCache, curveArrays, strandArrays, optimizedStrandArrays, layout.inputOffsets[strandIndex], subdivPerSegment, keepOneEveryXVerticesPerStrand, widthScale);
+                FALCOR_ASSERT(optimizedStrandArrays.controlPoints.size() == layout.getPointCount(strandIndex));
 
-            for (uint32_t j = i; j < std::min(strandCount, i + keepOneEveryXStrands); j++) pointOffset += vertexCountsPerStrand[j];
+                const uint32_t meshVertexOffset = pointCountPerCrossSection * layout.outputOffsets[strandIndex];
+                uint32_t vertexIndex = meshVertexOffset;
+                uint32_t faceIndex = 2 * pointCountPerCrossSection * (layout.outputOffsets[strandIndex] - strandIndex);
 
-            // Build the initial frame.
-            float3 fwd, s, t;
-            fwd = normalize(optimizedStrandArrays.controlPoints[1] - optimizedStrandArrays.controlPoints[0]);
-            FALCOR_ASSERT_LT(std::abs(length(fwd) - 1.f), 1e-3f);
-            buildFrame(fwd, s, t);
+                // Build the initial frame.
+                float3 fwd, s, t;
+                fwd = normalize(optimizedStrandArrays.controlPoints[1] - optimizedStrandArrays.controlPoints[0]);
+                FALCOR_ASSERT_LT(std::abs(length(fwd) - 1.f), 1e-3f);
+                buildFrame(fwd, s, t);
 
-            // Create mesh.
-            for (uint32_t j = 0; j < optimizedStrandArrays.controlPoints.size(); j++)
-            {
-                // Update the curve's frame vectors: [fwd, s, t]
-                updateCurveFrame(optimizedStrandArrays, fwd, s, t, j);
+                // Create mesh.
+                for (uint32_t j = 0; j < optimizedStrandArrays.controlPoints.size(); j++)
+                {
+                    // Update the curve's frame vectors: [fwd, s, t]
+                    updateCurveFrame(optimizedStrandArrays, fwd, s, t, j);
 
-                // Mesh vertices, normals, tangents, and texCrds (if any).
-                updateMeshResultBuffers(result, curveArrays, optimizedStrandArrays, fwd, s, t, pointCountPerCrossSection, j);
+                    // Mesh vertices, normals, tangents, and texCrds (if any).
+                    updateMeshResultBuffers(result, curveArrays, optimizedStrandArrays, fwd, s, t, pointCountPerCrossSection, j, vertexIndex);
 
-                // Mesh faces.
-                if (j < optimizedStrandArrays.controlPoints.size() - 1)
-                {
-                    uint32_t quadCountLimit = pointCountPerCrossSection;
-                    connectFaceVertices(result, meshVertexOffset, pointCountPerCrossSection, quadCountLimit, 1, 1, j);
+                    // Mesh faces.
+                    if (j < optimizedStrandArrays.controlPoints.size() - 1)
+                    {
+                        uint32_t quadCountLimit = pointCountPerCrossSection;
+                        connectFaceVertices(result, meshVertexOffset, pointCountPerCrossSection, quadCountLimit, 1, 1, j, faceIndex);
+                    }
                 }
             }
-
-            meshVertexOffset += pointCountPerCrossSection * (uint32_t)optimizedStrandArrays.controlPoints.size();
-        }
+        });
 
         return result;
     }
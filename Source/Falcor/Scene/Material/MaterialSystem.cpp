@@ -30,6 +30,8 @@
 #include "Core/API/Device.h"
 #include "Utils/Logger.h"
 #include "Utils/StringUtils.h"
+#include "Utils/Image/CookedTextureCache.h"
+#include "Utils/Settings/Settings.h"
 #include "MaterialTypeRegistry.h"
 #include "Scene/Lights/LightProfile.h"
 #include <numeric>
@@ -70,6 +72,36 @@ namespace Falcor
         mpFence = mpDevice->createFence();
         mpTextureManager = std::make_unique<TextureManager>(mpDevice, kMaxTextureCount);
 
+        const Settings& settings = Settings::getGlobalSettings();
+
+        // Generate texture mips on the loader threads if configured.
+        if (settings.getOption<bool>("TextureLoader:cpuMipGeneration", false))
+        {
+            CpuMipGenerator::Options options;
+            std::string filter = settings.getOption<std::string>("TextureLoader:mipFilter", "box");
+            if (filter == "kaiser")
+                options.filter = CpuMipGenerator::Filter::Kaiser;
+            else if (filter != "box")
+                logWarning("Unknown mip filter '{}'. Using box filter.", filter);
+            mpTextureManager->setCpuMipGeneration(true, options);
+        }
+
+        // Enable the persistent texture cache if configured.
+        if (auto directory = settings.getOption<std::string>("TextureCache:directory"))
+        {
+            CookedTextureCache::Options options;
+            options.directory = *directory;
+            options.maxSize = settings.getOption<uint64_t>("TextureCache:maxSizeMB", options.maxSize >> 20) << 20;
+            try
+            {
+                mpTextureManager->setCookedTextureCache(std::make_shared<CookedTextureCache>(mpDevice, options));
+            }
+            catch (const RuntimeError& e)
+            {
+                logWarning("Failed to create texture cache: {}", e.what());
+            }
+        }
+
         // Create a default texture sampler.
         Sampler::Desc desc;
         desc.setFilterMode(TextureFilteringMode::Linear, TextureFilteringMode::Linear, TextureFilteringMode::Linear);
@@ -178,6 +178,33 @@ namespace Falcor
         }
     }
 
+    void NDSDFGrid::setValuesInternal(SDFSparseValues&& values)
+    {
+        const uint32_t kCoarsestAllowedGridWidth = 8;
+
+        if (kCoarsestAllowedGridWidth > mGridWidth)
+        {
+            FALCOR_THROW("NDSDFGrid::setValues() grid width must be larger than {}.", kCoarsestAllowedGridWidth);
+        }
+
+        uint32_t lodCount = bitScanReverse(mGridWidth / kCoarsestAllowedGridWidth) + 1;
+        mCoarsestLODGridWidth = mGridWidth >> (lodCount - 1);
+        mCoarsestLODNormalizationFactor = calculateNormalizationFactor(mCoarsestLODGridWidth);
+
+        mValues.resize(lodCount);
+
+        // Same as above, but sampled from the sparse values. Coarse LODs only see the narrow band, values outside of it are clamped to the brick constants.
+        for (uint32_t lod = 0; lod < lodCount; lod++)
+        {
+            uint32_t lodWidthInValues = 1 + (mCoarsestLODGridWidth << lod);
+            float normalizationFactor = mCoarsestLODNormalizationFactor / float(1 << lod);
+
+            std::vector<int8_t>& lodFormattedValues = mValues[lod];
+            lodFormattedValues.resize(lodWidthInValues * lodWidthInValues * lodWidthInValues);
+            values.quantize(1.0f / normalizationFactor, 1 << (lodCount - lod - 1), 0, lodWidthInValues, lodFormattedValues.data());
+        }
+    }
+
     float NDSDFGrid::calculateNormalizationFactor(uint32_t gridWidth) const
     {
         return 0.5f * float(M_SQRT3) * mNarrowBandThickness / gridWidth;
@@ -59,6 +59,7 @@ namespace Falcor
 
     protected:
         virtual void setValuesInternal(const std::vector<float>& cornerValues) override;
+        virtual void setValuesInternal(SDFSparseValues&& values) override;
 
         float calculateNormalizationFactor(uint32_t gridWidth) const;
 
@@ -26,6 +26,7 @@
  # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  **************************************************************************/
 #include "SDFGrid.h"
+#include "SDFMeshBaker.h"
 #include "GlobalState.h"
 #include "NormalizedDenseSDFGrid/NDSDFGrid.h"
 #include "SparseVoxelSet/SDFSVS.h"
@@ -268,8 +269,39 @@ namespace Falcor
         setValuesInternal(cornerValues);
     }
 
+    void SDFGrid::setValues(SDFSparseValues values)
+    {
+        uint32_t gridWidth = values.getGridWidth();
+        FALCOR_CHECK(gridWidth > 0, "'values' are empty.");
+
+        // All types except SBS need to have a gridWidth that is a power of 2.
+        Type type = getType();
+        if (type != Type::SparseBrickSet)
+        {
+            FALCOR_CHECK(isPowerOf2(gridWidth), "'gridWidth' ({}) must be a power of 2 for SDFGrid type of {}", gridWidth, getTypeName(type));
+        }
+
+        mGridWidth = gridWidth;
+
+        values.signedFloodFill();
+        values.prune();
+        setValuesInternal(std::move(values));
+    }
+
     bool SDFGrid::loadValuesFromFile(const std::filesystem::path& path)
     {
+        // Stream the values unless the grid needs distances far away from the surface.
+        if (getType() != Type::NormalizedDenseGrid)
+        {
+            SDFSparseValues values;
+            if (!values.loadFromFile(path)) return false;
+
+            setValues(std::move(values));
+
+            mInitializedWithPrimitives = false;
+            return true;
+        }
+
         std::ifstream file(path, std::ios::in | std::ios::binary);
 
         if (file.is_open())
@@ -453,6 +485,8 @@ namespace Falcor
     {
         using namespace pybind11::literals;
 
+        FALCOR_SCRIPT_BINDING_DEPENDENCY(SDFMeshBaker)
+
         auto createSBS = [](const pybind11::kwargs& args)
         {
             uint32_t brickWidth = 7;
@@ -497,6 +531,15 @@ namespace Falcor
             "path"_a, "gridWidth"_a
         ); // PYTHONDEPRECATED
         sdfGrid.def("generateCheeseValues", &SDFGrid::generateCheeseValues, "gridWidth"_a, "seed"_a);
+        sdfGrid.def("bakeValuesFromMesh",
+            [](SDFGrid& self, const ref<TriangleMesh>& pMesh, uint32_t gridWidth, const std::filesystem::path& cacheDirectory)
+            {
+                SDFMeshBaker::Options options;
+                options.gridWidth = gridWidth;
+                self.setValues(SDFMeshBaker(*pMesh).bake(options, cacheDirectory));
+            },
+            "mesh"_a, "gridWidth"_a, "cacheDirectory"_a = std::filesystem::path()
+        );
         sdfGrid.def_property("name", &SDFGrid::getName, &SDFGrid::setName);
     }
 
@@ -528,6 +571,33 @@ namespace Falcor
         }
     }
 
+    void SDFGrid::createSDFGridTexture(RenderContext* pRenderContext, const SDFSparseValues& values, ref<Texture>& pTexture) const
+    {
+        FALCOR_ASSERT(pRenderContext);
+        FALCOR_ASSERT(values.getGridWidth() == mGridWidth);
+
+        uint32_t gridWidthInValues = mGridWidth + 1;
+        if (!pTexture || pTexture->getWidth() != gridWidthInValues)
+        {
+            pTexture = mpDevice->createTexture3D(gridWidthInValues, gridWidthInValues, gridWidthInValues, ResourceFormat::R8Snorm, 1);
+        }
+
+        // Upload one layer of bricks at a time, flushing regularly to keep the upload heap from growing.
+        const uint32_t kSlabsPerFlush = 16;
+        const uint32_t slabDepth = SDFSparseValues::kBrickWidth;
+        float normalizationMultipler = 2.0f * mGridWidth / float(M_SQRT3);
+        std::vector<int8_t> slab(size_t(slabDepth) * gridWidthInValues * gridWidthInValues);
+
+        for (uint32_t z = 0, slabIndex = 0; z < gridWidthInValues; z += slabDepth, slabIndex++)
+        {
+            uint32_t depth = std::min(slabDepth, gridWidthInValues - z);
+            values.quantize(normalizationMultipler, 1, z, z + depth, slab.data());
+            pRenderContext->updateSubresourceData(pTexture.get(), 0, slab.data(), uint3(0, 0, z), uint3(gridWidthInValues, gridWidthInValues, depth));
+
+            if ((slabIndex + 1) % kSlabsPerFlush == 0) pRenderContext->submit(true);
+        }
+    }
+
     void SDFGrid::updatePrimitivesBuffer()
     {
         if (mPrimitives.empty() || mPrimitives.size() <= mPrimitivesExcludedFromBuffer) return;
@@ -32,6 +32,7 @@
 #include "Core/API/Texture.h"
 #include "Core/Pass/ComputePass.h"
 #include "Scene/SDFs/SDF3DPrimitiveCommon.slang"
+#include "Scene/SDFs/SDFSparseValues.h"
 #include <memory>
 #include <vector>
 #include <utility>
@@ -123,7 +124,14 @@ namespace Falcor
         */
         void setValues(const std::vector<float>& cornerValues, uint32_t gridWidth);
 
+        /** Set the signed distance values of the SDF grid from sparse narrow-band values, without materializing the dense grid.
+            Unresolved values are sign-filled and bricks outside the narrow band are pruned before the values are handed to the grid.
+            \param[in] values The sparse corner values, the grid width is taken from them. Pass with std::move() to avoid a copy.
+        */
+        void setValues(SDFSparseValues values);
+
         /** Set the signed distance values of the SDF grid from a file.
+            Except for NDSDFGrid, which needs the far field for its coarse LODs, the file is streamed through SDFSparseValues.
             \param[in] path The path of a .sdfg file.
             \return true if the values could be set, otherwise false.
         */
@@ -235,6 +243,13 @@ namespace Falcor
 
     protected:
         virtual void setValuesInternal(const std::vector<float>& cornerValues) = 0;
+        virtual void setValuesInternal(SDFSparseValues&& values) = 0;
+
+        /** Creates or updates an SDF grid texture from sparse values, quantizing and uploading one layer of bricks at a time.
+            \param[in] values The sparse values, must match the grid width.
+            \param[in,out] pTexture The texture to update, recreated if it doesn't match the grid width.
+        */
+        void createSDFGridTexture(RenderContext* pRenderContext, const SDFSparseValues& values, ref<Texture>& pTexture) const;
 
         void createEvaluatePrimitivesPass(bool writeToTexture3D, bool mergeWithSDField);
 
@@ -0,0 +1,742 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "SDFMeshBaker.h"
+#include "Core/Error.h"
+#include "Utils/Logger.h"
+#include "Utils/NumericRange.h"
+#include "Utils/Scripting/ScriptBindings.h"
+#include <algorithm>
+#include <atomic>
+#include <execution>
+#include <limits>
+#include <thread>
+
+namespace Falcor
+{
+    namespace
+    {
+        constexpr uint32_t kBrickWidth = SDFSparseValues::kBrickWidth;
+        constexpr uint32_t kBrickValueCount = SDFSparseValues::kBrickValueCount;
+        constexpr uint32_t kMaxLeafSize = 4;
+        constexpr uint32_t kMaxStackSize = 64;          ///< Enough for any BVH built by median splits.
+        constexpr uint32_t kBricksPerBatch = 4096;      ///< Number of bricks baked in parallel before they are inserted into the sparse values.
+        constexpr uint32_t kCacheVersion = 1;
+        constexpr float kWindingNumberAccuracy = 2.f;   ///< Nodes further away than this multiple of their radius are approximated by a dipole.
+        constexpr float kSignPropagationMargin = 1.01f; ///< Relative margin on the edge length when propagating signs, the distances are subject to rounding.
+        constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+        // Ray direction used for ray parity, chosen to not be aligned with the grid or typical mesh edges.
+        const float3 kRayDir = normalize(float3(0.8710f, 0.3911f, 0.2971f));
+
+        uint32_t getLocalIndex(uint32_t x, uint32_t y, uint32_t z) { return x + kBrickWidth * (y + kBrickWidth * z); }
+
+        /** Returns the closest point to p on the triangle (a, b, c), see Ericson, "Real-Time Collision Detection", 5.1.5.
+        */
+        float3 closestPointOnTriangle(const float3& p, const float3& a, const float3& b, const float3& c)
+        {
+            float3 ab = b - a;
+            float3 ac = c - a;
+            float3 ap = p - a;
+            float d1 = dot(ab, ap);
+            float d2 = dot(ac, ap);
+            if (d1 <= 0.f && d2 <= 0.f) return a;
+
+            float3 bp = p - b;
+            float d3 = dot(ab, bp);
+            float d4 = dot(ac, bp);
+            if (d3 >= 0.f && d4 <= d3) return b;
+
+            float vc = d1 * d4 - d3 * d2;
+            if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f) return a + ab * (d1 / (d1 - d3));
+
+            float3 cp = p - c;
+            float d5 = dot(ab, cp);
+            float d6 = dot(ac, cp);
+            if (d6 >= 0.f && d5 <= d6) return c;
+
+            float vb = d5 * d2 - d1 * d6;
+            if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f) return a + ac * (d2 / (d2 - d6));
+
+            float va = d3 * d6 - d5 * d4;
+            if (va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f) return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+            float denom = 1.f / (va + vb + vc);
+            return a + ab * (vb * denom) + ac * (vc * denom);
+        }
+
+        float distanceSquaredToBox(const float3& p, const AABB& box)
+        {
+            float3 d = max(max(box.minPoint - p, p - box.maxPoint), float3(0.f));
+            return dot(d, d);
+        }
+
+        /** Returns the signed solid angle of a triangle with vertices a, b, c relative to the query point (Van Oosterom and Strackee).
+            Positive if the query point lies on the back side of the counter-clockwise triangle.
+        */
+        float solidAngle(const float3& a, const float3& b, const float3& c)
+        {
+            float la = length(a);
+            float lb = length(b);
+            float lc = length(c);
+            float det = dot(a, cross(b, c));
+            float div = la * lb * lc + dot(a, b) * lc + dot(b, c) * la + dot(c, a) * lb;
+            return 2.f * std::atan2(det, div);
+        }
+
+        bool intersectRayBox(const float3& origin, const float3& invDir, const AABB& box)
+        {
+            float3 t0 = (box.minPoint - origin) * invDir;
+            float3 t1 = (box.maxPoint - origin) * invDir;
+            float3 tMin = min(t0, t1);
+            float3 tMax = max(t0, t1);
+            float tEnter = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.f));
+            float tExit = std::min(std::min(tMax.x, tMax.y), tMax.z);
+            return tEnter <= tExit;
+        }
+
+        /** Moeller-Trumbore ray-triangle test, counting hits on both sides of the triangle.
+        */
+        bool intersectRayTriangle(const float3& origin, const float3& dir, const float3& a, const float3& b, const float3& c)
+        {
+            float3 e1 = b - a;
+            float3 e2 = c - a;
+            float3 pv = cross(dir, e2);
+            float det = dot(e1, pv);
+            if (det == 0.f) return false;
+
+            float invDet = 1.f / det;
+            float3 tv = origin - a;
+            float u = dot(tv, pv) * invDet;
+            if (u < 0.f || u > 1.f) return false;
+
+            float3 qv = cross(tv, e1);
+            float v = dot(dir, qv) * invDet;
+            if (v < 0.f || u + v > 1.f) return false;
+
+            return dot(e2, qv) * invDet > 0.f;
+        }
+
+        /** Solves the eikonal equation |grad(u)| = 1 at a grid point with the Godunov upwind scheme.
+            \param[in] a, b, c The smallest neighbor value along each axis, or infinity if there is none.
+            \param[in] h The grid spacing.
+        */
+        float solveEikonal(float a, float b, float c, float h)
+        {
+            if (a > b) std::swap(a, b);
+            if (b > c) std::swap(b, c);
+            if (a > b) std::swap(a, b);
+
+            float u = a + h;
+            if (u > b)
+            {
+                u = 0.5f * (a + b + std::sqrt(2.f * h * h - (a - b) * (a - b)));
+                if (u > c)
+                {
+                    float sum = a + b + c;
+                    float discriminant = sum * sum - 3.f * (a * a + b * b + c * c - h * h);
+                    u = (sum + std::sqrt(std::max(discriminant, 0.f))) / 3.f;
+                }
+            }
+            return u;
+        }
+
+        /** Runs the 8 sweeps of the fast sweeping method over a grid of unsigned distances. Seed values are never changed.
+        */
+        void fastSweep(float* pDistances, const bool* pIsSeed, const uint3& size, float h)
+        {
+            auto getIndex = [&](uint32_t x, uint32_t y, uint32_t z) { return x + size.x * (y + size_t(size.y) * z); };
+            auto getMinNeighbor = [&](uint32_t x, uint32_t y, uint32_t z, uint32_t axis)
+            {
+                uint3 coords(x, y, z);
+                float value = kInfinity;
+                if (coords[axis] > 0)
+                {
+                    uint3 n = coords;
+                    n[axis]--;
+                    value = pDistances[getIndex(n.x, n.y, n.z)];
+                }
+                if (coords[axis] + 1 < size[axis])
+                {
+                    uint3 n = coords;
+                    n[axis]++;
+                    value = std::min(value, pDistances[getIndex(n.x, n.y, n.z)]);
+                }
+                return value;
+            };
+
+            for (uint32_t sweep = 0; sweep < 8; sweep++)
+            {
+                for (uint32_t i = 0; i < size.z; i++)
+                {
+                    uint32_t z = (sweep & 4) ? size.z - 1 - i : i;
+                    for (uint32_t j = 0; j < size.y; j++)
+                    {
+                        uint32_t y = (sweep & 2) ? size.y - 1 - j : j;
+                        for (uint32_t k = 0; k < size.x; k++)
+                        {
+                            uint32_t x = (sweep & 1) ? size.x - 1 - k : k;
+                            size_t index = getIndex(x, y, z);
+                            if (pIsSeed[index]) continue;
+
+                            float u = solveEikonal(getMinNeighbor(x, y, z, 0), getMinNeighbor(x, y, z, 1), getMinNeighbor(x, y, z, 2), h);
+                            pDistances[index] = std::min(pDistances[index], u);
+                        }
+                    }
+                }
+            }
+        }
+
+        /** Get a temporary file path next to the final cache file. Files are written there first and then renamed,
+            so concurrent bakes (in this or other processes) never observe partially written files.
+        */
+        std::filesystem::path getTempPath(const std::filesystem::path& cachePath)
+        {
+            static std::atomic<uint64_t> counter{0};
+            auto tempPath = cachePath;
+            tempPath += fmt::format(".{}.{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()), counter.fetch_add(1));
+            return tempPath;
+        }
+    }
+
+    SDFMeshBaker::SDFMeshBaker(const TriangleMesh& mesh)
+    {
+        const auto& vertices = mesh.getVertices();
+        mPositions.reserve(vertices.size());
+        for (const auto& vertex : vertices) mPositions.push_back(vertex.position);
+
+        // Store all triangles with counter-clockwise front faces.
+        mIndices = mesh.getIndices();
+        if (mesh.getFrontFaceCW())
+        {
+            for (size_t i = 0; i + 2 < mIndices.size(); i += 3) std::swap(mIndices[i + 1], mIndices[i + 2]);
+        }
+
+        buildBVH();
+    }
+
+    SDFMeshBaker::SDFMeshBaker(std::vector<float3> positions, std::vector<uint32_t> indices)
+        : mPositions(std::move(positions))
+        , mIndices(std::move(indices))
+    {
+        buildBVH();
+    }
+
+    SDFSparseValues SDFMeshBaker::bake(const Options& options, const std::filesystem::path& cacheDirectory) const
+    {
+        FALCOR_CHECK(options.gridWidth > 0, "'gridWidth' must be larger than 0.");
+
+        const uint32_t gridWidth = options.gridWidth;
+        const float bandWidth = options.bandWidth > 0.f ? options.bandWidth : float(M_SQRT3) / gridWidth;
+
+        std::filesystem::path cachePath;
+        if (!cacheDirectory.empty())
+        {
+            cachePath = cacheDirectory / getCacheFileName(options);
+            SDFSparseValues values;
+            if (std::filesystem::exists(cachePath) && values.loadFromFile(cachePath, bandWidth)) return values;
+        }
+
+        // Grid point (x, y, z) lies at gridOrigin + voxelSize * (x, y, z) in mesh space. All distances below are in mesh space.
+        float scale;
+        float3 center;
+        computePlacement(options, scale, center);
+        const float voxelSize = 1.f / (scale * gridWidth);
+        const float3 gridOrigin = center - 0.5f / scale;
+        const float meshBandWidth = bandWidth / scale;
+
+        SDFSparseValues values(gridWidth, bandWidth);
+        const uint32_t bricksPerAxis = values.getBricksPerAxis();
+        const uint32_t brickCount = bricksPerAxis * bricksPerAxis * bricksPerAxis;
+        const float brickRadius = 0.5f * (kBrickWidth - 1) * float(M_SQRT3) * voxelSize;
+        const float nearDistance = brickRadius + meshBandWidth;
+
+        auto getBrickCoords = [&](uint32_t brickIndex) { return uint3(brickIndex % bricksPerAxis, (brickIndex / bricksPerAxis) % bricksPerAxis, brickIndex / (bricksPerAxis * bricksPerAxis)); };
+        auto getBrickCenter = [&](uint32_t brickIndex) { return gridOrigin + (float3(getBrickCoords(brickIndex) * kBrickWidth) + 0.5f * (kBrickWidth - 1)) * voxelSize; };
+
+        // Classify the bricks by the distance of their center to the surface. Only bricks within the brick radius
+        // plus the narrow band can hold values inside the narrow band, the query is bounded accordingly.
+        std::vector<float> centerDistances(brickCount);
+        NumericRange<uint32_t> brickRange(0, brickCount);
+        std::for_each(std::execution::par_unseq, brickRange.begin(), brickRange.end(), [&](uint32_t brickIndex)
+        {
+            centerDistances[brickIndex] = getDistance(getBrickCenter(brickIndex), nearDistance);
+        });
+
+        std::vector<uint32_t> nearBricks;
+        std::vector<bool> isNear(brickCount);
+        for (uint32_t brickIndex = 0; brickIndex < brickCount; brickIndex++)
+        {
+            if (centerDistances[brickIndex] < nearDistance)
+            {
+                isNear[brickIndex] = true;
+                nearBricks.push_back(brickIndex);
+            }
+        }
+
+        // Compute the distances of the far bricks, either by sweeping the brick grid or by exact queries.
+        if (options.fastSweeping && !nearBricks.empty())
+        {
+            std::unique_ptr<bool[]> isSeed(new bool[brickCount]);
+            for (uint32_t brickIndex = 0; brickIndex < brickCount; brickIndex++)
+            {
+                isSeed[brickIndex] = isNear[brickIndex];
+                if (!isNear[brickIndex]) centerDistances[brickIndex] = kInfinity;
+            }
+            fastSweep(centerDistances.data(), isSeed.get(), uint3(bricksPerAxis), kBrickWidth * voxelSize);
+        }
+        else
+        {
+            std::for_each(std::execution::par_unseq, brickRange.begin(), brickRange.end(), [&](uint32_t brickIndex)
+            {
+                if (!isNear[brickIndex]) centerDistances[brickIndex] = getDistance(getBrickCenter(brickIndex), kInfinity);
+            });
+        }
+
+        // Far bricks do not intersect the surface, and neither do the segments connecting neighboring far brick centers,
+        // as each center lies further than the brick radius (more than half the brick spacing) from the surface.
+        // The sign is therefore constant in each 6-connected region of far bricks and is evaluated once per region.
+        std::vector<bool> isVisited = isNear;
+        std::vector<uint32_t> stack;
+        for (uint32_t brickIndex = 0; brickIndex < brickCount; brickIndex++)
+        {
+            if (isVisited[brickIndex]) continue;
+
+            const float sign = isInside(getBrickCenter(brickIndex), options.signMethod) ? -1.f : 1.f;
+            isVisited[brickIndex] = true;
+            stack.push_back(brickIndex);
+            while (!stack.empty())
+            {
+                uint32_t index = stack.back();
+                stack.pop_back();
+                values.setTile(getBrickCoords(index), sign * std::min(centerDistances[index] * scale, float(M_SQRT3)));
+
+                uint3 coords = getBrickCoords(index);
+                for (uint32_t axis = 0; axis < 3; axis++)
+                {
+                    for (int32_t offset : { -1, 1 })
+                    {
+                        int3 neighbor = int3(coords);
+                        neighbor[axis] += offset;
+                        if (neighbor[axis] < 0 || neighbor[axis] >= int32_t(bricksPerAxis)) continue;
+
+                        uint32_t neighborIndex = neighbor.x + bricksPerAxis * (neighbor.y + bricksPerAxis * neighbor.z);
+                        if (isVisited[neighborIndex]) continue;
+                        isVisited[neighborIndex] = true;
+                        stack.push_back(neighborIndex);
+                    }
+                }
+            }
+        }
+
+        // Bake the near bricks in parallel, in batches to bound the memory of the intermediate values.
+        std::vector<float> batchValues;
+        for (size_t batchBegin = 0; batchBegin < nearBricks.size(); batchBegin += kBricksPerBatch)
+        {
+            uint32_t batchSize = uint32_t(std::min<size_t>(kBricksPerBatch, nearBricks.size() - batchBegin));
+            batchValues.resize(size_t(batchSize) * kBrickValueCount);
+
+            NumericRange<uint32_t> batchRange(0, batchSize);
+            std::for_each(std::execution::par_unseq, batchRange.begin(), batchRange.end(), [&](uint32_t i)
+            {
+                uint32_t brickIndex = nearBricks[batchBegin + i];
+                float maxDistance = centerDistances[brickIndex] + brickRadius;
+                bakeBrick(getBrickCoords(brickIndex), gridOrigin, voxelSize, maxDistance, options, &batchValues[size_t(i) * kBrickValueCount]);
+            });
+
+            for (uint32_t i = 0; i < batchSize; i++)
+            {
+                values.setBrick(getBrickCoords(nearBricks[batchBegin + i]), &batchValues[size_t(i) * kBrickValueCount]);
+            }
+        }
+
+        if (!cachePath.empty())
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(cacheDirectory, ec);
+            auto tempPath = getTempPath(cachePath);
+            if (values.writeToFile(tempPath))
+            {
+                std::filesystem::rename(tempPath, cachePath, ec);
+                if (ec) logWarning("SDFMeshBaker::bake() failed to write cache file '{}': {}", cachePath, ec.message());
+            }
+            std::filesystem::remove(tempPath, ec);
+        }
+
+        return values;
+    }
+
+    bool SDFMeshBaker::bakeToFile(const std::filesystem::path& path, const Options& options) const
+    {
+        return bake(options).writeToFile(path);
+    }
+
+    float4x4 SDFMeshBaker::getMeshToGridTransform(const Options& options) const
+    {
+        float scale;
+        float3 center;
+        computePlacement(options, scale, center);
+        return mul(math::matrixFromScaling(float3(scale)), math::matrixFromTranslation(-center));
+    }
+
+    std::string SDFMeshBaker::getCacheFileName(const Options& options) const
+    {
+        SHA1 sha1;
+        sha1.update(kCacheVersion);
+        sha1.update(mMeshHash.data(), mMeshHash.size());
+        sha1.update(options.gridWidth);
+        sha1.update(options.bandWidth);
+        sha1.update(static_cast<uint32_t>(options.signMethod));
+        sha1.update(options.fastSweeping);
+        sha1.update(options.padding);
+        return SHA1::toString(sha1.finalize()) + ".sdfg";
+    }
+
+    float SDFMeshBaker::getDistance(const float3& p) const
+    {
+        return getDistance(p, kInfinity);
+    }
+
+    float SDFMeshBaker::getWindingNumber(const float3& p) const
+    {
+        // Sum the solid angles of all triangles, approximating the solid angle of distant nodes by the one of their area-weighted normal.
+        // See Barill et al., "Fast Winding Numbers for Soups and Clouds", 2018.
+        float sum = 0.f;
+        uint32_t stack[kMaxStackSize];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const Node& node = mNodes[stack[--stackSize]];
+            float3 d = node.center - p;
+            float distanceSquared = dot(d, d);
+            if (distanceSquared > (kWindingNumberAccuracy * node.radius) * (kWindingNumberAccuracy * node.radius))
+            {
+                sum += dot(node.areaNormal, d) / (distanceSquared * std::sqrt(distanceSquared));
+            }
+            else if (node.count > 0)
+            {
+                for (uint32_t i = node.first; i < node.first + node.count; i++)
+                {
+                    sum += solidAngle(mPositions[mIndices[3 * i]] - p, mPositions[mIndices[3 * i + 1]] - p, mPositions[mIndices[3 * i + 2]] - p);
+                }
+            }
+            else
+            {
+                uint32_t nodeIndex = uint32_t(&node - mNodes.data());
+                stack[stackSize++] = nodeIndex + 1;
+                stack[stackSize++] = node.first;
+            }
+        }
+
+        return sum * float(M_1_4PI);
+    }
+
+    bool SDFMeshBaker::isInside(const float3& p, SignMethod signMethod) const
+    {
+        switch (signMethod)
+        {
+        case SignMethod::WindingNumber:
+            return getWindingNumber(p) > 0.5f;
+        case SignMethod::RayParity:
+            return (countRayHits(p, kRayDir) & 1) != 0;
+        default:
+            FALCOR_UNREACHABLE();
+        }
+    }
+
+    void SDFMeshBaker::buildBVH()
+    {
+        FALCOR_CHECK(!mIndices.empty() && mIndices.size() % 3 == 0, "Mesh must have at least one triangle and three indices per triangle.");
+        for (uint32_t index : mIndices) FALCOR_CHECK(index < mPositions.size(), "Vertex index ({}) is out of bounds.", index);
+
+        mMeshHash = SHA1::compute(mPositions.data(), mPositions.size() * sizeof(float3));
+        SHA1 sha1;
+        sha1.update(mMeshHash.data(), mMeshHash.size());
+        sha1.update(mIndices.data(), mIndices.size() * sizeof(uint32_t));
+        mMeshHash = sha1.finalize();
+
+        const uint32_t triangleCount = getTriangleCount();
+        std::vector<float3> centroids(triangleCount);
+        for (uint32_t i = 0; i < triangleCount; i++)
+        {
+            centroids[i] = (mPositions[mIndices[3 * i]] + mPositions[mIndices[3 * i + 1]] + mPositions[mIndices[3 * i + 2]]) / 3.f;
+        }
+
+        // Sort triangle IDs into the leaves, then reorder the indices to match.
+        std::vector<uint32_t> triangleIDs(triangleCount);
+        for (uint32_t i = 0; i < triangleCount; i++) triangleIDs[i] = i;
+
+        mNodes.clear();
+        mNodes.reserve(2 * size_t(triangleCount / kMaxLeafSize + 1));
+        buildNode(0, triangleCount, triangleIDs, centroids);
+
+        std::vector<uint32_t> indices(mIndices.size());
+        for (uint32_t i = 0; i < triangleCount; i++)
+        {
+            for (uint32_t j = 0; j < 3; j++) indices[3 * i + j] = mIndices[3 * triangleIDs[i] + j];
+        }
+        mIndices = std::move(indices);
+        mBounds = mNodes[0].bounds;
+    }
+
+    uint32_t SDFMeshBaker::buildNode(uint32_t first, uint32_t count, std::vector<uint32_t>& triangleIDs, const std::vector<float3>& centroids)
+    {
+        uint32_t nodeIndex = uint32_t(mNodes.size());
+        mNodes.emplace_back();
+
+        Node node;
+        AABB centroidBounds;
+        float3 weightedCenter = float3(0.f);
+        float area = 0.f;
+        for (uint32_t i = first; i < first + count; i++)
+        {
+            uint32_t triangleID = triangleIDs[i];
+            const float3& a = mPositions[mIndices[3 * triangleID]];
+            const float3& b = mPositions[mIndices[3 * triangleID + 1]];
+            const float3& c = mPositions[mIndices[3 * triangleID + 2]];
+            node.bounds.include(a).include(b).include(c);
+            centroidBounds.include(centroids[triangleID]);
+
+            float3 areaNormal = 0.5f * cross(b - a, c - a);
+            float triangleArea = length(areaNormal);
+            node.areaNormal += areaNormal;
+            weightedCenter += triangleArea * centroids[triangleID];
+            area += triangleArea;
+        }
+        node.center = area > 0.f ? weightedCenter / area : node.bounds.center();
+        node.radius = length(max(abs(node.bounds.minPoint - node.center), abs(node.bounds.maxPoint - node.center)));
+
+        if (count <= kMaxLeafSize)
+        {
+            node.first = first;
+            node.count = count;
+        }
+        else
+        {
+            // Split at the median centroid along the largest axis.
+            float3 extent = centroidBounds.extent();
+            uint32_t axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+            uint32_t leftCount = count / 2;
+            std::nth_element(triangleIDs.begin() + first, triangleIDs.begin() + first + leftCount, triangleIDs.begin() + first + count,
+                [&](uint32_t lhs, uint32_t rhs) { return centroids[lhs][axis] < centroids[rhs][axis]; });
+
+            buildNode(first, leftCount, triangleIDs, centroids);
+            node.first = buildNode(first + leftCount, count - leftCount, triangleIDs, centroids);
+            node.count = 0;
+        }
+
+        mNodes[nodeIndex] = node;
+        return nodeIndex;
+    }
+
+    float SDFMeshBaker::getDistance(const float3& p, float maxDistance) const
+    {
+        struct StackEntry
+        {
+            uint32_t nodeIndex;
+            float distanceSquared;
+        };
+
+        float bestDistanceSquared = maxDistance * maxDistance;
+        StackEntry stack[kMaxStackSize];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = { 0, distanceSquaredToBox(p, mNodes[0].bounds) };
+
+        while (stackSize > 0)
+        {
+            StackEntry entry = stack[--stackSize];
+            if (entry.distanceSquared >= bestDistanceSquared) continue;
+
+            const Node& node = mNodes[entry.nodeIndex];
+            if (node.count > 0)
+            {
+                for (uint32_t i = node.first; i < node.first + node.count; i++)
+                {
+                    float3 q = closestPointOnTriangle(p, mPositions[mIndices[3 * i]], mPositions[mIndices[3 * i + 1]], mPositions[mIndices[3 * i + 2]]);
+                    bestDistanceSquared = std::min(bestDistanceSquared, dot(q - p, q - p));
+                }
+            }
+            else
+            {
+                // Push the closer child last so that it is visited first.
+                StackEntry left = { entry.nodeIndex + 1, distanceSquaredToBox(p, mNodes[entry.nodeIndex + 1].bounds) };
+                StackEntry right = { node.first, distanceSquaredToBox(p, mNodes[node.first].bounds) };
+                if (left.distanceSquared < right.distanceSquared) std::swap(left, right);
+                if (left.distanceSquared < bestDistanceSquared) stack[stackSize++] = left;
+                if (right.distanceSquared < bestDistanceSquared) stack[stackSize++] = right;
+            }
+        }
+
+        return std::sqrt(bestDistanceSquared);
+    }
+
+    uint32_t SDFMeshBaker::countRayHits(const float3& origin, const float3& dir) const
+    {
+        const float3 invDir = 1.f / dir;
+        uint32_t hitCount = 0;
+        uint32_t stack[kMaxStackSize];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            uint32_t nodeIndex = stack[--stackSize];
+            const Node& node = mNodes[nodeIndex];
+            if (!intersectRayBox(origin, invDir, node.bounds)) continue;
+
+            if (node.count > 0)
+            {
+                for (uint32_t i = node.first; i < node.first + node.count; i++)
+                {
+                    if (intersectRayTriangle(origin, dir, mPositions[mIndices[3 * i]], mPositions[mIndices[3 * i + 1]], mPositions[mIndices[3 * i + 2]])) hitCount++;
+                }
+            }
+            else
+            {
+                stack[stackSize++] = nodeIndex + 1;
+                stack[stackSize++] = node.first;
+            }
+        }
+
+        return hitCount;
+    }
+
+    void SDFMeshBaker::computePlacement(const Options& options, float& scale, float3& center) const
+    {
+        FALCOR_CHECK(options.padding >= 0.f && options.padding < 0.5f, "'padding' ({}) must be in [0, 0.5).", options.padding);
+
+        float3 extent = mBounds.extent();
+        float maxExtent = std::max(std::max(extent.x, extent.y), extent.z);
+        scale = maxExtent > 0.f ? (1.f - 2.f * options.padding) / maxExtent : 1.f;
+        center = mBounds.center();
+    }
+
+    void SDFMeshBaker::bakeBrick(const uint3& brickCoords, const float3& gridOrigin, float voxelSize, float maxDistance, const Options& options, float* pValues) const
+    {
+        const float3 brickOrigin = gridOrigin + float3(brickCoords * kBrickWidth) * voxelSize;
+        const float scale = 1.f / (voxelSize * options.gridWidth);
+        auto getPosition = [&](uint32_t x, uint32_t y, uint32_t z) { return brickOrigin + float3(x, y, z) * voxelSize; };
+
+        // The distance of the first value is bounded by the distance to the brick center, all other values are bounded by
+        // the distance of a previously computed neighbor plus the voxel size, which keeps the BVH traversals short.
+        // Values outside the grid are computed as well and ignored by SDFSparseValues.
+        float distances[kBrickValueCount];
+        for (uint32_t z = 0; z < kBrickWidth; z++)
+        {
+            for (uint32_t y = 0; y < kBrickWidth; y++)
+            {
+                for (uint32_t x = 0; x < kBrickWidth; x++)
+                {
+                    float bound = maxDistance;
+                    if (x > 0) bound = distances[getLocalIndex(x - 1, y, z)] + voxelSize;
+                    else if (y > 0) bound = distances[getLocalIndex(x, y - 1, z)] + voxelSize;
+                    else if (z > 0) bound = distances[getLocalIndex(x, y, z - 1)] + voxelSize;
+                    distances[getLocalIndex(x, y, z)] = getDistance(getPosition(x, y, z), bound);
+                }
+            }
+        }
+
+        // The surface cannot cross the edge between two neighboring values if their distances sum up to more than the edge length,
+        // so signs are propagated across such edges and only evaluated explicitly for values right next to the surface.
+        float signs[kBrickValueCount] = {};
+        uint16_t stack[kBrickValueCount];
+        for (uint32_t i = 0; i < kBrickValueCount; i++)
+        {
+            if (signs[i] != 0.f) continue;
+
+            uint3 coords(i % kBrickWidth, (i / kBrickWidth) % kBrickWidth, i / (kBrickWidth * kBrickWidth));
+            signs[i] = isInside(getPosition(coords.x, coords.y, coords.z), options.signMethod) ? -1.f : 1.f;
+
+            uint32_t stackSize = 0;
+            stack[stackSize++] = uint16_t(i);
+            while (stackSize > 0)
+            {
+                uint32_t index = stack[--stackSize];
+                uint3 c(index % kBrickWidth, (index / kBrickWidth) % kBrickWidth, index / (kBrickWidth * kBrickWidth));
+                for (uint32_t axis = 0; axis < 3; axis++)
+                {
+                    for (int32_t offset : { -1, 1 })
+                    {
+                        int3 neighbor = int3(c);
+                        neighbor[axis] += offset;
+                        if (neighbor[axis] < 0 || neighbor[axis] >= int32_t(kBrickWidth)) continue;
+
+                        uint32_t neighborIndex = getLocalIndex(neighbor.x, neighbor.y, neighbor.z);
+                        if (signs[neighborIndex] != 0.f || distances[index] + distances[neighborIndex] <= kSignPropagationMargin * voxelSize) continue;
+                        signs[neighborIndex] = signs[index];
+                        stack[stackSize++] = uint16_t(neighborIndex);
+                    }
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < kBrickValueCount; i++)
+        {
+            pValues[i] = signs[i] * std::min(distances[i] * scale, float(M_SQRT3));
+        }
+    }
+
+    FALCOR_SCRIPT_BINDING(SDFMeshBaker)
+    {
+        using namespace pybind11::literals;
+
+        FALCOR_SCRIPT_BINDING_DEPENDENCY(TriangleMesh)
+
+        pybind11::enum_<SDFMeshBaker::SignMethod> signMethod(m, "SDFMeshBakerSignMethod");
+        signMethod.value("WindingNumber", SDFMeshBaker::SignMethod::WindingNumber);
+        signMethod.value("RayParity", SDFMeshBaker::SignMethod::RayParity);
+
+        auto createOptions = [](uint32_t gridWidth, float bandWidth, SDFMeshBaker::SignMethod signMethod, bool fastSweeping, float padding)
+        {
+            SDFMeshBaker::Options options;
+            options.gridWidth = gridWidth;
+            options.bandWidth = bandWidth;
+            options.signMethod = signMethod;
+            options.fastSweeping = fastSweeping;
+            options.padding = padding;
+            return options;
+        };
+
+        pybind11::class_<SDFMeshBaker> baker(m, "SDFMeshBaker");
+        baker.def(pybind11::init([](const ref<TriangleMesh>& pMesh) { return std::make_unique<SDFMeshBaker>(*pMesh); }), "mesh"_a);
+        baker.def("bakeToFile",
+            [createOptions](const SDFMeshBaker& self, const std::filesystem::path& path, uint32_t gridWidth, float bandWidth, SDFMeshBaker::SignMethod signMethod, bool fastSweeping, float padding)
+            {
+                pybind11::gil_scoped_release release;
+                return self.bakeToFile(path, createOptions(gridWidth, bandWidth, signMethod, fastSweeping, padding));
+            },
+            "path"_a, "gridWidth"_a = 256, "bandWidth"_a = 0.f, "signMethod"_a = SDFMeshBaker::SignMethod::WindingNumber, "fastSweeping"_a = true, "padding"_a = 0.05f
+        );
+        baker.def("getMeshToGridTransform",
+            [createOptions](const SDFMeshBaker& self, float padding) { return self.getMeshToGridTransform(createOptions(256, 0.f, SDFMeshBaker::SignMethod::WindingNumber, true, padding)); },
+            "padding"_a = 0.05f
+        );
+        baker.def_property_readonly("triangleCount", &SDFMeshBaker::getTriangleCount);
+    }
+}
@@ -0,0 +1,148 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "SDFSparseValues.h"
+#include "Core/Macros.h"
+#include "Scene/TriangleMesh.h"
+#include "Utils/CryptoUtils.h"
+#include "Utils/Math/AABB.h"
+#include "Utils/Math/Matrix.h"
+#include "Utils/Math/Vector.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Falcor
+{
+    /** Bakes triangle meshes into SDF grid values on the CPU.
+
+        Distances are found with closest-point queries on a triangle BVH, signs with generalized winding numbers or ray parity.
+        The grid is processed in parallel, one brick of SDFSparseValues::kBrickWidth^3 values at a time:
+        bricks that intersect the narrow band compute exact distances for all their values, while the constant values of all other bricks
+        are propagated from the narrow band by fast sweeping over the brick grid.
+        The result can be passed to any SDF grid with SDFGrid::setValues() and cached on disk as a .sdfg file,
+        so that SDF scenes can be prepared ahead of time without a GPU.
+    */
+    class FALCOR_API SDFMeshBaker
+    {
+    public:
+        /** Method used to decide if a grid point lies inside the mesh.
+        */
+        enum class SignMethod : uint32_t
+        {
+            WindingNumber,  ///< Generalized winding number, robust to holes and self-intersections.
+            RayParity,      ///< Parity of the number of hits along a ray, requires a watertight mesh.
+        };
+
+        struct Options
+        {
+            uint32_t gridWidth = 256;                       ///< Grid width in voxels.
+            float bandWidth = 0.f;                          ///< Width of the narrow band in grid-local units, see SDFSparseValues. If 0, one voxel diagonal is used.
+            SignMethod signMethod = SignMethod::WindingNumber;
+            bool fastSweeping = true;                       ///< Compute the bricks outside the narrow band with fast sweeping instead of exact distance queries.
+            float padding = 0.05f;                          ///< Fraction of the grid kept free on each side of the mesh when fitting it into the grid.
+
+            // Note: Empty constructor needed for gcc/clang due to the use of the nested struct as a default argument.
+            Options() {}
+        };
+
+        /** Create a baker for the triangles of a mesh. Builds the triangle BVH.
+            \param[in] mesh The mesh, taking its front face winding into account for the sign.
+        */
+        SDFMeshBaker(const TriangleMesh& mesh);
+
+        /** Create a baker from raw triangle data. Builds the triangle BVH.
+            \param[in] positions Vertex positions.
+            \param[in] indices Vertex indices, three per triangle, with counter-clockwise front faces.
+        */
+        SDFMeshBaker(std::vector<float3> positions, std::vector<uint32_t> indices);
+
+        /** Bake the mesh into sparse SDF values. The mesh is scaled uniformly and centered to fit into the grid, see getMeshToGridTransform().
+            \param[in] options Bake options.
+            \param[in] cacheDirectory If not empty, the values are loaded from a .sdfg file in this directory if one exists
+                       for the same mesh and options, otherwise they are baked and written there.
+            \return The sparse SDF values.
+        */
+        SDFSparseValues bake(const Options& options = Options(), const std::filesystem::path& cacheDirectory = {}) const;
+
+        /** Bake the mesh and write the values to a .sdfg file that can be loaded with SDFGrid::loadValuesFromFile().
+            \param[in] path The output file path.
+            \param[in] options Bake options.
+            \return true if the file was written, otherwise false.
+        */
+        bool bakeToFile(const std::filesystem::path& path, const Options& options = Options()) const;
+
+        /** Returns the transform that places the mesh into the grid-local space [-0.5, 0.5]^3.
+            The SDF grid instance should use the inverse of this transform to appear at the location of the mesh.
+        */
+        float4x4 getMeshToGridTransform(const Options& options = Options()) const;
+
+        /** Returns the file name used to cache the values baked with the given options.
+        */
+        std::string getCacheFileName(const Options& options = Options()) const;
+
+        /** Returns the unsigned distance from a point in mesh space to the closest triangle.
+        */
+        float getDistance(const float3& p) const;
+
+        /** Returns the generalized winding number of a point in mesh space, about 1 inside and 0 outside of closed meshes.
+        */
+        float getWindingNumber(const float3& p) const;
+
+        /** Returns true if a point in mesh space lies inside the mesh.
+        */
+        bool isInside(const float3& p, SignMethod signMethod) const;
+
+        const AABB& getBounds() const { return mBounds; }
+        uint32_t getTriangleCount() const { return uint32_t(mIndices.size() / 3); }
+
+    private:
+        struct Node
+        {
+            AABB bounds;
+            uint32_t first = 0;             ///< Index of the first triangle for leaves, the index of the second child for inner nodes.
+            uint32_t count = 0;             ///< Number of triangles for leaves, 0 for inner nodes. The first child follows its parent.
+            float3 areaNormal = float3(0.f);///< Sum of the area-weighted triangle normals.
+            float3 center = float3(0.f);    ///< Area-weighted centroid of the triangles.
+            float radius = 0.f;             ///< Radius of a sphere around the center bounding all triangles.
+        };
+
+        void buildBVH();
+        uint32_t buildNode(uint32_t first, uint32_t count, std::vector<uint32_t>& triangleIDs, const std::vector<float3>& centroids);
+        float getDistance(const float3& p, float maxDistance) const;
+        uint32_t countRayHits(const float3& origin, const float3& dir) const;
+        void computePlacement(const Options& options, float& scale, float3& center) const;
+        void bakeBrick(const uint3& brickCoords, const float3& gridOrigin, float voxelSize, float maxDistance, const Options& options, float* pValues) const;
+
+        std::vector<float3> mPositions;     ///< Vertex positions.
+        std::vector<uint32_t> mIndices;     ///< Triangle vertex indices, reordered during the BVH build.
+        std::vector<Node> mNodes;           ///< BVH nodes, the root is at index 0.
+        AABB mBounds;                       ///< Bounds of the mesh.
+        SHA1::MD mMeshHash;                 ///< Hash of the triangle data in input order, used for the cache file names.
+    };
+}
@@ -0,0 +1,471 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "SDFSparseValues.h"
+#include "Core/Error.h"
+#include "Utils/Logger.h"
+#include "Utils/NumericRange.h"
+#include <cstring>
+#include <execution>
+#include <fstream>
+#include <limits>
+
+namespace Falcor
+{
+    namespace
+    {
+        constexpr uint32_t kBrickWidth = SDFSparseValues::kBrickWidth;
+        constexpr uint32_t kBrickValueCount = SDFSparseValues::kBrickValueCount;
+
+        uint32_t getLocalIndex(uint32_t x, uint32_t y, uint32_t z) { return x + kBrickWidth * (y + kBrickWidth * z); }
+    }
+
+    SDFSparseValues::SDFSparseValues(uint32_t gridWidth, float bandWidth, float backgroundValue)
+        : mGridWidth(gridWidth)
+        , mBricksPerAxis(gridWidth / kBrickWidth + 1)
+        , mBandWidth(bandWidth > 0.f ? bandWidth : float(M_SQRT3) / gridWidth)
+        , mBackgroundValue(backgroundValue)
+    {
+        FALCOR_CHECK(gridWidth > 0, "'gridWidth' must be larger than 0.");
+        FALCOR_CHECK(backgroundValue > 0.f, "'backgroundValue' ({}) must be positive.", backgroundValue);
+
+        uint64_t brickCount = uint64_t(mBricksPerAxis) * mBricksPerAxis * mBricksPerAxis;
+        FALCOR_CHECK(brickCount < kBackground, "'gridWidth' ({}) is too large.", gridWidth);
+        mBricks.resize(brickCount);
+    }
+
+    SDFSparseValues SDFSparseValues::createFromDense(const std::vector<float>& cornerValues, uint32_t gridWidth, float bandWidth)
+    {
+        SDFSparseValues values(gridWidth, bandWidth);
+
+        uint32_t gridWidthInValues = gridWidth + 1;
+        size_t sliceSize = size_t(gridWidthInValues) * gridWidthInValues;
+        FALCOR_CHECK(cornerValues.size() == sliceSize * gridWidthInValues, "'cornerValues' must have a size of (gridWidth + 1)^3.");
+
+        for (uint32_t brickZ = 0; brickZ < values.mBricksPerAxis; brickZ++)
+        {
+            values.setBrickSlab(brickZ, cornerValues.data() + brickZ * kBrickWidth * sliceSize);
+        }
+
+        return values;
+    }
+
+    bool SDFSparseValues::loadFromFile(const std::filesystem::path& path, float bandWidth)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file.is_open())
+        {
+            logWarning("SDFSparseValues::loadFromFile() file '{}' could not be opened!", path);
+            return false;
+        }
+
+        uint32_t gridWidth = 0;
+        file.read(reinterpret_cast<char*>(&gridWidth), sizeof(uint32_t));
+        if (!file || gridWidth == 0)
+        {
+            logWarning("SDFSparseValues::loadFromFile() file '{}' has an invalid header!", path);
+            return false;
+        }
+
+        *this = SDFSparseValues(gridWidth, bandWidth);
+
+        // Read kBrickWidth slices at a time, i.e., one layer of bricks.
+        uint32_t gridWidthInValues = gridWidth + 1;
+        size_t sliceSize = size_t(gridWidthInValues) * gridWidthInValues;
+        std::vector<float> slab(kBrickWidth * sliceSize);
+
+        for (uint32_t brickZ = 0; brickZ < mBricksPerAxis; brickZ++)
+        {
+            uint32_t sliceCount = std::min(kBrickWidth, gridWidthInValues - brickZ * kBrickWidth);
+            file.read(reinterpret_cast<char*>(slab.data()), sliceCount * sliceSize * sizeof(float));
+            if (!file)
+            {
+                logWarning("SDFSparseValues::loadFromFile() file '{}' is truncated!", path);
+                *this = SDFSparseValues();
+                return false;
+            }
+
+            setBrickSlab(brickZ, slab.data());
+        }
+
+        return true;
+    }
+
+    bool SDFSparseValues::writeToFile(const std::filesystem::path& path) const
+    {
+        std::ofstream file(path, std::ios::out | std::ios::binary);
+        if (!file.is_open())
+        {
+            logWarning("SDFSparseValues::writeToFile() file '{}' could not be opened!", path);
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(&mGridWidth), sizeof(uint32_t));
+
+        uint32_t gridWidthInValues = mGridWidth + 1;
+        std::vector<float> slice(size_t(gridWidthInValues) * gridWidthInValues);
+        NumericRange<uint32_t> range(0, gridWidthInValues);
+        for (uint32_t z = 0; z < gridWidthInValues && file; z++)
+        {
+            std::for_each(std::execution::par_unseq, range.begin(), range.end(), [&](uint32_t y)
+            {
+                for (uint32_t x = 0; x < gridWidthInValues; x++) slice[x + size_t(gridWidthInValues) * y] = getValue(uint3(x, y, z));
+            });
+            file.write(reinterpret_cast<const char*>(slice.data()), slice.size() * sizeof(float));
+        }
+
+        if (!file)
+        {
+            logWarning("SDFSparseValues::writeToFile() failed to write file '{}'!", path);
+            return false;
+        }
+
+        return true;
+    }
+
+    void SDFSparseValues::setBrick(const uint3& brickCoords, const float* pValues)
+    {
+        FALCOR_CHECK(all(brickCoords < uint3(mBricksPerAxis)), "'brickCoords' ({}) is out of bounds.", brickCoords);
+
+        Brick& brick = mBricks[getBrickIndex(brickCoords)];
+        float constant;
+        if (findConstant(brickCoords, pValues, constant))
+        {
+            releaseBrick(brick);
+            brick.value = constant;
+        }
+        else
+        {
+            float* pDst = brick.slot < kBackground ? &mBrickData[size_t(brick.slot) * kBrickValueCount] : allocateBrick(brick);
+            std::memcpy(pDst, pValues, kBrickValueCount * sizeof(float));
+        }
+    }
+
+    void SDFSparseValues::setTile(const uint3& brickCoords, float value)
+    {
+        FALCOR_CHECK(all(brickCoords < uint3(mBricksPerAxis)), "'brickCoords' ({}) is out of bounds.", brickCoords);
+
+        Brick& brick = mBricks[getBrickIndex(brickCoords)];
+        if (isInsideBand(value))
+        {
+            float* pDst = brick.slot < kBackground ? &mBrickData[size_t(brick.slot) * kBrickValueCount] : allocateBrick(brick);
+            std::fill_n(pDst, kBrickValueCount, value);
+        }
+        else
+        {
+            releaseBrick(brick);
+            brick.value = value;
+        }
+    }
+
+    void SDFSparseValues::setValue(const uint3& coords, float value)
+    {
+        FALCOR_CHECK(all(coords <= uint3(mGridWidth)), "'coords' ({}) is out of bounds.", coords);
+
+        uint3 brickCoords = coords / kBrickWidth;
+        uint3 localCoords = coords % kBrickWidth;
+        Brick& brick = mBricks[getBrickIndex(brickCoords)];
+
+        if (brick.slot >= kBackground)
+        {
+            // Values of a previously empty brick are unknown until the signs are propagated.
+            float fillValue = brick.value;
+            if (brick.slot == kBackground)
+            {
+                fillValue = std::numeric_limits<float>::quiet_NaN();
+                mHasUnresolvedValues = true;
+            }
+            std::fill_n(allocateBrick(brick), kBrickValueCount, fillValue);
+        }
+
+        mBrickData[size_t(brick.slot) * kBrickValueCount + getLocalIndex(localCoords.x, localCoords.y, localCoords.z)] = value;
+    }
+
+    void SDFSparseValues::setValues(fstd::span<const uint3> coords, fstd::span<const float> values)
+    {
+        FALCOR_CHECK(coords.size() == values.size(), "'coords' and 'values' must have the same size.");
+
+        for (size_t i = 0; i < coords.size(); i++)
+        {
+            setValue(coords[i], values[i]);
+        }
+    }
+
+    void SDFSparseValues::signedFloodFill()
+    {
+        if (!mHasUnresolvedValues) return;
+
+        // Scan each row of values along x and assign unresolved values the sign of the preceding value.
+        // Rows of bricks are independent, a brick that was never written takes the sign of its first row.
+        NumericRange<uint32_t> range(0, mBricksPerAxis * mBricksPerAxis);
+        std::for_each(std::execution::par_unseq, range.begin(), range.end(), [&](uint32_t brickRow)
+        {
+            uint32_t brickY = brickRow % mBricksPerAxis;
+            uint32_t brickZ = brickRow / mBricksPerAxis;
+            uint32_t yCount = std::min(kBrickWidth, mGridWidth + 1 - brickY * kBrickWidth);
+            uint32_t zCount = std::min(kBrickWidth, mGridWidth + 1 - brickZ * kBrickWidth);
+
+            for (uint32_t z = 0; z < zCount; z++)
+            {
+                for (uint32_t y = 0; y < yCount; y++)
+                {
+                    float last = mBackgroundValue;
+
+                    for (uint32_t brickX = 0; brickX < mBricksPerAxis; brickX++)
+                    {
+                        Brick& brick = mBricks[getBrickIndex(uint3(brickX, brickY, brickZ))];
+                        if (brick.slot < kBackground)
+                        {
+                            float* pRow = &mBrickData[size_t(brick.slot) * kBrickValueCount + getLocalIndex(0, y, z)];
+                            uint32_t xCount = std::min(kBrickWidth, mGridWidth + 1 - brickX * kBrickWidth);
+                            for (uint32_t x = 0; x < xCount; x++)
+                            {
+                                if (std::isnan(pRow[x])) pRow[x] = std::copysign(mBandWidth, last);
+                                else last = pRow[x];
+                            }
+                        }
+                        else
+                        {
+                            if (brick.slot == kBackground)
+                            {
+                                brick.slot = kConstant;
+                                brick.value = std::copysign(mBackgroundValue, last);
+                            }
+                            last = brick.value;
+                        }
+                    }
+                }
+            }
+        });
+
+        mHasUnresolvedValues = false;
+    }
+
+    void SDFSparseValues::prune()
+    {
+        std::vector<float> brickData;
+        brickData.reserve(size_t(getDenseBrickCount()) * kBrickValueCount);
+
+        for (uint32_t z = 0; z < mBricksPerAxis; z++)
+        {
+            for (uint32_t y = 0; y < mBricksPerAxis; y++)
+            {
+                for (uint32_t x = 0; x < mBricksPerAxis; x++)
+                {
+                    Brick& brick = mBricks[getBrickIndex(uint3(x, y, z))];
+                    if (brick.slot >= kBackground) continue;
+
+                    const float* pValues = &mBrickData[size_t(brick.slot) * kBrickValueCount];
+                    float constant;
+                    if (findConstant(uint3(x, y, z), pValues, constant))
+                    {
+                        brick.slot = kConstant;
+                        brick.value = constant;
+                    }
+                    else
+                    {
+                        brick.slot = uint32_t(brickData.size() / kBrickValueCount);
+                        brickData.insert(brickData.end(), pValues, pValues + kBrickValueCount);
+                    }
+                }
+            }
+        }
+
+        mBrickData = std::move(brickData);
+        mFreeSlotCount = 0;
+    }
+
+    float SDFSparseValues::getValue(const uint3& coords) const
+    {
+        FALCOR_ASSERT(all(coords <= uint3(mGridWidth)));
+
+        const Brick& brick = mBricks[getBrickIndex(coords / kBrickWidth)];
+        if (brick.slot >= kBackground) return getBrickValue(brick);
+
+        uint3 localCoords = coords % kBrickWidth;
+        return mBrickData[size_t(brick.slot) * kBrickValueCount + getLocalIndex(localCoords.x, localCoords.y, localCoords.z)];
+    }
+
+    const float* SDFSparseValues::getBrickValues(const uint3& brickCoords) const
+    {
+        const Brick& brick = mBricks[getBrickIndex(brickCoords)];
+        return brick.slot < kBackground ? &mBrickData[size_t(brick.slot) * kBrickValueCount] : nullptr;
+    }
+
+    float SDFSparseValues::getBrickConstant(const uint3& brickCoords) const
+    {
+        return getBrickValue(mBricks[getBrickIndex(brickCoords)]);
+    }
+
+    void SDFSparseValues::quantize(float normalizationMultiplier, uint32_t stride, uint32_t zBegin, uint32_t zEnd, int8_t* pDst) const
+    {
+        FALCOR_CHECK(stride > 0 && mGridWidth % stride == 0, "'stride' ({}) must divide the grid width ({}).", stride, mGridWidth);
+
+        uint32_t outputWidth = mGridWidth / stride + 1;
+        FALCOR_CHECK(zBegin <= zEnd && zEnd <= outputWidth, "Invalid slice range [{}, {}).", zBegin, zEnd);
+
+        NumericRange<uint32_t> range(zBegin, zEnd);
+        std::for_each(std::execution::par_unseq, range.begin(), range.end(), [&](uint32_t z)
+        {
+            uint32_t gridZ = z * stride;
+            int8_t* pSlice = pDst + size_t(z - zBegin) * outputWidth * outputWidth;
+
+            for (uint32_t y = 0; y < outputWidth; y++)
+            {
+                uint32_t gridY = y * stride;
+                int8_t* pRow = pSlice + size_t(y) * outputWidth;
+
+                // Process the row one brick at a time.
+                for (uint32_t x = 0; x < outputWidth;)
+                {
+                    uint32_t brickX = x * stride / kBrickWidth;
+                    uint32_t xEnd = std::min(outputWidth, ((brickX + 1) * kBrickWidth + stride - 1) / stride);
+
+                    const Brick& brick = mBricks[getBrickIndex(uint3(brickX, gridY / kBrickWidth, gridZ / kBrickWidth))];
+                    if (brick.slot < kBackground)
+                    {
+                        const float* pValues = &mBrickData[size_t(brick.slot) * kBrickValueCount + getLocalIndex(0, gridY % kBrickWidth, gridZ % kBrickWidth)];
+                        for (; x < xEnd; x++) pRow[x] = quantizeValue(pValues[x * stride - brickX * kBrickWidth], normalizationMultiplier);
+                    }
+                    else
+                    {
+                        std::memset(pRow + x, quantizeValue(getBrickValue(brick), normalizationMultiplier), xEnd - x);
+                        x = xEnd;
+                    }
+                }
+            }
+        });
+    }
+
+    std::vector<float> SDFSparseValues::toDense() const
+    {
+        uint32_t gridWidthInValues = mGridWidth + 1;
+        std::vector<float> cornerValues(size_t(gridWidthInValues) * gridWidthInValues * gridWidthInValues);
+
+        NumericRange<uint32_t> range(0, gridWidthInValues);
+        std::for_each(std::execution::par_unseq, range.begin(), range.end(), [&](uint32_t z)
+        {
+            for (uint32_t y = 0; y < gridWidthInValues; y++)
+            {
+                for (uint32_t x = 0; x < gridWidthInValues; x++)
+                {
+                    cornerValues[x + gridWidthInValues * (y + size_t(gridWidthInValues) * z)] = getValue(uint3(x, y, z));
+                }
+            }
+        });
+
+        return cornerValues;
+    }
+
+    float* SDFSparseValues::allocateBrick(Brick& brick)
+    {
+        brick.slot = uint32_t(mBrickData.size() / kBrickValueCount);
+        mBrickData.resize(mBrickData.size() + kBrickValueCount);
+        return &mBrickData[size_t(brick.slot) * kBrickValueCount];
+    }
+
+    void SDFSparseValues::releaseBrick(Brick& brick)
+    {
+        // The storage is reclaimed by prune().
+        if (brick.slot < kBackground) mFreeSlotCount++;
+        brick.slot = kConstant;
+    }
+
+    bool SDFSparseValues::findConstant(const uint3& brickCoords, const float* pValues, float& constant) const
+    {
+        uint3 valueCount = min(uint3(kBrickWidth), uint3(mGridWidth + 1) - brickCoords * kBrickWidth);
+
+        // A brick is constant if all values lie outside the narrow band on the same side of the surface.
+        float minPositive = std::numeric_limits<float>::max();
+        float minNegative = std::numeric_limits<float>::max();
+        for (uint32_t z = 0; z < valueCount.z; z++)
+        {
+            for (uint32_t y = 0; y < valueCount.y; y++)
+            {
+                const float* pRow = pValues + getLocalIndex(0, y, z);
+                for (uint32_t x = 0; x < valueCount.x; x++)
+                {
+                    float value = pRow[x];
+                    if (isInsideBand(value)) return false;
+                    if (value > 0.f) minPositive = std::min(minPositive, value);
+                    else minNegative = std::min(minNegative, -value);
+                }
+            }
+        }
+
+        if (minPositive != std::numeric_limits<float>::max() && minNegative != std::numeric_limits<float>::max()) return false;
+        constant = minPositive != std::numeric_limits<float>::max() ? minPositive : -minNegative;
+        return true;
+    }
+
+    void SDFSparseValues::setBrickSlab(uint32_t brickZ, const float* pSlab)
+    {
+        uint32_t gridWidthInValues = mGridWidth + 1;
+        size_t sliceSize = size_t(gridWidthInValues) * gridWidthInValues;
+
+        auto gatherBrick = [&](uint32_t brickX, uint32_t brickY, float* pValues)
+        {
+            uint3 valueCount = min(uint3(kBrickWidth), uint3(gridWidthInValues) - uint3(brickX, brickY, brickZ) * kBrickWidth);
+            std::fill_n(pValues, kBrickValueCount, mBackgroundValue);
+            for (uint32_t z = 0; z < valueCount.z; z++)
+            {
+                for (uint32_t y = 0; y < valueCount.y; y++)
+                {
+                    const float* pSrc = pSlab + z * sliceSize + size_t(brickY * kBrickWidth + y) * gridWidthInValues + brickX * kBrickWidth;
+                    std::memcpy(pValues + getLocalIndex(0, y, z), pSrc, valueCount.x * sizeof(float));
+                }
+            }
+        };
+
+        // Classify the bricks in parallel, then copy the dense ones into the brick storage.
+        uint32_t brickCount = mBricksPerAxis * mBricksPerAxis;
+        std::vector<uint8_t> isDense(brickCount);
+        NumericRange<uint32_t> range(0, brickCount);
+        std::for_each(std::execution::par_unseq, range.begin(), range.end(), [&](uint32_t i)
+        {
+            uint3 brickCoords(i % mBricksPerAxis, i / mBricksPerAxis, brickZ);
+            float values[kBrickValueCount];
+            gatherBrick(brickCoords.x, brickCoords.y, values);
+
+            Brick& brick = mBricks[getBrickIndex(brickCoords)];
+            float constant;
+            isDense[i] = !findConstant(brickCoords, values, constant);
+            if (!isDense[i])
+            {
+                brick.slot = kConstant;
+                brick.value = constant;
+            }
+        });
+
+        for (uint32_t i = 0; i < brickCount; i++)
+        {
+            if (!isDense[i]) continue;
+            uint3 brickCoords(i % mBricksPerAxis, i / mBricksPerAxis, brickZ);
+            gatherBrick(brickCoords.x, brickCoords.y, allocateBrick(mBricks[getBrickIndex(brickCoords)]));
+        }
+    }
+}
@@ -0,0 +1,197 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include "Utils/Math/Vector.h"
+#include "Utils/Math/MathConstants.slangh"
+#include <fstd/span.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace Falcor
+{
+    /** Sparse, narrow-band storage of SDF grid corner values.
+
+        The (gridWidth + 1)^3 corner values of an SDF grid are partitioned into bricks of kBrickWidth^3 values.
+        Bricks that intersect the narrow band around the surface store all their values, all other bricks only store a single constant value.
+        Bricks that were never written hold the background value, or the inside value once signedFloodFill() has been called.
+        The brick table itself is dense, but only costs 8 bytes per brick, i.e., 1/256th of a dense grid of floats.
+
+        Values can be inserted brick-wise with setBrick(), as individual narrow-band samples with setValue()/setValues(),
+        or streamed from a .sdfg file with loadFromFile() without ever holding the dense grid in memory.
+        The SDF grid representations only look at the dense bricks when building, voxels whose corner values are all stored
+        in constant bricks are assumed to not intersect the surface (which holds for distance fields with a narrow band of at least one voxel diagonal).
+    */
+    class FALCOR_API SDFSparseValues
+    {
+    public:
+        static constexpr uint32_t kBrickWidth = 8;
+        static constexpr uint32_t kBrickValueCount = kBrickWidth * kBrickWidth * kBrickWidth;
+
+        /** Create an empty container.
+        */
+        SDFSparseValues() = default;
+
+        /** Create a container with all values set to the background value.
+            \param[in] gridWidth The grid width in voxels, the container stores (gridWidth + 1)^3 values.
+            \param[in] bandWidth Bricks with all absolute values larger or equal to this are stored as constants. If 0, one voxel diagonal is used.
+            \param[in] backgroundValue The value of bricks that were never written, must be positive (outside).
+        */
+        SDFSparseValues(uint32_t gridWidth, float bandWidth = 0.f, float backgroundValue = float(M_SQRT3));
+
+        /** Create a sparse container from a dense grid of corner values.
+            \param[in] cornerValues The corner values, of size (gridWidth + 1)^3.
+            \param[in] gridWidth The grid width in voxels.
+            \param[in] bandWidth Narrow band width, see constructor.
+        */
+        static SDFSparseValues createFromDense(const std::vector<float>& cornerValues, uint32_t gridWidth, float bandWidth = 0.f);
+
+        /** Stream corner values from a .sdfg file, only kBrickWidth slices of the grid are held in memory at any time.
+            \param[in] path The path of a .sdfg file.
+            \param[in] bandWidth Narrow band width, see constructor.
+            \return true if the values could be loaded, otherwise false.
+        */
+        bool loadFromFile(const std::filesystem::path& path, float bandWidth = 0.f);
+
+        /** Write all values to a .sdfg file, one slice at a time.
+            \param[in] path The output file path.
+            \return true if the file was written, otherwise false.
+        */
+        bool writeToFile(const std::filesystem::path& path) const;
+
+        /** Set all values of a brick. Bricks that lie outside the narrow band are stored as a constant.
+            \param[in] brickCoords The brick coordinates.
+            \param[in] pValues kBrickValueCount values with x running fastest. Values outside the grid are ignored.
+        */
+        void setBrick(const uint3& brickCoords, const float* pValues);
+
+        /** Set a brick to a constant value.
+            \param[in] brickCoords The brick coordinates.
+            \param[in] value The value, if it lies inside the narrow band the brick is stored densely.
+        */
+        void setTile(const uint3& brickCoords, float value);
+
+        /** Set a single corner value. Untouched values of a brick that was previously empty are resolved by signedFloodFill().
+            \param[in] coords The corner coordinates, in [0, gridWidth]^3.
+            \param[in] value The signed distance.
+        */
+        void setValue(const uint3& coords, float value);
+
+        /** Set a list of narrow-band corner values.
+            \param[in] coords The corner coordinates, in [0, gridWidth]^3.
+            \param[in] values The signed distances, same size as coords.
+        */
+        void setValues(fstd::span<const uint3> coords, fstd::span<const float> values);
+
+        /** Propagate the sign of the narrow band to all values that were not explicitly written, by scanning the grid along x.
+            Requires the narrow band to be closed along each scanline. Does nothing if no unresolved values exist.
+        */
+        void signedFloodFill();
+
+        /** Convert dense bricks that lie outside the narrow band to constants and compact the brick storage.
+        */
+        void prune();
+
+        /** Returns the value at the given corner coordinates.
+        */
+        float getValue(const uint3& coords) const;
+
+        /** Returns the values of a brick, or nullptr if the brick is stored as a constant.
+        */
+        const float* getBrickValues(const uint3& brickCoords) const;
+
+        /** Returns the constant value of a brick. Only valid if getBrickValues() returns nullptr.
+        */
+        float getBrickConstant(const uint3& brickCoords) const;
+
+        /** Quantizes a range of z-slices to normalized 8-bit snorm values, in the layout used by the SDF grid textures.
+            \param[in] normalizationMultiplier Multiplier mapping distances to [-1, 1], results outside are clamped.
+            \param[in] stride The sampling stride, the output grid has (gridWidth / stride + 1) values along each axis.
+            \param[in] zBegin First z-slice of the output grid to write.
+            \param[in] zEnd One past the last z-slice of the output grid to write.
+            \param[out] pDst Destination of size (zEnd - zBegin) * (gridWidth / stride + 1)^2.
+        */
+        void quantize(float normalizationMultiplier, uint32_t stride, uint32_t zBegin, uint32_t zEnd, int8_t* pDst) const;
+
+        /** Returns all (gridWidth + 1)^3 values as a dense grid.
+        */
+        std::vector<float> toDense() const;
+
+        /** Quantize a distance to a normalized snorm8 value, the same way the SDF grids do.
+        */
+        static int8_t quantizeValue(float value, float normalizationMultiplier)
+        {
+            float integerScale = std::clamp(value * normalizationMultiplier, -1.0f, 1.0f) * float(INT8_MAX);
+            return integerScale >= 0.0f ? int8_t(integerScale + 0.5f) : int8_t(integerScale - 0.5f);
+        }
+
+        uint32_t getGridWidth() const { return mGridWidth; }
+        uint32_t getBricksPerAxis() const { return mBricksPerAxis; }
+        float getBandWidth() const { return mBandWidth; }
+        float getBackgroundValue() const { return mBackgroundValue; }
+
+        /** Returns the number of bricks that store all their values.
+        */
+        uint32_t getDenseBrickCount() const { return uint32_t(mBrickData.size() / kBrickValueCount) - mFreeSlotCount; }
+
+        /** Returns the number of bytes used by the container.
+        */
+        size_t getMemoryUsage() const { return mBricks.size() * sizeof(Brick) + mBrickData.size() * sizeof(float); }
+
+    private:
+        static constexpr uint32_t kConstant = 0xffffffff;   ///< Slot of a brick holding a constant value.
+        static constexpr uint32_t kBackground = 0xfffffffe; ///< Slot of a brick that was never written.
+
+        struct Brick
+        {
+            uint32_t slot = kBackground;    ///< Offset of the brick values in units of bricks, or kConstant/kBackground.
+            float value = 0.f;              ///< Constant value of the brick if not stored densely.
+        };
+
+        uint32_t getBrickIndex(const uint3& brickCoords) const { return brickCoords.x + mBricksPerAxis * (brickCoords.y + mBricksPerAxis * brickCoords.z); }
+        bool isInsideBand(float value) const { return !(std::abs(value) >= mBandWidth); } // Unresolved (NaN) values count as inside.
+        float getBrickValue(const Brick& brick) const { return brick.slot == kBackground ? mBackgroundValue : brick.value; }
+        float* allocateBrick(Brick& brick);
+        void releaseBrick(Brick& brick);
+        bool findConstant(const uint3& brickCoords, const float* pValues, float& constant) const;
+        void setBrickSlab(uint32_t brickZ, const float* pSlab);
+
+        uint32_t mGridWidth = 0;
+        uint32_t mBricksPerAxis = 0;
+        float mBandWidth = 0.f;
+        float mBackgroundValue = 0.f;
+
+        std::vector<Brick> mBricks;         ///< Brick table, mBricksPerAxis^3 entries.
+        std::vector<float> mBrickData;      ///< Values of dense bricks, kBrickValueCount per brick.
+        uint32_t mFreeSlotCount = 0;        ///< Number of unused bricks in mBrickData, reclaimed by prune().
+        bool mHasUnresolvedValues = false;  ///< True if setValue() left values that must be resolved by signedFloodFill().
+    };
+}
@@ -109,6 +109,11 @@ namespace Falcor
             createSDFGridTexture(pRenderContext, mSDField);
             mSDField.clear();
         }
+        else if (mpSparseSDField)
+        {
+            createSDFGridTexture(pRenderContext, *mpSparseSDField);
+            mpSparseSDField.reset();
+        }
         return createResourcesFromPrimitivesAndSDField(pRenderContext, false);
     }
 
@@ -122,6 +127,11 @@ namespace Falcor
             createSDFGridTexture(pRenderContext, mSDField);
             mSDField.clear();
         }
+        else if (mpSparseSDField)
+        {
+            createSDFGridTexture(pRenderContext, *mpSparseSDField);
+            mpSparseSDField.reset();
+        }
 
         if (!mPrimitives.empty())
         {
@@ -974,6 +984,8 @@ namespace Falcor
 
     void SDFSBS::setValuesInternal(const std::vector<float>& cornerValues)
     {
+        mpSparseSDField.reset();
+
         uint32_t gridWidthInValues = mGridWidth + 1;
         uint32_t valueCount = gridWidthInValues * gridWidthInValues * gridWidthInValues;
         mSDField.resize(valueCount);
@@ -988,6 +1000,14 @@ namespace Falcor
         }
     }
 
+    void SDFSBS::setValuesInternal(SDFSparseValues&& values)
+    {
+        // The values are quantized while uploading the grid texture, one layer of bricks at a time.
+        mSDField.clear();
+        mSDField.shrink_to_fit();
+        mpSparseSDField = std::make_unique<SDFSparseValues>(std::move(values));
+    }
+
     void SDFSBS::createSDFGridTexture(RenderContext* pRenderContext, const std::vector<int8_t>& sdField)
     {
         FALCOR_CHECK(!sdField.empty(), "Cannot create SDF grid texture from empty values vector");
@@ -1007,6 +1027,16 @@ namespace Falcor
         mHasGridRepresentation = true;
     }
 
+    void SDFSBS::createSDFGridTexture(RenderContext* pRenderContext, const SDFSparseValues& values)
+    {
+        SDFGrid::createSDFGridTexture(pRenderContext, values, mpSDFGridTexture);
+
+        mSDFieldUpdated = true;
+        mCurrentBakedPrimitiveCount = 0;
+        mBakedPrimitiveCount = 0;
+        mHasGridRepresentation = true;
+    }
+
     uint32_t SDFSBS::fetchCount(RenderContext* pRenderContext, const ref<Buffer>& pBuffer)
     {
         if (!mpCountStagingBuffer)
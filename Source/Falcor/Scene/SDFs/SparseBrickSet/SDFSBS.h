@@ -79,8 +79,10 @@ namespace Falcor
         void allocatePrimitiveBits();
 
         virtual void setValuesInternal(const std::vector<float>& cornerValues) override;
+        virtual void setValuesInternal(SDFSparseValues&& values) override;
 
         void createSDFGridTexture(RenderContext* pRenderContext, const std::vector<int8_t>& sdField);
+        void createSDFGridTexture(RenderContext* pRenderContext, const SDFSparseValues& values);
 
         uint32_t fetchCount(RenderContext* pRenderContext, const ref<Buffer>& pBuffer);
 
@@ -89,6 +91,7 @@ namespace Falcor
     private:
         // CPU data.
         std::vector<int8_t> mSDField;
+        std::unique_ptr<SDFSparseValues> mpSparseSDField;   ///< Set instead of mSDField if the grid was loaded from sparse values.
 
         // Specs.
         uint32_t mDefaultGridWidth = 0;                 ///< The grid width used if the grid was not loaded from a file (it is empty).
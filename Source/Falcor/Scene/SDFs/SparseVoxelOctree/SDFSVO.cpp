@@ -98,7 +98,11 @@ namespace Falcor
         }
 
         // Create source grid texture to read from.
-        if (mpSDFGridTexture && mpSDFGridTexture->getWidth() == mGridWidth + 1)
+        if (mpSparseValues)
+        {
+            createSDFGridTexture(pRenderContext, *mpSparseValues, mpSDFGridTexture);
+        }
+        else if (mpSDFGridTexture && mpSDFGridTexture->getWidth() == mGridWidth + 1)
         {
             pRenderContext->updateTextureData(mpSDFGridTexture.get(), mValues.data());
         }
@@ -408,6 +412,7 @@ namespace Falcor
     void SDFSVO::setValuesInternal(const std::vector<float>& cornerValues)
     {
         mLevelCount = bitScanReverse(mGridWidth) + 1;
+        mpSparseValues.reset();
 
         uint32_t gridWidthInValues = mGridWidth + 1;
         uint32_t valueCount = gridWidthInValues * gridWidthInValues * gridWidthInValues;
@@ -422,4 +427,14 @@ namespace Falcor
             mValues[v] = integerScale >= 0.0f ? int8_t(integerScale + 0.5f) : int8_t(integerScale - 0.5f);
         }
     }
+
+    void SDFSVO::setValuesInternal(SDFSparseValues&& values)
+    {
+        mLevelCount = bitScanReverse(mGridWidth) + 1;
+
+        // The values are quantized while uploading the grid texture, one layer of bricks at a time.
+        mValues.clear();
+        mValues.shrink_to_fit();
+        mpSparseValues = std::make_unique<SDFSparseValues>(std::move(values));
+    }
 }
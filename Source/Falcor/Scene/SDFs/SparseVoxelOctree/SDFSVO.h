@@ -62,10 +62,12 @@ namespace Falcor
 
     protected:
         virtual void setValuesInternal(const std::vector<float>& cornerValues) override;
+        virtual void setValuesInternal(SDFSparseValues&& values) override;
 
     private:
         // CPU data.
         std::vector<int8_t> mValues;
+        std::unique_ptr<SDFSparseValues> mpSparseValues;    ///< Set instead of mValues if the grid was created from sparse values.
 
         // Specs.
         uint32_t mLevelCount = 0;
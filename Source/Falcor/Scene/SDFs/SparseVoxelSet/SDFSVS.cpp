@@ -28,9 +28,11 @@
 #include "SDFSVS.h"
 #include "Core/API/Device.h"
 #include "Core/API/RenderContext.h"
+#include "Utils/Math/Common.h"
 #include "Utils/Math/MathHelpers.h"
 #include "Utils/Math/MathConstants.slangh"
-#include "Scene/SDFs/SDFVoxelTypes.slang"
+#include "Utils/NumericRange.h"
+#include <execution>
 
 namespace Falcor
 {
@@ -38,6 +40,10 @@ namespace Falcor
     {
         const std::string kSDFCountSurfaceVoxelsShaderName = "Scene/SDFs/SDFSurfaceVoxelCounter.cs.slang";
         const std::string kSDFSVSVoxelizerShaderName = "Scene/SDFs/SparseVoxelSet/SDFSVSVoxelizer.cs.slang";
+
+        const uint32_t kBrickWidth = SDFSparseValues::kBrickWidth;
+        const uint32_t kValueBlockWidth = kBrickWidth + 3;  ///< Values from one before to two after a brick of voxels, as accessed by the voxel neighborhoods.
+        const uint32_t kVoxelBlockWidth = kBrickWidth + 2;  ///< Voxels from one before to one after a brick of voxels, as accessed by the neighbor masks.
     }
 
     size_t SDFSVS::getSize() const
@@ -57,6 +63,22 @@ namespace Falcor
             FALCOR_THROW("An SDFSVS instance cannot be created from primitives!");
         }
 
+        // Voxels were already created on the CPU from sparse values.
+        if (mValues.empty())
+        {
+            mVoxelCount = (uint32_t)mVoxels.size();
+            mpVoxelAABBBuffer = mpDevice->createStructuredBuffer(sizeof(AABB), mVoxelCount, ResourceBindFlags::ShaderResource | ResourceBindFlags::UnorderedAccess, MemoryType::DeviceLocal, mVoxelAABBs.data(), false);
+            mpVoxelBuffer = mpDevice->createStructuredBuffer(
+                sizeof(SDFSVSVoxel),
+                mVoxelCount,
+                ResourceBindFlags::ShaderResource | ResourceBindFlags::UnorderedAccess,
+                MemoryType::DeviceLocal,
+                mVoxels.data(),
+                true
+            );
+            return;
+        }
+
         if (mpSDFGridTexture && mpSDFGridTexture->getWidth() == mGridWidth + 1)
         {
             pRenderContext->updateTextureData(mpSDFGridTexture.get(), mValues.data());
@@ -161,6 +183,9 @@ namespace Falcor
 
     void SDFSVS::setValuesInternal(const std::vector<float>& cornerValues)
     {
+        mVoxelAABBs.clear();
+        mVoxels.clear();
+
         uint32_t gridWidthInValues = mGridWidth + 1;
         uint32_t valueCount = gridWidthInValues * gridWidthInValues * gridWidthInValues;
         mValues.resize(valueCount);
@@ -174,4 +199,194 @@ namespace Falcor
             mValues[v] = integerScale >= 0.0f ? int8_t(integerScale + 0.5f) : int8_t(integerScale - 0.5f);
         }
     }
+
+    void SDFSVS::setValuesInternal(SDFSparseValues&& values)
+    {
+        mValues.clear();
+        mValues.shrink_to_fit();
+
+        createVoxels(values, mVoxelAABBs, mVoxels);
+    }
+
+    void SDFSVS::createVoxels(const SDFSparseValues& values, std::vector<AABB>& voxelAABBs, std::vector<SDFSVSVoxel>& voxels)
+    {
+        const int32_t gridWidth = (int32_t)values.getGridWidth();
+        const uint32_t bricksPerAxis = values.getBricksPerAxis();
+        const uint32_t voxelBricksPerAxis = div_round_up((uint32_t)gridWidth, kBrickWidth);
+        const float normalizationMultipler = 2.0f * gridWidth / float(M_SQRT3);
+
+        // Only bricks of voxels with corners in dense value bricks can contain the surface, all other corners are constant and of a single sign.
+        std::vector<uint8_t> isCandidate(size_t(voxelBricksPerAxis) * voxelBricksPerAxis * voxelBricksPerAxis, 0);
+        for (uint32_t z = 0; z < bricksPerAxis; z++)
+        {
+            for (uint32_t y = 0; y < bricksPerAxis; y++)
+            {
+                for (uint32_t x = 0; x < bricksPerAxis; x++)
+                {
+                    if (!values.getBrickValues(uint3(x, y, z))) continue;
+
+                    // The values of a brick are shared with the voxel bricks before it.
+                    for (uint32_t o = 0; o < 8; o++)
+                    {
+                        int3 voxelBrick = int3(x, y, z) - int3(o & 1, (o >> 1) & 1, o >> 2);
+                        if (any(voxelBrick < int3(0)) || any(voxelBrick >= int3(voxelBricksPerAxis))) continue;
+                        isCandidate[voxelBrick.x + voxelBricksPerAxis * (voxelBrick.y + size_t(voxelBricksPerAxis) * voxelBrick.z)] = 1;
+                    }
+                }
+            }
+        }
+
+        std::vector<uint32_t> candidates;
+        for (uint32_t i = 0; i < (uint32_t)isCandidate.size(); i++)
+        {
+            if (isCandidate[i]) candidates.push_back(i);
+        }
+
+        // Voxelize the candidate bricks in parallel, then concatenate the results in brick order.
+        std::vector<std::vector<AABB>> brickVoxelAABBs(candidates.size());
+        std::vector<std::vector<SDFSVSVoxel>> brickVoxels(candidates.size());
+
+        NumericRange<uint32_t> range(0, (uint32_t)candidates.size());
+        std::for_each(std::execution::par_unseq, range.begin(), range.end(), [&](uint32_t c)
+        {
+            uint32_t brickIndex = candidates[c];
+            int3 brickOrigin = int3(brickIndex % voxelBricksPerAxis, (brickIndex / voxelBricksPerAxis) % voxelBricksPerAxis, brickIndex / (voxelBricksPerAxis * voxelBricksPerAxis)) * int32_t(kBrickWidth);
+            int3 blockOrigin = brickOrigin - int3(1);
+
+            // Gather the quantized values one brick segment at a time, values outside the grid are loaded as 1 like the voxelizer does.
+            int8_t valueBlock[kValueBlockWidth * kValueBlockWidth * kValueBlockWidth];
+            auto blockValue = [&](int3 coords) -> int8_t& { coords -= blockOrigin; return valueBlock[coords.x + kValueBlockWidth * (coords.y + kValueBlockWidth * coords.z)]; };
+
+            for (int32_t z = 0; z < (int32_t)kValueBlockWidth; z++)
+            {
+                for (int32_t y = 0; y < (int32_t)kValueBlockWidth; y++)
+                {
+                    int3 rowCoords = blockOrigin + int3(0, y, z);
+                    int8_t* pRow = &blockValue(rowCoords);
+                    if (rowCoords.y < 0 || rowCoords.y > gridWidth || rowCoords.z < 0 || rowCoords.z > gridWidth)
+                    {
+                        std::fill_n(pRow, kValueBlockWidth, int8_t(INT8_MAX));
+                        continue;
+                    }
+
+                    uint3 localCoords = uint3(rowCoords) % kBrickWidth;
+                    for (int32_t x = 0; x < (int32_t)kValueBlockWidth;)
+                    {
+                        int32_t gridX = rowCoords.x + x;
+                        if (gridX < 0 || gridX > gridWidth)
+                        {
+                            pRow[x++] = INT8_MAX;
+                            continue;
+                        }
+
+                        uint32_t brickX = uint32_t(gridX) / kBrickWidth;
+                        int32_t xEnd = std::min((int32_t)kValueBlockWidth, int32_t((brickX + 1) * kBrickWidth) - rowCoords.x);
+                        const float* pValues = values.getBrickValues(uint3(brickX, uint32_t(rowCoords.y) / kBrickWidth, uint32_t(rowCoords.z) / kBrickWidth));
+                        if (pValues)
+                        {
+                            pValues += kBrickWidth * (localCoords.y + kBrickWidth * localCoords.z);
+                            for (; x < xEnd; x++) pRow[x] = SDFSparseValues::quantizeValue(pValues[rowCoords.x + x - int32_t(brickX * kBrickWidth)], normalizationMultipler);
+                        }
+                        else
+                        {
+                            int8_t value = SDFSparseValues::quantizeValue(values.getBrickConstant(uint3(brickX, uint32_t(rowCoords.y) / kBrickWidth, uint32_t(rowCoords.z) / kBrickWidth)), normalizationMultipler);
+                            for (; x < xEnd; x++) pRow[x] = value;
+                        }
+                    }
+                }
+            }
+
+            // Find the voxels that contain the surface, including the neighbors of the brick's voxels.
+            // The sign flags of the values are OR:ed over the 2x2x2 corners of each voxel, one axis at a time.
+            const uint8_t kInside = 0x1;
+            const uint8_t kOutside = 0x2;
+            uint8_t signs[kValueBlockWidth * kValueBlockWidth * kValueBlockWidth];
+            for (uint32_t i = 0; i < kValueBlockWidth * kValueBlockWidth * kValueBlockWidth; i++)
+            {
+                signs[i] = (valueBlock[i] <= 0 ? kInside : 0) | (valueBlock[i] >= 0 ? kOutside : 0);
+            }
+            for (uint32_t axisStride : { 1u, kValueBlockWidth, kValueBlockWidth * kValueBlockWidth })
+            {
+                for (uint32_t i = 0; i + axisStride < kValueBlockWidth * kValueBlockWidth * kValueBlockWidth; i++) signs[i] |= signs[i + axisStride];
+            }
+
+            bool containsSurface[kVoxelBlockWidth * kVoxelBlockWidth * kVoxelBlockWidth];
+            auto voxelContainsSurface = [&](int3 voxelCoords) -> bool& { voxelCoords -= blockOrigin; return containsSurface[voxelCoords.x + kVoxelBlockWidth * (voxelCoords.y + kVoxelBlockWidth * voxelCoords.z)]; };
+
+            for (int32_t z = 0; z < (int32_t)kVoxelBlockWidth; z++)
+            {
+                for (int32_t y = 0; y < (int32_t)kVoxelBlockWidth; y++)
+                {
+                    for (int32_t x = 0; x < (int32_t)kVoxelBlockWidth; x++)
+                    {
+                        int3 voxelCoords = blockOrigin + int3(x, y, z);
+                        bool valid = all(voxelCoords >= int3(0)) && all(voxelCoords < int3(gridWidth));
+                        voxelContainsSurface(voxelCoords) = valid && signs[x + kValueBlockWidth * (y + kValueBlockWidth * z)] == (kInside | kOutside);
+                    }
+                }
+            }
+
+            // Create the voxels, see SDFSVSVoxelizer.cs.slang.
+            for (int32_t z = 0; z < (int32_t)kBrickWidth; z++)
+            {
+                for (int32_t y = 0; y < (int32_t)kBrickWidth; y++)
+                {
+                    for (int32_t x = 0; x < (int32_t)kBrickWidth; x++)
+                    {
+                        int3 voxelCoords = brickOrigin + int3(x, y, z);
+                        if (any(voxelCoords >= int3(gridWidth)) || !voxelContainsSurface(voxelCoords)) continue;
+
+                        float3 p = float3(voxelCoords) - float(gridWidth) * 0.5f;
+                        brickVoxelAABBs[c].push_back(AABB(p / float(gridWidth), (p + 1.0f) / float(gridWidth)));
+
+                        SDFSVSVoxel voxel = {};
+                        for (int32_t sx = 0; sx < 4; sx++)
+                        {
+                            for (int32_t sy = 0; sy < 4; sy++)
+                            {
+                                uint32_t packedValues = 0;
+                                for (int32_t sz = 0; sz < 4; sz++)
+                                {
+                                    int3 coords = voxelCoords + int3(sx, sy, sz) - int3(1);
+                                    bool valid = all(coords >= int3(0)) && all(coords < int3(gridWidth));
+                                    int8_t value = valid ? blockValue(coords) : int8_t(INT8_MAX);
+                                    packedValues |= uint32_t(uint8_t(value)) << (8 * sz);
+                                }
+                                voxel.packedValuesSlices[sx][sy] = packedValues;
+                            }
+                        }
+
+                        for (int32_t nx = 0; nx <= 2; nx++)
+                        {
+                            for (int32_t ny = 0; ny <= 2; ny++)
+                            {
+                                for (int32_t nz = 0; nz <= 2; nz++)
+                                {
+                                    if (voxelContainsSurface(voxelCoords + int3(nx, ny, nz) - int3(1)))
+                                    {
+                                        voxel.validNeighborsMask |= (1 << (nz + 3 * (ny + 3 * nx)));
+                                    }
+                                }
+                            }
+                        }
+
+                        brickVoxels[c].push_back(voxel);
+                    }
+                }
+            }
+        });
+
+        size_t voxelCount = 0;
+        for (const auto& brick : brickVoxels) voxelCount += brick.size();
+
+        voxelAABBs.clear();
+        voxels.clear();
+        voxelAABBs.reserve(voxelCount);
+        voxels.reserve(voxelCount);
+        for (size_t c = 0; c < candidates.size(); c++)
+        {
+            voxelAABBs.insert(voxelAABBs.end(), brickVoxelAABBs[c].begin(), brickVoxelAABBs[c].end());
+            voxels.insert(voxels.end(), brickVoxels[c].begin(), brickVoxels[c].end());
+        }
+    }
 }
@@ -28,6 +28,7 @@
 #pragma once
 
 #include "Scene/SDFs/SDFGrid.h"
+#include "Scene/SDFs/SDFVoxelTypes.slang"
 #include "Core/API/Buffer.h"
 #include "Core/API/Texture.h"
 #include "Core/Pass/ComputePass.h"
@@ -55,12 +56,23 @@ namespace Falcor
 
         virtual void bindShaderData(const ShaderVar& var) const override;
 
+        /** Creates the voxels of a sparse voxel set on the CPU, matching the output of the GPU voxelizer up to the order of the voxels.
+            Only voxels with corners in dense bricks of the sparse values are visited.
+            \param[in] values The sparse corner values.
+            \param[out] voxelAABBs The AABBs of all voxels that contain the surface.
+            \param[out] voxels The voxel data, in the same order as the AABBs.
+        */
+        static void createVoxels(const SDFSparseValues& values, std::vector<AABB>& voxelAABBs, std::vector<SDFSVSVoxel>& voxels);
+
     protected:
         virtual void setValuesInternal(const std::vector<float>& cornerValues) override;
+        virtual void setValuesInternal(SDFSparseValues&& values) override;
 
     private:
         // CPU data.
         std::vector<int8_t> mValues;
+        std::vector<AABB> mVoxelAABBs;      ///< Voxel AABBs created on the CPU from sparse values.
+        std::vector<SDFSVSVoxel> mVoxels;   ///< Voxels created on the CPU from sparse values.
 
         // Specs.
         ref<Buffer> mpVoxelAABBBuffer;
@@ -54,6 +54,7 @@
 #include <sstream>
 #include <algorithm>
 #include <execution>
+#include <set>
 
 namespace Falcor
 {
@@ -73,6 +74,8 @@ namespace Falcor
         const std::string kIndexBufferName = "indexData";
         const std::string kVertexBufferName = "vertices";
         const std::string kPrevVertexBufferName = "prevVertices";
+        const std::string kCompressedVertexBufferName = "compressedVertices";
+        const std::string kVertexQuantizationBufferName = "vertexQuantization";
         const std::string kProceduralPrimAABBBufferName = "proceduralPrimitiveAABBs";
         const std::string kCurveBufferName = "curves";
         const std::string kCurveIndexBufferName = "curveIndices";
@@ -194,6 +197,7 @@ namespace Falcor
         mUseCompressedHitInfo = sceneData.useCompressedHitInfo;
         mHas16BitIndices = sceneData.has16BitIndices;
         mHas32BitIndices = sceneData.has32BitIndices;
+        mVertexCacheStats = sceneData.vertexCacheStats;
 
         mCurveDesc = std::move(sceneData.curveDesc);
         mCurveBBs = std::move(sceneData.curveBBs);
@@ -215,6 +219,18 @@ namespace Falcor
         mMeshStaticData.setBufferCountDefinePrefix("SCENE_VERTEX");
         mMeshStaticData.createGpuBuffers(mpDevice, ResourceBindFlags::ShaderResource | ResourceBindFlags::UnorderedAccess | ResourceBindFlags::Vertex);
 
+        mMeshCompressedStaticData = std::move(sceneData.meshCompressedStaticData);
+        mMeshVertexQuantization = std::move(sceneData.meshVertexQuantization);
+        if (hasCompressedVertices())
+        {
+            mpMeshCompressedStaticBuffer = mpDevice->createStructuredBuffer(sizeof(CompressedStaticVertexData), (uint32_t)mMeshCompressedStaticData.size(),
+                ResourceBindFlags::ShaderResource | ResourceBindFlags::Vertex, MemoryType::DeviceLocal, mMeshCompressedStaticData.data(), false);
+            mpMeshCompressedStaticBuffer->setName("Scene::mpMeshCompressedStaticBuffer");
+            mpMeshVertexQuantizationBuffer = mpDevice->createStructuredBuffer(sizeof(VertexQuantization), (uint32_t)mMeshVertexQuantization.size(),
+                ResourceBindFlags::ShaderResource, MemoryType::DeviceLocal, mMeshVertexQuantization.data(), false);
+            mpMeshVertexQuantizationBuffer->setName("Scene::mpMeshVertexQuantizationBuffer");
+        }
+
         // Setup additional resources.
         mFrontClockwiseRS[RasterizerState::CullMode::None] = RasterizerState::create(RasterizerState::Desc().setFrontCounterCW(false).setCullMode(RasterizerState::CullMode::None));
         mFrontClockwiseRS[RasterizerState::CullMode::Back] = RasterizerState::create(RasterizerState::Desc().setFrontCounterCW(false).setCullMode(RasterizerState::CullMode::Back));
@@ -288,6 +304,7 @@ namespace Falcor
         defines.add("SCENE_HAS_INDEXED_VERTICES", hasIndexBuffer() ? "1" : "0");
         defines.add("SCENE_HAS_16BIT_INDICES", mHas16BitIndices ? "1" : "0");
         defines.add("SCENE_HAS_32BIT_INDICES", mHas32BitIndices ? "1" : "0");
+        defines.add("SCENE_HAS_COMPRESSED_VERTICES", hasCompressedVertices() ? "1" : "0");
         mMeshIndexData.getShaderDefines(defines);
         mMeshStaticData.getShaderDefines(defines);
 
@@ -382,7 +399,8 @@ namespace Falcor
             FALCOR_ASSERT(draw.count > 0);
 
             // Set state.
-            pState->setVao(draw.ibFormat == ResourceFormat::R16Uint ? mpMeshVao16Bit : mpMeshVao);
+            if (draw.compressed) pState->setVao(draw.ibFormat == ResourceFormat::R16Uint ? mpMeshCompressedVao16Bit : mpMeshCompressedVao);
+            else pState->setVao(draw.ibFormat == ResourceFormat::R16Uint ? mpMeshVao16Bit : mpMeshVao);
 
             if (draw.ccw) pState->setRasterizerState(pRasterizerStateCCW);
             else pState->setRasterizerState(pRasterizerStateCW);
@@ -444,7 +462,8 @@ namespace Falcor
         if (!mMeshIndexData.empty())
             pIB = mMeshIndexData.getGpuBuffer(0);
 
-        ref<Buffer> pStaticBuffer = mMeshStaticData.getGpuBuffer(0);
+        // The packed vertex buffer is empty if all meshes use compressed vertices.
+        ref<Buffer> pStaticBuffer = mMeshStaticData.getBufferCount() > 0 ? mMeshStaticData.getGpuBuffer(0) : nullptr;
 
         Vao::BufferVec pVBs(kVertexBufferCount);
         pVBs[kStaticDataBufferIndex] = pStaticBuffer;
@@ -492,8 +511,29 @@ namespace Falcor
         // Create the VAO objects.
         // Note that the global index buffer can be mixed 16/32-bit format.
         // For drawing the meshes we need separate VAOs for these cases.
-        mpMeshVao = Vao::create(Vao::Topology::TriangleList, pLayout, pVBs, pIB, ResourceFormat::R32Uint);
-        mpMeshVao16Bit = Vao::create(Vao::Topology::TriangleList, pLayout, pVBs, pIB, ResourceFormat::R16Uint);
+        if (pStaticBuffer)
+        {
+            mpMeshVao = Vao::create(Vao::Topology::TriangleList, pLayout, pVBs, pIB, ResourceFormat::R32Uint);
+            mpMeshVao16Bit = Vao::create(Vao::Topology::TriangleList, pLayout, pVBs, pIB, ResourceFormat::R16Uint);
+        }
+
+        // Meshes with compressed vertices use a separate vertex buffer and layout, see CompressedStaticVertexData.
+        // The position is fetched as snorm16 with the tangent bits in w, the packed normal/tangent bits are passed through as raw bits.
+        if (mpMeshCompressedStaticBuffer)
+        {
+            ref<VertexLayout> pCompressedLayout = VertexLayout::create();
+            ref<VertexBufferLayout> pCompressedStaticLayout = VertexBufferLayout::create();
+            pCompressedStaticLayout->addElement(VERTEX_POSITION_NAME, 0, ResourceFormat::RGBA16Snorm, 1, VERTEX_POSITION_LOC);
+            pCompressedStaticLayout->addElement(VERTEX_PACKED_NORMAL_TANGENT_CURVE_RADIUS_NAME, 8, ResourceFormat::R32Float, 1, VERTEX_PACKED_NORMAL_TANGENT_CURVE_RADIUS_LOC);
+            pCompressedStaticLayout->addElement(VERTEX_TEXCOORD_NAME, 12, ResourceFormat::RG16Float, 1, VERTEX_TEXCOORD_LOC);
+            pCompressedLayout->addBufferLayout(kStaticDataBufferIndex, pCompressedStaticLayout);
+            pCompressedLayout->addBufferLayout(kDrawIdBufferIndex, pInstLayout);
+
+            Vao::BufferVec pCompressedVBs = pVBs;
+            pCompressedVBs[kStaticDataBufferIndex] = mpMeshCompressedStaticBuffer;
+            mpMeshCompressedVao = Vao::create(Vao::Topology::TriangleList, pCompressedLayout, pCompressedVBs, pIB, ResourceFormat::R32Uint);
+            mpMeshCompressedVao16Bit = Vao::create(Vao::Topology::TriangleList, pCompressedLayout, pCompressedVBs, pIB, ResourceFormat::R16Uint);
+        }
     }
 
     void Scene::createCurveVao(const std::vector<uint32_t>& indexData, const std::vector<StaticCurveVertexData>& staticData)
@@ -597,9 +637,12 @@ namespace Falcor
                 // Load vertices from global vertex buffer.
                 // Note that the mesh local vbOffset is added to address into the global vertex buffer.
                 StaticVertexData vertices[3];
-                vertices[0] = mMeshStaticData[(size_t)desc.vbOffset + vidx[0]].unpack();
-                vertices[1] = mMeshStaticData[(size_t)desc.vbOffset + vidx[1]].unpack();
-                vertices[2] = mMeshStaticData[(size_t)desc.vbOffset + vidx[2]].unpack();
+                for (int i = 0; i < 3; i++)
+                {
+                    const size_t index = (size_t)desc.vbOffset + vidx[i];
+                    if (desc.useCompressedVertices()) vertices[i].texCrd = mMeshCompressedStaticData[index].unpackTexCrd();
+                    else vertices[i] = mMeshStaticData[index].unpack();
+                }
 
                 int2 v0 = int2(std::floor(vertices[0].texCrd[0]), std::floor(vertices[0].texCrd[1]));
                 int2 v1 = int2(std::floor(vertices[1].texCrd[0]), std::floor(vertices[1].texCrd[1]));
@@ -827,6 +870,11 @@ namespace Falcor
             mMeshIndexData.bindShaderData(var[kIndexBufferName]);
         mMeshStaticData.bindShaderData(var[kVertexBufferName]);
         var[kPrevVertexBufferName] = mpAnimationController->getPrevVertexData();
+        if (hasCompressedVertices())
+        {
+            var[kCompressedVertexBufferName] = mpMeshCompressedStaticBuffer;
+            var[kVertexQuantizationBufferName] = mpMeshVertexQuantizationBuffer;
+        }
 
         if (mpCurveVao != nullptr)
         {
@@ -1368,6 +1416,8 @@ namespace Falcor
             s.uniqueVertexCount += mesh.vertexCount;
             s.uniqueTriangleCount += mesh.getTriangleCount();
         }
+        s.vertexCacheACMR = mVertexCacheStats.getACMR();
+        s.vertexCacheATVR = mVertexCacheStats.getATVR();
 
         for (CurveID curveID{ 0 }; curveID.get() < getCurveCount(); ++curveID)
         {
@@ -1384,10 +1434,12 @@ namespace Falcor
 
         s.indexMemoryInBytes += mMeshIndexData.getByteSize();
         s.vertexMemoryInBytes += mMeshStaticData.getByteSize();
+        s.vertexMemoryInBytes += mpMeshCompressedStaticBuffer ? mpMeshCompressedStaticBuffer->getSize() : 0;
+        s.geometryMemoryInBytes += mpMeshVertexQuantizationBuffer ? mpMeshVertexQuantizationBuffer->getSize() : 0;
 
-        if (mpMeshVao)
+        if (const auto& pVao = mpMeshVao ? mpMeshVao : mpMeshCompressedVao)
         {
-            const auto& pDrawID = mpMeshVao->getVertexBuffer(kDrawIdBufferIndex);
+            const auto& pDrawID = pVao->getVertexBuffer(kDrawIdBufferIndex);
             s.geometryMemoryInBytes += pDrawID ? pDrawID->getSize() : 0;
         }
 
@@ -1462,6 +1514,7 @@ namespace Falcor
 
         if (mpBlasScratch) s.blasScratchMemoryInBytes += mpBlasScratch->getSize();
         if (mpBlasStaticWorldMatrices) s.blasScratchMemoryInBytes += mpBlasStaticWorldMatrices->getSize();
+        if (mpBlasCompressedVertexTransforms) s.blasScratchMemoryInBytes += mpBlasCompressedVertexTransforms->getSize();
     }
 
     void Scene::updateRaytracingTLASStats()
@@ -1542,6 +1595,83 @@ namespace Falcor
         }
     }
 
+    Scene::MemoryReport Scene::getMemoryReport() const
+    {
+        const auto& s = mSceneStats;
+        MemoryReport report;
+
+        // The categories are based on the scene stats and sum up to the total memory usage.
+        report.categories["vertices"] = s.vertexMemoryInBytes;
+        report.categories["indices"] = s.indexMemoryInBytes;
+        report.categories["geometry"] = s.geometryMemoryInBytes;
+        report.categories["animation"] = s.animationMemoryInBytes;
+        report.categories["curves"] = s.curveIndexMemoryInBytes + s.curveVertexMemoryInBytes;
+        report.categories["sdfGrids"] = s.sdfGridMemoryInBytes;
+        report.categories["materials"] = s.materials.materialMemoryInBytes;
+        report.categories["textures"] = s.materials.textureMemoryInBytes;
+        report.categories["blas"] = s.blasMemoryInBytes + s.blasScratchMemoryInBytes;
+        report.categories["tlas"] = s.tlasMemoryInBytes + s.tlasScratchMemoryInBytes;
+        report.categories["lights"] = s.lightsMemoryInBytes;
+        report.categories["envMap"] = s.envMapMemoryInBytes;
+        report.categories["lightCollection"] = s.emissiveMemoryInBytes;
+        report.categories["grids"] = s.gridVolumeMemoryInBytes + s.gridMemoryInBytes;
+
+        auto& assets = report.assets;
+
+        // Mesh vertex and index data.
+        for (size_t meshID = 0; meshID < mMeshDesc.size(); meshID++)
+        {
+            const auto& mesh = mMeshDesc[meshID];
+            uint64_t vertexSize = mesh.useCompressedVertices() ? sizeof(CompressedStaticVertexData) : sizeof(PackedStaticVertexData);
+            uint64_t indexSize = mesh.use16BitIndices() ? sizeof(uint16_t) : sizeof(uint32_t);
+            assets.push_back({ "meshes", mMeshNames[meshID], mesh.vertexCount * vertexSize + mesh.indexCount * indexSize });
+        }
+
+        // BLASes. The mesh BLASes are ordered by mesh group, followed by the BLAS for the procedural primitives.
+        for (size_t blasID = 0; blasID < mBlasData.size(); blasID++)
+        {
+            std::string name = "procedural";
+            if (blasID < mMeshGroups.size() && !mMeshGroups[blasID].meshList.empty())
+            {
+                const auto& meshList = mMeshGroups[blasID].meshList;
+                name = fmt::format("{} ({} meshes)", mMeshNames[meshList[0].get()], meshList.size());
+            }
+            assets.push_back({ "blas", name, mBlasData[blasID].blasByteSize });
+        }
+
+        for (const auto& [name, bytes] : mpMaterials->getTextureManager().getTextureMemoryUsage())
+        {
+            assets.push_back({ "textures", name, bytes });
+        }
+
+        // Grids can be shared between volumes, so each grid is only reported once.
+        std::set<const Grid*> reportedGrids;
+        for (const auto& pGridVolume : mGridVolumes)
+        {
+            for (uint32_t slot = 0; slot < (uint32_t)GridVolume::GridSlot::Count; slot++)
+            {
+                const auto& gridSequence = pGridVolume->getGridSequence((GridVolume::GridSlot)slot);
+                const char* slotName = (GridVolume::GridSlot)slot == GridVolume::GridSlot::Density ? "density" : "emission";
+                for (size_t frame = 0; frame < gridSequence.size(); frame++)
+                {
+                    const auto& pGrid = gridSequence[frame];
+                    if (!pGrid || !reportedGrids.insert(pGrid.get()).second) continue;
+                    std::string name = fmt::format("{}.{}[{}]", pGridVolume->getName(), slotName, frame);
+                    assets.push_back({ "grids", name, pGrid->getGridSizeInBytes() });
+                }
+            }
+        }
+
+        for (const auto& pSDFGrid : mSDFGrids)
+        {
+            assets.push_back({ "sdfGrids", pSDFGrid->getName(), pSDFGrid->getSize() });
+        }
+
+        std::stable_sort(assets.begin(), assets.end(), [](const auto& a, const auto& b) { return a.bytes > b.bytes; });
+
+        return report;
+    }
+
     bool Scene::updateAnimatable(Animatable& animatable, const AnimationController& controller, bool force)
     {
         NodeID nodeID = animatable.getNodeID();
@@ -2163,6 +2293,8 @@ namespace Falcor
                 << "  Unique vertex count: " << s.uniqueVertexCount << std::endl
                 << "  Instanced triangle count: " << s.instancedTriangleCount << std::endl
                 << "  Instanced vertex count: " << s.instancedVertexCount << std::endl
+                << "  Vertex cache ACMR: " << s.vertexCacheACMR << std::endl
+                << "  Vertex cache ATVR: " << s.vertexCacheATVR << std::endl
                 << "  Index  buffer memory: " << formatByteSize(s.indexMemoryInBytes) << std::endl
                 << "  Vertex buffer memory: " << formatByteSize(s.vertexMemoryInBytes) << std::endl
                 << "  Geometry data memory: " << formatByteSize(s.geometryMemoryInBytes) << std::endl
@@ -2691,22 +2823,23 @@ namespace Falcor
 
     void Scene::createDrawList()
     {
-        if (!mpMeshVao)
+        if (!mpMeshVao && !mpMeshCompressedVao)
             return;
 
         // This function creates argument buffers for draw indirect calls to rasterize the scene.
         // The updateGeometryInstances() function must have been called before so that the flags are accurate.
         //
-        // Note that we create four draw buffers to handle all combinations of:
+        // Note that we create up to eight draw buffers to handle all combinations of:
         // 1) mesh is using 16- or 32-bit indices,
-        // 2) mesh triangle winding is CW or CCW after transformation.
+        // 2) mesh triangle winding is CW or CCW after transformation,
+        // 3) mesh is using packed or compressed vertices.
         //
         // TODO: Update the draw args if a mesh undergoes animation that flips the winding.
 
         mDrawArgs.clear();
 
         // Helper to create the draw-indirect buffer.
-        auto createDrawBuffer = [this](const auto& drawMeshes, bool ccw, ResourceFormat ibFormat = ResourceFormat::Unknown)
+        auto createDrawBuffer = [this](const auto& drawMeshes, bool ccw, bool compressed, ResourceFormat ibFormat = ResourceFormat::Unknown)
         {
             if (drawMeshes.size() > 0)
             {
@@ -2717,13 +2850,15 @@ namespace Falcor
                 draw.count = (uint32_t)drawMeshes.size();
                 draw.ccw = ccw;
                 draw.ibFormat = ibFormat;
+                draw.compressed = compressed;
                 mDrawArgs.push_back(draw);
             }
         };
 
         if (hasIndexBuffer())
         {
-            std::vector<DrawIndexedArguments> drawClockwiseMeshes[2], drawCounterClockwiseMeshes[2];
+            // Draw lists are indexed by 2 * compressed + (use16Bit ? 0 : 1).
+            std::vector<DrawIndexedArguments> drawClockwiseMeshes[4], drawCounterClockwiseMeshes[4];
 
             uint32_t instanceID = 0;
             for (const auto& instance : mGeometryInstanceData)
@@ -2740,18 +2875,22 @@ namespace Falcor
                 draw.BaseVertexLocation = mesh.vbOffset;
                 draw.StartInstanceLocation = instanceID++;
 
-                int i = use16Bit ? 0 : 1;
+                int i = (mesh.useCompressedVertices() ? 2 : 0) + (use16Bit ? 0 : 1);
                 (instance.isWorldFrontFaceCW()) ? drawClockwiseMeshes[i].push_back(draw) : drawCounterClockwiseMeshes[i].push_back(draw);
             }
 
-            createDrawBuffer(drawClockwiseMeshes[0], false, ResourceFormat::R16Uint);
-            createDrawBuffer(drawClockwiseMeshes[1], false, ResourceFormat::R32Uint);
-            createDrawBuffer(drawCounterClockwiseMeshes[0], true, ResourceFormat::R16Uint);
-            createDrawBuffer(drawCounterClockwiseMeshes[1], true, ResourceFormat::R32Uint);
+            for (int i = 0; i < 4; i++)
+            {
+                const bool compressed = i >= 2;
+                const ResourceFormat ibFormat = (i & 1) == 0 ? ResourceFormat::R16Uint : ResourceFormat::R32Uint;
+                createDrawBuffer(drawClockwiseMeshes[i], false, compressed, ibFormat);
+                createDrawBuffer(drawCounterClockwiseMeshes[i], true, compressed, ibFormat);
+            }
         }
         else
         {
-            std::vector<DrawArguments> drawClockwiseMeshes, drawCounterClockwiseMeshes;
+            // Draw lists are indexed by compressed.
+            std::vector<DrawArguments> drawClockwiseMeshes[2], drawCounterClockwiseMeshes[2];
 
             uint32_t instanceID = 0;
             for (const auto& instance : mGeometryInstanceData)
@@ -2767,11 +2906,15 @@ namespace Falcor
                 draw.StartVertexLocation = mesh.vbOffset;
                 draw.StartInstanceLocation = instanceID++;
 
-                (instance.isWorldFrontFaceCW()) ? drawClockwiseMeshes.push_back(draw) : drawCounterClockwiseMeshes.push_back(draw);
+                int i = mesh.useCompressedVertices() ? 1 : 0;
+                (instance.isWorldFrontFaceCW()) ? drawClockwiseMeshes[i].push_back(draw) : drawCounterClockwiseMeshes[i].push_back(draw);
             }
 
-            createDrawBuffer(drawClockwiseMeshes, false);
-            createDrawBuffer(drawCounterClockwiseMeshes, true);
+            for (int i = 0; i < 2; i++)
+            {
+                createDrawBuffer(drawClockwiseMeshes[i], false, i == 1);
+                createDrawBuffer(drawCounterClockwiseMeshes[i], true, i == 1);
+            }
         }
     }
 
@@ -2818,6 +2961,38 @@ namespace Falcor
                 return mpBlasStaticWorldMatrices;
             };
 
+            // Meshes with compressed vertices store positions relative to their bounds. The BLAS build dequantizes them
+            // using a per-mesh transform, which is composed with the world transform for pre-transformed static meshes.
+            // The matrices use the same layout as getStaticMatricesBuffer() and are indexed by mesh ID.
+            auto getCompressedVertexTransformsBuffer = [&]()
+            {
+                if (!mpBlasCompressedVertexTransforms)
+                {
+                    std::vector<float4x4> transposedMatrices(mMeshDesc.size(), float4x4::identity());
+                    for (const auto& meshGroup : mMeshGroups)
+                    {
+                        for (const MeshID meshID : meshGroup.meshList)
+                        {
+                            if (!mMeshDesc[meshID.get()].useCompressedVertices()) continue;
+                            const VertexQuantization& q = mMeshVertexQuantization[meshID.get()];
+                            float4x4 m = mul(math::matrixFromTranslation(q.center), math::matrixFromScaling(q.halfExtent));
+                            if (meshGroup.isStatic)
+                            {
+                                uint32_t matrixID = mGeometryInstanceData[mMeshIdToInstanceIds[meshID.get()][0]].globalMatrixID;
+                                m = mul(globalMatrices[matrixID], m);
+                            }
+                            transposedMatrices[meshID.get()] = transpose(m);
+                        }
+                    }
+
+                    uint32_t float4Count = (uint32_t)transposedMatrices.size() * 4;
+                    mpBlasCompressedVertexTransforms = mpDevice->createStructuredBuffer(sizeof(float4), float4Count, ResourceBindFlags::ShaderResource, MemoryType::DeviceLocal, transposedMatrices.data(), false);
+                    mpBlasCompressedVertexTransforms->setName("Scene::mpBlasCompressedVertexTransforms");
+                    pRenderContext->resourceBarrier(mpBlasCompressedVertexTransforms.get(), Resource::State::NonPixelShader);
+                }
+                return mpBlasCompressedVertexTransforms;
+            };
+
             // Iterate over the mesh groups. One BLAS will be created for each group.
             // Each BLAS may contain multiple geometries.
             for (size_t i = 0; i < mMeshGroups.size(); i++)
@@ -2873,10 +3048,21 @@ namespace Falcor
                         desc.flags = pMaterial->isOpaque() ? RtGeometryFlags::Opaque : RtGeometryFlags::None;
 
                         // Set the position data
-                        desc.content.triangles.vertexData = mMeshStaticData.getGpuAddress(mesh.vbOffset);
-                        desc.content.triangles.vertexStride = sizeof(PackedStaticVertexData);
+                        if (mesh.useCompressedVertices())
+                        {
+                            // The snorm16 positions are fetched directly and dequantized by the transform (the w component is ignored).
+                            desc.content.triangles.transform3x4 = getCompressedVertexTransformsBuffer()->getGpuAddress() + meshID.get() * 64ull;
+                            desc.content.triangles.vertexData = mpMeshCompressedStaticBuffer->getGpuAddress() + mesh.vbOffset * sizeof(CompressedStaticVertexData);
+                            desc.content.triangles.vertexStride = sizeof(CompressedStaticVertexData);
+                            desc.content.triangles.vertexFormat = ResourceFormat::RGBA16Snorm;
+                        }
+                        else
+                        {
+                            desc.content.triangles.vertexData = mMeshStaticData.getGpuAddress(mesh.vbOffset);
+                            desc.content.triangles.vertexStride = sizeof(PackedStaticVertexData);
+                            desc.content.triangles.vertexFormat = ResourceFormat::RGB32Float;
+                        }
                         desc.content.triangles.vertexCount = mesh.vertexCount;
-                        desc.content.triangles.vertexFormat = ResourceFormat::RGB32Float;
 
                         // Set index data
                         if (!mMeshIndexData.empty())
@@ -3191,6 +3377,8 @@ namespace Falcor
             if (pVb)
                 pRenderContext->resourceBarrier(pVb.get(), Resource::State::NonPixelShader);
         }
+        if (mpMeshCompressedStaticBuffer)
+            pRenderContext->resourceBarrier(mpMeshCompressedStaticBuffer.get(), Resource::State::NonPixelShader);
 
         for (size_t i = 0; i < mMeshIndexData.getBufferCount(); ++i)
         {
@@ -4063,11 +4251,13 @@ namespace Falcor
 
         // Bind variables.
         auto var = mpLoadMeshPass->getRootVar()["meshLoader"];
+        var["meshID"] = meshID.get();
         var["vertexCount"] = meshDesc.vertexCount;
         var["vbOffset"] = meshDesc.vbOffset;
         var["triangleCount"] = meshDesc.getTriangleCount();
         var["ibOffset"] = meshDesc.ibOffset;
         var["use16BitIndices"] = meshDesc.use16BitIndices();
+        var["useCompressedVertices"] = meshDesc.useCompressedVertices();
         bindShaderData(var["scene"]);
         for (const auto& name : kMeshLoaderRequiredBufferNames)
         {
@@ -4083,6 +4273,7 @@ namespace Falcor
         if (!mpUpdateMeshPass)
             mpUpdateMeshPass = ComputePass::create(mpDevice, kMeshIOShaderFilename, "setMeshVertices", getSceneDefines());
         const auto& meshDesc = getMesh(meshID);
+        FALCOR_CHECK(!meshDesc.useCompressedVertices(), "Mesh {} uses compressed vertices and cannot be updated.", meshID.get());
 
         // Bind variables.
         auto var = mpUpdateMeshPass->getRootVar()["meshUpdater"];
@@ -4101,6 +4292,29 @@ namespace Falcor
         updateForInverseRendering(mpDevice->getRenderContext(), false, true);
     }
 
+    inline pybind11::dict toPython(const Scene::MemoryReport& report)
+    {
+        pybind11::dict d;
+        d["total"] = report.getTotal();
+
+        pybind11::dict categories;
+        for (const auto& [name, bytes] : report.categories) categories[name.c_str()] = bytes;
+        d["categories"] = categories;
+
+        pybind11::list assets;
+        for (const auto& asset : report.assets)
+        {
+            pybind11::dict a;
+            a["category"] = asset.category;
+            a["name"] = asset.name;
+            a["bytes"] = asset.bytes;
+            assets.append(a);
+        }
+        d["assets"] = assets;
+
+        return d;
+    }
+
     inline pybind11::dict toPython(const Scene::SceneStats& stats)
     {
         pybind11::dict d;
@@ -4114,6 +4328,8 @@ namespace Falcor
         d["uniqueVertexCount"] = stats.uniqueVertexCount;
         d["instancedTriangleCount"] = stats.instancedTriangleCount;
         d["instancedVertexCount"] = stats.instancedVertexCount;
+        d["vertexCacheACMR"] = stats.vertexCacheACMR;
+        d["vertexCacheATVR"] = stats.vertexCacheATVR;
         d["indexMemoryInBytes"] = stats.indexMemoryInBytes;
         d["vertexMemoryInBytes"] = stats.vertexMemoryInBytes;
         d["geometryMemoryInBytes"] = stats.geometryMemoryInBytes;
@@ -4343,6 +4559,7 @@ namespace Falcor
             }, "minPoint"_a, "maxPoint"_a);
         scene.def("getGeometryUVTiles", &Scene::getGeometryUVTiles, "geometryID"_a);
         scene.def_property_readonly("memory_usage", &Scene::getMemoryUsageInBytes);
+        scene.def_property_readonly("memory_report", [](const Scene* pScene) { return toPython(pScene->getMemoryReport()); });
 
         // Materials
         scene.def_property_readonly(kMaterials.c_str(), &Scene::getMaterials);
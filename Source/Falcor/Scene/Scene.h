@@ -48,6 +48,7 @@
 #include "Core/Object.h"
 #include "Core/API/VAO.h"
 #include "Core/API/RtAccelerationStructure.h"
+#include "Utils/Geometry/MeshOptimizer.h"
 #include "Utils/Math/AABB.h"
 #include "Utils/Math/Rectangle.h"
 #include "Utils/Math/Vector.h"
@@ -59,6 +60,7 @@
 #include <sigs/sigs.h>
 
 #include <functional>
+#include <map>
 #include <memory>
 #include <type_traits>
 #include <optional>
@@ -272,11 +274,16 @@ namespace Falcor
             bool has16BitIndices = false;                           ///< True if 16-bit mesh indices are used.
             bool has32BitIndices = false;                           ///< True if 32-bit mesh indices are used.
             uint32_t meshDrawCount = 0;                             ///< Number of meshes to draw.
+            VertexCacheStats vertexCacheStats;                      ///< Post-transform vertex cache statistics of all unique meshes.
 
             /// Vertex indices for all meshes in either 32-bit or 16-bit format packed tightly, decided per mesh.
             SplitIndexBuffer meshIndexData;
             /// Vertex attributes for all meshes in packed format.
             SplitVertexBuffer meshStaticData;
+            /// Vertex attributes for static meshes in compressed format, see CompressedStaticVertexData.
+            std::vector<CompressedStaticVertexData> meshCompressedStaticData;
+            /// Position quantization per mesh, indexed by mesh ID. Only valid for meshes with compressed vertices.
+            std::vector<VertexQuantization> meshVertexQuantization;
             /// Additional vertex attributes for skinned meshes.
             std::vector<SkinningVertexData> meshSkinningData;
 
@@ -313,6 +320,8 @@ namespace Falcor
             uint64_t uniqueVertexCount = 0;             ///< Number of unique vertices. A vertex can be referenced by multiple triangles/instances.
             uint64_t instancedTriangleCount = 0;        ///< Number of instanced triangles. This is the total number of rendered triangles.
             uint64_t instancedVertexCount = 0;          ///< Number of instanced vertices. This is the total number of vertices in the rendered triangles.
+            float vertexCacheACMR = 0.f;                ///< Vertex cache ACMR (transformed vertices per triangle) of all unique meshes, simulated for a 16-entry FIFO. Zero unless built with SceneBuilder::Flags::OptimizeVertexCache.
+            float vertexCacheATVR = 0.f;                ///< Vertex cache ATVR (transforms per vertex) of all unique meshes, simulated for a 16-entry FIFO. Zero unless built with SceneBuilder::Flags::OptimizeVertexCache.
             uint64_t indexMemoryInBytes = 0;            ///< Total memory in bytes used by the index buffer.
             uint64_t vertexMemoryInBytes = 0;           ///< Total memory in bytes used by the vertex buffer.
             uint64_t geometryMemoryInBytes = 0;         ///< Total memory in bytes used by the geometry data (meshes, curves, custom primitives, instances etc.).
@@ -387,6 +396,30 @@ namespace Falcor
             }
         };
 
+        /** Report of the GPU memory used by the scene per resource category and per asset.
+        */
+        struct MemoryReport
+        {
+            struct Asset
+            {
+                std::string category;                   ///< Category of the asset ("meshes", "blas", "textures", "grids" or "sdfGrids").
+                std::string name;                       ///< Asset name or source path.
+                uint64_t bytes = 0;                     ///< Memory in bytes used by the asset.
+            };
+
+            std::map<std::string, uint64_t> categories; ///< Memory in bytes per resource category. The categories sum up to the total memory usage.
+            std::vector<Asset> assets;                  ///< Memory in bytes per asset, sorted by size in descending order.
+
+            /** Get the total memory usage in bytes.
+            */
+            uint64_t getTotal() const
+            {
+                uint64_t total = 0;
+                for (const auto& [name, bytes] : categories) total += bytes;
+                return total;
+            }
+        };
+
         /** Return list of file extensions filters for all supported file formats.
         */
         static const FileDialogFilterVec& getFileExtensionFilters();
@@ -960,6 +993,15 @@ namespace Falcor
         */
         const ref<Vao>& getMeshVao16() const { return mpMeshVao16Bit; }
 
+        /** Get the scene's VAOs for meshes with compressed vertices.
+            \param[in] use16BitIndices Return the VAO for 16-bit vertex indices.
+            \return VAO object or nullptr if no meshes use compressed vertices.
+        */
+        const ref<Vao>& getMeshCompressedVao(bool use16BitIndices = false) const
+        {
+            return use16BitIndices ? mpMeshCompressedVao16Bit : mpMeshCompressedVao;
+        }
+
         /** Get the scene's VAO for curves.
         */
         const ref<Vao>& getCurveVao() const { return mpCurveVao; }
@@ -1064,6 +1106,14 @@ namespace Falcor
 
         uint64_t getMemoryUsageInBytes() const { return getSceneStats().getTotalMemory(); }
 
+        /** Get a report of the GPU memory used by the scene.
+            The report is computed when called, from the sizes of the GPU resources the scene currently holds (the same sizes as the scene statistics).
+            Resources that were replaced or freed after creation, e.g. rebuilt acceleration structures or unloaded textures, are therefore not counted.
+            BLAS/TLAS memory is only included after the acceleration structures are built.
+            \return Memory usage per resource category and per asset.
+        */
+        MemoryReport getMemoryReport() const;
+
         /** Allows connecting to signal that signals IScene::UpdateFlags when they are changed.
          */
         UpdateFlagsSignal::Interface getUpdateFlagsSignal() override { return mUpdateFlagsSignal.getInterface(); }
@@ -1182,6 +1232,7 @@ namespace Falcor
         /** Check whether scene has an index buffer.
         */
         bool hasIndexBuffer() const { return !mMeshIndexData.empty(); }
+        bool hasCompressedVertices() const { return !mMeshCompressedStaticData.empty(); }
 
         /** Initialize all cameras in the scene through the animation controller using their corresponding scene graph nodes.
         */
@@ -1233,6 +1284,7 @@ namespace Falcor
             uint32_t count = 0;             ///< Number of draws.
             bool ccw = true;                ///< True if counterclockwise triangle winding.
             ResourceFormat ibFormat = ResourceFormat::Unknown;  ///< Index buffer format.
+            bool compressed = false;        ///< True if the meshes use compressed vertices.
         };
 
         GeometryTypeFlags mGeometryTypes;                           ///< Set of geometry types that exist in the scene.
@@ -1242,9 +1294,12 @@ namespace Falcor
         bool mUseCompressedHitInfo = false;                         ///< True if scene should used compressed HitInfo (on scenes with triangles meshes only).
         bool mHas16BitIndices = false;                              ///< True if any meshes use 16-bit indices.
         bool mHas32BitIndices = false;                              ///< True if any meshes use 32-bit indices.
+        VertexCacheStats mVertexCacheStats;                         ///< Post-transform vertex cache statistics of all unique meshes.
 
         ref<Vao> mpMeshVao;                               ///< Vertex array object for the global mesh vertex/index buffers.
         ref<Vao> mpMeshVao16Bit;                          ///< VAO for drawing meshes with 16-bit vertex indices.
+        ref<Vao> mpMeshCompressedVao;                     ///< VAO for drawing meshes with compressed vertices.
+        ref<Vao> mpMeshCompressedVao16Bit;                ///< VAO for drawing meshes with compressed vertices and 16-bit vertex indices.
         ref<Vao> mpCurveVao;                                        ///< Vertex array object for the global curve vertex/index buffers.
         std::vector<DrawArgs> mDrawArgs;                            ///< List of draw arguments for rasterizing the meshes in the scene.
 
@@ -1429,6 +1484,7 @@ namespace Falcor
         std::vector<BlasGroup> mBlasGroups;                 ///< BLAS group data.
         ref<Buffer> mpBlasScratch;                          ///< Scratch buffer used for BLAS builds.
         ref<Buffer> mpBlasStaticWorldMatrices;              ///< Object-to-world transform matrices in row-major format. Only valid for static meshes.
+        ref<Buffer> mpBlasCompressedVertexTransforms;       ///< Dequantization transforms for meshes with compressed vertices, indexed by mesh ID.
         bool mBlasDataValid = false;                        ///< Flag to indicate if the BLAS data is valid. This will be reset when geometry is changed.
         bool mRebuildBlas = true;                           ///< Flag to indicate BLASes need to be rebuilt.
 
@@ -1440,6 +1496,11 @@ namespace Falcor
         SplitIndexBuffer mMeshIndexData;
         SplitVertexBuffer mMeshStaticData;
 
+        std::vector<CompressedStaticVertexData> mMeshCompressedStaticData;  ///< Compressed vertices of static meshes (CPU copy).
+        std::vector<VertexQuantization> mMeshVertexQuantization;            ///< Position quantization per mesh.
+        ref<Buffer> mpMeshCompressedStaticBuffer;                           ///< GPU buffer of compressed vertices.
+        ref<Buffer> mpMeshVertexQuantizationBuffer;                         ///< GPU buffer of position quantization per mesh.
+
         UpdateFlagsSignal mUpdateFlagsSignal;
     public:
         SplitVertexBuffer& getMeshStaticData()
@@ -33,28 +33,119 @@
 #include "Utils/Logger.h"
 #include "Utils/Math/Common.h"
 #include "Utils/Image/TextureAnalyzer.h"
+#include "Utils/Geometry/MeshOptimizer.h"
 #include "Utils/Timing/TimeReport.h"
 #include "Utils/Scripting/ScriptBindings.h"
 #include "Utils/Math/MathHelpers.h"
+#include "Utils/Math/FNVHash.h"
 #include "Utils/ObjectIDPython.h"
 #include "Utils/NumericRange.h"
+#include "Utils/StringUtils.h"
 #include <mikktspace.h>
 #include <filesystem>
 #include <cmath>
+#include <array>
+#include <atomic>
 #include <execution>
+#include <numeric>
+#include <unordered_map>
 
 namespace Falcor
 {
     namespace
     {
-        // Large mesh groups are split in order to reduce the size of the largest BLAS.
-        // The target is max 16M triangles per BLAS (= approx 0.5GB post-compaction). Note that this is not a strict limit.
-        const size_t kMaxTrianglesPerBLAS = 1ull << 24;
+        // Number of bins per axis used for evaluating split candidates in the SAH mesh group splitter.
+        const size_t kSAHBinCount = 32;
+
+        // Number of faces per chunk when generating tangents for large meshes in parallel.
+        const uint32_t kTangentChunkFaceCount = 1 << 16;
 
         // Texture coordinates for textured emissive materials are quantized for performance reasons.
         // We'll log a warning if the maximum quantization error exceeds this value.
         const float kMaxTexelError = 0.5f;
 
+        // Maximum texture coordinate error for storing a mesh in compressed vertex format.
+        // Textures may not be loaded at this point, so the tolerance is in texture space rather than texels.
+        const float kMaxCompressedTexCrdError = 1.f / 4096.f;
+
+        // Rough estimate of the BLAS memory per triangle used for checking the scene memory budget.
+        // The actual size depends on the driver and on whether the BLAS is compacted.
+        const uint64_t kEstimatedBLASBytesPerTriangle = 64;
+
+        // Maximum number of meshes per bucket that are tested for rigid transform equivalence when instancing duplicate meshes.
+        // This bounds the cost for large buckets of meshes that share topology and texture coordinates but are not duplicates.
+        const size_t kMaxRigidCandidatesPerBucket = 64;
+
+        // Position tolerance relative to the mesh extent and absolute normal/tangent tolerance for rigid transform equivalence.
+        const float kRigidPositionTolerance = 1e-5f;
+        const float kRigidDirectionTolerance = 1e-3f;
+
+        /** Find a rigid transform (rotation and translation) that maps the source vertices onto the destination vertices.
+            The transform is fitted to three reference vertices and then verified against all vertices.
+            \param[in] src Source vertices.
+            \param[in] dst Destination vertices. Must have the same number of vertices as the source.
+            \param[out] transform Transform from source to destination space. Only valid if the function returns true.
+            \return True if the destination vertices are a rigid transform of the source vertices.
+        */
+        bool findRigidTransform(const std::vector<StaticVertexData>& src, const std::vector<StaticVertexData>& dst, float4x4& transform)
+        {
+            FALCOR_ASSERT(src.size() == dst.size());
+            if (src.size() < 3) return false;
+
+            // Pick the first vertex, the vertex farthest from it, and the vertex farthest from the line through both.
+            const float3 p0 = src[0].position;
+            size_t i1 = 0;
+            float extent = 0.f;
+            for (size_t i = 1; i < src.size(); i++)
+            {
+                float d = length(src[i].position - p0);
+                if (d > extent) { extent = d; i1 = i; }
+            }
+            if (!(extent > 0.f)) return false;
+
+            const float3 axis = (src[i1].position - p0) / extent;
+            size_t i2 = 0;
+            float maxDist = 0.f;
+            for (size_t i = 1; i < src.size(); i++)
+            {
+                float3 v = src[i].position - p0;
+                float d = length(v - dot(v, axis) * axis);
+                if (d > maxDist) { maxDist = d; i2 = i; }
+            }
+            if (!(maxDist > 1e-3f * extent)) return false;
+
+            // Build orthonormal frames from the reference vertices and compute the rotation between them.
+            auto computeFrame = [&](const std::vector<StaticVertexData>& vertices)
+            {
+                float3 e0 = normalize(vertices[i1].position - vertices[0].position);
+                float3 e1 = vertices[i2].position - vertices[0].position;
+                e1 = normalize(e1 - dot(e1, e0) * e0);
+                float3x3 frame;
+                frame.setCol(0, e0);
+                frame.setCol(1, e1);
+                frame.setCol(2, cross(e0, e1));
+                return frame;
+            };
+
+            const float3x3 rotation = mul(computeFrame(dst), transpose(computeFrame(src)));
+            const float3 translation = dst[0].position - mul(rotation, p0);
+
+            // Verify that the transform maps all vertices within tolerance.
+            for (size_t i = 0; i < src.size(); i++)
+            {
+                const auto& s = src[i];
+                const auto& d = dst[i];
+                float tolerance = kRigidPositionTolerance * std::max(extent, length(d.position));
+                if (length(mul(rotation, s.position) + translation - d.position) > tolerance) return false;
+                if (length(mul(rotation, s.normal) - d.normal) > kRigidDirectionTolerance) return false;
+                if (length(mul(rotation, s.tangent.xyz()) - d.tangent.xyz()) > kRigidDirectionTolerance) return false;
+            }
+
+            transform = float4x4::identity();
+            for (int r = 0; r < 3; r++) transform[r] = float4(rotation[r], translation[r]);
+            return true;
+        }
+
         int largestAxis(const float3& v)
         {
             if (v.x >= v.y && v.x >= v.z) return 0;
@@ -65,7 +156,7 @@ namespace Falcor
         class MikkTSpaceWrapper
         {
         public:
-            static std::vector<float4> generateTangents(const SceneBuilder::Mesh& mesh)
+            static std::vector<float4> generateTangents(const SceneBuilder::Mesh& mesh, bool parallel)
             {
                 if (!mesh.normals.pData || !mesh.positions.pData || !mesh.texCrds.pData || !mesh.pIndices)
                 {
@@ -73,6 +164,154 @@ namespace Falcor
                     return {};
                 }
 
+                if (!parallel || mesh.faceCount < 2 * kTangentChunkFaceCount)
+                {
+                    std::vector<float4> tangents;
+                    if (!generateTangents(mesh, {}, tangents))
+                    {
+                        FALCOR_THROW("MikkTSpace failed to generate tangents for the mesh '{}'.", mesh.name);
+                    }
+                    return tangents;
+                }
+
+                // MikkTSpace welds vertices with identical position, normal and texture coordinate, and the tangent of a face
+                // vertex only depends on the faces sharing its welded vertex. We split the mesh into spatially coherent chunks
+                // and extend each chunk by all faces sharing a vertex with it. Running MikkTSpace on the extended chunk with
+                // the faces in mesh order then produces the same tangents for the faces of the chunk as for the whole mesh.
+
+                // Weld vertices by hashing their attributes. Vertices with equal hashes are treated as welded, which may
+                // conservatively extend the chunks on hash collisions, but never changes the result.
+                const bool perVertex = mesh.positions.frequency == SceneBuilder::Mesh::AttributeFrequency::Vertex &&
+                    mesh.normals.frequency == SceneBuilder::Mesh::AttributeFrequency::Vertex &&
+                    mesh.texCrds.frequency == SceneBuilder::Mesh::AttributeFrequency::Vertex;
+                const uint32_t keyCount = perVertex ? mesh.vertexCount : mesh.indexCount;
+                auto getKey = [&](uint32_t face, uint32_t vert) { return perVertex ? mesh.pIndices[face * 3 + vert] : face * 3 + vert; };
+
+                std::vector<std::pair<uint64_t, uint32_t>> keys(keyCount);
+                auto keyRange = NumericRange<uint32_t>(0, keyCount);
+                std::for_each(std::execution::par, keyRange.begin(), keyRange.end(), [&](uint32_t key)
+                {
+                    float3 position = perVertex ? mesh.get(mesh.positions, key) : mesh.getPosition(key / 3, key % 3);
+                    float3 normal = perVertex ? mesh.get(mesh.normals, key) : mesh.getNormal(key / 3, key % 3);
+                    float2 texCrd = perVertex ? mesh.get(mesh.texCrds, key) : mesh.getTexCrd(key / 3, key % 3);
+
+                    // Adding zero maps negative zeros to positive zeros, as MikkTSpace compares the values as floats.
+                    FNVHash64 hash;
+                    hash.insert(position + 0.f);
+                    hash.insert(normal + 0.f);
+                    hash.insert(texCrd + 0.f);
+                    keys[key] = { hash.get(), key };
+                });
+                std::sort(std::execution::par, keys.begin(), keys.end());
+
+                std::vector<uint32_t> weldIDs(keyCount);
+                uint32_t weldCount = 0;
+                for (uint32_t i = 0; i < keyCount; i++)
+                {
+                    if (i == 0 || keys[i].first != keys[i - 1].first) weldCount++;
+                    weldIDs[keys[i].second] = weldCount - 1;
+                }
+                keys = {};
+
+                // Build the lists of faces sharing each welded vertex.
+                std::vector<uint32_t> faceOffsets(weldCount + 1, 0);
+                for (uint32_t face = 0; face < mesh.faceCount; face++)
+                {
+                    for (uint32_t vert = 0; vert < 3; vert++) faceOffsets[weldIDs[getKey(face, vert)] + 1]++;
+                }
+                std::partial_sum(faceOffsets.begin(), faceOffsets.end(), faceOffsets.begin());
+
+                std::vector<uint32_t> adjacentFaces(mesh.indexCount);
+                std::vector<uint32_t> cursors(faceOffsets.begin(), faceOffsets.end() - 1);
+                for (uint32_t face = 0; face < mesh.faceCount; face++)
+                {
+                    for (uint32_t vert = 0; vert < 3; vert++) adjacentFaces[cursors[weldIDs[getKey(face, vert)]]++] = face;
+                }
+                cursors = {};
+
+                // Sort the faces by the Morton code of their centroid to keep the chunks compact independent of the face order.
+                AABB bounds;
+                for (uint32_t face = 0; face < mesh.faceCount; face++) bounds.include(mesh.getPosition(face, 0));
+                const float3 scale = 1023.f / max(bounds.extent(), float3(1e-20f));
+
+                auto spreadBits = [](uint32_t v)
+                {
+                    v = (v * 0x00010001u) & 0xFF0000FFu;
+                    v = (v * 0x00000101u) & 0x0F00F00Fu;
+                    v = (v * 0x00000011u) & 0xC30C30C3u;
+                    v = (v * 0x00000005u) & 0x49249249u;
+                    return v;
+                };
+
+                std::vector<std::pair<uint32_t, uint32_t>> sortedFaces(mesh.faceCount);
+                auto faceRange = NumericRange<uint32_t>(0, mesh.faceCount);
+                std::for_each(std::execution::par, faceRange.begin(), faceRange.end(), [&](uint32_t face)
+                {
+                    float3 centroid = (mesh.getPosition(face, 0) + mesh.getPosition(face, 1) + mesh.getPosition(face, 2)) / 3.f;
+                    uint3 cell = uint3(clamp((centroid - bounds.minPoint) * scale, float3(0.f), float3(1023.f)));
+                    sortedFaces[face] = { spreadBits(cell.x) | (spreadBits(cell.y) << 1) | (spreadBits(cell.z) << 2), face };
+                });
+                std::sort(std::execution::par, sortedFaces.begin(), sortedFaces.end());
+
+                // Generate tangents for the chunks in parallel.
+                std::vector<float4> tangents(mesh.indexCount);
+                std::atomic<bool> success = true;
+                const uint32_t chunkCount = div_round_up(mesh.faceCount, kTangentChunkFaceCount);
+
+                auto chunkRange = NumericRange<uint32_t>(0, chunkCount);
+                std::for_each(std::execution::par, chunkRange.begin(), chunkRange.end(), [&](uint32_t chunk)
+                {
+                    const uint32_t begin = chunk * kTangentChunkFaceCount;
+                    const uint32_t end = std::min(begin + kTangentChunkFaceCount, mesh.faceCount);
+
+                    // Collect the faces of the chunk and all faces sharing a vertex with them in mesh order.
+                    std::vector<uint32_t> faces;
+                    for (uint32_t i = begin; i < end; i++)
+                    {
+                        uint32_t face = sortedFaces[i].second;
+                        for (uint32_t vert = 0; vert < 3; vert++)
+                        {
+                            uint32_t weldID = weldIDs[getKey(face, vert)];
+                            auto adjacent = adjacentFaces.begin();
+                            faces.insert(faces.end(), adjacent + faceOffsets[weldID], adjacent + faceOffsets[weldID + 1]);
+                        }
+                    }
+                    std::sort(faces.begin(), faces.end());
+                    faces.erase(std::unique(faces.begin(), faces.end()), faces.end());
+
+                    std::vector<float4> chunkTangents;
+                    if (!generateTangents(mesh, faces, chunkTangents))
+                    {
+                        success = false;
+                        return;
+                    }
+
+                    // Copy the tangents of the faces of the chunk.
+                    for (uint32_t i = begin; i < end; i++)
+                    {
+                        uint32_t face = sortedFaces[i].second;
+                        size_t index = std::lower_bound(faces.begin(), faces.end(), face) - faces.begin();
+                        std::copy_n(chunkTangents.begin() + index * 3, 3, tangents.begin() + face * 3);
+                    }
+                });
+
+                if (!success)
+                {
+                    FALCOR_THROW("MikkTSpace failed to generate tangents for the mesh '{}'.", mesh.name);
+                }
+
+                return tangents;
+            }
+
+        private:
+            /** Run MikkTSpace on a subset of the faces of a mesh.
+                \param[in] mesh The mesh.
+                \param[in] faces Sorted list of mesh faces to process, or empty to process all faces.
+                \param[out] tangents Tangents for the face vertices of the processed faces.
+                \return True if successful.
+            */
+            static bool generateTangents(const SceneBuilder::Mesh& mesh, std::vector<uint32_t> faces, std::vector<float4>& tangents)
+            {
                 // Generate new tangent space.
                 SMikkTSpaceInterface mikktspace = {};
                 mikktspace.m_getNumFaces = [](const SMikkTSpaceContext* pContext) { return ((MikkTSpaceWrapper*)(pContext->m_pUserData))->getFaceCount(); };
@@ -82,65 +321,41 @@ namespace Falcor
                 mikktspace.m_getTexCoord = [](const SMikkTSpaceContext* pContext, float texCrd[], int32_t face, int32_t vert) { ((MikkTSpaceWrapper*)(pContext->m_pUserData))->getTexCrd(texCrd, face, vert); };
                 mikktspace.m_setTSpaceBasic = [](const SMikkTSpaceContext* pContext, const float tangent[], float sign, int32_t face, int32_t vert) { ((MikkTSpaceWrapper*)(pContext->m_pUserData))->setTangent(tangent, sign, face, vert); };
 
-                MikkTSpaceWrapper wrapper(mesh);
+                MikkTSpaceWrapper wrapper(mesh, std::move(faces));
                 SMikkTSpaceContext context = {};
                 context.m_pInterface = &mikktspace;
                 context.m_pUserData = &wrapper;
 
-                if (genTangSpaceDefault(&context) == false)
-                {
-                    FALCOR_THROW("MikkTSpace failed to generate tangents for the mesh '{}'.", mesh.name);
-                }
+                if (genTangSpaceDefault(&context) == false) return false;
 
-                return wrapper.mTangents;
+                tangents = std::move(wrapper.mTangents);
+                return true;
             }
 
-        private:
-            MikkTSpaceWrapper(const SceneBuilder::Mesh& mesh)
+            MikkTSpaceWrapper(const SceneBuilder::Mesh& mesh, std::vector<uint32_t> faces)
                 : mMesh(mesh)
+                , mFaces(std::move(faces))
             {
                 FALCOR_ASSERT(mesh.indexCount > 0);
-                mTangents.resize(mesh.indexCount, float4(0));
-
                 FALCOR_ASSERT_EQ(mesh.indexCount, mMesh.faceCount * 3);
-                mPositions.resize(mMesh.faceCount * 3);
-                switch (mMesh.positions.frequency)
-                {
-                case SceneBuilder::Mesh::AttributeFrequency::Constant:
-                {
-                    std::fill_n(mPositions.begin(), mPositions.size(), mMesh.positions.pData[0]);
-                    break;
-                }
-                case SceneBuilder::Mesh::AttributeFrequency::Uniform:
-                {
-                    for (uint32_t i = 0; i < mMesh.faceCount; ++i)
-                        std::fill_n(mPositions.begin() + i * 3, 3, mMesh.positions.pData[i]);
-                    break;
-                }
-                case SceneBuilder::Mesh::AttributeFrequency::Vertex:
-                {
-                    FALCOR_ASSERT_EQ(mesh.indexCount, mPositions.size());
-                    for (size_t fvarIdx = 0; fvarIdx < mPositions.size(); ++fvarIdx)
-                        mPositions[fvarIdx] = mMesh.positions.pData[mMesh.pIndices[fvarIdx]];
-                    break;
-                }
-                case SceneBuilder::Mesh::AttributeFrequency::FaceVarying:
+                mTangents.resize(getFaceCount() * 3, float4(0));
+
+                mPositions.resize(getFaceCount() * 3);
+                for (int32_t face = 0; face < getFaceCount(); ++face)
                 {
-                    memcpy(mPositions.data(), mMesh.positions.pData, mPositions.size() * sizeof(float3));
-                    break;
-                }
-                default:
-                    FALCOR_UNREACHABLE();
+                    for (uint32_t vert = 0; vert < 3; ++vert)
+                        mPositions[face * 3 + vert] = mMesh.getPosition(getMeshFace(face), vert);
                 }
-
             }
             const SceneBuilder::Mesh& mMesh;
+            std::vector<uint32_t> mFaces;       ///< Mesh faces to process, or empty if processing all faces.
             std::vector<float4> mTangents;
             std::vector<float3> mPositions;
-            int32_t getFaceCount() const { return (int32_t)mMesh.faceCount; }
+            int32_t getFaceCount() const { return mFaces.empty() ? (int32_t)mMesh.faceCount : (int32_t)mFaces.size(); }
+            uint32_t getMeshFace(int32_t face) const { return mFaces.empty() ? (uint32_t)face : mFaces[face]; }
             void getPosition(float position[], int32_t face, int32_t vert) const { FALCOR_ASSERT_LT(size_t(face) * 3 + vert, mPositions.size()); memcpy(position, mPositions.data() + (face * 3 + vert), sizeof(float3)); }
-            void getNormal(float normal[], int32_t face, int32_t vert) { *reinterpret_cast<float3*>(normal) = mMesh.getNormal(face, vert); }
-            void getTexCrd(float texCrd[], int32_t face, int32_t vert) { *reinterpret_cast<float2*>(texCrd) = mMesh.getTexCrd(face, vert); }
+            void getNormal(float normal[], int32_t face, int32_t vert) { *reinterpret_cast<float3*>(normal) = mMesh.getNormal(getMeshFace(face), vert); }
+            void getTexCrd(float texCrd[], int32_t face, int32_t vert) { *reinterpret_cast<float2*>(texCrd) = mMesh.getTexCrd(getMeshFace(face), vert); }
 
             void setTangent(const float tangent[], float sign, int32_t face, int32_t vert)
             {
@@ -201,12 +416,126 @@ namespace Falcor
             return sha1.finalize();
 
         }
+
+        std::vector<std::vector<uint32_t>> partitionMeshesSAHRecursive(const std::vector<AABB>& meshBounds, const std::vector<size_t>& triangleCounts, size_t maxTrianglesPerGroup, std::vector<uint32_t> meshes)
+        {
+            // This function implements a recursive top-down BVH builder to partition meshes into groups
+            // using the surface area heuristic (SAH). The cost of a split is the surface area of each half weighted by
+            // its triangle count, which is evaluated for binned mesh centroids along all three axes. This favors compact
+            // groups with little spatial overlap. Splits that keep the number of groups needed to stay under the triangle
+            // limit minimal are preferred, so that small groups are not repeatedly cut off.
+            // Individual meshes are not split and the two halves are processed in parallel.
+
+            FALCOR_ASSERT(!meshes.empty());
+
+            size_t triangleCount = 0;
+            for (uint32_t mesh : meshes) triangleCount += triangleCounts[mesh];
+            if (triangleCount <= maxTrianglesPerGroup || meshes.size() == 1) return { std::move(meshes) };
+
+            AABB centroidBounds;
+            for (uint32_t mesh : meshes) centroidBounds.include(meshBounds[mesh].center());
+
+            auto getBin = [&](uint32_t mesh, int axis)
+            {
+                float offset = meshBounds[mesh].center()[axis] - centroidBounds.minPoint[axis];
+                size_t bin = (size_t)(kSAHBinCount * offset / centroidBounds.extent()[axis]);
+                return std::min(bin, kSAHBinCount - 1);
+            };
+
+            struct Bin
+            {
+                AABB bounds;
+                size_t meshCount = 0;
+                size_t triangleCount = 0;
+            };
+
+            const size_t minGroupCount = div_round_up(triangleCount, maxTrianglesPerGroup);
+            int bestAxis = -1;
+            size_t bestBin = 0;
+            double bestCost = std::numeric_limits<double>::infinity();
+            bool bestIsMinimal = false;
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                if (!(centroidBounds.extent()[axis] > 0.f)) continue;
+
+                std::array<Bin, kSAHBinCount> bins;
+                for (uint32_t mesh : meshes)
+                {
+                    auto& bin = bins[getBin(mesh, axis)];
+                    bin.bounds.include(meshBounds[mesh]);
+                    bin.meshCount++;
+                    bin.triangleCount += triangleCounts[mesh];
+                }
+
+                // Sweep from the right to accumulate the right half for the split in front of each bin.
+                std::array<Bin, kSAHBinCount> right;
+                for (size_t i = kSAHBinCount - 1; i > 0; i--)
+                {
+                    right[i] = i + 1 < kSAHBinCount ? right[i + 1] : Bin();
+                    right[i].bounds.include(bins[i].bounds);
+                    right[i].meshCount += bins[i].meshCount;
+                    right[i].triangleCount += bins[i].triangleCount;
+                }
+
+                // Sweep from the left and evaluate the cost of each split.
+                Bin left;
+                for (size_t i = 1; i < kSAHBinCount; i++)
+                {
+                    left.bounds.include(bins[i - 1].bounds);
+                    left.meshCount += bins[i - 1].meshCount;
+                    left.triangleCount += bins[i - 1].triangleCount;
+                    if (left.meshCount == 0 || right[i].meshCount == 0) continue;
+
+                    size_t groupCount = div_round_up(left.triangleCount, maxTrianglesPerGroup) +
+                        div_round_up(right[i].triangleCount, maxTrianglesPerGroup);
+                    bool isMinimal = groupCount <= minGroupCount;
+                    double cost = (double)left.bounds.area() * left.triangleCount + (double)right[i].bounds.area() * right[i].triangleCount;
+
+                    if ((isMinimal && !bestIsMinimal) || (isMinimal == bestIsMinimal && cost < bestCost))
+                    {
+                        bestAxis = axis;
+                        bestBin = i;
+                        bestCost = cost;
+                        bestIsMinimal = isMinimal;
+                    }
+                }
+            }
+
+            // Partition the meshes by the best split. If all centroids coincide, fall back on splitting at the middle mesh.
+            auto splitIter = meshes.begin() + meshes.size() / 2;
+            if (bestAxis >= 0)
+            {
+                splitIter = std::partition(meshes.begin(), meshes.end(), [&](uint32_t mesh) { return getBin(mesh, bestAxis) < bestBin; });
+            }
+            FALCOR_ASSERT(splitIter != meshes.begin() && splitIter != meshes.end());
+
+            // Recursively split the left and right halves in parallel.
+            std::array<std::vector<uint32_t>, 2> halves = {
+                std::vector<uint32_t>(meshes.begin(), splitIter),
+                std::vector<uint32_t>(splitIter, meshes.end()),
+            };
+            std::array<std::vector<std::vector<uint32_t>>, 2> lists;
+
+            auto range = NumericRange<size_t>(0, 2);
+            std::for_each(std::execution::par, range.begin(), range.end(), [&](size_t i)
+                { lists[i] = partitionMeshesSAHRecursive(meshBounds, triangleCounts, maxTrianglesPerGroup, std::move(halves[i])); });
+
+            // Move elements into a single list and return.
+            lists[0].insert(
+                lists[0].end(),
+                std::make_move_iterator(lists[1].begin()),
+                std::make_move_iterator(lists[1].end()));
+
+            return std::move(lists[0]);
+        }
     }
 
     SceneBuilder::SceneBuilder(ref<Device> pDevice, const Settings& settings, Flags flags)
         : mpDevice(pDevice)
         , mSettings(settings)
         , mFlags(flags)
+        , mUseCompressedVertices(is_set(flags, Flags::UseCompressedVertices))
     {
         mAssetResolver = AssetResolver::getDefaultResolver();
         mSceneData.pMaterials = std::make_unique<MaterialSystem>(mpDevice);
@@ -354,20 +683,46 @@ namespace Falcor
         prepareSceneGraph();
         prepareMeshes();
         removeUnusedMeshes();
+
+        if (is_set(mFlags, Flags::InstanceDuplicateMeshes | Flags::InstanceRigidDuplicateMeshes))
+        {
+            if (is_set(mFlags, Flags::FlattenStaticMeshInstances))
+            {
+                logWarning("SceneBuilder flag 'InstanceDuplicateMeshes' is ignored as 'FlattenStaticMeshInstances' is set.");
+            }
+            else
+            {
+                timeReport.measure("Preparing meshes");
+                auto stats = instanceDuplicateMeshes();
+                std::string note = fmt::format("{} duplicates, {} saved", stats.exactCount + stats.rigidCount, formatByteSize(stats.savedBytes));
+                timeReport.measure("Instancing meshes", note);
+            }
+        }
+
         flattenStaticMeshInstances();
         pretransformStaticMeshes();
         unifyTriangleWinding();
         optimizeSceneGraph();
         calculateMeshBoundingBoxes();
         createMeshGroups();
-        optimizeGeometry();
+        auto splitStats = optimizeGeometry();
         sortMeshes();
+        optimizeVertexOrder();
+        enforceMemoryBudget();
         createGlobalBuffers();
         createCurveGlobalBuffers();
         collectVolumeGrids();
         removeDuplicateSDFGrids();
 
-        timeReport.measure("Post processing geometry");
+        std::string geometryNote;
+        if (splitStats.splitCount > 0)
+        {
+            geometryNote = fmt::format(
+                "{} mesh groups split into {} with '{}' splitter, overlap {:.4f} avg, {:.4f} max",
+                splitStats.splitCount, splitStats.groupCount, splitStats.splitter, splitStats.averageOverlap, splitStats.maxOverlap
+            );
+        }
+        timeReport.measure("Post processing geometry", geometryNote);
 
         optimizeMaterials();
         removeDuplicateMaterials();
@@ -529,9 +884,10 @@ namespace Falcor
 
                 for (size_t i = 0; i < texCoordCount; ++i)
                 {
-                    transformedTexCoords[i] = mul(coordTransform, float3(mesh.texCrds.pData[i], 1.f));
+                    transformedTexCoords[i] = mul(coordTransform, float3(mesh.texCrds[i], 1.f));
                 }
                 mesh.texCrds.pData = transformedTexCoords.data();
+                mesh.texCrds.stride = 0;
             }
         }
 
@@ -697,14 +1053,15 @@ namespace Falcor
         return processedMesh;
     }
 
-    void SceneBuilder::generateTangents(Mesh& mesh, std::vector<float4>& tangents)
+    void SceneBuilder::generateTangents(Mesh& mesh, std::vector<float4>& tangents, bool parallel)
     {
-        tangents = MikkTSpaceWrapper::generateTangents(mesh);
+        tangents = MikkTSpaceWrapper::generateTangents(mesh, parallel);
         if (!tangents.empty())
         {
             FALCOR_ASSERT(tangents.size() == mesh.indexCount);
             mesh.tangents.pData = tangents.data();
             mesh.tangents.frequency = Mesh::AttributeFrequency::FaceVarying;
+            mesh.tangents.stride = 0;
 
             /// MikkTSpace can produces NaN tangents in case of degenerate triangles,
             /// e.g. triangles where all three points, normals, and texture coordinates happen to be identical.
@@ -1421,49 +1778,255 @@ namespace Falcor
             logWarning("Scene has {} unused meshes that will be removed.", unusedCount);
 
             const size_t meshCount = mMeshes.size();
-            MeshList meshes;
-            meshes.reserve(meshCount);
+            compactMeshList();
+            FALCOR_ASSERT(mMeshes.size() == meshCount - unusedCount);
+        }
+    }
+
+    SceneBuilder::DuplicateMeshStats SceneBuilder::instanceDuplicateMeshes()
+    {
+        // This function detects static meshes with identical geometry and converts them into instances of
+        // a single mesh. Exact duplicates are linked to the scene graph nodes of the duplicate, while rigidly
+        // transformed duplicates get a new child node holding the transform between the two meshes.
+        // The meshes are first bucketed by a hash of their transform invariant data, and the buckets are
+        // then searched for duplicates in parallel.
+
+        const bool matchRigid = is_set(mFlags, Flags::InstanceRigidDuplicateMeshes);
+        const size_t meshCount = mMeshes.size();
 
-            for (MeshID meshID{ 0 }; meshID.get() < (uint32_t)meshCount; ++meshID)
+        auto isCandidate = [](const MeshSpec& mesh)
+        {
+            return !mesh.isDynamic() && !mesh.instances.empty() && !mesh.staticData.empty();
+        };
+
+        // Compare the data that is not affected by a rigid transform.
+        auto hasSameInvariantData = [](const MeshSpec& a, const MeshSpec& b)
+        {
+            if (a.topology != b.topology || a.materialId != b.materialId || a.vertexCount != b.vertexCount ||
+                a.indexCount != b.indexCount || a.use16BitIndices != b.use16BitIndices || a.isFrontFaceCW != b.isFrontFaceCW ||
+                a.isDisplaced != b.isDisplaced || a.indexData != b.indexData || a.staticData.size() != b.staticData.size())
+            {
+                return false;
+            }
+            return std::equal(a.staticData.begin(), a.staticData.end(), b.staticData.begin(), [](const auto& va, const auto& vb)
+            {
+                return all(va.texCrd == vb.texCrd) && va.curveRadius == vb.curveRadius && va.tangent.w == vb.tangent.w;
+            });
+        };
+
+        auto hasSameVertexData = [](const MeshSpec& a, const MeshSpec& b)
+        {
+            return std::equal(a.staticData.begin(), a.staticData.end(), b.staticData.begin(), [](const auto& va, const auto& vb)
             {
-                auto& mesh = mMeshes[meshID.get()];
-                if (mesh.instances.empty()) continue; // Skip unused meshes
+                return all(va.position == vb.position) && all(va.normal == vb.normal) && all(va.tangent == vb.tangent);
+            });
+        };
 
-                // Get new mesh ID.
-                const MeshID newMeshID(meshes.size());
+        // Hash the mesh data. The bucket hash only includes the transform invariant data.
+        std::vector<uint64_t> bucketHashes(meshCount);
+        std::vector<uint64_t> exactHashes(meshCount);
+
+        auto hashMesh = [&](size_t meshIndex)
+        {
+            const auto& mesh = mMeshes[meshIndex];
+            if (!isCandidate(mesh)) return;
+
+            FNVHash64 hash;
+            hash.insert(mesh.topology);
+            hash.insert(mesh.materialId);
+            hash.insert(mesh.vertexCount);
+            hash.insert(mesh.indexCount);
+            hash.insert(mesh.use16BitIndices);
+            hash.insert(mesh.isFrontFaceCW);
+            hash.insert(mesh.isDisplaced);
+            hash.insert(mesh.indexData.data(), mesh.indexData.size() * sizeof(uint32_t));
+            for (const auto& v : mesh.staticData)
+            {
+                hash.insert(v.texCrd);
+                hash.insert(v.curveRadius);
+                hash.insert(v.tangent.w);
+            }
+            bucketHashes[meshIndex] = hash.get();
 
-                // Update the mesh IDs in the scene graph nodes.
-                for (const auto& nodeID : mesh.instances)
-                {
-                    FALCOR_ASSERT(nodeID.get() < mSceneGraph.size());
-                    auto& node = mSceneGraph[nodeID.get()];
-                    std::replace(node.meshes.begin(), node.meshes.end(), meshID, newMeshID);
-                }
+            for (const auto& v : mesh.staticData)
+            {
+                hash.insert(v.position);
+                hash.insert(v.normal);
+                hash.insert(v.tangent);
+            }
+            exactHashes[meshIndex] = hash.get();
+        };
+
+        auto range = NumericRange<size_t>(0, meshCount);
+        std::for_each(std::execution::par, range.begin(), range.end(), hashMesh);
 
-                // Update the mesh IDs of cached meshes.
-                for (auto &cachedMesh : mSceneData.cachedMeshes)
+        // Group the candidate meshes into buckets in mesh order.
+        std::vector<std::vector<MeshID>> buckets;
+        std::unordered_map<uint64_t, size_t> bucketIndices;
+        for (MeshID meshID{ 0 }; meshID.get() < (uint32_t)meshCount; ++meshID)
+        {
+            if (!isCandidate(mMeshes[meshID.get()])) continue;
+            auto [it, inserted] = bucketIndices.try_emplace(bucketHashes[meshID.get()], buckets.size());
+            if (inserted) buckets.emplace_back();
+            buckets[it->second].push_back(meshID);
+        }
+
+        // Search each bucket for duplicates. The first mesh of a set of duplicates is kept and all later ones
+        // are matched to it, so a matched mesh is never referenced by another match.
+        struct DuplicateMatch
+        {
+            MeshID duplicateID;
+            MeshID meshID;
+            bool isRigid = false;
+            float4x4 transform = float4x4::identity();
+        };
+
+        std::vector<std::vector<DuplicateMatch>> bucketMatches(buckets.size());
+
+        auto processBucket = [&](size_t bucketIndex)
+        {
+            const auto& bucket = buckets[bucketIndex];
+            if (bucket.size() < 2) return;
+
+            std::unordered_map<uint64_t, std::vector<MeshID>> exactCandidates;
+            std::vector<MeshID> rigidCandidates;
+
+            for (MeshID meshID : bucket)
+            {
+                const auto& mesh = mMeshes[meshID.get()];
+                auto& candidates = exactCandidates[exactHashes[meshID.get()]];
+
+                auto exactIt = std::find_if(candidates.begin(), candidates.end(), [&](MeshID candidateID)
+                {
+                    const auto& candidate = mMeshes[candidateID.get()];
+                    return hasSameInvariantData(candidate, mesh) && hasSameVertexData(candidate, mesh);
+                });
+                if (exactIt != candidates.end())
                 {
-                    if (cachedMesh.meshID == meshID) cachedMesh.meshID = newMeshID;
+                    bucketMatches[bucketIndex].push_back({ meshID, *exactIt });
+                    continue;
                 }
-                for (auto& cache : mSceneData.cachedCurves)
+
+                if (matchRigid)
                 {
-                    if (cache.tessellationMode != CurveTessellationMode::LinearSweptSphere)
+                    float4x4 transform;
+                    auto rigidIt = std::find_if(rigidCandidates.begin(), rigidCandidates.end(), [&](MeshID candidateID)
                     {
-                        if (cache.geometryID == CurveOrMeshID{ meshID }) cache.geometryID = CurveOrMeshID{ newMeshID };
+                        const auto& candidate = mMeshes[candidateID.get()];
+                        return hasSameInvariantData(candidate, mesh) &&
+                            findRigidTransform(candidate.staticData, mesh.staticData, transform);
+                    });
+                    if (rigidIt != rigidCandidates.end())
+                    {
+                        bucketMatches[bucketIndex].push_back({ meshID, *rigidIt, true, transform });
+                        continue;
                     }
                 }
 
-                meshes.push_back(std::move(mesh));
+                candidates.push_back(meshID);
+                if (rigidCandidates.size() < kMaxRigidCandidatesPerBucket) rigidCandidates.push_back(meshID);
             }
+        };
 
-            mMeshes = std::move(meshes);
+        auto bucketRange = NumericRange<size_t>(0, buckets.size());
+        std::for_each(std::execution::par, bucketRange.begin(), bucketRange.end(), processBucket);
 
-            // Validate scene graph.
-            FALCOR_ASSERT(mMeshes.size() == meshCount - unusedCount);
-            for (const auto& node : mSceneGraph)
+        std::vector<DuplicateMatch> matches;
+        for (const auto& m : bucketMatches) matches.insert(matches.end(), m.begin(), m.end());
+        std::sort(matches.begin(), matches.end(), [](const auto& a, const auto& b) { return a.duplicateID < b.duplicateID; });
+
+        // Move the instances of all duplicates over to the meshes they were matched to.
+        DuplicateMeshStats stats;
+        for (const auto& match : matches)
+        {
+            auto& duplicate = mMeshes[match.duplicateID.get()];
+            auto& mesh = mMeshes[match.meshID.get()];
+            FALCOR_ASSERT(mesh.instances.size() > 0 && duplicate.instances.size() > 0);
+
+            for (NodeID nodeID : duplicate.instances)
+            {
+                FALCOR_ASSERT_LT(nodeID.get(), mSceneGraph.size());
+                auto& meshes = mSceneGraph[nodeID.get()].meshes;
+                auto it = std::find(meshes.begin(), meshes.end(), match.duplicateID);
+                FALCOR_ASSERT(it != meshes.end());
+
+                // Reuse the node unless the mesh needs a transform or is already instanced by it.
+                if (!match.isRigid && mesh.instances.count(nodeID) == 0)
+                {
+                    *it = match.meshID;
+                    mesh.instances.insert(nodeID);
+                    continue;
+                }
+
+                meshes.erase(it);
+                NodeID newNodeID = addNode(Node{ duplicate.name, match.transform, float4x4::identity(), float4x4::identity(), nodeID });
+                mSceneGraph[newNodeID.get()].meshes.push_back(match.meshID);
+                mesh.instances.insert(newNodeID);
+            }
+
+            duplicate.instances.clear();
+            (match.isRigid ? stats.rigidCount : stats.exactCount)++;
+            stats.savedBytes += duplicate.indexData.size() * sizeof(uint32_t);
+            stats.savedBytes += duplicate.staticData.size() * sizeof(PackedStaticVertexData);
+        }
+
+        if (!matches.empty())
+        {
+            compactMeshList();
+            logInfo("Instanced {} duplicate meshes ({} exact, {} rigidly transformed), saving {}.",
+                matches.size(), stats.exactCount, stats.rigidCount, formatByteSize(stats.savedBytes));
+        }
+
+        return stats;
+    }
+
+    void SceneBuilder::compactMeshList()
+    {
+        // This function removes all meshes that are not referenced by any scene graph nodes
+        // and updates the mesh IDs in the scene graph and cached animations.
+
+        const size_t meshCount = mMeshes.size();
+        MeshList meshes;
+        meshes.reserve(meshCount);
+
+        for (MeshID meshID{ 0 }; meshID.get() < (uint32_t)meshCount; ++meshID)
+        {
+            auto& mesh = mMeshes[meshID.get()];
+            if (mesh.instances.empty()) continue; // Skip unused meshes
+
+            // Get new mesh ID.
+            const MeshID newMeshID(meshes.size());
+
+            // Update the mesh IDs in the scene graph nodes.
+            for (const auto& nodeID : mesh.instances)
+            {
+                FALCOR_ASSERT(nodeID.get() < mSceneGraph.size());
+                auto& node = mSceneGraph[nodeID.get()];
+                std::replace(node.meshes.begin(), node.meshes.end(), meshID, newMeshID);
+            }
+
+            // Update the mesh IDs of cached meshes.
+            for (auto &cachedMesh : mSceneData.cachedMeshes)
             {
-                for (MeshID meshID : node.meshes) FALCOR_ASSERT_LT(meshID.get(), mMeshes.size());
+                if (cachedMesh.meshID == meshID) cachedMesh.meshID = newMeshID;
             }
+            for (auto& cache : mSceneData.cachedCurves)
+            {
+                if (cache.tessellationMode != CurveTessellationMode::LinearSweptSphere)
+                {
+                    if (cache.geometryID == CurveOrMeshID{ meshID }) cache.geometryID = CurveOrMeshID{ newMeshID };
+                }
+            }
+
+            meshes.push_back(std::move(mesh));
+        }
+
+        mMeshes = std::move(meshes);
+
+        // Validate scene graph.
+        for (const auto& node : mSceneGraph)
+        {
+            for (MeshID meshID : node.meshes) FALCOR_ASSERT_LT(meshID.get(), mMeshes.size());
         }
     }
 
@@ -2337,7 +2900,81 @@ namespace Falcor
         return leftList;
     }
 
-    void SceneBuilder::optimizeGeometry()
+    SceneBuilder::MeshGroupList SceneBuilder::splitMeshGroupSAH(MeshGroup& meshGroup) const
+    {
+        // Early out if splitting is not needed or possible.
+        size_t triangleCount = 0;
+        if (!needsSplit(meshGroup, triangleCount)) return MeshGroupList{ std::move(meshGroup) };
+
+        std::vector<AABB> meshBounds;
+        std::vector<size_t> triangleCounts;
+        meshBounds.reserve(meshGroup.meshList.size());
+        triangleCounts.reserve(meshGroup.meshList.size());
+        for (auto meshID : meshGroup.meshList)
+        {
+            const auto& mesh = mMeshes[meshID.get()];
+            meshBounds.push_back(mesh.boundingBox);
+            triangleCounts.push_back(mesh.getTriangleCount());
+        }
+
+        auto partition = partitionMeshesSAH(meshBounds, triangleCounts, kMaxTrianglesPerBLAS);
+
+        MeshGroupList meshGroups;
+        meshGroups.reserve(partition.size());
+        for (const auto& indices : partition)
+        {
+            MeshGroup group{ {}, meshGroup.isStatic, meshGroup.isDisplaced };
+            group.meshList.reserve(indices.size());
+            for (uint32_t index : indices) group.meshList.push_back(meshGroup.meshList[index]);
+
+            // Issue warning if single mesh exceeds the triangle count limit.
+            if (indices.size() == 1 && triangleCounts[indices[0]] > kMaxTrianglesPerBLAS)
+            {
+                const auto& mesh = mMeshes[group.meshList[0].get()];
+                logWarning("Mesh '{}' has {} triangles, expect extraneous GPU memory usage.", mesh.name, triangleCounts[indices[0]]);
+            }
+
+            meshGroups.push_back(std::move(group));
+        }
+
+        return meshGroups;
+    }
+
+    std::vector<std::vector<uint32_t>> SceneBuilder::partitionMeshesSAH(const std::vector<AABB>& meshBounds, const std::vector<size_t>& triangleCounts, size_t maxTrianglesPerGroup)
+    {
+        FALCOR_CHECK(meshBounds.size() == triangleCounts.size(), "Mesh bounds and triangle counts must have the same size.");
+        FALCOR_CHECK(maxTrianglesPerGroup > 0, "'maxTrianglesPerGroup' must be greater than zero.");
+
+        if (meshBounds.empty()) return {};
+
+        std::vector<uint32_t> meshes(meshBounds.size());
+        std::iota(meshes.begin(), meshes.end(), 0u);
+        return partitionMeshesSAHRecursive(meshBounds, triangleCounts, maxTrianglesPerGroup, std::move(meshes));
+    }
+
+    float SceneBuilder::calculateOverlap(const std::vector<AABB>& bounds)
+    {
+        // The overlap is the sum of the surface areas of the pairwise intersections of the bounding boxes,
+        // relative to the surface area of the bounding box of all of them. It is zero for disjoint boxes.
+
+        AABB totalBounds;
+        for (const auto& bb : bounds) totalBounds.include(bb);
+
+        double overlapArea = 0.0;
+        for (size_t i = 0; i < bounds.size(); i++)
+        {
+            for (size_t j = i + 1; j < bounds.size(); j++)
+            {
+                AABB overlap = bounds[i] & bounds[j];
+                if (overlap.valid()) overlapArea += overlap.area();
+            }
+        }
+
+        float totalArea = totalBounds.valid() ? totalBounds.area() : 0.f;
+        return totalArea > 0.f ? (float)(overlapArea / totalArea) : 0.f;
+    }
+
+    SceneBuilder::MeshGroupSplitStats SceneBuilder::optimizeGeometry()
     {
         // This function optimizes the geometry for raytracing performance and memory usage.
         //
@@ -2350,15 +2987,48 @@ namespace Falcor
         //  - Split large meshes into smaller to reduce spatial overlap between BLASes.
         //  - Sort meshes into BLASes based on spatial locality.
 
+        //
+        // The splitting strategy can be selected with the 'SceneBuilder:meshGroupSplitter' option:
+        //  - 'sah' (default): Partition meshes using the surface area heuristic.
+        //  - 'midpoint': Split at the midpoint of the largest axis, splitting meshes that straddle the plane.
+        //  - 'median': Split at the triangle count median along the largest axis.
+        //  - 'simple': Partition meshes in order by triangle count.
+        // The overlap between the resulting groups is logged for each split and summarized in the build time report for comparing the strategies.
+
+        std::string splitter = mSettings.getOption<std::string>("SceneBuilder:meshGroupSplitter", "sah");
+        if (splitter != "sah" && splitter != "midpoint" && splitter != "median" && splitter != "simple")
+        {
+            logWarning("SceneBuilder::optimizeGeometry() - Unknown mesh group splitter '{}'. Using 'sah' instead.", splitter);
+            splitter = "sah";
+        }
+
         MeshGroupList optimizedGroups;
+        MeshGroupSplitStats stats;
 
         for (auto& meshGroup : mMeshGroups)
         {
-            //auto groups = splitMeshGroupSimple(meshGroup);
-            //auto groups = splitMeshGroupMedian(meshGroup);
-            auto groups = splitMeshGroupMidpointMeshes(meshGroup);
+            MeshGroupList groups;
+            if (splitter == "midpoint") groups = splitMeshGroupMidpointMeshes(meshGroup);
+            else if (splitter == "median") groups = splitMeshGroupMedian(meshGroup);
+            else if (splitter == "simple") groups = splitMeshGroupSimple(meshGroup);
+            else groups = splitMeshGroupSAH(meshGroup);
 
-            if (groups.size() > 1) logWarning("SceneBuilder::optimizeGeometry() performance warning - Mesh group was split into {} groups.", groups.size());
+            if (groups.size() > 1)
+            {
+                std::vector<AABB> bounds;
+                for (const auto& group : groups) bounds.push_back(calculateBoundingBox(group));
+                float overlap = calculateOverlap(bounds);
+
+                logWarning(
+                    "SceneBuilder::optimizeGeometry() performance warning - Mesh group was split into {} groups with '{}' splitter, relative overlap {:.4f}.",
+                    groups.size(), splitter, overlap
+                );
+
+                stats.splitCount++;
+                stats.groupCount += groups.size();
+                stats.averageOverlap += overlap;
+                stats.maxOverlap = std::max(stats.maxOverlap, overlap);
+            }
 
             optimizedGroups.insert(
                 optimizedGroups.end(),
@@ -2367,6 +3037,10 @@ namespace Falcor
         }
 
         mMeshGroups = std::move(optimizedGroups);
+
+        stats.splitter = splitter;
+        if (stats.splitCount > 0) stats.averageOverlap /= stats.splitCount;
+        return stats;
     }
 
     void SceneBuilder::sortMeshes()
@@ -2414,11 +3088,173 @@ namespace Falcor
         }
     }
 
+    void SceneBuilder::optimizeVertexOrder()
+    {
+        // This function reorders the triangles of each indexed mesh for post-transform vertex cache efficiency,
+        // followed by reordering the vertices in the order they are first referenced to improve vertex fetch locality.
+        // The resulting vertex cache statistics are stored in the scene data.
+        // Nothing is done unless the OptimizeVertexCache flag is set, including the vertex cache analysis.
+
+        if (!is_set(mFlags, Flags::OptimizeVertexCache)) return;
+
+        // Meshes with vertex animation caches are addressed by vertex index, their vertex order must be preserved.
+        std::vector<bool> preserveVertexOrder(mMeshes.size(), false);
+        for (const auto& cache : mSceneData.cachedMeshes)
+        {
+            preserveVertexOrder[cache.meshID.get()] = true;
+        }
+        for (const auto& cache : mSceneData.cachedCurves)
+        {
+            if (cache.tessellationMode != CurveTessellationMode::LinearSweptSphere)
+            {
+                preserveVertexOrder[cache.geometryID.get()] = true;
+            }
+        }
+
+        std::vector<VertexCacheStats> statsBefore(mMeshes.size());
+        std::vector<VertexCacheStats> statsAfter(mMeshes.size());
+
+        auto processMesh = [&](size_t meshIndex)
+        {
+            MeshSpec& mesh = mMeshes[meshIndex];
+            if (mesh.topology != Vao::Topology::TriangleList) return;
+
+            // Non-indexed meshes transform every vertex of every triangle.
+            if (mesh.indexCount == 0)
+            {
+                VertexCacheStats& stats = statsBefore[meshIndex];
+                stats.triangleCount = mesh.getTriangleCount();
+                stats.vertexCount = mesh.vertexCount;
+                stats.transformCount = mesh.vertexCount;
+                statsAfter[meshIndex] = stats;
+                return;
+            }
+
+            std::vector<uint32_t> indices(mesh.indexCount);
+            for (uint32_t i = 0; i < mesh.indexCount; i++) indices[i] = mesh.getIndex(i);
+
+            statsBefore[meshIndex] = analyzeVertexCache(indices, mesh.vertexCount);
+            optimizeVertexCache(indices, mesh.vertexCount);
+
+            if (!preserveVertexOrder[meshIndex])
+            {
+                std::vector<uint32_t> remap = optimizeVertexFetch(indices, mesh.vertexCount);
+
+                std::vector<StaticVertexData> staticData(mesh.staticData.size());
+                for (size_t i = 0; i < remap.size(); i++) staticData[remap[i]] = mesh.staticData[i];
+                mesh.staticData = std::move(staticData);
+
+                if (mesh.isSkinned())
+                {
+                    FALCOR_ASSERT(mesh.skinningData.size() == remap.size());
+                    std::vector<SkinningVertexData> skinningData(mesh.skinningData.size());
+                    for (size_t i = 0; i < remap.size(); i++)
+                    {
+                        skinningData[remap[i]] = mesh.skinningData[i];
+                        skinningData[remap[i]].staticIndex = remap[mesh.skinningData[i].staticIndex];
+                    }
+                    mesh.skinningData = std::move(skinningData);
+                }
+            }
+
+            statsAfter[meshIndex] = analyzeVertexCache(indices, mesh.vertexCount);
+            mesh.indexData = mesh.use16BitIndices ? compact16BitIndices(indices) : std::move(indices);
+        };
+
+        auto range = NumericRange<size_t>(0, mMeshes.size());
+        std::for_each(std::execution::par, range.begin(), range.end(), processMesh);
+
+        VertexCacheStats totalBefore;
+        VertexCacheStats totalAfter;
+        for (size_t i = 0; i < mMeshes.size(); i++)
+        {
+            totalBefore += statsBefore[i];
+            totalAfter += statsAfter[i];
+        }
+        mSceneData.vertexCacheStats = totalAfter;
+
+        logInfo("SceneBuilder::optimizeVertexOrder() - ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}.",
+            totalBefore.getACMR(), totalAfter.getACMR(), totalBefore.getATVR(), totalAfter.getATVR());
+    }
+
+    bool SceneBuilder::canCompressVertices(const MeshSpec& mesh)
+    {
+        if (mesh.isDynamic() || mesh.isDisplaced || mesh.staticData.empty()) return false;
+        for (const auto& v : mesh.staticData)
+        {
+            // Curve radius is not stored and texcoords must be representable in fp16.
+            if (v.curveRadius > 0.f) return false;
+            float2 error = abs(f16tof32(f32tof16(v.texCrd)) - v.texCrd);
+            if (!(error.x <= kMaxCompressedTexCrdError && error.y <= kMaxCompressedTexCrdError)) return false;
+        }
+        return true;
+    }
+
+    SceneBuilder::MemoryEstimate SceneBuilder::estimateMemoryUsage(bool useCompressedVertices) const
+    {
+        MemoryEstimate estimate;
+
+        for (const auto& mesh : mMeshes)
+        {
+            const bool compressed = useCompressedVertices && canCompressVertices(mesh);
+            estimate.vertexMemoryInBytes += mesh.staticData.size() * (compressed ? sizeof(CompressedStaticVertexData) : sizeof(PackedStaticVertexData));
+            estimate.vertexMemoryInBytes += mesh.skinningData.size() * sizeof(SkinningVertexData);
+            estimate.vertexMemoryInBytes += mesh.prevVertexCount * sizeof(PrevVertexData);
+            estimate.indexMemoryInBytes += mesh.indexData.size() * sizeof(uint32_t);
+            estimate.blasMemoryInBytes += mesh.getTriangleCount() * kEstimatedBLASBytesPerTriangle;
+        }
+
+        for (const auto& curve : mCurves)
+        {
+            estimate.curveMemoryInBytes += curve.staticData.size() * sizeof(StaticCurveVertexData);
+            estimate.curveMemoryInBytes += curve.indexData.size() * sizeof(uint32_t);
+        }
+
+        estimate.textureMemoryInBytes = mSceneData.pMaterials->getTextureManager().getStats().textureMemoryInBytes;
+
+        std::set<ref<Grid>> uniqueGrids;
+        for (const auto& pGridVolume : mSceneData.gridVolumes)
+        {
+            auto grids = pGridVolume->getAllGrids();
+            uniqueGrids.insert(grids.begin(), grids.end());
+        }
+        for (const auto& pGrid : uniqueGrids) estimate.gridMemoryInBytes += pGrid->getGridSizeInBytes();
+        for (const auto& pSDFGrid : mSceneData.sdfGrids) estimate.gridMemoryInBytes += pSDFGrid->getSize();
+
+        return estimate;
+    }
+
+    void SceneBuilder::enforceMemoryBudget()
+    {
+        const uint64_t budget = mSettings.getOption<uint64_t>("SceneBuilder:memoryBudgetMB", 0) << 20;
+        if (budget == 0) return;
+
+        auto estimate = estimateMemoryUsage(mUseCompressedVertices);
+        if (estimate.getTotal() > budget && !mUseCompressedVertices && mSettings.getOption<bool>("SceneBuilder:memoryBudgetCompress", true))
+        {
+            logInfo("Estimated scene memory {} exceeds the budget of {}. Using compressed vertices.",
+                formatByteSize(estimate.getTotal()), formatByteSize(budget));
+            mUseCompressedVertices = true;
+            estimate = estimateMemoryUsage(true);
+        }
+
+        if (estimate.getTotal() > budget)
+        {
+            FALCOR_THROW("Estimated scene memory {} exceeds the budget of {} (vertices {}, indices {}, curves {}, BLAS {}, textures {}, grids {}).",
+                formatByteSize(estimate.getTotal()), formatByteSize(budget), formatByteSize(estimate.vertexMemoryInBytes),
+                formatByteSize(estimate.indexMemoryInBytes), formatByteSize(estimate.curveMemoryInBytes), formatByteSize(estimate.blasMemoryInBytes),
+                formatByteSize(estimate.textureMemoryInBytes), formatByteSize(estimate.gridMemoryInBytes));
+        }
+
+        logInfo("Estimated scene memory {} is within the budget of {}.", formatByteSize(estimate.getTotal()), formatByteSize(budget));
+    }
+
     void SceneBuilder::createGlobalBuffers()
     {
         FALCOR_ASSERT(mSceneData.meshIndexData.empty());
         FALCOR_ASSERT(mSceneData.meshStaticData.empty());
         FALCOR_ASSERT(mSceneData.meshSkinningData.empty());
+        FALCOR_ASSERT(mSceneData.meshCompressedStaticData.empty());
 
         const bool isIndexed = !is_set(mFlags, Flags::NonIndexedVertices);
 
@@ -2441,15 +3277,42 @@ namespace Falcor
 
         mSceneData.meshSkinningData.reserve(totalSkinningVertexCount);
 
+        const bool useCompressedVertices = mUseCompressedVertices;
+        if (useCompressedVertices)
+        {
+            mSceneData.meshVertexQuantization.resize(mMeshes.size());
+        }
+
+        // Meshes that don't fit in a single compressed vertex buffer fall back to the packed format.
+        const size_t maxCompressedVertexCount = std::numeric_limits<uint32_t>::max() / sizeof(CompressedStaticVertexData);
+        auto fitsCompressedVertexBuffer = [&](const MeshSpec& mesh)
+        {
+            return mSceneData.meshCompressedStaticData.size() + mesh.staticData.size() <= maxCompressedVertexCount;
+        };
+
         // Copy all vertex and index data into the global buffers.
-        for (auto& mesh : mMeshes)
+        for (uint32_t meshID = 0; meshID < (uint32_t)mMeshes.size(); meshID++)
         {
+            auto& mesh = mMeshes[meshID];
             mesh.skinningVertexOffset = (uint32_t)mSceneData.meshSkinningData.size();
             mesh.prevVertexOffset = mesh.skinningVertexOffset;
 
-            // Insert the static vertex data in the global array.
-            // The vertices are automatically converted to their packed format in this step.
-            mesh.staticVertexOffset = mSceneData.meshStaticData.insert(mesh.staticData.begin(), mesh.staticData.end());
+            if (useCompressedVertices && canCompressVertices(mesh) && fitsCompressedVertexBuffer(mesh))
+            {
+                // Insert the vertices in compressed format with positions quantized to the mesh bounds.
+                const auto quantization = VertexQuantization::fromBounds(mesh.boundingBox.minPoint, mesh.boundingBox.maxPoint);
+                mesh.useCompressedVertices = true;
+                mesh.staticVertexOffset = (uint32_t)mSceneData.meshCompressedStaticData.size();
+                mSceneData.meshVertexQuantization[meshID] = quantization;
+                for (const auto& v : mesh.staticData)
+                    mSceneData.meshCompressedStaticData.emplace_back(v, quantization);
+            }
+            else
+            {
+                // Insert the static vertex data in the global array.
+                // The vertices are automatically converted to their packed format in this step.
+                mesh.staticVertexOffset = mSceneData.meshStaticData.insert(mesh.staticData.begin(), mesh.staticData.end());
+            }
 
             if (isIndexed)
             {
@@ -2474,6 +3337,13 @@ namespace Falcor
             mesh.skinningData.clear();
         }
 
+        if (useCompressedVertices)
+        {
+            logInfo(
+                "SceneBuilder::createGlobalBuffers() - Stored {} vertices in compressed format.", mSceneData.meshCompressedStaticData.size()
+            );
+        }
+
         // Initialize offsets for prev vertex data for vertex-animated meshes
         uint32_t prevOffset = (uint32_t)mSceneData.meshSkinningData.size();
         for (auto& cache : mSceneData.cachedMeshes)
@@ -2595,6 +3465,9 @@ namespace Falcor
         // Note that non-emissive meshes are unmodified and use full precision texcoords.
         for (auto& mesh : mMeshes)
         {
+            // Compressed vertices already store texture coordinates in fp16.
+            if (mesh.useCompressedVertices) continue;
+
             const auto& pMaterial = mSceneData.pMaterials->getMaterial(mesh.materialId)->toBasicMaterial();
             if (pMaterial && pMaterial->getEmissiveTexture() != nullptr)
             {
@@ -2702,6 +3575,7 @@ namespace Falcor
             meshFlags |= mesh.isFrontFaceCW ? (uint32_t)MeshFlags::IsFrontFaceCW : 0;
             meshFlags |= mesh.isDisplaced ? (uint32_t)MeshFlags::IsDisplaced : 0;
             meshFlags |= mesh.isAnimated ? (uint32_t)MeshFlags::IsAnimated : 0;
+            meshFlags |= mesh.useCompressedVertices ? (uint32_t)MeshFlags::UseCompressedVertices : 0;
             meshData[meshID].flags = meshFlags;
 
             if (mesh.use16BitIndices) mSceneData.has16BitIndices = true;
@@ -2805,6 +3679,7 @@ namespace Falcor
                     instance.ibOffset = mesh.indexOffset;
                     instance.flags |= mesh.use16BitIndices ? (uint32_t)GeometryInstanceFlags::Use16BitIndices : 0;
                     instance.flags |= mesh.isDynamic() ? (uint32_t)GeometryInstanceFlags::IsDynamic : 0;
+                    instance.flags |= mesh.useCompressedVertices ? (uint32_t)GeometryInstanceFlags::UseCompressedVertices : 0;
                     instance.instanceIndex = tlasInstanceIndex;
                     instance.geometryIndex = blasGeometryIndex;
                     instanceData.push_back(instance);
@@ -2962,6 +3837,10 @@ namespace Falcor
         flags.value("DontUseDisplacement", SceneBuilder::Flags::DontUseDisplacement);
         flags.value("UseCompressedHitInfo", SceneBuilder::Flags::UseCompressedHitInfo);
         flags.value("TessellateCurvesIntoPolyTubes", SceneBuilder::Flags::TessellateCurvesIntoPolyTubes);
+        flags.value("OptimizeVertexCache", SceneBuilder::Flags::OptimizeVertexCache);
+        flags.value("UseCompressedVertices", SceneBuilder::Flags::UseCompressedVertices);
+        flags.value("InstanceDuplicateMeshes", SceneBuilder::Flags::InstanceDuplicateMeshes);
+        flags.value("InstanceRigidDuplicateMeshes", SceneBuilder::Flags::InstanceRigidDuplicateMeshes);
         flags.value("UseCache", SceneBuilder::Flags::UseCache);
         flags.value("RebuildCache", SceneBuilder::Flags::RebuildCache);
         ScriptBindings::addEnumBinaryOperators(flags);
@@ -77,6 +77,10 @@ namespace Falcor
             DontUseDisplacement             = 0x4000,   ///< Don't use displacement mapping.
             UseCompressedHitInfo            = 0x8000,   ///< Use compressed hit info (on scenes with triangle meshes only).
             TessellateCurvesIntoPolyTubes   = 0x10000,  ///< Tessellate curves into poly-tubes (the default is linear swept spheres).
+            OptimizeVertexCache             = 0x20000,  ///< Reorder triangles and vertices of indexed meshes for post-transform vertex cache and vertex fetch efficiency.
+            UseCompressedVertices           = 0x40000,  ///< Store vertices of static meshes in a compressed format (quantized positions, octahedral normals/tangents and fp16 texcoords).
+            InstanceDuplicateMeshes         = 0x80000,  ///< Detect static meshes with identical geometry and convert them into instances of a single mesh. Ignored if FlattenStaticMeshInstances is set.
+            InstanceRigidDuplicateMeshes    = 0x100000, ///< Also instance static meshes whose geometry only differs by a rigid transform (rotation and translation). Implies InstanceDuplicateMeshes.
 
             UseCache                        = 0x10000000, ///< Enable scene caching. This caches the runtime scene representation on disk to reduce load time.
             RebuildCache                    = 0x20000000, ///< Rebuild scene cache.
@@ -105,6 +109,13 @@ namespace Falcor
             {
                 const T* pData = nullptr;
                 AttributeFrequency frequency = AttributeFrequency::None;
+                uint32_t stride = 0;                    ///< Byte stride between elements, allows referencing interleaved vertex data. Zero means tightly packed.
+
+                const T& operator[](size_t index) const
+                {
+                    if (stride == 0) return pData[index];
+                    return *reinterpret_cast<const T*>(reinterpret_cast<const uint8_t*>(pData) + index * stride);
+                }
             };
 
             std::string name;                           ///< The mesh's name.
@@ -153,7 +164,7 @@ namespace Falcor
             {
                 if (attribute.pData)
                 {
-                    return attribute.pData[index];
+                    return attribute[index];
                 }
                 return T{};
             }
@@ -433,10 +444,31 @@ namespace Falcor
         ProcessedMesh processMesh(const Mesh& mesh, MeshAttributeIndices* pAttributeIndices = nullptr, std::vector<float4>* pTangents = nullptr) const;
 
         /** Generate tangents for a mesh.
+            Large meshes are split into chunks that are processed in parallel. The result is identical to the serial path.
             \param mesh The mesh to generate tangents for. If successful, the tangent attribute on the mesh will be set to the output vector.
             \param tangents Output for generated tangents.
+            \param parallel Process large meshes in parallel chunks.
+        */
+        static void generateTangents(Mesh& mesh, std::vector<float4>& tangents, bool parallel = true);
+
+        /// Large mesh groups are split in order to reduce the size of the largest BLAS.
+        /// The target is max 16M triangles per BLAS (= approx 0.5GB post-compaction). Note that this is not a strict limit.
+        static constexpr size_t kMaxTrianglesPerBLAS = 1ull << 24;
+
+        /** Partition meshes into groups using the surface area heuristic (SAH).
+            Meshes are split recursively until each group has at most maxTrianglesPerGroup triangles or consists of a single mesh.
+            Individual meshes are not split.
+            \param meshBounds Bounding box of each mesh.
+            \param triangleCounts Triangle count of each mesh.
+            \param maxTrianglesPerGroup Maximum number of triangles per group.
+            \return List of groups, each given as indices into the mesh arrays.
         */
-        static void generateTangents(Mesh& mesh, std::vector<float4>& tangents);
+        static std::vector<std::vector<uint32_t>> partitionMeshesSAH(const std::vector<AABB>& meshBounds, const std::vector<size_t>& triangleCounts, size_t maxTrianglesPerGroup = kMaxTrianglesPerBLAS);
+
+        /** Compute the relative spatial overlap of a set of bounding boxes, e.g. of mesh groups.
+            \return Sum of the surface areas of the pairwise intersections divided by the surface area of the union bounding box. Zero for disjoint boxes.
+        */
+        static float calculateOverlap(const std::vector<AABB>& bounds);
 
         /** Add a pre-processed mesh.
             \param mesh The pre-processed mesh.
@@ -708,6 +740,7 @@ namespace Falcor
             bool isFrontFaceCW = false;             ///< Indicate whether front-facing side has clockwise winding in object space.
             bool isDisplaced = false;               ///< True if mesh has displacement map.
             bool isAnimated = false;                ///< True if the mesh vertices can be modified during rendering (e.g., skinning or inverse rendering).
+            bool useCompressedVertices = false;     ///< True if the vertices are stored in compressed format. This is decided in createGlobalBuffers().
             AABB boundingBox;                       ///< Mesh bounding-box in object space.
             std::set<NodeID> instances;             ///< IDs of all nodes that instantiate this mesh.
 
@@ -758,6 +791,37 @@ namespace Falcor
             std::vector<StaticCurveVertexData> staticData;
         };
 
+        struct DuplicateMeshStats
+        {
+            size_t exactCount = 0;      ///< Number of meshes replaced by an instance of an identical mesh.
+            size_t rigidCount = 0;      ///< Number of meshes replaced by a transformed instance of an identical mesh.
+            size_t savedBytes = 0;      ///< Vertex and index data in bytes saved by removing the duplicates.
+        };
+
+        struct MeshGroupSplitStats
+        {
+            std::string splitter;       ///< Name of the splitting strategy used.
+            size_t splitCount = 0;      ///< Number of mesh groups that were split.
+            size_t groupCount = 0;      ///< Number of mesh groups the split groups were split into.
+            float averageOverlap = 0.f; ///< Average relative overlap of the split groups (see calculateOverlap()).
+            float maxOverlap = 0.f;     ///< Maximum relative overlap of the split groups.
+        };
+
+        struct MemoryEstimate
+        {
+            uint64_t vertexMemoryInBytes = 0;   ///< Static, skinning and previous vertex data.
+            uint64_t indexMemoryInBytes = 0;    ///< Index data.
+            uint64_t curveMemoryInBytes = 0;    ///< Curve vertex and index data.
+            uint64_t blasMemoryInBytes = 0;     ///< Approximate BLAS memory for the meshes.
+            uint64_t textureMemoryInBytes = 0;  ///< Material textures.
+            uint64_t gridMemoryInBytes = 0;     ///< Volume grids and SDF grids.
+
+            uint64_t getTotal() const
+            {
+                return vertexMemoryInBytes + indexMemoryInBytes + curveMemoryInBytes + blasMemoryInBytes + textureMemoryInBytes + gridMemoryInBytes;
+            }
+        };
+
         using SceneGraph = std::vector<InternalNode>;
         using MeshList = std::vector<MeshSpec>;
         using MeshGroup = Scene::MeshGroup;
@@ -777,6 +841,7 @@ namespace Falcor
         ref<Scene> mpScene;
         SceneCache::Key mSceneCacheKey;
         bool mWriteSceneCache = false;  ///< True if scene cache should be written after import.
+        bool mUseCompressedVertices;    ///< True if static meshes are stored in compressed format. Set from the build flags or when needed to fit in the memory budget.
 
         SceneGraph mSceneGraph;
 
@@ -810,20 +875,32 @@ namespace Falcor
         MeshGroupList splitMeshGroupSimple(MeshGroup& meshGroup) const;
         MeshGroupList splitMeshGroupMedian(MeshGroup& meshGroup) const;
         MeshGroupList splitMeshGroupMidpointMeshes(MeshGroup& meshGroup);
+        MeshGroupList splitMeshGroupSAH(MeshGroup& meshGroup) const;
 
         // Post processing
         void prepareDisplacementMaps();
         void prepareSceneGraph();
         void prepareMeshes();
         void removeUnusedMeshes();
+        DuplicateMeshStats instanceDuplicateMeshes();
+        void compactMeshList();
         void flattenStaticMeshInstances();
         void optimizeSceneGraph();
         void pretransformStaticMeshes();
         void unifyTriangleWinding();
         void calculateMeshBoundingBoxes();
         void createMeshGroups();
-        void optimizeGeometry();
+        MeshGroupSplitStats optimizeGeometry();
         void sortMeshes();
+        void optimizeVertexOrder();
+
+        /** Check the estimated scene memory against the budget set by the 'SceneBuilder:memoryBudgetMB' option.
+            If the budget is exceeded, compressed vertices are enabled unless 'SceneBuilder:memoryBudgetCompress' is false.
+            Throws if the scene does not fit in the budget, so that loading fails before the GPU resources are created.
+        */
+        void enforceMemoryBudget();
+        MemoryEstimate estimateMemoryUsage(bool useCompressedVertices) const;
+        static bool canCompressVertices(const MeshSpec& mesh);
         void createGlobalBuffers();
         void createCurveGlobalBuffers();
         void optimizeMaterials();
@@ -43,7 +43,7 @@ namespace Falcor
         /** Specfies the current cache file version.
             This needs to be incremented every time the file format changes!
         */
-        const uint32_t kVersion = 25;
+        const uint32_t kVersion = 27;
 
         /** Scene cache directory (subdirectory in the application data directory).
         */
@@ -375,8 +375,11 @@ namespace Falcor
         stream.write(sceneData.has16BitIndices);
         stream.write(sceneData.has32BitIndices);
         stream.write(sceneData.meshDrawCount);
+        stream.write(sceneData.vertexCacheStats);
         writeSplitBuffer(stream, sceneData.meshIndexData);
         writeSplitBuffer(stream, sceneData.meshStaticData);
+        stream.write(sceneData.meshCompressedStaticData);
+        stream.write(sceneData.meshVertexQuantization);
         stream.write(sceneData.meshSkinningData);
 
         writeMarker(stream, "Curves");
@@ -501,8 +504,11 @@ namespace Falcor
         stream.read(sceneData.has16BitIndices);
         stream.read(sceneData.has32BitIndices);
         stream.read(sceneData.meshDrawCount);
+        stream.read(sceneData.vertexCacheStats);
         readSplitBuffer(stream, sceneData.meshIndexData);
         readSplitBuffer(stream, sceneData.meshStaticData);
+        stream.read(sceneData.meshCompressedStaticData);
+        stream.read(sceneData.meshVertexQuantization);
         stream.read(sceneData.meshSkinningData);
 
         readMarker(stream, "Curves");
@@ -0,0 +1,262 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "MeshOptimizer.h"
+#include "Core/Error.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Falcor
+{
+namespace
+{
+// Parameters of the vertex scoring function, see https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+constexpr uint32_t kCacheSize = 32;
+constexpr uint32_t kMaxValence = 32;
+constexpr float kLastTriangleScore = 0.75f;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kValenceBoostScale = 2.f;
+constexpr float kValenceBoostPower = 0.5f;
+
+constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+struct ScoreTables
+{
+    float cache[kCacheSize + 1];   ///< Score by cache position, the last entry is for vertices not in the cache.
+    float valence[kMaxValence + 1]; ///< Score by number of remaining triangles using the vertex.
+
+    ScoreTables()
+    {
+        for (uint32_t i = 0; i < kCacheSize; ++i)
+        {
+            // The vertices of the last emitted triangle get a fixed score so that the next triangle does not
+            // depend on the order in which they were added.
+            cache[i] = i < 3 ? kLastTriangleScore : std::pow(1.f - float(i - 3) / float(kCacheSize - 3), kCacheDecayPower);
+        }
+        cache[kCacheSize] = 0.f;
+
+        // Vertices with no remaining triangles must never contribute.
+        valence[0] = 0.f;
+        for (uint32_t i = 1; i <= kMaxValence; ++i)
+            valence[i] = kValenceBoostScale * std::pow(float(i), -kValenceBoostPower);
+    }
+
+    float getScore(uint32_t cachePosition, uint32_t liveValence) const
+    {
+        if (liveValence == 0)
+            return -1.f;
+        return cache[std::min(cachePosition, kCacheSize)] + valence[std::min(liveValence, kMaxValence)];
+    }
+};
+
+void checkIndices(fstd::span<const uint32_t> indices, uint32_t vertexCount)
+{
+    FALCOR_CHECK(indices.size() % 3 == 0, "Index count ({}) must be a multiple of 3.", indices.size());
+    for (uint32_t index : indices)
+        FALCOR_CHECK(index < vertexCount, "Vertex index ({}) is out of range ({} vertices).", index, vertexCount);
+}
+} // namespace
+
+VertexCacheStats analyzeVertexCache(fstd::span<const uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize)
+{
+    checkIndices(indices, vertexCount);
+    FALCOR_CHECK(cacheSize > 0, "Cache size must be positive.");
+
+    VertexCacheStats stats;
+    stats.triangleCount = indices.size() / 3;
+
+    // A vertex is in the FIFO if fewer than 'cacheSize' vertices were inserted after it.
+    std::vector<uint64_t> insertTime(vertexCount, 0);
+    uint64_t time = uint64_t(cacheSize) + 1;
+    for (uint32_t index : indices)
+    {
+        if (insertTime[index] == 0)
+            stats.vertexCount++;
+        if (time - insertTime[index] > cacheSize)
+        {
+            insertTime[index] = time++;
+            stats.transformCount++;
+        }
+    }
+
+    return stats;
+}
+
+void optimizeVertexCache(fstd::span<uint32_t> indices, uint32_t vertexCount)
+{
+    checkIndices(indices, vertexCount);
+
+    const uint32_t triangleCount = uint32_t(indices.size() / 3);
+    if (triangleCount == 0)
+        return;
+
+    static const ScoreTables kScores;
+
+    // Build vertex to triangle adjacency.
+    // The adjacency list of each vertex only holds the triangles that have not been emitted yet.
+    std::vector<uint32_t> liveValence(vertexCount, 0);
+    for (uint32_t index : indices)
+        liveValence[index]++;
+
+    std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+    for (uint32_t v = 0; v < vertexCount; ++v)
+        adjacencyOffset[v + 1] = adjacencyOffset[v] + liveValence[v];
+
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+        for (uint32_t i = 0; i < indices.size(); ++i)
+            adjacency[fill[indices[i]]++] = i / 3;
+    }
+
+    // Initial scores. No vertices are in the cache.
+    std::vector<float> vertexScore(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v)
+        vertexScore[v] = kScores.getScore(kCacheSize, liveValence[v]);
+
+    std::vector<float> triangleScore(triangleCount);
+    for (uint32_t t = 0; t < triangleCount; ++t)
+        triangleScore[t] = vertexScore[indices[3 * t]] + vertexScore[indices[3 * t + 1]] + vertexScore[indices[3 * t + 2]];
+
+    std::vector<uint32_t> order;
+    order.reserve(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+
+    // The cache holds up to three additional entries while a triangle is being added.
+    uint32_t cache[kCacheSize + 3];
+    uint32_t newCache[kCacheSize + 3];
+    uint32_t cacheCount = 0;
+
+    uint32_t bestTriangle = kInvalidIndex;
+    uint32_t cursor = 0;
+
+    while (order.size() < triangleCount)
+    {
+        // Fall back to the next not yet emitted triangle in input order if no triangle in the cache is available.
+        if (bestTriangle == kInvalidIndex)
+        {
+            while (emitted[cursor])
+                cursor++;
+            bestTriangle = cursor;
+        }
+
+        const uint32_t t = bestTriangle;
+        order.push_back(t);
+        emitted[t] = true;
+
+        // Remove the triangle from the adjacency lists of its vertices.
+        const uint32_t tri[3] = {indices[3 * t], indices[3 * t + 1], indices[3 * t + 2]};
+        for (uint32_t v : tri)
+        {
+            uint32_t* pAdjacency = adjacency.data() + adjacencyOffset[v];
+            uint32_t& count = liveValence[v];
+            auto it = std::find(pAdjacency, pAdjacency + count, t);
+            FALCOR_ASSERT(it != pAdjacency + count);
+            *it = pAdjacency[--count];
+        }
+
+        // Move the triangle's vertices to the front of the cache.
+        uint32_t newCacheCount = 0;
+        for (uint32_t v : tri)
+        {
+            if (std::find(newCache, newCache + newCacheCount, v) == newCache + newCacheCount)
+                newCache[newCacheCount++] = v;
+        }
+        for (uint32_t i = 0; i < cacheCount; ++i)
+        {
+            const uint32_t v = cache[i];
+            if (v != tri[0] && v != tri[1] && v != tri[2])
+                newCache[newCacheCount++] = v;
+        }
+
+        // Update scores of the vertices in the cache (including the ones that were just evicted) and propagate the
+        // change to their remaining triangles. At the same time, pick the best remaining triangle using a cached vertex.
+        // Triangles are compared as their scores are updated, which is slightly approximate but avoids a second pass.
+        bestTriangle = kInvalidIndex;
+        float bestScore = -std::numeric_limits<float>::infinity();
+        for (uint32_t i = 0; i < newCacheCount; ++i)
+        {
+            const uint32_t v = newCache[i];
+            const float score = kScores.getScore(i, liveValence[v]);
+            const float delta = score - vertexScore[v];
+            vertexScore[v] = score;
+
+            const bool inCache = i < kCacheSize;
+            const uint32_t* pAdjacency = adjacency.data() + adjacencyOffset[v];
+            for (uint32_t j = 0; j < liveValence[v]; ++j)
+            {
+                const uint32_t candidate = pAdjacency[j];
+                triangleScore[candidate] += delta;
+                if (inCache && triangleScore[candidate] > bestScore)
+                {
+                    bestScore = triangleScore[candidate];
+                    bestTriangle = candidate;
+                }
+            }
+        }
+
+        cacheCount = std::min(newCacheCount, kCacheSize);
+        std::copy(newCache, newCache + cacheCount, cache);
+    }
+
+    // Write the triangles in the new order.
+    std::vector<uint32_t> reordered(indices.size());
+    for (uint32_t i = 0; i < triangleCount; ++i)
+    {
+        const uint32_t t = order[i];
+        reordered[3 * i + 0] = indices[3 * t + 0];
+        reordered[3 * i + 1] = indices[3 * t + 1];
+        reordered[3 * i + 2] = indices[3 * t + 2];
+    }
+    std::copy(reordered.begin(), reordered.end(), indices.begin());
+}
+
+std::vector<uint32_t> optimizeVertexFetch(fstd::span<uint32_t> indices, uint32_t vertexCount)
+{
+    checkIndices(indices, vertexCount);
+
+    std::vector<uint32_t> remap(vertexCount, kInvalidIndex);
+    uint32_t nextVertex = 0;
+    for (uint32_t& index : indices)
+    {
+        if (remap[index] == kInvalidIndex)
+            remap[index] = nextVertex++;
+        index = remap[index];
+    }
+
+    // Keep unreferenced vertices at the end so the remap stays a permutation.
+    for (uint32_t& newIndex : remap)
+    {
+        if (newIndex == kInvalidIndex)
+            newIndex = nextVertex++;
+    }
+    FALCOR_ASSERT(nextVertex == vertexCount);
+
+    return remap;
+}
+} // namespace Falcor
@@ -0,0 +1,89 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include <fstd/span.h>
+#include <cstdint>
+#include <vector>
+
+namespace Falcor
+{
+/**
+ * Post-transform vertex cache statistics of an indexed triangle list.
+ * Statistics of multiple meshes can be accumulated with operator+=.
+ */
+struct VertexCacheStats
+{
+    uint64_t triangleCount = 0;  ///< Number of triangles.
+    uint64_t vertexCount = 0;    ///< Number of unique vertices referenced by the triangles.
+    uint64_t transformCount = 0; ///< Number of vertex shader invocations (cache misses).
+
+    /// Average cache miss ratio, i.e. the number of transformed vertices per triangle. Lies in [0.5, 3], lower is better.
+    float getACMR() const { return triangleCount > 0 ? float(transformCount) / float(triangleCount) : 0.f; }
+
+    /// Average transform to vertex ratio, i.e. the number of times each vertex is transformed. Ideal value is 1.
+    float getATVR() const { return vertexCount > 0 ? float(transformCount) / float(vertexCount) : 0.f; }
+
+    VertexCacheStats& operator+=(const VertexCacheStats& other)
+    {
+        triangleCount += other.triangleCount;
+        vertexCount += other.vertexCount;
+        transformCount += other.transformCount;
+        return *this;
+    }
+};
+
+/**
+ * Simulate a FIFO post-transform vertex cache for an indexed triangle list.
+ * @param[in] indices Triangle list indices.
+ * @param[in] vertexCount Number of vertices. All indices must be smaller than this.
+ * @param[in] cacheSize Number of entries in the simulated cache.
+ * @return Vertex cache statistics.
+ */
+FALCOR_API VertexCacheStats analyzeVertexCache(fstd::span<const uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize = 16);
+
+/**
+ * Reorder triangles to improve post-transform vertex cache utilization.
+ * This implements Tom Forsyth's linear-speed vertex cache optimization. The algorithm does not depend on the
+ * exact cache size of the hardware and works well for both FIFO and LRU caches.
+ * The set of triangles and their winding is preserved, only the triangle order is changed.
+ * @param[in,out] indices Triangle list indices, reordered in place.
+ * @param[in] vertexCount Number of vertices. All indices must be smaller than this.
+ */
+FALCOR_API void optimizeVertexCache(fstd::span<uint32_t> indices, uint32_t vertexCount);
+
+/**
+ * Reorder vertices in the order they are first referenced by the index buffer to improve vertex fetch locality.
+ * This should be run after optimizeVertexCache(). The indices are rewritten to reference the new vertex order.
+ * Vertices not referenced by any triangle are placed at the end, in their original order.
+ * @param[in,out] indices Triangle list indices, remapped in place.
+ * @param[in] vertexCount Number of vertices. All indices must be smaller than this.
+ * @return Mapping from old to new vertex indices. The vertex data must be permuted as newData[remap[i]] = oldData[i].
+ */
+FALCOR_API std::vector<uint32_t> optimizeVertexFetch(fstd::span<uint32_t> indices, uint32_t vertexCount);
+} // namespace Falcor
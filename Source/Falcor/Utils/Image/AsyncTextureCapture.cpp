@@ -0,0 +1,241 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "AsyncTextureCapture.h"
+#include "ExrWriter.h"
+#include "Core/API/Device.h"
+#include "Core/API/RenderContext.h"
+#include "Utils/Logger.h"
+#include "Utils/Timing/TraceRecorder.h"
+
+namespace Falcor
+{
+AsyncTextureCapture::AsyncTextureCapture(ref<Device> pDevice, const Options& options)
+    : mpDevice(pDevice), mOptions(options), mThreadPool(std::max(1u, options.threadCount))
+{
+    FALCOR_CHECK(mOptions.maxInFlightFrames > 0, "'maxInFlightFrames' must be greater than zero.");
+}
+
+AsyncTextureCapture::~AsyncTextureCapture()
+{
+    flush();
+}
+
+void AsyncTextureCapture::captureToFile(
+    RenderContext* pRenderContext,
+    const ref<Texture>& pTexture,
+    const std::filesystem::path& path,
+    Bitmap::FileFormat format,
+    Bitmap::ExportFlags exportFlags,
+    uint32_t mipLevel,
+    uint32_t arraySlice
+)
+{
+    FALCOR_CHECK(pTexture, "'pTexture' must not be null.");
+    FALCOR_CHECK(format != Bitmap::FileFormat::DdsFile, "AsyncTextureCapture does not support saving to DDS.");
+    FALCOR_CHECK(pTexture->getType() == Texture::Type::Texture2D, "AsyncTextureCapture only supports 2D textures.");
+
+    ref<Texture> pSrc = pTexture;
+    uint32_t subresource = pTexture->getSubresourceIndex(arraySlice, mipLevel);
+    ResourceFormat resourceFormat = pTexture->getFormat();
+    uint32_t width = pTexture->getWidth(mipLevel);
+    uint32_t height = pTexture->getHeight(mipLevel);
+
+    // Handle the special case where we have an HDR texture with less then 3 channels (see Texture::captureToFile()).
+    if (getFormatType(resourceFormat) == FormatType::Float && getFormatChannelCount(resourceFormat) < 3)
+    {
+        pSrc = mpDevice->createTexture2D(
+            width, height, ResourceFormat::RGBA32Float, 1, 1, nullptr, ResourceBindFlags::RenderTarget | ResourceBindFlags::ShaderResource
+        );
+        pRenderContext->blit(pTexture->getSRV(mipLevel, 1, arraySlice, 1), pSrc->getRTV(0, 0, 1));
+        subresource = 0;
+        resourceFormat = ResourceFormat::RGBA32Float;
+    }
+
+    Capture capture;
+    capture.readbacks.push_back(pRenderContext->asyncReadTextureSubresource(pSrc.get(), subresource, acquireReadbackBuffer()));
+    capture.byteSize = capture.readbacks.back()->getDataSize();
+    capture.encode = [=](std::vector<std::vector<uint8_t>>& data)
+    { Bitmap::saveImage(path, width, height, format, exportFlags, resourceFormat, true, data[0].data()); };
+
+    submit(std::move(capture));
+}
+
+void AsyncTextureCapture::captureToMultiLayerExr(RenderContext* pRenderContext, fstd::span<const Layer> layers, const std::filesystem::path& path)
+{
+    FALCOR_CHECK(!layers.empty(), "No layers to capture.");
+
+    const uint32_t width = layers[0].pTexture->getWidth();
+    const uint32_t height = layers[0].pTexture->getHeight();
+
+    Capture capture;
+    std::vector<ExrWriter::Layer> exrLayers;
+    for (const auto& layer : layers)
+    {
+        const Texture* pTexture = layer.pTexture.get();
+        FALCOR_CHECK(pTexture, "Layer '{}' has no texture.", layer.name);
+        FALCOR_CHECK(pTexture->getType() == Texture::Type::Texture2D, "Layer '{}' is not a 2D texture.", layer.name);
+        FALCOR_CHECK(
+            pTexture->getWidth() == width && pTexture->getHeight() == height,
+            "Layer '{}' has mismatching dimensions ({}x{}, expected {}x{}).",
+            layer.name,
+            pTexture->getWidth(),
+            pTexture->getHeight(),
+            width,
+            height
+        );
+        ResourceFormat format = pTexture->getFormat();
+        FALCOR_CHECK(ExrWriter::isFormatSupported(format), "Layer '{}' has unsupported format {}.", layer.name, to_string(format));
+
+        exrLayers.push_back({layer.name, format, layer.channelMask, nullptr});
+
+        capture.readbacks.push_back(pRenderContext->asyncReadTextureSubresource(pTexture, 0, acquireReadbackBuffer()));
+        capture.byteSize += capture.readbacks.back()->getDataSize();
+    }
+
+    capture.encode = [=](std::vector<std::vector<uint8_t>>& data) mutable
+    {
+        for (size_t i = 0; i < exrLayers.size(); ++i)
+            exrLayers[i].pData = data[i].data();
+        ExrWriter::write(path, width, height, exrLayers);
+    };
+
+    submit(std::move(capture));
+}
+
+void AsyncTextureCapture::endFrame()
+{
+    ++mFrameIndex;
+    mMaxFrameReadbacks = std::max(mMaxFrameReadbacks, mFrameReadbacks);
+    mFrameReadbacks = 0;
+    poll();
+    retireOldFrames();
+}
+
+void AsyncTextureCapture::poll()
+{
+    while (!mInFlight.empty() && isReady(mInFlight.front()))
+    {
+        retire(mInFlight.front());
+        mInFlight.pop_front();
+    }
+}
+
+void AsyncTextureCapture::flush()
+{
+    while (!mInFlight.empty())
+    {
+        retire(mInFlight.front());
+        mInFlight.pop_front();
+    }
+    mThreadPool.wait_for_tasks();
+}
+
+void AsyncTextureCapture::submit(Capture&& capture)
+{
+    capture.frame = mFrameIndex;
+    mFrameReadbacks += capture.readbacks.size();
+    mPendingBytes += capture.byteSize;
+    mInFlight.push_back(std::move(capture));
+
+    poll();
+    retireOldFrames();
+
+    // Limit the memory held by pending captures. Retire readbacks first, then wait for the workers.
+    while (mPendingBytes > mOptions.maxPendingBytes && !mInFlight.empty())
+    {
+        retire(mInFlight.front());
+        mInFlight.pop_front();
+    }
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock, [&]() { return mPendingBytes <= mOptions.maxPendingBytes || mThreadPool.get_tasks_total() == 0; });
+}
+
+void AsyncTextureCapture::retireOldFrames()
+{
+    // Limit the number of frames in flight. Captures of the current frame are never waited on here.
+    while (!mInFlight.empty() && mInFlight.front().frame + mOptions.maxInFlightFrames <= mFrameIndex)
+    {
+        retire(mInFlight.front());
+        mInFlight.pop_front();
+    }
+}
+
+void AsyncTextureCapture::retire(Capture& capture)
+{
+    // Copy data out of the readback buffers. This waits for the GPU if the readback has not completed yet.
+    // Keep enough buffers for the frames in flight plus the frame being recorded.
+    const size_t maxFreeBuffers = (mOptions.maxInFlightFrames + 1) * std::max(mMaxFrameReadbacks, mFrameReadbacks);
+    std::vector<std::vector<uint8_t>> data;
+    data.reserve(capture.readbacks.size());
+    for (const auto& pReadback : capture.readbacks)
+    {
+        data.push_back(pReadback->getData());
+        if (mFreeBuffers.size() < maxFreeBuffers)
+            mFreeBuffers.push_back(pReadback->getBuffer());
+    }
+    capture.readbacks.clear();
+
+    mThreadPool.push_task(
+        [this, data = std::move(data), encode = std::move(capture.encode), byteSize = capture.byteSize]() mutable
+        {
+            FALCOR_PROFILE_CPU("AsyncTextureCapture::encode");
+            try
+            {
+                encode(data);
+            }
+            catch (const std::exception& e)
+            {
+                logError("AsyncTextureCapture: {}", e.what());
+            }
+            data.clear();
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mPendingBytes -= byteSize;
+            }
+            mCondition.notify_all();
+        }
+    );
+}
+
+bool AsyncTextureCapture::isReady(const Capture& capture) const
+{
+    for (const auto& pReadback : capture.readbacks)
+        if (!pReadback->isReady())
+            return false;
+    return true;
+}
+
+ref<Buffer> AsyncTextureCapture::acquireReadbackBuffer()
+{
+    if (mFreeBuffers.empty())
+        return nullptr;
+    ref<Buffer> pBuffer = std::move(mFreeBuffers.back());
+    mFreeBuffers.pop_back();
+    return pBuffer;
+}
+} // namespace Falcor
@@ -0,0 +1,173 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Bitmap.h"
+#include "Core/Macros.h"
+#include "Core/API/fwd.h"
+#include "Core/API/CopyContext.h"
+#include "Core/API/Texture.h"
+#include <BS_thread_pool/BS_thread_pool.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <fstd/span.h>
+
+namespace Falcor
+{
+class RenderContext;
+
+/**
+ * Utility class to capture textures to image files without stalling the GPU.
+ * Captures are pipelined: texture readbacks are recorded on the render context and complete via fences,
+ * completed readbacks are handed to a pool of worker threads that encode and write the image files.
+ * The number of frames with readbacks in flight and the memory held by pending captures are bounded; when a limit
+ * is reached, capturing blocks until earlier captures have completed (backpressure).
+ * Call endFrame() once per frame so that the in-flight limit is counted in frames rather than individual captures.
+ */
+class FALCOR_API AsyncTextureCapture
+{
+public:
+    struct Options
+    {
+        // Note: Empty constructor needed for gcc/clang due to the use of the nested struct as a default argument.
+        Options() {}
+        uint32_t maxInFlightFrames = 2;        ///< Maximum number of frames with captures waiting for GPU readback.
+        uint64_t maxPendingBytes = 2ull << 30; ///< Maximum memory held by captures that are not yet written.
+        uint32_t threadCount = 4;              ///< Number of worker threads for encoding and writing files.
+    };
+
+    struct Layer
+    {
+        std::string name;                                            ///< Layer name.
+        ref<Texture> pTexture;                                       ///< Texture to capture (mip 0, array slice 0).
+        TextureChannelFlags channelMask = TextureChannelFlags::RGBA; ///< Channels to write (channels not in the format are ignored).
+    };
+
+    /**
+     * Constructor.
+     * @param[in] pDevice GPU device.
+     * @param[in] options Capture options.
+     */
+    AsyncTextureCapture(ref<Device> pDevice, const Options& options = Options());
+
+    /**
+     * Destructor.
+     * Blocks until all pending captures have been written.
+     */
+    ~AsyncTextureCapture();
+
+    /**
+     * Capture a texture subresource to an image file.
+     * @param[in] pRenderContext Render context used to read back the texture.
+     * @param[in] pTexture Texture to capture (must be a 2D texture).
+     * @param[in] path Path of the file to write.
+     * @param[in] format Destination image file format.
+     * @param[in] exportFlags Save flags, see Bitmap::ExportFlags.
+     * @param[in] mipLevel Mip level to capture.
+     * @param[in] arraySlice Array slice to capture.
+     */
+    void captureToFile(
+        RenderContext* pRenderContext,
+        const ref<Texture>& pTexture,
+        const std::filesystem::path& path,
+        Bitmap::FileFormat format = Bitmap::FileFormat::PngFile,
+        Bitmap::ExportFlags exportFlags = Bitmap::ExportFlags::None,
+        uint32_t mipLevel = 0,
+        uint32_t arraySlice = 0
+    );
+
+    /**
+     * Capture multiple textures to a single multi-layer EXR file.
+     * All textures must have the same dimensions and a format supported by ExrWriter.
+     * @param[in] pRenderContext Render context used to read back the textures.
+     * @param[in] layers Layers to capture.
+     * @param[in] path Path of the file to write.
+     */
+    void captureToMultiLayerExr(RenderContext* pRenderContext, fstd::span<const Layer> layers, const std::filesystem::path& path);
+
+    /**
+     * Mark the end of a frame.
+     * Captures submitted since the previous call belong to the same frame and are never waited on to satisfy
+     * the in-flight frame limit. Captures of frames older than the limit are retired, waiting for the GPU if needed.
+     */
+    void endFrame();
+
+    /**
+     * Hand completed readbacks to the worker threads without blocking.
+     * This is called by the capture functions, but can be called once per frame to reduce latency.
+     */
+    void poll();
+
+    /**
+     * Block until all pending captures have been written.
+     */
+    void flush();
+
+    /**
+     * Get the memory currently held by captures that are not yet written.
+     */
+    uint64_t getPendingBytes() const { return mPendingBytes.load(); }
+
+private:
+    using EncodeFunc = std::function<void(std::vector<std::vector<uint8_t>>& data)>;
+
+    struct Capture
+    {
+        std::vector<CopyContext::ReadTextureTask::SharedPtr> readbacks;
+        EncodeFunc encode;
+        uint64_t byteSize = 0;
+        uint64_t frame = 0;
+    };
+
+    void submit(Capture&& capture);
+    void retireOldFrames();
+    void retire(Capture& capture);
+    bool isReady(const Capture& capture) const;
+    ref<Buffer> acquireReadbackBuffer();
+
+    ref<Device> mpDevice;
+    Options mOptions;
+
+    std::deque<Capture> mInFlight;          ///< Captures waiting for GPU readback (in submission order).
+    std::vector<ref<Buffer>> mFreeBuffers;  ///< Readback buffers available for reuse.
+    uint64_t mFrameIndex = 0;               ///< Index of the current frame.
+    size_t mFrameReadbacks = 0;             ///< Number of readbacks submitted in the current frame.
+    size_t mMaxFrameReadbacks = 0;          ///< Maximum number of readbacks submitted in a single frame.
+
+    std::atomic<uint64_t> mPendingBytes{0}; ///< Memory held by captures not yet written.
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+
+    BS::thread_pool mThreadPool;
+};
+} // namespace Falcor
@@ -26,15 +26,68 @@
  # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  **************************************************************************/
 #include "AsyncTextureLoader.h"
+#include "CookedTextureCache.h"
 #include "Core/API/Device.h"
+#include "Core/Platform/OS.h"
 #include "Utils/Threading.h"
+#include "Utils/Timing/TraceRecorder.h"
 
 namespace Falcor
 {
 namespace
 {
 constexpr size_t kUploadsPerFlush = 16; ///< Number of texture uploads before issuing a flush (to keep upload heap from growing).
+
+/**
+ * Load a texture and generate its mip chain on the calling thread.
+ * All mips are uploaded at once, no work is done on the render context apart from the upload.
+ */
+ref<Texture> createFromFileWithCpuMips(
+    ref<Device> pDevice,
+    const std::filesystem::path& path,
+    bool loadAsSrgb,
+    ResourceBindFlags bindFlags,
+    Bitmap::ImportFlags importFlags,
+    const CpuMipGenerator::Options& options
+)
+{
+    // DDS files store their mips explicitly.
+    if (hasExtension(path, "dds") || !std::filesystem::exists(path))
+        return Texture::createFromFile(pDevice, path, true, loadAsSrgb, bindFlags, importFlags);
+
+    Bitmap::UniqueConstPtr pBitmap = Bitmap::createFromFile(path, true, importFlags);
+    if (!pBitmap)
+        return nullptr;
+
+    const uint32_t width = pBitmap->getWidth();
+    const uint32_t height = pBitmap->getHeight();
+    ResourceFormat format = pBitmap->getFormat();
+    if (loadAsSrgb)
+        format = linearToSrgbFormat(format);
+
+    ref<Texture> pTexture;
+    if (CpuMipGenerator::isFormatSupported(format))
+    {
+        std::vector<uint8_t> mips;
+        {
+            FALCOR_PROFILE_CPU("generateMips");
+            mips = CpuMipGenerator::generate(width, height, format, pBitmap->getData(), options);
+        }
+        pTexture = pDevice->createTexture2D(width, height, format, 1, CpuMipGenerator::getMipCount(width, height), mips.data(), bindFlags);
+    }
+    else
+    {
+        pTexture = pDevice->createTexture2D(width, height, format, 1, Texture::kMaxPossible, pBitmap->getData(), bindFlags);
+    }
+
+    if (pTexture)
+    {
+        pTexture->setSourcePath(path);
+        pTexture->setImportFlags(importFlags);
+    }
+    return pTexture;
 }
+} // namespace
 
 AsyncTextureLoader::AsyncTextureLoader(ref<Device> pDevice, size_t threadCount) : mpDevice(pDevice)
 {
@@ -77,6 +130,33 @@ std::future<ref<Texture>> AsyncTextureLoader::loadFromFile(
     return mLoadRequestQueue.back().promise.get_future();
 }
 
+void AsyncTextureLoader::setCookedTextureCache(std::shared_ptr<CookedTextureCache> pCache)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mpCookedTextureCache = std::move(pCache);
+}
+
+std::shared_ptr<CookedTextureCache> AsyncTextureLoader::getCookedTextureCache() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mpCookedTextureCache;
+}
+
+void AsyncTextureLoader::setCpuMipGeneration(bool enabled, const CpuMipGenerator::Options& options)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (enabled)
+        mCpuMipOptions = options;
+    else
+        mCpuMipOptions.reset();
+}
+
+bool AsyncTextureLoader::isCpuMipGenerationEnabled() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mCpuMipOptions.has_value();
+}
+
 void AsyncTextureLoader::runWorkers(size_t threadCount)
 {
     // Create a barrier to synchronize worker threads before issuing a global flush.
@@ -103,6 +183,8 @@ void AsyncTextureLoader::runWorker()
     // To avoid the upload heap growing too large, we synchronize the threads and
     // issue a global GPU flush at regular intervals.
 
+    TraceRecorder::setThreadName("AsyncTextureLoader");
+
     while (true)
     {
         // Wait on condition until more work is ready.
@@ -129,20 +211,38 @@ void AsyncTextureLoader::runWorker()
         // Pop next load request from queue.
         auto request = std::move(mLoadRequestQueue.front());
         mLoadRequestQueue.pop();
+        auto pCache = mpCookedTextureCache;
+        auto cpuMipOptions = mCpuMipOptions;
 
         lock.unlock();
 
         // Load the textures (this part is running in parallel).
         ref<Texture> pTexture;
-        if (request.paths.size() == 1)
-        {
-            pTexture = Texture::createFromFile(
-                mpDevice, request.paths[0], request.generateMipLevels, request.loadAsSRGB, request.bindFlags, request.importFlags
-            );
-        }
-        else
         {
-            pTexture = Texture::createMippedFromFiles(mpDevice, request.paths, request.loadAsSRGB, request.bindFlags, request.importFlags);
+            FALCOR_PROFILE_CPU("loadTexture");
+            if (request.paths.size() == 1 && pCache)
+            {
+                pTexture = pCache->loadFromFile(
+                    request.paths[0], request.generateMipLevels, request.loadAsSRGB, request.bindFlags, request.importFlags
+                );
+            }
+            else if (request.paths.size() == 1 && request.generateMipLevels && cpuMipOptions)
+            {
+                pTexture = createFromFileWithCpuMips(
+                    mpDevice, request.paths[0], request.loadAsSRGB, request.bindFlags, request.importFlags, *cpuMipOptions
+                );
+            }
+            else if (request.paths.size() == 1)
+            {
+                pTexture = Texture::createFromFile(
+                    mpDevice, request.paths[0], request.generateMipLevels, request.loadAsSRGB, request.bindFlags, request.importFlags
+                );
+            }
+            else
+            {
+                pTexture =
+                    Texture::createMippedFromFiles(mpDevice, request.paths, request.loadAsSRGB, request.bindFlags, request.importFlags);
+            }
         }
 
         request.promise.set_value(pTexture);
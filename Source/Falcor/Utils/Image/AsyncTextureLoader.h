@@ -26,6 +26,7 @@
  # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  **************************************************************************/
 #pragma once
+#include "CpuMipGenerator.h"
 #include "Core/Macros.h"
 #include "Core/API/fwd.h"
 #include "Core/API/Resource.h"
@@ -35,6 +36,7 @@
 #include <functional>
 #include <future>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <thread>
 #include <vector>
@@ -43,6 +45,7 @@
 namespace Falcor
 {
 class Barrier;
+class CookedTextureCache;
 
 /**
  * Utility class to load textures asynchronously using multiple worker threads.
@@ -100,6 +103,33 @@ public:
         LoadCallback callback = {}
     );
 
+    /**
+     * Set a persistent texture cache. Single-file texture loads are served from the cache when possible,
+     * and cooked into the cache otherwise. Pass nullptr to disable caching.
+     * @param[in] pCache Texture cache, or nullptr.
+     */
+    void setCookedTextureCache(std::shared_ptr<CookedTextureCache> pCache);
+
+    /**
+     * Get the persistent texture cache, or nullptr if not set.
+     */
+    std::shared_ptr<CookedTextureCache> getCookedTextureCache() const;
+
+    /**
+     * Enable generating mip chains on the loader threads instead of on the GPU.
+     * When enabled, textures loaded with generateMipLevels have their mips built with CpuMipGenerator
+     * and all mips are uploaded at once. Formats not supported by CpuMipGenerator fall back to GPU generation.
+     * Loads served through the cooked texture cache are not affected.
+     * @param[in] enabled True to generate mips on the CPU.
+     * @param[in] options Mip generation options.
+     */
+    void setCpuMipGeneration(bool enabled, const CpuMipGenerator::Options& options = CpuMipGenerator::Options());
+
+    /**
+     * Check if mip chains are generated on the loader threads.
+     */
+    bool isCpuMipGenerationEnabled() const;
+
 private:
     void runWorkers(size_t threadCount);
     void runWorker();
@@ -118,13 +148,15 @@ private:
 
     ref<Device> mpDevice;
 
-    std::mutex mMutex;                      ///< Mutex for synchronizing access to shared resources.
+    mutable std::mutex mMutex;              ///< Mutex for synchronizing access to shared resources.
     std::condition_variable mCondition;     ///< Condition variable for workers to wait on.
     std::shared_ptr<Barrier> mFlushBarrier; ///< Barrier for flushing the GPU to upload textures.
     std::vector<std::thread> mThreads;      ///< Worker threads.
 
     // Internal state. Do not access outside of critical section.
-    std::queue<LoadRequest> mLoadRequestQueue; ///< Texture loading request queue.
+    std::queue<LoadRequest> mLoadRequestQueue;                ///< Texture loading request queue.
+    std::shared_ptr<CookedTextureCache> mpCookedTextureCache; ///< Optional persistent texture cache.
+    std::optional<CpuMipGenerator::Options> mCpuMipOptions;   ///< Options for CPU mip generation, or empty to generate mips on the GPU.
 
     bool mTerminate = false;     ///< Flag to terminate worker threads.
     bool mFlushPending = false;  ///< Flag to indicate a GPU flush is pending.
@@ -26,6 +26,7 @@
  # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  **************************************************************************/
 #include "Bitmap.h"
+#include "ExrWriter.h"
 #include "Core/Macros.h"
 #include "Core/API/Texture.h"
 #include "Core/Platform/MemoryMappedFile.h"
@@ -205,6 +206,52 @@ static std::vector<float> convertToRGBA32Float(ResourceFormat format, uint32_t w
     return floatData;
 }
 
+/**
+ * Saves an image as EXR file using the parallel EXR writer.
+ * Float and half-float RGB(A) data is written in place, other formats are converted to RGBA float first.
+ */
+static void saveExr(
+    const std::filesystem::path& path,
+    uint32_t width,
+    uint32_t height,
+    Bitmap::ExportFlags exportFlags,
+    ResourceFormat resourceFormat,
+    const void* pData
+)
+{
+    std::vector<float> floatData;
+    bool writeInPlace = ExrWriter::isFormatSupported(resourceFormat) && getFormatChannelCount(resourceFormat) >= 3;
+    if (!writeInPlace)
+    {
+        if (!isConvertibleToRGBA32Float(resourceFormat))
+            FALCOR_THROW("Only support for 32-bit/channel RGB/RGBA or 16-bit RGBA images as PFM/EXR files.");
+        floatData = convertToRGBA32Float(resourceFormat, width, height, pData);
+        pData = floatData.data();
+        resourceFormat = ResourceFormat::RGBA32Float;
+    }
+
+    const bool exportAlpha = is_set(exportFlags, Bitmap::ExportFlags::ExportAlpha);
+    if (exportAlpha && getFormatChannelCount(resourceFormat) != 4)
+        FALCOR_THROW("Requesting to export alpha-channel to EXR file, but the resource doesn't have an alpha-channel");
+
+    // Use the same compression and pixel types as the previous FreeImage based export:
+    // half-float with PIZ by default, B44 for lossy, and uncompressed float unless float16 is requested.
+    ExrWriter::Layer layer{"", resourceFormat, exportAlpha ? TextureChannelFlags::RGBA : TextureChannelFlags::RGB, pData, true};
+    ExrWriter::Options options;
+    options.compression = ExrWriter::Compression::Piz;
+    if (is_set(exportFlags, Bitmap::ExportFlags::Uncompressed))
+    {
+        options.compression = ExrWriter::Compression::None;
+        layer.writeHalf = is_set(exportFlags, Bitmap::ExportFlags::ExrFloat16);
+    }
+    else if (is_set(exportFlags, Bitmap::ExportFlags::Lossy))
+    {
+        options.compression = ExrWriter::Compression::B44;
+    }
+
+    ExrWriter::write(path, width, height, fstd::span<const ExrWriter::Layer>(&layer, 1), options);
+}
+
 /**
  * Converts 96bpp to 128bpp RGBA without clamping.
  * Note that we can't use FreeImage_ConvertToRGBAF() as it clamps to [0,1].
@@ -628,7 +675,13 @@ void Bitmap::saveImage(
         }
     }
 
-    if (fileFormat == Bitmap::FileFormat::PfmFile || fileFormat == Bitmap::FileFormat::ExrFile)
+    if (fileFormat == Bitmap::FileFormat::ExrFile)
+    {
+        saveExr(path, width, height, exportFlags, resourceFormat, pData);
+        return;
+    }
+
+    if (fileFormat == Bitmap::FileFormat::PfmFile)
     {
         std::vector<float> floatData;
         if (isConvertibleToRGBA32Float(resourceFormat))
@@ -678,21 +731,6 @@ void Bitmap::saveImage(
             }
             head += bytesPerPixel * width;
         }
-
-        if (fileFormat == Bitmap::FileFormat::ExrFile)
-        {
-            flags = 0;
-            if (is_set(exportFlags, ExportFlags::Uncompressed))
-            {
-                flags |= EXR_NONE;
-                if (!is_set(exportFlags, ExportFlags::ExrFloat16))
-                    flags |= EXR_FLOAT;
-            }
-            else if (is_set(exportFlags, ExportFlags::Lossy))
-            {
-                flags |= EXR_B44 | EXR_ZIP;
-            }
-        }
     }
     else
     {
@@ -0,0 +1,487 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "CookedTextureCache.h"
+#include "Core/Error.h"
+#include "Core/API/Device.h"
+#include "Core/API/NativeFormats.h"
+#include "Core/API/RenderContext.h"
+#include "Core/Platform/MemoryMappedFile.h"
+#include "Core/Platform/OS.h"
+#include "Utils/CryptoUtils.h"
+#include "Utils/Logger.h"
+#include "Utils/Timing/TraceRecorder.h"
+#include <dds_header/DDSHeader.h>
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+/// Version of the cooked file layout. Bump to invalidate existing caches.
+constexpr uint32_t kCacheVersion = 1;
+
+const std::string kCacheExtension = ".dds";
+const std::string kTempExtension = ".tmp";
+const std::string kSourceStampsFilename = "sources.json";
+
+std::string computeContentHash(const std::filesystem::path& path)
+{
+    MemoryMappedFile file(path, MemoryMappedFile::kWholeFile, MemoryMappedFile::AccessHint::SequentialScan);
+    if (!file.isOpen())
+        return {};
+
+    SHA1 sha1;
+    sha1.update(file.getData(), file.getSize());
+    return SHA1::toString(sha1.finalize());
+}
+
+std::string computeKey(
+    const std::string& contentHash,
+    bool generateMipLevels,
+    bool loadAsSrgb,
+    Bitmap::ImportFlags importFlags,
+    ImageIO::CompressionMode compression
+)
+{
+    SHA1 sha1;
+    sha1.update(kCacheVersion);
+    sha1.update(generateMipLevels);
+    sha1.update(loadAsSrgb);
+    sha1.update(static_cast<uint32_t>(importFlags));
+    sha1.update(static_cast<uint32_t>(compression));
+    sha1.update(contentHash.data(), contentHash.size());
+    return SHA1::toString(sha1.finalize());
+}
+
+bool isCompressible(const Texture* pTexture)
+{
+    // Only 8-bit RGBA formats are block compressed. The base resolution must be a multiple of 4 (DX spec),
+    // otherwise the exporter would have to clamp the image dimensions.
+    switch (pTexture->getFormat())
+    {
+    case ResourceFormat::RGBA8Unorm:
+    case ResourceFormat::RGBA8UnormSrgb:
+    case ResourceFormat::BGRA8Unorm:
+    case ResourceFormat::BGRA8UnormSrgb:
+    case ResourceFormat::BGRX8Unorm:
+    case ResourceFormat::BGRX8UnormSrgb:
+        return pTexture->getWidth() % 4 == 0 && pTexture->getHeight() % 4 == 0;
+    default:
+        return false;
+    }
+}
+
+/// Write a 2D texture with all its mips to a DDS file with DX10 header. Subresources are tightly packed.
+void writeDDS(const std::filesystem::path& path, const Texture* pTexture, const std::vector<std::vector<uint8_t>>& subresources)
+{
+    DDS_HEADER header = {};
+    header.size = sizeof(DDS_HEADER);
+    header.flags = DDS_HEADER_FLAGS_TEXTURE | DDS_HEADER_FLAGS_MIPMAP;
+    header.width = pTexture->getWidth();
+    header.height = pTexture->getHeight();
+    header.mipMapCount = pTexture->getMipCount();
+    header.ddspf.size = sizeof(DDS_PIXELFORMAT);
+    header.ddspf.flags = DDS_FOURCC;
+    header.ddspf.fourCC = MAKEFOURCC('D', 'X', '1', '0');
+    header.caps = DDS_SURFACE_FLAGS_TEXTURE | (header.mipMapCount > 1 ? DDS_SURFACE_FLAGS_MIPMAP : 0);
+
+    DDS_HEADER_DXT10 dx10Header = {};
+    dx10Header.dxgiFormat = getDxgiFormat(pTexture->getFormat());
+    dx10Header.resourceDimension = DDS_DIMENSION_TEXTURE2D;
+    dx10Header.arraySize = 1;
+
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if (!stream)
+        FALCOR_THROW("Failed to open '{}' for writing.", path);
+
+    const uint32_t magic = DDS_MAGIC;
+    stream.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream.write(reinterpret_cast<const char*>(&dx10Header), sizeof(dx10Header));
+    for (const auto& data : subresources)
+        stream.write(reinterpret_cast<const char*>(data.data()), data.size());
+
+    if (!stream)
+        FALCOR_THROW("Failed to write '{}'.", path);
+}
+
+/// Get a temporary file path next to the final cache file. Files are written there first and then renamed,
+/// so concurrent loaders (in this or other processes) never observe partially written files.
+/// The temporary file keeps the extension of the final file (e.g. '<key>.<tid>.<n>.tmp.dds'), which the DDS writer expects.
+std::filesystem::path getTempPath(const std::filesystem::path& cachePath)
+{
+    static std::atomic<uint64_t> counter{0};
+    auto tempPath = cachePath.parent_path() / cachePath.stem();
+    tempPath += fmt::format(".{}.{}{}", std::hash<std::thread::id>{}(std::this_thread::get_id()), counter.fetch_add(1), kTempExtension);
+    tempPath += cachePath.extension();
+    return tempPath;
+}
+
+/// Check if a path is a temporary file written by getTempPath().
+bool isTempPath(const std::filesystem::path& path)
+{
+    return path.stem().extension() == kTempExtension;
+}
+} // namespace
+
+CookedTextureCache::CookedTextureCache(ref<Device> pDevice, const Options& options) : mpDevice(pDevice), mOptions(options)
+{
+    FALCOR_CHECK(!mOptions.directory.empty(), "Cache directory must not be empty.");
+
+    std::error_code ec;
+    std::filesystem::create_directories(mOptions.directory, ec);
+    if (!std::filesystem::is_directory(mOptions.directory))
+        FALCOR_THROW("Failed to create texture cache directory '{}'.", mOptions.directory);
+
+    // Build the index from the cooked files on disk.
+    for (const auto& entry : std::filesystem::directory_iterator(mOptions.directory, ec))
+    {
+        // Skip files that are being written by other processes or were left behind by an interrupted write.
+        if (!entry.is_regular_file(ec) || entry.path().extension() != kCacheExtension || isTempPath(entry.path()))
+            continue;
+        Entry e;
+        e.size = entry.file_size(ec);
+        e.lastAccess = entry.last_write_time(ec);
+        if (ec)
+            continue;
+        mEntries[entry.path().stem().string()] = e;
+        mTotalSize += e.size;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        evict();
+    }
+
+    loadSourceStamps();
+
+    logInfo("Texture cache '{}' holds {} textures ({:.1f} MB).", mOptions.directory, mEntries.size(), mTotalSize / (1024.0 * 1024.0));
+}
+
+CookedTextureCache::~CookedTextureCache()
+{
+    saveSourceStamps();
+}
+
+ref<Texture> CookedTextureCache::loadFromFile(
+    const std::filesystem::path& path,
+    bool generateMipLevels,
+    bool loadAsSrgb,
+    ResourceBindFlags bindFlags,
+    Bitmap::ImportFlags importFlags
+)
+{
+    // DDS files are already stored in an uploadable format.
+    if (hasExtension(path, "dds"))
+        return Texture::createFromFile(mpDevice, path, generateMipLevels, loadAsSrgb, bindFlags, importFlags);
+
+    std::string key;
+    {
+        FALCOR_PROFILE_CPU("CookedTextureCache::computeKey");
+        std::string contentHash = getSourceHash(path);
+        if (!contentHash.empty())
+            key = computeKey(contentHash, generateMipLevels, loadAsSrgb, importFlags, mOptions.compression);
+    }
+    if (key.empty())
+        return Texture::createFromFile(mpDevice, path, generateMipLevels, loadAsSrgb, bindFlags, importFlags);
+
+    const std::filesystem::path cachePath = getCachePath(key);
+
+    bool cached = false;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        cached = mEntries.find(key) != mEntries.end();
+    }
+
+    if (cached)
+    {
+        ref<Texture> pTexture = ImageIO::loadTextureFromDDS(mpDevice, cachePath, loadAsSrgb, bindFlags);
+        if (pTexture)
+        {
+            pTexture->setSourcePath(path);
+            pTexture->setImportFlags(importFlags);
+            touch(key);
+            return pTexture;
+        }
+
+        // The entry was evicted concurrently or the file is invalid. Drop it and cook again.
+        remove(key);
+    }
+
+    ref<Texture> pTexture = Texture::createFromFile(mpDevice, path, generateMipLevels, loadAsSrgb, bindFlags, importFlags);
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStats.misses++;
+    }
+
+    if (pTexture && cook(pTexture, cachePath))
+    {
+        std::error_code ec;
+        uint64_t size = std::filesystem::file_size(cachePath, ec);
+        if (!ec)
+            insert(key, size);
+    }
+
+    return pTexture;
+}
+
+void CookedTextureCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (const auto& [key, entry] : mEntries)
+    {
+        std::error_code ec;
+        std::filesystem::remove(getCachePath(key), ec);
+    }
+    mEntries.clear();
+    mTotalSize = 0;
+}
+
+uint64_t CookedTextureCache::getSize() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mTotalSize;
+}
+
+size_t CookedTextureCache::getEntryCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mEntries.size();
+}
+
+CookedTextureCache::Stats CookedTextureCache::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mStats;
+}
+
+std::string CookedTextureCache::getSourceHash(const std::filesystem::path& path)
+{
+    std::error_code ec;
+    const std::filesystem::path absolutePath = std::filesystem::absolute(path, ec);
+    const uint64_t size = std::filesystem::file_size(absolutePath, ec);
+    if (ec)
+        return {};
+    const int64_t modificationTime = std::filesystem::last_write_time(absolutePath, ec).time_since_epoch().count();
+    if (ec)
+        return {};
+
+    // Only rehash the file content if the size or modification time changed.
+    const std::string pathString = absolutePath.string();
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (auto it = mSourceStamps.find(pathString); it != mSourceStamps.end())
+        {
+            if (it->second.size == size && it->second.modificationTime == modificationTime)
+                return it->second.hash;
+        }
+    }
+
+    std::string hash = computeContentHash(absolutePath);
+    if (hash.empty())
+        return {};
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSourceStamps[pathString] = {size, modificationTime, hash};
+    mSourceStampsDirty = true;
+    mStats.hashed++;
+    return hash;
+}
+
+void CookedTextureCache::loadSourceStamps()
+{
+    std::ifstream stream(mOptions.directory / kSourceStampsFilename);
+    if (!stream)
+        return;
+
+    try
+    {
+        nlohmann::json json = nlohmann::json::parse(stream);
+        if (json.at("version").get<uint32_t>() != kCacheVersion)
+            return;
+        for (const auto& [path, stamp] : json.at("sources").items())
+        {
+            mSourceStamps[path] = {
+                stamp.at("size").get<uint64_t>(),
+                stamp.at("modificationTime").get<int64_t>(),
+                stamp.at("hash").get<std::string>(),
+            };
+        }
+    }
+    catch (const std::exception& e)
+    {
+        logWarning("Failed to read texture cache source hashes: {}", e.what());
+        mSourceStamps.clear();
+    }
+}
+
+void CookedTextureCache::saveSourceStamps()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mSourceStampsDirty)
+        return;
+
+    nlohmann::json sources = nlohmann::json::object();
+    for (const auto& [path, stamp] : mSourceStamps)
+        sources[path] = {{"size", stamp.size}, {"modificationTime", stamp.modificationTime}, {"hash", stamp.hash}};
+    nlohmann::json json = {{"version", kCacheVersion}, {"sources", sources}};
+
+    // Write to a temporary file first so that other processes never read a partially written file.
+    const std::filesystem::path path = mOptions.directory / kSourceStampsFilename;
+    const std::filesystem::path tempPath = getTempPath(path);
+    {
+        std::ofstream stream(tempPath, std::ios::trunc);
+        stream << json.dump();
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec)
+    {
+        logWarning("Failed to write texture cache source hashes to '{}'.", path);
+        std::filesystem::remove(tempPath, ec);
+        return;
+    }
+    mSourceStampsDirty = false;
+}
+
+std::filesystem::path CookedTextureCache::getCachePath(const std::string& key) const
+{
+    return mOptions.directory / (key + kCacheExtension);
+}
+
+bool CookedTextureCache::cook(const ref<Texture>& pTexture, const std::filesystem::path& cachePath)
+{
+    FALCOR_PROFILE_CPU("CookedTextureCache::cook");
+
+    if (pTexture->getType() != Resource::Type::Texture2D || pTexture->getArraySize() != 1)
+        return false;
+
+    const bool compress = mOptions.compression != ImageIO::CompressionMode::None && isCompressible(pTexture.get());
+    if (!compress && getDxgiFormat(pTexture->getFormat()) == DXGI_FORMAT_UNKNOWN)
+        return false;
+
+    const std::filesystem::path tempPath = getTempPath(cachePath);
+    try
+    {
+        // Read back the texture. Only the readback needs exclusive access to the device,
+        // encoding and writing the file runs in parallel on the calling thread.
+        std::vector<std::vector<uint8_t>> subresources(compress ? 1 : pTexture->getMipCount());
+        {
+            std::lock_guard<std::mutex> lock(mpDevice->getGlobalGfxMutex());
+            RenderContext* pRenderContext = mpDevice->getRenderContext();
+            for (uint32_t mip = 0; mip < subresources.size(); ++mip)
+                subresources[mip] = pRenderContext->readTextureSubresource(pTexture.get(), pTexture->getSubresourceIndex(0, mip));
+        }
+
+        if (compress)
+        {
+            // The compressor regenerates the mip chain from the base level.
+            auto pBitmap = Bitmap::create(pTexture->getWidth(), pTexture->getHeight(), pTexture->getFormat(), subresources[0].data());
+            ImageIO::saveToDDS(tempPath, *pBitmap, mOptions.compression, pTexture->getMipCount() > 1);
+        }
+        else
+        {
+            writeDDS(tempPath, pTexture.get(), subresources);
+        }
+
+        std::filesystem::rename(tempPath, cachePath);
+    }
+    catch (const std::exception& e)
+    {
+        logWarning("Failed to write cooked texture for '{}': {}", pTexture->getSourcePath(), e.what());
+        std::error_code ec;
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStats.cooked++;
+    return true;
+}
+
+void CookedTextureCache::touch(const std::string& key)
+{
+    // Persist the access time in the file modification time so the LRU order is retained across runs.
+    const auto now = std::filesystem::file_time_type::clock::now();
+    std::error_code ec;
+    std::filesystem::last_write_time(getCachePath(key), now, ec);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStats.hits++;
+    if (auto it = mEntries.find(key); it != mEntries.end())
+        it->second.lastAccess = now;
+}
+
+void CookedTextureCache::insert(const std::string& key, uint64_t size)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto& entry = mEntries[key];
+    mTotalSize = mTotalSize - entry.size + size;
+    entry.size = size;
+    entry.lastAccess = std::filesystem::file_time_type::clock::now();
+    evict();
+}
+
+void CookedTextureCache::remove(const std::string& key)
+{
+    std::error_code ec;
+    std::filesystem::remove(getCachePath(key), ec);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (auto it = mEntries.find(key); it != mEntries.end())
+    {
+        mTotalSize -= it->second.size;
+        mEntries.erase(it);
+    }
+}
+
+void CookedTextureCache::evict()
+{
+    // Caller must hold mMutex.
+    while (mTotalSize > mOptions.maxSize && !mEntries.empty())
+    {
+        auto oldest = mEntries.begin();
+        for (auto it = mEntries.begin(); it != mEntries.end(); ++it)
+        {
+            if (it->second.lastAccess < oldest->second.lastAccess)
+                oldest = it;
+        }
+
+        // Removal may fail if the file is currently mapped by a loader (Windows); it will be overwritten or evicted later.
+        std::error_code ec;
+        std::filesystem::remove(getCachePath(oldest->first), ec);
+        mTotalSize -= oldest->second.size;
+        mEntries.erase(oldest);
+        mStats.evicted++;
+    }
+}
+} // namespace Falcor
@@ -0,0 +1,168 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Bitmap.h"
+#include "ImageIO.h"
+#include "Core/Macros.h"
+#include "Core/API/fwd.h"
+#include "Core/API/Resource.h"
+#include "Core/API/Texture.h"
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace Falcor
+{
+/**
+ * Persistent on-disk cache of cooked textures.
+ *
+ * The first time a texture is loaded it is imported from its source file as usual (decoding and GPU mip generation).
+ * The resulting texture, including its full mip chain, is read back and stored in the cache directory as a DDS file
+ * with a DX10 header. Subsequent loads of the same source memory-map the cooked file and upload it directly,
+ * skipping image decoding and mip generation.
+ *
+ * Cache entries are keyed by the SHA-1 hash of the source file content together with all parameters that affect
+ * the cooked result (mip generation, sRGB, import flags and compression mode), so modified source files are never
+ * served stale data. The content hash of each source file is stored with its size and modification time, and the
+ * file is only rehashed when either of them changes. The stored hashes persist across runs.
+ *
+ * The total size of the cache is bounded; when exceeded, the least recently used entries are evicted.
+ * Access times are persisted in the file modification times, so the LRU order survives across runs.
+ *
+ * DDS source files are already in an uploadable format and bypass the cache.
+ *
+ * The class is thread-safe and can be used from texture loader worker threads.
+ */
+class FALCOR_API CookedTextureCache
+{
+public:
+    struct Options
+    {
+        std::filesystem::path directory;   ///< Cache directory. Created if it does not exist.
+        uint64_t maxSize = 8ull << 30;     ///< Maximum total size of the cached files in bytes.
+        /// Block compression used when cooking 8-bit RGBA textures. Other formats are always stored uncompressed.
+        ImageIO::CompressionMode compression = ImageIO::CompressionMode::None;
+    };
+
+    struct Stats
+    {
+        uint64_t hits = 0;    ///< Number of loads served from the cache.
+        uint64_t misses = 0;  ///< Number of loads imported from the source file.
+        uint64_t cooked = 0;  ///< Number of textures written to the cache.
+        uint64_t evicted = 0; ///< Number of cache entries evicted.
+        uint64_t hashed = 0;  ///< Number of source files whose content was hashed.
+    };
+
+    /**
+     * Constructor. Scans the cache directory to build the cache index.
+     * Throws an exception if the cache directory cannot be created.
+     * @param[in] pDevice GPU device.
+     * @param[in] options Cache options.
+     */
+    CookedTextureCache(ref<Device> pDevice, const Options& options);
+
+    /**
+     * Destructor. Stores the source file hashes in the cache directory.
+     */
+    ~CookedTextureCache();
+
+    /**
+     * Load a texture through the cache. Same semantics as Texture::createFromFile().
+     * @param[in] path File path of the texture.
+     * @param[in] generateMipLevels Whether the full mip-chain should be generated.
+     * @param[in] loadAsSrgb Load the texture as sRGB format if supported, otherwise linear color.
+     * @param[in] bindFlags The bind flags for the texture resource.
+     * @param[in] importFlags Optional flags for the file import.
+     * @return A new texture, or nullptr if the texture failed to load.
+     */
+    ref<Texture> loadFromFile(
+        const std::filesystem::path& path,
+        bool generateMipLevels,
+        bool loadAsSrgb,
+        ResourceBindFlags bindFlags = ResourceBindFlags::ShaderResource,
+        Bitmap::ImportFlags importFlags = Bitmap::ImportFlags::None
+    );
+
+    /**
+     * Remove all entries from the cache and delete the cached files.
+     */
+    void clear();
+
+    /**
+     * Get the total size of the cached files in bytes.
+     */
+    uint64_t getSize() const;
+
+    /**
+     * Get the number of cached textures.
+     */
+    size_t getEntryCount() const;
+
+    /**
+     * Get cache statistics.
+     */
+    Stats getStats() const;
+
+    const Options& getOptions() const { return mOptions; }
+
+private:
+    struct Entry
+    {
+        uint64_t size = 0;
+        std::filesystem::file_time_type lastAccess;
+    };
+
+    struct SourceStamp
+    {
+        uint64_t size = 0;
+        int64_t modificationTime = 0;
+        std::string hash; ///< SHA-1 of the file content.
+    };
+
+    std::string getSourceHash(const std::filesystem::path& path);
+    void loadSourceStamps();
+    void saveSourceStamps();
+    std::filesystem::path getCachePath(const std::string& key) const;
+    bool cook(const ref<Texture>& pTexture, const std::filesystem::path& cachePath);
+    void touch(const std::string& key);
+    void insert(const std::string& key, uint64_t size);
+    void remove(const std::string& key);
+    void evict();
+
+    ref<Device> mpDevice;
+    Options mOptions;
+
+    mutable std::mutex mMutex;
+    std::map<std::string, Entry> mEntries; ///< Cache index. Key is the hash string.
+    uint64_t mTotalSize = 0;               ///< Total size of all entries in bytes.
+    std::map<std::string, SourceStamp> mSourceStamps; ///< Content hashes of source files. Key is the absolute source path.
+    bool mSourceStampsDirty = false;
+    Stats mStats;
+};
+} // namespace Falcor
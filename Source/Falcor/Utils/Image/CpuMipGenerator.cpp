@@ -0,0 +1,567 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "CpuMipGenerator.h"
+#include "Core/Error.h"
+#include "Core/Platform/OS.h"
+#include "Utils/Math/Float16.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <optional>
+
+namespace Falcor
+{
+namespace
+{
+/// Parameters of the Kaiser filter (same defaults as NVTT).
+constexpr float kKaiserWidth = 3.f; ///< Filter width in destination pixels.
+constexpr float kKaiserAlpha = 4.f; ///< Window shape parameter.
+
+/// Number of iterations for the binary search of the alpha coverage scale.
+constexpr uint32_t kAlphaCoverageIterations = 16;
+
+enum class Component
+{
+    Unorm8,
+    Unorm16,
+    Float16,
+    Float32,
+};
+
+struct FormatDesc
+{
+    uint32_t channelCount;
+    Component component;
+    bool isSrgb;   ///< RGB channels are sRGB encoded.
+    bool hasAlpha; ///< Channel 3 holds alpha.
+};
+
+std::optional<FormatDesc> getFormatDesc(ResourceFormat format)
+{
+    switch (format)
+    {
+    case ResourceFormat::R8Unorm:
+        return FormatDesc{1, Component::Unorm8, false, false};
+    case ResourceFormat::RG8Unorm:
+        return FormatDesc{2, Component::Unorm8, false, false};
+    case ResourceFormat::RGBA8Unorm:
+    case ResourceFormat::BGRA8Unorm:
+        return FormatDesc{4, Component::Unorm8, false, true};
+    case ResourceFormat::RGBA8UnormSrgb:
+    case ResourceFormat::BGRA8UnormSrgb:
+        return FormatDesc{4, Component::Unorm8, true, true};
+    case ResourceFormat::BGRX8Unorm:
+        return FormatDesc{4, Component::Unorm8, false, false};
+    case ResourceFormat::BGRX8UnormSrgb:
+        return FormatDesc{4, Component::Unorm8, true, false};
+    case ResourceFormat::R16Unorm:
+        return FormatDesc{1, Component::Unorm16, false, false};
+    case ResourceFormat::RG16Unorm:
+        return FormatDesc{2, Component::Unorm16, false, false};
+    case ResourceFormat::RGBA16Unorm:
+        return FormatDesc{4, Component::Unorm16, false, true};
+    case ResourceFormat::R16Float:
+        return FormatDesc{1, Component::Float16, false, false};
+    case ResourceFormat::RG16Float:
+        return FormatDesc{2, Component::Float16, false, false};
+    case ResourceFormat::RGBA16Float:
+        return FormatDesc{4, Component::Float16, false, true};
+    case ResourceFormat::R32Float:
+        return FormatDesc{1, Component::Float32, false, false};
+    case ResourceFormat::RG32Float:
+        return FormatDesc{2, Component::Float32, false, false};
+    case ResourceFormat::RGB32Float:
+        return FormatDesc{3, Component::Float32, false, false};
+    case ResourceFormat::RGBA32Float:
+        return FormatDesc{4, Component::Float32, false, true};
+    default:
+        return {};
+    }
+}
+
+float srgbToLinear(float c)
+{
+    return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+/// Lookup tables for sRGB conversion of 8-bit values.
+struct SrgbTables
+{
+    static constexpr uint32_t kBucketCount = 4096;
+
+    std::array<float, 256> toLinear;           ///< Linear value for each 8-bit sRGB code.
+    std::array<float, 256> thresholds;         ///< Linear value halfway (in sRGB space) between code i and i + 1.
+    std::array<uint8_t, kBucketCount> buckets; ///< Smallest code for each uniform bucket of linear values.
+
+    SrgbTables()
+    {
+        for (uint32_t i = 0; i < 256; ++i)
+            toLinear[i] = srgbToLinear(i / 255.f);
+        for (uint32_t i = 0; i < 255; ++i)
+            thresholds[i] = srgbToLinear((i + 0.5f) / 255.f);
+        thresholds[255] = std::numeric_limits<float>::infinity();
+        for (uint32_t i = 0; i < kBucketCount; ++i)
+            buckets[i] = encodeSlow(float(i) / kBucketCount);
+    }
+
+    uint8_t encodeSlow(float v) const
+    {
+        return uint8_t(std::upper_bound(thresholds.begin(), thresholds.end() - 1, v) - thresholds.begin());
+    }
+
+    /// Encode a linear value to the nearest 8-bit sRGB code.
+    /// The bucket gives a lower bound on the code, a few threshold comparisons find the exact code.
+    uint8_t encode(float v) const
+    {
+        v = std::clamp(v, 0.f, 1.f);
+        uint32_t code = buckets[std::min(uint32_t(v * kBucketCount), kBucketCount - 1)];
+        while (v >= thresholds[code])
+            ++code;
+        return uint8_t(code);
+    }
+};
+
+const SrgbTables& getSrgbTables()
+{
+    static const SrgbTables tables;
+    return tables;
+}
+
+/// Image with float channels in linear space.
+struct Image
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t channelCount = 0;
+    std::vector<float> data;
+
+    Image() = default;
+    Image(uint32_t w, uint32_t h, uint32_t c) : width(w), height(h), channelCount(c), data(size_t(w) * h * c) {}
+
+    float* row(uint32_t y) { return data.data() + size_t(y) * width * channelCount; }
+    const float* row(uint32_t y) const { return data.data() + size_t(y) * width * channelCount; }
+};
+
+/// Decode values to float in linear space.
+void decode(const FormatDesc& desc, const void* pData, size_t count, float* pDst)
+{
+    switch (desc.component)
+    {
+    case Component::Unorm8:
+    {
+        const uint8_t* pSrc = static_cast<const uint8_t*>(pData);
+        for (size_t i = 0; i < count; ++i)
+            pDst[i] = pSrc[i] * (1.f / 255.f);
+        if (desc.isSrgb)
+        {
+            const auto& tables = getSrgbTables();
+            for (size_t i = 0; i < count; i += desc.channelCount)
+            {
+                for (uint32_t c = 0; c < 3; ++c)
+                    pDst[i + c] = tables.toLinear[pSrc[i + c]];
+            }
+        }
+        break;
+    }
+    case Component::Unorm16:
+    {
+        const uint16_t* pSrc = static_cast<const uint16_t*>(pData);
+        for (size_t i = 0; i < count; ++i)
+            pDst[i] = pSrc[i] * (1.f / 65535.f);
+        break;
+    }
+    case Component::Float16:
+    {
+        const uint16_t* pSrc = static_cast<const uint16_t*>(pData);
+        for (size_t i = 0; i < count; ++i)
+            pDst[i] = math::float16ToFloat32(pSrc[i]);
+        break;
+    }
+    case Component::Float32:
+        std::memcpy(pDst, pData, count * sizeof(float));
+        break;
+    }
+}
+
+void encode(const Image& image, const FormatDesc& desc, float alphaScale, void* pData)
+{
+    const size_t count = image.data.size();
+    const float* pSrc = image.data.data();
+    const uint32_t channelCount = desc.channelCount;
+
+    switch (desc.component)
+    {
+    case Component::Unorm8:
+    {
+        uint8_t* pDst = static_cast<uint8_t*>(pData);
+        for (size_t i = 0; i < count; ++i)
+            pDst[i] = uint8_t(std::clamp(pSrc[i], 0.f, 1.f) * 255.f + 0.5f);
+        if (desc.isSrgb)
+        {
+            const auto& tables = getSrgbTables();
+            for (size_t i = 0; i < count; i += channelCount)
+            {
+                for (uint32_t c = 0; c < 3; ++c)
+                    pDst[i + c] = tables.encode(pSrc[i + c]);
+            }
+        }
+        if (alphaScale != 1.f)
+        {
+            for (size_t i = 3; i < count; i += 4)
+                pDst[i] = uint8_t(std::clamp(pSrc[i] * alphaScale, 0.f, 1.f) * 255.f + 0.5f);
+        }
+        break;
+    }
+    case Component::Unorm16:
+    {
+        uint16_t* pDst = static_cast<uint16_t*>(pData);
+        for (size_t i = 0; i < count; ++i)
+            pDst[i] = uint16_t(std::clamp(pSrc[i], 0.f, 1.f) * 65535.f + 0.5f);
+        if (alphaScale != 1.f)
+        {
+            for (size_t i = 3; i < count; i += 4)
+                pDst[i] = uint16_t(std::clamp(pSrc[i] * alphaScale, 0.f, 1.f) * 65535.f + 0.5f);
+        }
+        break;
+    }
+    case Component::Float16:
+    {
+        uint16_t* pDst = static_cast<uint16_t*>(pData);
+        for (size_t i = 0; i < count; ++i)
+            pDst[i] = math::float32ToFloat16(pSrc[i]);
+        if (alphaScale != 1.f)
+        {
+            for (size_t i = 3; i < count; i += 4)
+                pDst[i] = math::float32ToFloat16(std::min(pSrc[i] * alphaScale, 1.f));
+        }
+        break;
+    }
+    case Component::Float32:
+    {
+        float* pDst = static_cast<float*>(pData);
+        std::memcpy(pDst, pSrc, count * sizeof(float));
+        if (alphaScale != 1.f)
+        {
+            for (size_t i = 3; i < count; i += 4)
+                pDst[i] = std::min(pSrc[i] * alphaScale, 1.f);
+        }
+        break;
+    }
+    }
+}
+
+/// Zeroth order modified Bessel function of the first kind.
+float bessel0(float x)
+{
+    float sum = 1.f;
+    float term = 1.f;
+    for (uint32_t k = 1; k < 32; ++k)
+    {
+        float t = x / (2.f * k);
+        term *= t * t;
+        sum += term;
+        if (term < sum * 1e-8f)
+            break;
+    }
+    return sum;
+}
+
+float evalKaiser(float x)
+{
+    // Windowed sinc, x in destination pixels.
+    float t = x / (0.5f * kKaiserWidth);
+    if (std::abs(t) >= 1.f)
+        return 0.f;
+    float sinc = x == 0.f ? 1.f : std::sin(float(M_PI) * x) / (float(M_PI) * x);
+    float window = bessel0(kKaiserAlpha * std::sqrt(1.f - t * t)) / bessel0(kKaiserAlpha);
+    return sinc * window;
+}
+
+/**
+ * 1D resampling kernel. Each destination pixel has the same number of taps (padded with zero weights)
+ * so that the filter loops have no data dependent control flow.
+ */
+struct Kernel
+{
+    uint32_t tapCount = 0;
+    std::vector<uint32_t> indices; ///< Source indices [dst * tapCount + tap].
+    std::vector<float> weights;    ///< Weights [dst * tapCount + tap].
+
+    Kernel(uint32_t srcSize, uint32_t dstSize, CpuMipGenerator::Filter filter)
+    {
+        const float scale = float(srcSize) / float(dstSize);
+        const float radius = filter == CpuMipGenerator::Filter::Box ? 0.5f * scale : 0.5f * kKaiserWidth * scale;
+
+        // Source pixels overlapping the filter footprint [center - radius, center + radius].
+        auto getCenter = [&](uint32_t d) { return (d + 0.5f) * scale; };
+        auto getFirst = [&](uint32_t d) { return int32_t(std::floor(getCenter(d) - radius)); };
+        auto getLast = [&](uint32_t d) { return int32_t(std::ceil(getCenter(d) + radius)) - 1; };
+
+        tapCount = 0;
+        for (uint32_t d = 0; d < dstSize; ++d)
+            tapCount = std::max(tapCount, uint32_t(getLast(d) - getFirst(d) + 1));
+        indices.resize(size_t(dstSize) * tapCount, 0);
+        weights.resize(size_t(dstSize) * tapCount, 0.f);
+
+        for (uint32_t d = 0; d < dstSize; ++d)
+        {
+            const float center = getCenter(d);
+            const int32_t first = getFirst(d);
+            uint32_t* pIndices = &indices[size_t(d) * tapCount];
+            float* pWeights = &weights[size_t(d) * tapCount];
+
+            float sum = 0.f;
+            for (uint32_t t = 0; t < tapCount; ++t)
+            {
+                const int32_t i = first + int32_t(t);
+                float w = 0.f;
+                if (filter == CpuMipGenerator::Filter::Box)
+                {
+                    // Overlap of the source pixel with the destination footprint.
+                    w = std::max(0.f, std::min(float(i + 1), center + radius) - std::max(float(i), center - radius));
+                }
+                else
+                {
+                    w = evalKaiser((i + 0.5f - center) / scale);
+                }
+                // Clamp to edge.
+                pIndices[t] = uint32_t(std::clamp(i, 0, int32_t(srcSize) - 1));
+                pWeights[t] = w;
+                sum += w;
+            }
+
+            if (sum != 0.f)
+            {
+                for (uint32_t t = 0; t < tapCount; ++t)
+                    pWeights[t] /= sum;
+            }
+        }
+    }
+};
+
+/// Horizontal filter of a single row. Templated on the channel count so the inner loop maps to a single vector operation.
+template<uint32_t C>
+void filterRow(const float* pSrc, float* pDst, uint32_t width, const Kernel& kernel)
+{
+    for (uint32_t x = 0; x < width; ++x)
+    {
+        float acc[C] = {};
+        const uint32_t* pIndices = &kernel.indices[size_t(x) * kernel.tapCount];
+        const float* pWeights = &kernel.weights[size_t(x) * kernel.tapCount];
+        for (uint32_t t = 0; t < kernel.tapCount; ++t)
+        {
+            const float* pTexel = pSrc + size_t(pIndices[t]) * C;
+            const float w = pWeights[t];
+            for (uint32_t c = 0; c < C; ++c)
+                acc[c] += w * pTexel[c];
+        }
+        for (uint32_t c = 0; c < C; ++c)
+            pDst[size_t(x) * C + c] = acc[c];
+    }
+}
+
+/**
+ * Downsample an image with a separable filter.
+ * For each destination row, the vertical pass accumulates the weighted source rows into a row buffer
+ * (a contiguous multiply-add over the row), followed by the horizontal pass on that single row.
+ * @param[in] getRow Function returning a pointer to a source row in float linear space.
+ */
+template<typename GetRow>
+Image downsample(
+    uint32_t srcWidth,
+    uint32_t srcHeight,
+    uint32_t channelCount,
+    GetRow getRow,
+    uint32_t width,
+    uint32_t height,
+    CpuMipGenerator::Filter filter
+)
+{
+    const Kernel kernelX(srcWidth, width, filter);
+    const Kernel kernelY(srcHeight, height, filter);
+    const size_t rowSize = size_t(srcWidth) * channelCount;
+
+    Image dst(width, height, channelCount);
+    std::vector<float> rowBuffer(rowSize);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        float* pRow = rowBuffer.data();
+        std::fill(rowBuffer.begin(), rowBuffer.end(), 0.f);
+        for (uint32_t t = 0; t < kernelY.tapCount; ++t)
+        {
+            const float w = kernelY.weights[size_t(y) * kernelY.tapCount + t];
+            if (w == 0.f)
+                continue;
+            const float* pSrc = getRow(kernelY.indices[size_t(y) * kernelY.tapCount + t]);
+            for (size_t i = 0; i < rowSize; ++i)
+                pRow[i] += w * pSrc[i];
+        }
+
+        switch (channelCount)
+        {
+        case 1:
+            filterRow<1>(pRow, dst.row(y), width, kernelX);
+            break;
+        case 2:
+            filterRow<2>(pRow, dst.row(y), width, kernelX);
+            break;
+        case 3:
+            filterRow<3>(pRow, dst.row(y), width, kernelX);
+            break;
+        case 4:
+            filterRow<4>(pRow, dst.row(y), width, kernelX);
+            break;
+        default:
+            FALCOR_UNREACHABLE();
+        }
+    }
+    return dst;
+}
+
+/// Compute the fraction of pixels passing the alpha test (scaled alpha >= cutoff).
+float computeAlphaCoverage(const Image& image, float cutoff, float scale)
+{
+    size_t count = 0;
+    for (size_t i = 3; i < image.data.size(); i += 4)
+        count += image.data[i] * scale >= cutoff ? 1 : 0;
+    return float(count) / float(image.data.size() / 4);
+}
+
+/// Find the alpha scale that best preserves the given alpha test coverage (binary search, coverage is monotonic in the scale).
+float findAlphaScale(const Image& image, float cutoff, float targetCoverage)
+{
+    float lo = 0.f;
+    float hi = 4.f;
+    float bestScale = 1.f;
+    float bestError = std::abs(computeAlphaCoverage(image, cutoff, 1.f) - targetCoverage);
+    for (uint32_t i = 0; i < kAlphaCoverageIterations && bestError > 0.f; ++i)
+    {
+        float scale = 0.5f * (lo + hi);
+        float coverage = computeAlphaCoverage(image, cutoff, scale);
+        if (std::abs(coverage - targetCoverage) < bestError)
+        {
+            bestScale = scale;
+            bestError = std::abs(coverage - targetCoverage);
+        }
+        if (coverage < targetCoverage)
+            lo = scale;
+        else
+            hi = scale;
+    }
+    return bestScale;
+}
+} // namespace
+
+bool CpuMipGenerator::isFormatSupported(ResourceFormat format)
+{
+    return getFormatDesc(format).has_value();
+}
+
+uint32_t CpuMipGenerator::getMipCount(uint32_t width, uint32_t height)
+{
+    return bitScanReverse(width | height) + 1;
+}
+
+std::vector<uint8_t> CpuMipGenerator::generate(
+    uint32_t width,
+    uint32_t height,
+    ResourceFormat format,
+    const void* pData,
+    const Options& options
+)
+{
+    const auto desc = getFormatDesc(format);
+    FALCOR_CHECK(desc.has_value(), "Format {} is not supported for CPU mip generation.", to_string(format));
+    FALCOR_CHECK(width > 0 && height > 0, "Invalid image size {}x{}.", width, height);
+    FALCOR_CHECK(pData != nullptr, "'pData' must not be null.");
+
+    const uint32_t mipCount = getMipCount(width, height);
+    const size_t bytesPerPixel = getFormatBytesPerBlock(format);
+    auto getMipSize = [&](uint32_t mip)
+    { return size_t(std::max(1u, width >> mip)) * std::max(1u, height >> mip) * bytesPerPixel; };
+
+    size_t totalSize = 0;
+    for (uint32_t mip = 0; mip < mipCount; ++mip)
+        totalSize += getMipSize(mip);
+
+    std::vector<uint8_t> result(totalSize);
+    std::memcpy(result.data(), pData, getMipSize(0));
+    if (mipCount == 1)
+        return result;
+
+    const bool preserveCoverage = options.alphaCutoff > 0.f && desc->hasAlpha;
+    const uint32_t channelCount = desc->channelCount;
+    const size_t srcRowPitch = size_t(width) * bytesPerPixel;
+    const uint8_t* pSrc = static_cast<const uint8_t*>(pData);
+
+    // The base level is decoded row by row on demand to avoid a full resolution float copy.
+    std::vector<float> decodedRow(size_t(width) * channelCount);
+    auto getBaseRow = [&](uint32_t y)
+    {
+        if (desc->component == Component::Float32)
+            return reinterpret_cast<const float*>(pSrc + y * srcRowPitch);
+        decode(*desc, pSrc + y * srcRowPitch, decodedRow.size(), decodedRow.data());
+        return static_cast<const float*>(decodedRow.data());
+    };
+
+    float targetCoverage = 0.f;
+    if (preserveCoverage)
+    {
+        size_t count = 0;
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            const float* pRow = getBaseRow(y);
+            for (size_t i = 3; i < decodedRow.size(); i += 4)
+                count += pRow[i] >= options.alphaCutoff ? 1 : 0;
+        }
+        targetCoverage = float(count) / (float(width) * height);
+    }
+
+    // Each level is filtered from the previous (unscaled) float level and encoded independently.
+    Image level = downsample(width, height, channelCount, getBaseRow, std::max(1u, width >> 1), std::max(1u, height >> 1), options.filter);
+    uint8_t* pDst = result.data() + getMipSize(0);
+    for (uint32_t mip = 1; mip < mipCount; ++mip)
+    {
+        if (mip > 1)
+        {
+            auto getRow = [&level](uint32_t y) { return static_cast<const float*>(level.row(y)); };
+            level = downsample(
+                level.width, level.height, channelCount, getRow, std::max(1u, width >> mip), std::max(1u, height >> mip), options.filter
+            );
+        }
+        const float alphaScale = preserveCoverage ? findAlphaScale(level, options.alphaCutoff, targetCoverage) : 1.f;
+        encode(level, *desc, alphaScale, pDst);
+        pDst += getMipSize(mip);
+    }
+    FALCOR_ASSERT(pDst == result.data() + result.size());
+
+    return result;
+}
+} // namespace Falcor
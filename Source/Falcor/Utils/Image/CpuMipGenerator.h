@@ -0,0 +1,95 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include "Core/API/Formats.h"
+#include <cstdint>
+#include <vector>
+
+namespace Falcor
+{
+/**
+ * Generates texture mip chains on the CPU.
+ *
+ * Mips are built iteratively from the previous level using separable filters. Intermediate levels are kept
+ * in 32-bit float to avoid accumulating quantization errors. sRGB formats are filtered in linear space.
+ * Optionally, alpha is rescaled per mip to preserve the alpha test coverage of the base level.
+ *
+ * The inner loops operate on contiguous float rows and are written to be auto-vectorized by the compiler.
+ * This is meant to be used on texture loader threads so that the render queue is not involved in mip generation.
+ */
+class FALCOR_API CpuMipGenerator
+{
+public:
+    enum class Filter
+    {
+        Box,    ///< Box filter. Matches the GPU mip generation for power-of-two textures.
+        Kaiser, ///< Kaiser-windowed sinc filter. Sharper results than the box filter.
+    };
+
+    struct Options
+    {
+        // Note: Empty constructor needed for gcc/clang due to the use of the nested struct as a default argument.
+        Options() {}
+        Filter filter = Filter::Box; ///< Downsampling filter.
+        /// If larger than zero, alpha is scaled in each mip to preserve the fraction of texels passing an alpha test
+        /// with this cutoff. Only applies to formats with an alpha channel.
+        float alphaCutoff = 0.f;
+    };
+
+    /**
+     * Check if a format is supported for CPU mip generation.
+     * Supported are uncompressed 8/16-bit unorm and 16/32-bit float formats, including sRGB variants.
+     */
+    static bool isFormatSupported(ResourceFormat format);
+
+    /**
+     * Get the number of mips in a full mip chain. This matches the number of mips created for Texture::kMaxPossible.
+     */
+    static uint32_t getMipCount(uint32_t width, uint32_t height);
+
+    /**
+     * Generate a full mip chain.
+     * Throws an exception if the format is not supported.
+     * @param[in] width Width of the base level in pixels.
+     * @param[in] height Height of the base level in pixels.
+     * @param[in] format Format of the image data.
+     * @param[in] pData Tightly packed image data of the base level.
+     * @param[in] options Options.
+     * @return Tightly packed data of all mips, starting with a copy of the base level.
+     *         The layout matches the initial data expected by Device::createTexture2D().
+     */
+    static std::vector<uint8_t> generate(
+        uint32_t width,
+        uint32_t height,
+        ResourceFormat format,
+        const void* pData,
+        const Options& options = Options()
+    );
+};
+} // namespace Falcor
@@ -0,0 +1,186 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "ExrWriter.h"
+#include "Core/Error.h"
+
+#include <ImfChannelList.h>
+#include <ImfFrameBuffer.h>
+#include <ImfHeader.h>
+#include <ImfMultiPartOutputFile.h>
+#include <ImfOutputFile.h>
+#include <ImfOutputPart.h>
+#include <ImfPartType.h>
+#include <ImfThreading.h>
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+const char* kChannelNames[] = {"R", "G", "B", "A"};
+
+Imf::Compression getImfCompression(ExrWriter::Compression compression)
+{
+    switch (compression)
+    {
+    case ExrWriter::Compression::None:
+        return Imf::NO_COMPRESSION;
+    case ExrWriter::Compression::Zip:
+        return Imf::ZIP_COMPRESSION;
+    case ExrWriter::Compression::Piz:
+        return Imf::PIZ_COMPRESSION;
+    case ExrWriter::Compression::B44:
+        return Imf::B44_COMPRESSION;
+    case ExrWriter::Compression::Dwaa:
+        return Imf::DWAA_COMPRESSION;
+    default:
+        FALCOR_THROW("Unknown EXR compression.");
+    }
+}
+
+/**
+ * Make sure the OpenEXR global thread pool has at least the given number of threads.
+ * The pool is only ever grown, as resizing it blocks while other files are being written.
+ */
+int prepareThreadPool(uint32_t threadCount)
+{
+    static std::mutex sMutex;
+
+    int count = threadCount > 0 ? int(threadCount) : int(std::max(1u, std::thread::hardware_concurrency()));
+    std::lock_guard<std::mutex> lock(sMutex);
+    if (Imf::globalThreadCount() < count)
+        Imf::setGlobalThreadCount(count);
+    return count;
+}
+
+/// Add the channels and frame buffer slices of a layer.
+void addLayer(const ExrWriter::Layer& layer, uint32_t width, Imf::Header& header, Imf::FrameBuffer& frameBuffer)
+{
+    FALCOR_CHECK(layer.pData, "Layer '{}' has no data.", layer.name);
+    FALCOR_CHECK(
+        ExrWriter::isFormatSupported(layer.format), "Layer '{}' has unsupported format {}.", layer.name, to_string(layer.format)
+    );
+    uint32_t formatChannelCount = getFormatChannelCount(layer.format);
+    uint32_t channelMask = (uint32_t)layer.channelMask & ((1u << formatChannelCount) - 1);
+    FALCOR_CHECK(channelMask != 0, "Layer '{}' has no channels to write (mask {:#x}).", layer.name, (uint32_t)layer.channelMask);
+
+    // The slice type describes the data in memory, the channel type how it is stored in the file.
+    // OpenEXR converts between the two while filling each chunk, so no full-image copy is needed.
+    bool isHalf = getNumChannelBits(layer.format, 0) == 16;
+    Imf::PixelType sliceType = isHalf ? Imf::HALF : Imf::FLOAT;
+    Imf::PixelType channelType = isHalf || layer.writeHalf ? Imf::HALF : Imf::FLOAT;
+    size_t channelSize = isHalf ? 2 : 4;
+    size_t pixelStride = channelSize * formatChannelCount;
+    size_t rowStride = pixelStride * width;
+
+    for (uint32_t c = 0; c < formatChannelCount; ++c)
+    {
+        if ((channelMask & (1u << c)) == 0)
+            continue;
+        std::string channelName = layer.name.empty() ? kChannelNames[c] : layer.name + "." + kChannelNames[c];
+        FALCOR_CHECK(header.channels().findChannel(channelName) == nullptr, "Duplicate EXR channel '{}'.", channelName);
+        header.channels().insert(channelName, Imf::Channel(channelType));
+        char* pBase = const_cast<char*>(static_cast<const char*>(layer.pData)) + c * channelSize;
+        frameBuffer.insert(channelName, Imf::Slice(sliceType, pBase, pixelStride, rowStride));
+    }
+}
+} // namespace
+
+bool ExrWriter::isFormatSupported(ResourceFormat format)
+{
+    if (isCompressedFormat(format) || getFormatType(format) != FormatType::Float)
+        return false;
+    uint32_t bits = getNumChannelBits(format, 0);
+    for (uint32_t c = 1; c < getFormatChannelCount(format); ++c)
+        if (getNumChannelBits(format, c) != bits)
+            return false;
+    return bits == 16 || bits == 32;
+}
+
+void ExrWriter::write(
+    const std::filesystem::path& path,
+    uint32_t width,
+    uint32_t height,
+    fstd::span<const Layer> layers,
+    const Options& options
+)
+{
+    FALCOR_CHECK(!layers.empty(), "No layers to write.");
+    FALCOR_CHECK(width > 0 && height > 0, "Invalid image dimensions {}x{}.", width, height);
+
+    Imf::Header baseHeader(width, height);
+    baseHeader.compression() = getImfCompression(options.compression);
+
+    // Single-part files store all layers in one header, multi-part files use one header per layer.
+    size_t partCount = options.multiPart ? layers.size() : 1;
+    std::vector<Imf::Header> headers(partCount, baseHeader);
+    std::vector<Imf::FrameBuffer> frameBuffers(partCount);
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        size_t part = options.multiPart ? i : 0;
+        if (options.multiPart)
+        {
+            headers[part].setName(layers[i].name.empty() ? "rgba" : layers[i].name);
+            headers[part].setType(Imf::SCANLINEIMAGE);
+        }
+        addLayer(layers[i], width, headers[part], frameBuffers[part]);
+    }
+
+    int threadCount = prepareThreadPool(options.threadCount);
+
+    // Writing all scanlines at once lets OpenEXR compress all chunks of a part in parallel.
+    try
+    {
+        if (!options.multiPart)
+        {
+            Imf::OutputFile file(path.string().c_str(), headers[0], threadCount);
+            file.setFrameBuffer(frameBuffers[0]);
+            file.writePixels(height);
+        }
+        else
+        {
+            Imf::MultiPartOutputFile file(path.string().c_str(), headers.data(), int(headers.size()), false, threadCount);
+            for (size_t i = 0; i < headers.size(); ++i)
+            {
+                Imf::OutputPart part(file, int(i));
+                part.setFrameBuffer(frameBuffers[i]);
+                part.writePixels(height);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        FALCOR_THROW("Failed to write EXR file '{}': {}", path, e.what());
+    }
+}
+} // namespace Falcor
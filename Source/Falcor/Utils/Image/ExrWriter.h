@@ -0,0 +1,96 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include "Core/API/Formats.h"
+#include <fstd/span.h>
+#include <filesystem>
+#include <string>
+
+namespace Falcor
+{
+/**
+ * Writer for OpenEXR files with multiple layers.
+ * Each layer is stored as a set of channels named "<layer>.R", "<layer>.G", etc. either in a single part
+ * or in one part per layer. A layer with an empty name is stored as the default layer ("R", "G", "B", "A").
+ * Scanline chunks are compressed in parallel on the OpenEXR thread pool. Pixel data is read in place,
+ * conversion from float to half is done per chunk by OpenEXR.
+ */
+class FALCOR_API ExrWriter
+{
+public:
+    enum class Compression
+    {
+        None, ///< No compression.
+        Zip,  ///< Lossless zlib compression, 16 scanlines per chunk.
+        Piz,  ///< Lossless wavelet compression, 32 scanlines per chunk.
+        B44,  ///< Lossy 4x4 block compression (half channels only).
+        Dwaa, ///< Lossy DCT-based compression, 32 scanlines per chunk.
+    };
+
+    struct Layer
+    {
+        std::string name;                ///< Layer name.
+        ResourceFormat format;           ///< Format of the pixel data. Must be a 16- or 32-bit float format.
+        TextureChannelFlags channelMask; ///< Channels to write. Channels not present in the format are ignored.
+        const void* pData;               ///< Pixel data (top-down, tightly packed rows).
+        bool writeHalf = false;          ///< Store 32-bit float data as half-float channels.
+    };
+
+    struct Options
+    {
+        // Note: Empty constructor needed for gcc/clang due to the use of the nested struct as a default argument.
+        Options() {}
+        Compression compression = Compression::Zip; ///< Compression method.
+        bool multiPart = false;                     ///< Write each layer to a separate part instead of a single part.
+        uint32_t threadCount = 0;                   ///< Number of threads for compression (0 to use all hardware threads).
+    };
+
+    /**
+     * Check if a format can be written as an EXR layer.
+     */
+    static bool isFormatSupported(ResourceFormat format);
+
+    /**
+     * Write layers to an EXR file.
+     * Throws an exception if the file cannot be written.
+     * @param[in] path Path of the file to write.
+     * @param[in] width Image width in pixels.
+     * @param[in] height Image height in pixels.
+     * @param[in] layers Layers to write. All layers must have the given dimensions.
+     * @param[in] options Write options.
+     */
+    static void write(
+        const std::filesystem::path& path,
+        uint32_t width,
+        uint32_t height,
+        fstd::span<const Layer> layers,
+        const Options& options = Options()
+    );
+};
+} // namespace Falcor
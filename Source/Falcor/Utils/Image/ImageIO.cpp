@@ -31,12 +31,16 @@
 #include "Core/API/CopyContext.h"
 #include "Core/API/NativeFormats.h"
 #include "Core/Platform/MemoryMappedFile.h"
+#include "Utils/Math/Common.h"
 #include "Utils/Math/ScalarMath.h"
 #include "Utils/Logger.h"
+#include "Utils/NumericRange.h"
 
 #include <dds_header/DDSHeader.h>
 #include <nvtt/nvtt.h>
 
+#include <atomic>
+#include <execution>
 #include <filesystem>
 
 namespace Falcor
@@ -55,8 +59,10 @@ struct ImportData
     uint32_t mipLevels;
     bool hasDX10Header = false;
 
-    // Data to be imported
-    std::vector<uint8_t> imageData;
+    // Memory-mapped file. The image data is referenced directly in the mapping (no copies).
+    MemoryMappedFile file;
+    const uint8_t* pImageData = nullptr;
+    size_t imageSize = 0;
 };
 
 struct ExportData
@@ -519,11 +525,23 @@ void readDDSHeader(ImportData& data, const void* pHeaderData, size_t& headerSize
     }
 }
 
-// Loads the information and data for the specified image. This function does not handle creation of the texture for the image.
+// Computes the size in bytes of a single subresource (all depth slices of one mip level).
+size_t getSubresourceSize(const ImportData& data, uint32_t mipLevel)
+{
+    uint32_t width = std::max(1u, data.width >> mipLevel);
+    uint32_t height = std::max(1u, data.height >> mipLevel);
+    uint32_t depth = std::max(1u, data.depth >> mipLevel);
+    size_t blocksX = div_round_up(width, getFormatWidthCompressionRatio(data.format));
+    size_t blocksY = div_round_up(height, getFormatHeightCompressionRatio(data.format));
+    return blocksX * blocksY * depth * getFormatBytesPerBlock(data.format);
+}
+
+// Maps the specified image and reads its information. The image data is not copied and stays valid as long as data.file is open.
+// This function does not handle creation of the texture for the image.
 void loadDDS(const std::filesystem::path& path, bool loadAsSrgb, ImportData& data)
 {
-    MemoryMappedFile file(path, MemoryMappedFile::kWholeFile, MemoryMappedFile::AccessHint::SequentialScan);
-    if (!file.isOpen())
+    MemoryMappedFile& file = data.file;
+    if (!file.open(path, MemoryMappedFile::kWholeFile, MemoryMappedFile::AccessHint::SequentialScan))
     {
         FALCOR_THROW("Failed to open file.");
     }
@@ -546,11 +564,24 @@ void loadDDS(const std::filesystem::path& path, bool loadAsSrgb, ImportData& dat
     {
         FALCOR_THROW("No image data after DDS header.");
     }
+    if (data.format == ResourceFormat::Unknown)
+    {
+        FALCOR_THROW("Unsupported DDS pixel format.");
+    }
+
+    data.pImageData = reinterpret_cast<const uint8_t*>(file.getData()) + headerSize;
+    data.imageSize = file.getSize() - headerSize;
 
-    // Read image data.
-    size_t imageSize = file.getSize() - headerSize;
-    data.imageData.resize(imageSize);
-    std::memcpy(data.imageData.data(), reinterpret_cast<const uint8_t*>(file.getData()) + headerSize, imageSize);
+    // The subresources are tightly packed in D3D subresource order (array slice major, mip minor),
+    // which is the layout texture creation expects. Check that the mapped image data covers all of them.
+    size_t expectedSize = 0;
+    for (uint32_t mipLevel = 0; mipLevel < data.mipLevels; ++mipLevel)
+        expectedSize += getSubresourceSize(data, mipLevel);
+    expectedSize *= data.arraySize;
+    if (expectedSize > data.imageSize)
+    {
+        FALCOR_THROW("DDS image data is truncated (expected at least {} bytes, found {}).", expectedSize, data.imageSize);
+    }
 }
 } // namespace
 
@@ -574,10 +605,15 @@ Bitmap::UniqueConstPtr ImageIO::loadBitmapFromDDS(const std::filesystem::path& p
     }
 
     // Create from first image
-    return Bitmap::create(data.width, data.height, data.format, data.imageData.data());
+    return Bitmap::create(data.width, data.height, data.format, data.pImageData);
 }
 
-ref<Texture> ImageIO::loadTextureFromDDS(ref<Device> pDevice, const std::filesystem::path& path, bool loadAsSrgb)
+ref<Texture> ImageIO::loadTextureFromDDS(
+    ref<Device> pDevice,
+    const std::filesystem::path& path,
+    bool loadAsSrgb,
+    ResourceBindFlags bindFlags
+)
 {
     ImportData data;
     try
@@ -595,16 +631,20 @@ ref<Texture> ImageIO::loadTextureFromDDS(ref<Device> pDevice, const std::filesys
     switch (data.type)
     {
     case Resource::Type::Texture1D:
-        pTex = pDevice->createTexture1D(data.width, data.format, data.arraySize, data.mipLevels, data.imageData.data());
+        pTex = pDevice->createTexture1D(data.width, data.format, data.arraySize, data.mipLevels, data.pImageData, bindFlags);
         break;
     case Resource::Type::Texture2D:
-        pTex = pDevice->createTexture2D(data.width, data.height, data.format, data.arraySize, data.mipLevels, data.imageData.data());
+        pTex =
+            pDevice->createTexture2D(data.width, data.height, data.format, data.arraySize, data.mipLevels, data.pImageData, bindFlags);
         break;
     case Resource::Type::TextureCube:
-        pTex = pDevice->createTextureCube(data.width, data.height, data.format, data.arraySize / 6, data.mipLevels, data.imageData.data());
+        pTex = pDevice->createTextureCube(
+            data.width, data.height, data.format, data.arraySize / 6, data.mipLevels, data.pImageData, bindFlags
+        );
         break;
     case Resource::Type::Texture3D:
-        pTex = pDevice->createTexture3D(data.width, data.height, data.depth, data.format, data.mipLevels, data.imageData.data());
+        pTex =
+            pDevice->createTexture3D(data.width, data.height, data.depth, data.format, data.mipLevels, data.pImageData, bindFlags);
         break;
     default:
         logWarning("Failed to load DDS image from '{}': Unrecognized texture type.", path);
@@ -619,6 +659,42 @@ ref<Texture> ImageIO::loadTextureFromDDS(ref<Device> pDevice, const std::filesys
     return pTex;
 }
 
+std::vector<ref<Texture>> ImageIO::loadTexturesFromDDS(
+    ref<Device> pDevice,
+    fstd::span<const std::filesystem::path> paths,
+    bool loadAsSrgb
+)
+{
+    // Each file is mapped and uploaded independently, so files can be loaded in parallel.
+    // Flush regularly to keep the upload heap from growing too large (same as TextureManager).
+    std::vector<ref<Texture>> textures(paths.size());
+    std::atomic<size_t> texturesLoaded{0};
+    NumericRange<size_t> range(0, paths.size());
+    std::for_each(
+        std::execution::par_unseq,
+        range.begin(),
+        range.end(),
+        [&](size_t i)
+        {
+            textures[i] = loadTextureFromDDS(pDevice, paths[i], loadAsSrgb);
+            if (texturesLoaded.fetch_add(1) % 10 == 9)
+            {
+                std::lock_guard<std::mutex> lock(pDevice->getGlobalGfxMutex());
+                pDevice->wait();
+            }
+        }
+    );
+
+    // Submit and wait for the uploads of the last batch, so that all returned textures are ready to use.
+    if (!paths.empty())
+    {
+        std::lock_guard<std::mutex> lock(pDevice->getGlobalGfxMutex());
+        pDevice->wait();
+    }
+
+    return textures;
+}
+
 void ImageIO::saveToDDS(const std::filesystem::path& path, const Bitmap& bitmap, CompressionMode mode, bool generateMips)
 {
     if (!hasExtension(path, "dds"))
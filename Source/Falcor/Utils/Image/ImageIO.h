@@ -29,7 +29,9 @@
 #include "Bitmap.h"
 #include "Core/Macros.h"
 #include "Core/API/Texture.h"
+#include <fstd/span.h>
 #include <filesystem>
+#include <vector>
 
 namespace Falcor
 {
@@ -82,13 +84,32 @@ public:
 
     /**
      * Load a DDS file to a Texture.
+     * The file is memory-mapped and all mips and array slices are uploaded directly from the mapping.
      * Throws an exception if the DDS file is malformed.
      * @param[in] path Path of file to load.
      * @param[in] loadAsSrgb If true, convert the image format property to a corresponding sRGB format if available. Image data is not
      * changed.
+     * @param[in] bindFlags The bind flags for the texture resource.
      * @return Texture object containing image data if loading was successful. Otherwise, nullptr.
      */
-    static ref<Texture> loadTextureFromDDS(ref<Device> pDevice, const std::filesystem::path& path, bool loadAsSrgb);
+    static ref<Texture> loadTextureFromDDS(
+        ref<Device> pDevice,
+        const std::filesystem::path& path,
+        bool loadAsSrgb,
+        ResourceBindFlags bindFlags = ResourceBindFlags::ShaderResource
+    );
+
+    /**
+     * Load multiple DDS files to Textures in parallel.
+     * @param[in] paths Paths of files to load.
+     * @param[in] loadAsSrgb If true, convert the image format property to a corresponding sRGB format if available.
+     * @return List of textures in the same order as the paths. Entries are nullptr for files that failed to load.
+     */
+    static std::vector<ref<Texture>> loadTexturesFromDDS(
+        ref<Device> pDevice,
+        fstd::span<const std::filesystem::path> paths,
+        bool loadAsSrgb
+    );
 
     /**
      * Saves a bitmap to a DDS file.
@@ -131,11 +131,11 @@ TextureManager::CpuTextureHandle TextureManager::loadUdimTexture(
     filename.replace(pos, 6, "[1-9][0-9][0-9][0-9]");
     std::regex udimRegex(filename);
     std::vector<std::filesystem::path> texturePaths;
-    // Find the first directory containing the pattern, in case the UDIM set lives in multiple available directories
+    // Find all files in the first directory containing the pattern, in case the UDIM set lives in multiple available directories
     if (assetResolver)
-        texturePaths = assetResolver->resolvePathPattern(dirpath, filename, true /* firstMatchOnly */);
+        texturePaths = assetResolver->resolvePathPattern(dirpath, filename);
     else
-        texturePaths = globFilesInDirectory(dirpath, udimRegex, true /* firstMatchOnly */);
+        texturePaths = globFilesInDirectory(dirpath, udimRegex);
 
     // Nothing found, return an invalid handle
     if (texturePaths.empty())
@@ -146,10 +146,6 @@ TextureManager::CpuTextureHandle TextureManager::loadUdimTexture(
         return CpuTextureHandle();
     }
 
-    // Now load all the files from that directory
-    std::filesystem::path loadedDir = texturePaths[0].parent_path();
-    texturePaths = globFilesInDirectory(loadedDir, udimRegex);
-
     if (loadedTextureCount)
         *loadedTextureCount = texturePaths.size();
 
@@ -645,6 +641,20 @@ TextureManager::Stats TextureManager::getStats() const
     return s;
 }
 
+std::vector<std::pair<std::string, uint64_t>> TextureManager::getTextureMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::vector<std::pair<std::string, uint64_t>> usage;
+    for (const auto& t : mTextureDescs)
+    {
+        if (!t.pTexture)
+            continue;
+        const auto& path = t.pTexture->getSourcePath();
+        usage.emplace_back(path.empty() ? t.pTexture->getName() : path.string(), t.pTexture->getTextureSizeInBytes());
+    }
+    return usage;
+}
+
 TextureManager::CpuTextureHandle TextureManager::addDesc(const TextureDesc& desc)
 {
     CpuTextureHandle handle;
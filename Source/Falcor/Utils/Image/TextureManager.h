@@ -40,6 +40,8 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <utility>
+#include <vector>
 
 namespace Falcor
 {
@@ -148,6 +150,28 @@ public:
 
     ~TextureManager();
 
+    /**
+     * Set a persistent cache of cooked textures used for asynchronous texture loading.
+     * Textures are transparently loaded from the cache when available, and added to it otherwise.
+     * @param[in] pCache Texture cache, or nullptr to disable caching.
+     */
+    void setCookedTextureCache(std::shared_ptr<CookedTextureCache> pCache) { mAsyncTextureLoader.setCookedTextureCache(std::move(pCache)); }
+
+    /**
+     * Get the persistent texture cache, or nullptr if not set.
+     */
+    std::shared_ptr<CookedTextureCache> getCookedTextureCache() const { return mAsyncTextureLoader.getCookedTextureCache(); }
+
+    /**
+     * Enable generating mip chains on the texture loader threads instead of on the GPU.
+     * @param[in] enabled True to generate mips on the CPU.
+     * @param[in] options Mip generation options.
+     */
+    void setCpuMipGeneration(bool enabled, const CpuMipGenerator::Options& options = CpuMipGenerator::Options())
+    {
+        mAsyncTextureLoader.setCpuMipGeneration(enabled, options);
+    }
+
     /**
      * Add a texture to the manager.
      * If the texture is already managed, its existing handle is returned.
@@ -279,6 +303,13 @@ public:
      */
     Stats getStats() const;
 
+    /**
+     * Returns the memory used by each loaded texture.
+     * Like getStats(), the sizes are queried from the currently loaded textures.
+     * @return List of texture names and sizes in bytes. The source path is used as the name if available.
+     */
+    std::vector<std::pair<std::string, uint64_t>> getTextureMemoryUsage() const;
+
 private:
     size_t getUdimRange(size_t requiredSize);
     void freeUdimRange(size_t rangeStart);
@@ -29,18 +29,24 @@
 #include "Core/Error.h"
 #include "Core/Platform/OS.h"
 #include "Utils/Scripting/ScriptBindings.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <mutex>
 #include <set>
+#include <thread>
+#include <vector>
 
 namespace Falcor
 {
 namespace
 {
 std::mutex sMutex;
-Logger::Level sVerbosity = Logger::Level::Info;
-Logger::OutputFlags sOutputs = Logger::OutputFlags::Console | Logger::OutputFlags::File | Logger::OutputFlags::DebugWindow;
+std::atomic<Logger::Level> sVerbosity = Logger::Level::Info;
+std::atomic<Logger::OutputFlags> sOutputs = Logger::OutputFlags::Console | Logger::OutputFlags::File | Logger::OutputFlags::DebugWindow;
 std::filesystem::path sLogFilePath;
 
 bool sInitialized = false;
@@ -84,14 +90,362 @@ void printToLogFile(const std::string& s)
 
     if (sLogFile)
     {
-        std::fprintf(sLogFile, "%s", s.c_str());
+        std::fwrite(s.data(), 1, s.size(), sLogFile);
         std::fflush(sLogFile);
     }
 }
+
+struct Message
+{
+    Logger::Level level;
+    std::string text; ///< Formatted message including level prefix and newline.
+};
+
+/**
+ * Write a batch of messages to the outputs.
+ * Consecutive console messages to the same stream and all file messages are written at once.
+ * Must be called with sMutex held.
+ */
+void writeMessages(const Message* pMessages, size_t count)
+{
+    Logger::OutputFlags outputs = sOutputs.load(std::memory_order_relaxed);
+
+    // Write to console.
+    if (is_set(outputs, Logger::OutputFlags::Console))
+    {
+        std::string buffer;
+        std::ostream* pStream = nullptr;
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::ostream* pMessageStream = pMessages[i].level > Logger::Level::Error ? &std::cout : &std::cerr;
+            if (pMessageStream != pStream && !buffer.empty())
+            {
+                *pStream << buffer;
+                pStream->flush();
+                buffer.clear();
+            }
+            pStream = pMessageStream;
+            buffer += pMessages[i].text;
+        }
+        if (!buffer.empty())
+        {
+            *pStream << buffer;
+            pStream->flush();
+        }
+    }
+
+    // Write to file.
+    if (is_set(outputs, Logger::OutputFlags::File))
+    {
+        if (count == 1)
+        {
+            printToLogFile(pMessages[0].text);
+        }
+        else
+        {
+            std::string buffer;
+            for (size_t i = 0; i < count; ++i)
+                buffer += pMessages[i].text;
+            printToLogFile(buffer);
+        }
+    }
+
+    // Write to debug window if debugger is attached.
+    if (is_set(outputs, Logger::OutputFlags::DebugWindow) && isDebuggerPresent())
+    {
+        for (size_t i = 0; i < count; ++i)
+            printToDebugWindow(pMessages[i].text);
+    }
+}
+
+/**
+ * Bounded multi-producer single-consumer message queue.
+ * This is a ring buffer with a sequence number per slot (Vyukov's bounded queue), which allows
+ * producers to enqueue without locks. Only a single consumer thread may call tryPop().
+ */
+class MessageQueue
+{
+public:
+    MessageQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+            size *= 2;
+        mMask = size - 1;
+        mSlots = std::make_unique<Slot[]>(size);
+        for (size_t i = 0; i < size; ++i)
+            mSlots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    bool tryPush(Message&& message)
+    {
+        size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot& slot = mSlots[pos & mMask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+            if (diff == 0)
+            {
+                if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    slot.message = std::move(message);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // Queue is full.
+            }
+            else
+            {
+                pos = mEnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool isEmpty() const
+    {
+        const Slot& slot = mSlots[mDequeuePos & mMask];
+        return (intptr_t)slot.sequence.load(std::memory_order_acquire) - (intptr_t)(mDequeuePos + 1) < 0;
+    }
+
+    bool tryPop(Message& message)
+    {
+        Slot& slot = mSlots[mDequeuePos & mMask];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if ((intptr_t)sequence - (intptr_t)(mDequeuePos + 1) < 0)
+            return false; // Queue is empty.
+        message = std::move(slot.message);
+        slot.sequence.store(mDequeuePos + mMask + 1, std::memory_order_release);
+        ++mDequeuePos;
+        return true;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        Message message;
+    };
+
+    size_t mMask = 0;
+    std::unique_ptr<Slot[]> mSlots;
+    alignas(64) std::atomic<size_t> mEnqueuePos{0};
+    alignas(64) size_t mDequeuePos = 0;
+};
+
+/**
+ * Background writer for asynchronous logging.
+ * Producers push formatted messages to the queue, the writer thread drains it and writes batches to the outputs.
+ */
+class AsyncWriter
+{
+public:
+    AsyncWriter(size_t capacity, Logger::OverflowPolicy overflowPolicy) : mQueue(capacity), mOverflowPolicy(overflowPolicy)
+    {
+        mThread = std::thread(&AsyncWriter::run, this);
+    }
+
+    ~AsyncWriter() { stop(); }
+
+    /**
+     * Push a message to the queue.
+     * The writer thread is kept running while producers are inside push(), so pushed messages are never lost.
+     * @return Returns false if the writer is stopping. The message is not consumed and must be written synchronously.
+     */
+    bool push(Message& message)
+    {
+        // Announce the producer before checking the stop flag. stop() sets the flag before waiting for
+        // active producers, so either the producer sees the flag or stop() waits for the producer.
+        mActiveProducers.fetch_add(1, std::memory_order_seq_cst);
+        if (mStopping.load(std::memory_order_seq_cst))
+        {
+            mActiveProducers.fetch_sub(1, std::memory_order_release);
+            return false;
+        }
+
+        bool pushed = true;
+        while (!mQueue.tryPush(std::move(message)))
+        {
+            if (mOverflowPolicy == Logger::OverflowPolicy::Drop)
+            {
+                mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+                pushed = false;
+                break;
+            }
+            wake();
+            std::this_thread::yield();
+        }
+        if (pushed)
+        {
+            mPushedCount.fetch_add(1, std::memory_order_seq_cst);
+            if (mWriterWaiting.load(std::memory_order_seq_cst))
+                wake();
+        }
+
+        mActiveProducers.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    void flush()
+    {
+        uint64_t target = mPushedCount.load(std::memory_order_seq_cst);
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWakeRequested = true;
+        mWakeCondition.notify_one();
+        mFlushCondition.wait(lock, [&]() { return mWrittenCount >= target || !mRunning; });
+    }
+
+    void stop()
+    {
+        // Wait for producers that are still pushing to the queue. The writer keeps draining the queue meanwhile.
+        mStopping.store(true, std::memory_order_seq_cst);
+        while (mActiveProducers.load(std::memory_order_seq_cst) > 0)
+            std::this_thread::yield();
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!mRunning)
+                return;
+            mTerminate = true;
+        }
+        mWakeCondition.notify_one();
+        mThread.join();
+    }
+
+private:
+    void wake()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mWakeRequested = true;
+        mWakeCondition.notify_one();
+    }
+
+    void run()
+    {
+        const size_t kMaxBatchSize = 1024;
+        std::vector<Message> batch;
+        batch.reserve(kMaxBatchSize);
+
+        while (true)
+        {
+            Message message;
+            while (batch.size() < kMaxBatchSize && mQueue.tryPop(message))
+                batch.push_back(std::move(message));
+
+            if (uint64_t droppedCount = mDroppedCount.exchange(0, std::memory_order_relaxed); droppedCount > 0)
+            {
+                batch.push_back(Message{
+                    Logger::Level::Warning, fmt::format("(Warning) Logger dropped {} messages because the queue was full.\n", droppedCount)});
+            }
+
+            if (!batch.empty())
+            {
+                {
+                    std::lock_guard<std::mutex> lock(sMutex);
+                    writeMessages(batch.data(), batch.size());
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mWrittenCount += batch.size();
+                }
+                mFlushCondition.notify_all();
+                batch.clear();
+                continue;
+            }
+
+            // Queue is empty, wait for more messages.
+            std::unique_lock<std::mutex> lock(mMutex);
+            if (mTerminate)
+            {
+                if (mQueue.isEmpty())
+                    break;
+                continue;
+            }
+            mWriterWaiting.store(true, std::memory_order_seq_cst);
+            // Re-check the queue after announcing that we are waiting to avoid missing a wake up.
+            if (!mWakeRequested && mQueue.isEmpty())
+                mWakeCondition.wait_for(lock, std::chrono::milliseconds(100), [&]() { return mWakeRequested || mTerminate; });
+            mWriterWaiting.store(false, std::memory_order_relaxed);
+            mWakeRequested = false;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRunning = false;
+        mFlushCondition.notify_all();
+    }
+
+    MessageQueue mQueue;
+    Logger::OverflowPolicy mOverflowPolicy;
+    std::thread mThread;
+
+    std::atomic<uint32_t> mActiveProducers{0};
+    std::atomic<bool> mStopping{false};
+    std::atomic<uint64_t> mPushedCount{0};
+    std::atomic<uint64_t> mDroppedCount{0};
+    std::atomic<bool> mWriterWaiting{false};
+
+    std::mutex mMutex; ///< Protects the members below.
+    std::condition_variable mWakeCondition;
+    std::condition_variable mFlushCondition;
+    uint64_t mWrittenCount = 0;
+    bool mWakeRequested = false;
+    bool mTerminate = false;
+    bool mRunning = true;
+};
+/// Asynchronous writer. The current writer is accessed without locks. Threads using it are counted in
+/// one of two reader counts, selected by the current epoch. When the writer is replaced, the epoch is flipped
+/// and the retired writer is deleted once the readers of the previous epoch (which may have seen it) are done.
+std::mutex sAsyncMutex;
+std::unique_ptr<AsyncWriter> spAsyncWriterOwner; ///< Owns the current writer. Protected by sAsyncMutex.
+std::atomic<AsyncWriter*> spAsyncWriter{nullptr};
+std::atomic<uint32_t> sAsyncEpoch{0};
+std::atomic<uint32_t> sAsyncReaders[2] = {0, 0};
+size_t sAsyncQueueCapacity = Logger::kDefaultQueueCapacity;
+Logger::OverflowPolicy sAsyncOverflowPolicy = Logger::OverflowPolicy::Block;
+
+/// Scoped access to the current asynchronous writer. The writer is not deleted while the access is alive.
+class AsyncWriterAccess
+{
+public:
+    AsyncWriterAccess()
+    {
+        // Register as a reader before loading the writer. A writer replaced after the registration is
+        // not deleted until the reader is done, a writer replaced before it can no longer be loaded.
+        mEpoch = sAsyncEpoch.load(std::memory_order_seq_cst) & 1;
+        sAsyncReaders[mEpoch].fetch_add(1, std::memory_order_seq_cst);
+        mpWriter = spAsyncWriter.load(std::memory_order_seq_cst);
+    }
+
+    ~AsyncWriterAccess() { sAsyncReaders[mEpoch].fetch_sub(1, std::memory_order_release); }
+
+    AsyncWriterAccess(const AsyncWriterAccess&) = delete;
+    AsyncWriterAccess& operator=(const AsyncWriterAccess&) = delete;
+
+    AsyncWriter* get() const { return mpWriter; }
+
+private:
+    uint32_t mEpoch;
+    AsyncWriter* mpWriter;
+};
+
+/// Wait until no thread can still access a writer that was replaced before this call.
+/// Must be called with sAsyncMutex held.
+void waitForAsyncReaders()
+{
+    uint32_t prevEpoch = sAsyncEpoch.fetch_add(1, std::memory_order_seq_cst) & 1;
+    while (sAsyncReaders[prevEpoch].load(std::memory_order_acquire) > 0)
+        std::this_thread::yield();
+}
 } // namespace
 
 void Logger::shutdown()
 {
+    setAsync(false);
+
+    std::lock_guard<std::mutex> lock(sMutex);
     if (sLogFile)
     {
         fclose(sLogFile);
@@ -148,62 +502,109 @@ private:
 
 void Logger::log(Level level, const std::string_view msg, Frequency frequency)
 {
-    std::lock_guard<std::mutex> lock(sMutex);
-    if (level <= sVerbosity)
-    {
-        std::string s = fmt::format("{} {}\n", getLogLevelString(level), msg);
+    if (level > sVerbosity.load(std::memory_order_relaxed))
+        return;
 
-        if (frequency == Frequency::Once && MessageDeduplicator::instance().isDuplicate(s))
-            return;
+    std::string s = fmt::format("{} {}\n", getLogLevelString(level), msg);
 
-        // Write to console.
-        if (is_set(sOutputs, OutputFlags::Console))
-        {
-            auto& os = level > Logger::Level::Error ? std::cout : std::cerr;
-            os << s;
-            os.flush();
-        }
+    if (frequency == Frequency::Once && MessageDeduplicator::instance().isDuplicate(s))
+        return;
 
-        // Write to file.
-        if (is_set(sOutputs, OutputFlags::File))
+    Message message{level, std::move(s)};
+    if (spAsyncWriter.load(std::memory_order_relaxed))
+    {
+        AsyncWriterAccess access;
+        if (AsyncWriter* pAsyncWriter = access.get(); pAsyncWriter && pAsyncWriter->push(message))
         {
-            printToLogFile(s);
+            // Make sure fatal messages are written before the application terminates.
+            if (level == Level::Fatal)
+                pAsyncWriter->flush();
+            return;
         }
+        // The writer was stopped after we loaded it, fall back to writing synchronously.
+    }
 
-        // Write to debug window if debugger is attached.
-        if (is_set(sOutputs, OutputFlags::DebugWindow) && isDebuggerPresent())
-        {
-            printToDebugWindow(s);
-        }
+    std::lock_guard<std::mutex> lock(sMutex);
+    writeMessages(&message, 1);
+}
+
+void Logger::setAsync(bool enabled, size_t queueCapacity, OverflowPolicy overflowPolicy)
+{
+    std::lock_guard<std::mutex> lock(sAsyncMutex);
+
+    // Stop the current writer (this writes all pending messages).
+    std::unique_ptr<AsyncWriter> pRetiredWriter = std::move(spAsyncWriterOwner);
+    spAsyncWriter.store(nullptr, std::memory_order_seq_cst);
+    if (pRetiredWriter)
+        pRetiredWriter->stop();
+
+    if (enabled)
+    {
+        spAsyncWriterOwner = std::make_unique<AsyncWriter>(queueCapacity, overflowPolicy);
+        spAsyncWriter.store(spAsyncWriterOwner.get(), std::memory_order_seq_cst);
+        sAsyncQueueCapacity = queueCapacity;
+        sAsyncOverflowPolicy = overflowPolicy;
+    }
+
+    // Delete the retired writer once no thread can access it anymore.
+    if (pRetiredWriter)
+    {
+        waitForAsyncReaders();
+        pRetiredWriter.reset();
     }
 }
 
+size_t Logger::getAsyncQueueCapacity()
+{
+    std::lock_guard<std::mutex> lock(sAsyncMutex);
+    return sAsyncQueueCapacity;
+}
+
+Logger::OverflowPolicy Logger::getAsyncOverflowPolicy()
+{
+    std::lock_guard<std::mutex> lock(sAsyncMutex);
+    return sAsyncOverflowPolicy;
+}
+
+bool Logger::isAsync()
+{
+    return spAsyncWriter.load(std::memory_order_acquire) != nullptr;
+}
+
+void Logger::flush()
+{
+    AsyncWriterAccess access;
+    if (AsyncWriter* pAsyncWriter = access.get())
+        pAsyncWriter->flush();
+}
+
 void Logger::setVerbosity(Level level)
 {
-    std::lock_guard<std::mutex> lock(sMutex);
     sVerbosity = level;
 }
 
 Logger::Level Logger::getVerbosity()
 {
-    std::lock_guard<std::mutex> lock(sMutex);
     return sVerbosity;
 }
 
 void Logger::setOutputs(OutputFlags outputs)
 {
-    std::lock_guard<std::mutex> lock(sMutex);
+    // Write pending messages to the previous outputs.
+    flush();
     sOutputs = outputs;
 }
 
 Logger::OutputFlags Logger::getOutputs()
 {
-    std::lock_guard<std::mutex> lock(sMutex);
     return sOutputs;
 }
 
 void Logger::setLogFilePath(const std::filesystem::path& path)
 {
+    // Write pending messages to the previous log file.
+    flush();
+
     std::lock_guard<std::mutex> lock(sMutex);
     if (sLogFile)
     {
@@ -256,6 +657,20 @@ FALCOR_SCRIPT_BINDING(Logger)
         [](pybind11::object, std::filesystem::path path) { Logger::setLogFilePath(path); }
     );
 
+    pybind11::enum_<Logger::OverflowPolicy> overflowPolicy(logger, "OverflowPolicy");
+    overflowPolicy.value("Block", Logger::OverflowPolicy::Block);
+    overflowPolicy.value("Drop", Logger::OverflowPolicy::Drop);
+
+    logger.def_static(
+        "set_async",
+        &Logger::setAsync,
+        "enabled"_a,
+        "queue_capacity"_a = Logger::kDefaultQueueCapacity,
+        "overflow_policy"_a = Logger::OverflowPolicy::Block
+    );
+    logger.def_property_readonly_static("is_async", [](pybind11::object) { return Logger::isAsync(); });
+    logger.def_static("flush", &Logger::flush);
+
     logger.def_static(
         "log",
         [](Logger::Level level, const std::string_view msg) { Logger::log(level, msg, Logger::Frequency::Always); },
@@ -37,6 +37,8 @@ namespace Falcor
 /**
  * Container class for logging messages.
  * Messages are only printed to the selected outputs if they match the verbosity level.
+ * In asynchronous mode, messages are pushed to a bounded lock-free queue and written to the
+ * outputs in batches by a background thread. The queue is flushed on fatal messages and on shutdown.
  */
 class FALCOR_API Logger
 {
@@ -68,6 +70,15 @@ public:
         DebugWindow = 0x4, ///< Output to debug window (if debugger is attached).
     };
 
+    /// Behavior when the asynchronous message queue is full.
+    enum class OverflowPolicy
+    {
+        Block, ///< Wait until the background thread has made space in the queue.
+        Drop,  ///< Drop the message. The number of dropped messages is reported in the log.
+    };
+
+    static constexpr size_t kDefaultQueueCapacity = 8192;
+
     /**
      * Shutdown the logger and close the log file.
      */
@@ -109,6 +120,35 @@ public:
      */
     static std::filesystem::path getLogFilePath();
 
+    /**
+     * Enable/disable asynchronous logging.
+     * Disabling asynchronous logging flushes all pending messages and stops the background thread.
+     * @param[in] enabled True to enable asynchronous logging.
+     * @param[in] queueCapacity Capacity of the message queue (rounded up to a power of two).
+     * @param[in] overflowPolicy Behavior when the message queue is full.
+     */
+    static void setAsync(bool enabled, size_t queueCapacity = kDefaultQueueCapacity, OverflowPolicy overflowPolicy = OverflowPolicy::Block);
+
+    /**
+     * Check if asynchronous logging is enabled.
+     */
+    static bool isAsync();
+
+    /**
+     * Get the queue capacity passed to the last call enabling asynchronous logging.
+     */
+    static size_t getAsyncQueueCapacity();
+
+    /**
+     * Get the overflow policy passed to the last call enabling asynchronous logging.
+     */
+    static OverflowPolicy getAsyncOverflowPolicy();
+
+    /**
+     * Block until all pending messages have been written to the outputs.
+     */
+    static void flush();
+
     /**
      * Log a message.
      * @param[in] level Log level.
@@ -163,6 +163,11 @@ struct AABB
         if (!valid())
             return {};
 
+#if FALCOR_MATH_SIMD
+        AABB result;
+        math::simd::transformBounds(mat, minPoint, maxPoint, result.minPoint, result.maxPoint);
+        return result;
+#else
         float3 xa = mat.getCol(0).xyz() * minPoint.x;
         float3 xb = mat.getCol(0).xyz() * maxPoint.x;
         float3 xMin = min(xa, xb);
@@ -182,6 +187,7 @@ struct AABB
         float3 newMax = xMax + yMax + zMax + mat.getCol(3).xyz();
 
         return AABB(newMin, newMax);
+#endif
     }
 
     /// Checks whether two bounding boxes are equal.
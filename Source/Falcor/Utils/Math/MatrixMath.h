@@ -35,6 +35,7 @@
 #pragma once
 
 #include "MatrixTypes.h"
+#include "MatrixSIMD.h"
 #include "Vector.h"
 #include "Quaternion.h"
 
@@ -326,6 +327,69 @@ template<typename T>
     return inverse * oneOverDet;
 }
 
+/// Compute inverse of an affine 4x4 matrix, i.e. a matrix with the last row equal to (0, 0, 0, 1).
+template<typename T>
+[[nodiscard]] inline matrix<T, 4, 4> inverseAffine(const matrix<T, 4, 4>& m)
+{
+    matrix<T, 3, 3> invRot = inverse(matrix<T, 3, 3>(m));
+    vector<T, 3> invTranslation = -mul(invRot, vector<T, 3>(m[0][3], m[1][3], m[2][3]));
+
+    matrix<T, 4, 4> result(invRot);
+    for (int r = 0; r < 3; ++r)
+        result[r][3] = invTranslation[r];
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// SIMD specializations for float4x4 (see MatrixSIMD.h)
+// ----------------------------------------------------------------------------
+
+#if FALCOR_MATH_SIMD
+
+/// Multiply matrix and matrix.
+[[nodiscard]] inline float4x4 mul(const float4x4& lhs, const float4x4& rhs)
+{
+    return simd::mul(lhs, rhs);
+}
+
+/// Multiply matrix and vector. Vector is treated as a column vector.
+[[nodiscard]] inline float4 mul(const float4x4& lhs, const float4& rhs)
+{
+    return simd::mul(lhs, rhs);
+}
+
+/// Transform a point by a 4x4 matrix. The point is treated as a column vector with a 1 in the 4th component.
+[[nodiscard]] inline float3 transformPoint(const float4x4& m, const float3& v)
+{
+    return simd::transform<true>(m, v);
+}
+
+/// Transform a vector by a 4x4 matrix. The vector is treated as a column vector with a 0 in the 4th component.
+[[nodiscard]] inline float3 transformVector(const float4x4& m, const float3& v)
+{
+    return simd::transform<false>(m, v);
+}
+
+/// Transpose a matrix.
+[[nodiscard]] inline float4x4 transpose(const float4x4& m)
+{
+    return simd::transpose(m);
+}
+
+/// Compute inverse of a 4x4 matrix.
+[[nodiscard]] inline float4x4 inverse(const float4x4& m)
+{
+    return simd::inverse(m);
+}
+
+/// Compute inverse of an affine 4x4 matrix, i.e. a matrix with the last row equal to (0, 0, 0, 1).
+[[nodiscard]] inline float4x4 inverseAffine(const float4x4& m)
+{
+    return simd::inverseAffine(m);
+}
+
+#endif // FALCOR_MATH_SIMD
+
 /// Compute the (X * Y * Z) euler angles of a 4x4 matrix.
 template<typename T>
 void extractEulerAngleXYZ(const matrix<T, 4, 4>& m, float& angleX, float& angleY, float& angleZ)
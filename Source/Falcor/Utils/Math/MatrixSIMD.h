@@ -0,0 +1,500 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+
+#include "MatrixTypes.h"
+#include "VectorTypes.h"
+
+/**
+ * SIMD implementations of the most frequently used float4x4 operations.
+ *
+ * The backend is selected at compile time:
+ * - FALCOR_MATH_SIMD_AVX2: x86 with AVX2 and FMA (e.g. /arch:AVX2 or -mavx2 -mfma)
+ * - FALCOR_MATH_SIMD_SSE: x86 with SSE2 (default on x64)
+ * - FALCOR_MATH_SIMD_NEON: ARM64 with NEON
+ *
+ * If no backend is available, or FALCOR_MATH_NO_SIMD is defined, FALCOR_MATH_SIMD is 0 and the scalar
+ * implementations in MatrixMath.h are used.
+ */
+
+#if !defined(FALCOR_MATH_NO_SIMD)
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#define FALCOR_MATH_SIMD_AVX2 1
+#define FALCOR_MATH_SIMD_SSE 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FALCOR_MATH_SIMD_SSE 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define FALCOR_MATH_SIMD_NEON 1
+#endif
+#endif
+
+#if FALCOR_MATH_SIMD_SSE || FALCOR_MATH_SIMD_NEON
+#define FALCOR_MATH_SIMD 1
+#else
+#define FALCOR_MATH_SIMD 0
+#endif
+
+#if FALCOR_MATH_SIMD_SSE
+#include <immintrin.h>
+#elif FALCOR_MATH_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+#if FALCOR_MATH_SIMD
+
+namespace Falcor
+{
+namespace math
+{
+namespace simd
+{
+
+// ----------------------------------------------------------------------------
+// 4-wide float vector primitives
+// ----------------------------------------------------------------------------
+
+#if FALCOR_MATH_SIMD_SSE
+
+using f32x4 = __m128;
+
+inline f32x4 load(const float* p)
+{
+    return _mm_loadu_ps(p);
+}
+inline void store(float* p, f32x4 v)
+{
+    _mm_storeu_ps(p, v);
+}
+inline f32x4 set(float x, float y, float z, float w)
+{
+    return _mm_setr_ps(x, y, z, w);
+}
+inline f32x4 add(f32x4 a, f32x4 b)
+{
+    return _mm_add_ps(a, b);
+}
+inline f32x4 sub(f32x4 a, f32x4 b)
+{
+    return _mm_sub_ps(a, b);
+}
+inline f32x4 mul(f32x4 a, f32x4 b)
+{
+    return _mm_mul_ps(a, b);
+}
+inline f32x4 div(f32x4 a, f32x4 b)
+{
+    return _mm_div_ps(a, b);
+}
+inline f32x4 min(f32x4 a, f32x4 b)
+{
+    return _mm_min_ps(a, b);
+}
+inline f32x4 max(f32x4 a, f32x4 b)
+{
+    return _mm_max_ps(a, b);
+}
+
+/// Returns a * b + c.
+inline f32x4 madd(f32x4 a, f32x4 b, f32x4 c)
+{
+#if FALCOR_MATH_SIMD_AVX2
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+/// Returns (a[X], a[Y], b[Z], b[W]).
+template<int X, int Y, int Z, int W>
+inline f32x4 shuffle(f32x4 a, f32x4 b)
+{
+    return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+}
+
+/// Transpose the 4x4 matrix given by its rows in place.
+inline void transpose(f32x4& r0, f32x4& r1, f32x4& r2, f32x4& r3)
+{
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+}
+
+#elif FALCOR_MATH_SIMD_NEON
+
+using f32x4 = float32x4_t;
+
+inline f32x4 load(const float* p)
+{
+    return vld1q_f32(p);
+}
+inline void store(float* p, f32x4 v)
+{
+    vst1q_f32(p, v);
+}
+inline f32x4 set(float x, float y, float z, float w)
+{
+    const float v[4] = {x, y, z, w};
+    return vld1q_f32(v);
+}
+inline f32x4 add(f32x4 a, f32x4 b)
+{
+    return vaddq_f32(a, b);
+}
+inline f32x4 sub(f32x4 a, f32x4 b)
+{
+    return vsubq_f32(a, b);
+}
+inline f32x4 mul(f32x4 a, f32x4 b)
+{
+    return vmulq_f32(a, b);
+}
+inline f32x4 div(f32x4 a, f32x4 b)
+{
+    return vdivq_f32(a, b);
+}
+inline f32x4 min(f32x4 a, f32x4 b)
+{
+    return vminq_f32(a, b);
+}
+inline f32x4 max(f32x4 a, f32x4 b)
+{
+    return vmaxq_f32(a, b);
+}
+
+/// Returns a * b + c.
+inline f32x4 madd(f32x4 a, f32x4 b, f32x4 c)
+{
+    return vfmaq_f32(c, a, b);
+}
+
+/// Returns (a[X], a[Y], b[Z], b[W]).
+template<int X, int Y, int Z, int W>
+inline f32x4 shuffle(f32x4 a, f32x4 b)
+{
+    f32x4 r = vdupq_n_f32(vgetq_lane_f32(a, X));
+    r = vsetq_lane_f32(vgetq_lane_f32(a, Y), r, 1);
+    r = vsetq_lane_f32(vgetq_lane_f32(b, Z), r, 2);
+    return vsetq_lane_f32(vgetq_lane_f32(b, W), r, 3);
+}
+
+/// Transpose the 4x4 matrix given by its rows in place.
+inline void transpose(f32x4& r0, f32x4& r1, f32x4& r2, f32x4& r3)
+{
+    float32x4x2_t t01 = vtrnq_f32(r0, r1);
+    float32x4x2_t t23 = vtrnq_f32(r2, r3);
+    r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+
+#endif
+
+/// Returns a vector with all components set to a[I].
+template<int I>
+inline f32x4 splat(f32x4 a)
+{
+    return shuffle<I, I, I, I>(a, a);
+}
+
+#if FALCOR_MATH_SIMD_NEON
+template<>
+inline f32x4 splat<0>(f32x4 a)
+{
+    return vdupq_laneq_f32(a, 0);
+}
+template<>
+inline f32x4 splat<1>(f32x4 a)
+{
+    return vdupq_laneq_f32(a, 1);
+}
+template<>
+inline f32x4 splat<2>(f32x4 a)
+{
+    return vdupq_laneq_f32(a, 2);
+}
+template<>
+inline f32x4 splat<3>(f32x4 a)
+{
+    return vdupq_laneq_f32(a, 3);
+}
+#endif
+
+/// Returns the sum of all components in all components.
+inline f32x4 sumAll(f32x4 a)
+{
+    a = add(a, shuffle<1, 0, 3, 2>(a, a));
+    return add(a, shuffle<2, 3, 0, 1>(a, a));
+}
+
+inline f32x4 load(const float3& v, float w)
+{
+    return set(v.x, v.y, v.z, w);
+}
+
+inline float3 storeFloat3(f32x4 v)
+{
+    float r[4];
+    store(r, v);
+    return float3(r[0], r[1], r[2]);
+}
+
+inline void loadRows(const float4x4& m, f32x4& r0, f32x4& r1, f32x4& r2, f32x4& r3)
+{
+    r0 = load(&m[0][0]);
+    r1 = load(&m[1][0]);
+    r2 = load(&m[2][0]);
+    r3 = load(&m[3][0]);
+}
+
+inline float4x4 storeRows(f32x4 r0, f32x4 r1, f32x4 r2, f32x4 r3)
+{
+    float4x4 result;
+    store(&result[0][0], r0);
+    store(&result[1][0], r1);
+    store(&result[2][0], r2);
+    store(&result[3][0], r3);
+    return result;
+}
+
+/// Returns the cross product of the xyz components. The w component is zero.
+inline f32x4 cross3(f32x4 a, f32x4 b)
+{
+    f32x4 aYZX = shuffle<1, 2, 0, 3>(a, a);
+    f32x4 bYZX = shuffle<1, 2, 0, 3>(b, b);
+    f32x4 c = sub(mul(a, bYZX), mul(aYZX, b));
+    return shuffle<1, 2, 0, 3>(c, c);
+}
+
+// ----------------------------------------------------------------------------
+// Matrix operations
+// ----------------------------------------------------------------------------
+
+/// Multiply matrix and matrix.
+inline float4x4 mul(const float4x4& lhs, const float4x4& rhs)
+{
+    float4x4 result;
+#if FALCOR_MATH_SIMD_AVX2
+    // Compute two rows at once, each row of the result is a linear combination of the rows of rhs.
+    __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&rhs[0][0]));
+    __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&rhs[1][0]));
+    __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&rhs[2][0]));
+    __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&rhs[3][0]));
+    for (int r = 0; r < 4; r += 2)
+    {
+        __m256 a = _mm256_loadu_ps(&lhs[r][0]);
+        __m256 c = _mm256_mul_ps(_mm256_permute_ps(a, 0x00), b0);
+        c = _mm256_fmadd_ps(_mm256_permute_ps(a, 0x55), b1, c);
+        c = _mm256_fmadd_ps(_mm256_permute_ps(a, 0xaa), b2, c);
+        c = _mm256_fmadd_ps(_mm256_permute_ps(a, 0xff), b3, c);
+        _mm256_storeu_ps(&result[r][0], c);
+    }
+#else
+    // Each row of the result is a linear combination of the rows of rhs.
+    f32x4 b0, b1, b2, b3;
+    loadRows(rhs, b0, b1, b2, b3);
+    for (int r = 0; r < 4; ++r)
+    {
+        f32x4 a = load(&lhs[r][0]);
+        f32x4 c = mul(splat<0>(a), b0);
+        c = madd(splat<1>(a), b1, c);
+        c = madd(splat<2>(a), b2, c);
+        c = madd(splat<3>(a), b3, c);
+        store(&result[r][0], c);
+    }
+#endif
+    return result;
+}
+
+/// Multiply matrix and vector. Vector is treated as a column vector.
+inline float4 mul(const float4x4& m, const float4& v)
+{
+    f32x4 c0, c1, c2, c3;
+    loadRows(m, c0, c1, c2, c3);
+    transpose(c0, c1, c2, c3);
+    f32x4 x = load(&v[0]);
+    f32x4 r = mul(c0, splat<0>(x));
+    r = madd(c1, splat<1>(x), r);
+    r = madd(c2, splat<2>(x), r);
+    r = madd(c3, splat<3>(x), r);
+    float4 result;
+    store(&result[0], r);
+    return result;
+}
+
+/// Transform a point (w = 1) or vector (w = 0) by a 4x4 matrix.
+template<bool IsPoint>
+inline float3 transform(const float4x4& m, const float3& v)
+{
+    f32x4 c0, c1, c2, c3;
+    loadRows(m, c0, c1, c2, c3);
+    transpose(c0, c1, c2, c3);
+    f32x4 x = load(v, 0.f);
+    f32x4 r = mul(c0, splat<0>(x));
+    r = madd(c1, splat<1>(x), r);
+    r = madd(c2, splat<2>(x), r);
+    if (IsPoint)
+        r = add(r, c3);
+    return storeFloat3(r);
+}
+
+/// Transpose a matrix.
+inline float4x4 transpose(const float4x4& m)
+{
+    f32x4 r0, r1, r2, r3;
+    loadRows(m, r0, r1, r2, r3);
+    transpose(r0, r1, r2, r3);
+    return storeRows(r0, r1, r2, r3);
+}
+
+/// 2x2 matrix product a * b with 2x2 matrices stored row-major in a vector.
+inline f32x4 mul2x2(f32x4 a, f32x4 b)
+{
+    return madd(a, shuffle<0, 3, 0, 3>(b, b), mul(shuffle<1, 0, 3, 2>(a, a), shuffle<2, 1, 2, 1>(b, b)));
+}
+
+/// 2x2 matrix product adj(a) * b with 2x2 matrices stored row-major in a vector.
+inline f32x4 adjMul2x2(f32x4 a, f32x4 b)
+{
+    return sub(mul(shuffle<3, 3, 0, 0>(a, a), b), mul(shuffle<1, 1, 2, 2>(a, a), shuffle<2, 3, 0, 1>(b, b)));
+}
+
+/// 2x2 matrix product a * adj(b) with 2x2 matrices stored row-major in a vector.
+inline f32x4 mulAdj2x2(f32x4 a, f32x4 b)
+{
+    return sub(mul(a, shuffle<3, 0, 3, 0>(b, b)), mul(shuffle<1, 0, 3, 2>(a, a), shuffle<2, 1, 2, 1>(b, b)));
+}
+
+/// Compute inverse of a 4x4 matrix.
+/// Uses the block-wise inversion of the matrix split into 2x2 sub-matrices [A B; C D].
+inline float4x4 inverse(const float4x4& m)
+{
+    f32x4 r0, r1, r2, r3;
+    loadRows(m, r0, r1, r2, r3);
+
+    f32x4 A = shuffle<0, 1, 0, 1>(r0, r1);
+    f32x4 B = shuffle<2, 3, 2, 3>(r0, r1);
+    f32x4 C = shuffle<0, 1, 0, 1>(r2, r3);
+    f32x4 D = shuffle<2, 3, 2, 3>(r2, r3);
+
+    // Determinants of the sub-matrices (|A|, |B|, |C|, |D|).
+    f32x4 detSub = sub(
+        mul(shuffle<0, 2, 0, 2>(r0, r2), shuffle<1, 3, 1, 3>(r1, r3)), //
+        mul(shuffle<1, 3, 1, 3>(r0, r2), shuffle<0, 2, 0, 2>(r1, r3))
+    );
+    f32x4 detA = splat<0>(detSub);
+    f32x4 detB = splat<1>(detSub);
+    f32x4 detC = splat<2>(detSub);
+    f32x4 detD = splat<3>(detSub);
+
+    f32x4 DC = adjMul2x2(D, C);
+    f32x4 AB = adjMul2x2(A, B);
+
+    // Adjugates of the blocks of the inverse [X Y; Z W] * |M|.
+    f32x4 X = sub(mul(detD, A), mul2x2(B, DC));
+    f32x4 W = sub(mul(detA, D), mul2x2(C, AB));
+    f32x4 Y = sub(mul(detB, C), mulAdj2x2(D, AB));
+    f32x4 Z = sub(mul(detC, B), mulAdj2x2(A, DC));
+
+    // |M| = |A| |D| + |B| |C| - tr(adj(A) B adj(D) C)
+    f32x4 detM = madd(detA, detD, mul(detB, detC));
+    detM = sub(detM, sumAll(mul(AB, shuffle<0, 2, 1, 3>(DC, DC))));
+
+    f32x4 invDetM = div(set(1.f, -1.f, -1.f, 1.f), detM);
+    X = mul(X, invDetM);
+    Y = mul(Y, invDetM);
+    Z = mul(Z, invDetM);
+    W = mul(W, invDetM);
+
+    // Apply the adjugate and assemble the rows.
+    return storeRows(
+        shuffle<3, 1, 3, 1>(X, Y), //
+        shuffle<2, 0, 2, 0>(X, Y),
+        shuffle<3, 1, 3, 1>(Z, W),
+        shuffle<2, 0, 2, 0>(Z, W)
+    );
+}
+
+/// Compute inverse of an affine 4x4 matrix.
+inline float4x4 inverseAffine(const float4x4& m)
+{
+    f32x4 r0 = load(&m[0][0]);
+    f32x4 r1 = load(&m[1][0]);
+    f32x4 r2 = load(&m[2][0]);
+
+    // The columns of the inverse 3x3 matrix are the cross products of its rows divided by the determinant.
+    f32x4 c0 = cross3(r1, r2);
+    f32x4 c1 = cross3(r2, r0);
+    f32x4 c2 = cross3(r0, r1);
+    f32x4 invDet = div(set(1.f, 1.f, 1.f, 1.f), sumAll(mul(r0, c0)));
+    c0 = mul(c0, invDet);
+    c1 = mul(c1, invDet);
+    c2 = mul(c2, invDet);
+
+    // Translation is -inverse(R) * t, with t stored in the w components of the rows.
+    f32x4 t = mul(c0, splat<3>(r0));
+    t = madd(c1, splat<3>(r1), t);
+    t = madd(c2, splat<3>(r2), t);
+    t = sub(set(0.f, 0.f, 0.f, 0.f), t);
+
+    transpose(c0, c1, c2, t);
+    return storeRows(c0, c1, c2, set(0.f, 0.f, 0.f, 1.f));
+}
+
+/// Transform an axis-aligned bounding box given by its min/max points by a 4x4 matrix.
+inline void transformBounds(const float4x4& m, const float3& minPoint, const float3& maxPoint, float3& outMin, float3& outMax)
+{
+    f32x4 c0, c1, c2, c3;
+    loadRows(m, c0, c1, c2, c3);
+    transpose(c0, c1, c2, c3);
+
+    f32x4 p0 = load(minPoint, 0.f);
+    f32x4 p1 = load(maxPoint, 0.f);
+
+    f32x4 a = mul(c0, splat<0>(p0));
+    f32x4 b = mul(c0, splat<0>(p1));
+    f32x4 newMin = min(a, b);
+    f32x4 newMax = max(a, b);
+
+    a = mul(c1, splat<1>(p0));
+    b = mul(c1, splat<1>(p1));
+    newMin = add(newMin, min(a, b));
+    newMax = add(newMax, max(a, b));
+
+    a = mul(c2, splat<2>(p0));
+    b = mul(c2, splat<2>(p1));
+    newMin = add(add(newMin, min(a, b)), c3);
+    newMax = add(add(newMax, max(a, b)), c3);
+
+    outMin = storeFloat3(newMin);
+    outMax = storeFloat3(newMax);
+}
+
+} // namespace simd
+} // namespace math
+} // namespace Falcor
+
+#endif // FALCOR_MATH_SIMD
@@ -28,114 +28,251 @@
 #include "AliasTable.h"
 #include "Core/Error.h"
 #include "Core/API/Device.h"
+#include "Utils/NumericRange.h"
+#include <algorithm>
+#include <execution>
 
 namespace Falcor
 {
-// This builds an alias table via the O(N) algorithm from Vose 1991, "A linear algorithm for generating random
-// numbers with a given distribution," IEEE Transactions on Software Engineering 17(9), 972-975.
+namespace
+{
+// Number of elements processed per task by the parallel passes below. The decomposition into blocks does not depend
+// on the number of threads, which keeps the floating-point results (and hence the table) deterministic.
+constexpr size_t kBlockSize = 1 << 16;
+
+size_t getBlockCount(size_t count)
+{
+    return (count + kBlockSize - 1) / kBlockSize;
+}
+
+/// Calls func(blockIndex, begin, end) in parallel for each block of [0, count).
+template<typename F>
+void parallelForBlocks(size_t count, F func)
+{
+    auto range = NumericRange<size_t>(0, getBlockCount(count));
+    std::for_each(
+        std::execution::par,
+        range.begin(),
+        range.end(),
+        [&](size_t blockIndex)
+        {
+            const size_t begin = blockIndex * kBlockSize;
+            func(blockIndex, begin, std::min(count, begin + kBlockSize));
+        }
+    );
+}
+
+/// Computes the exclusive prefix sum of value(i) for i in [0, count). The result has count + 1 entries.
+template<typename F>
+std::vector<double> computePrefixSum(size_t count, F value)
+{
+    std::vector<double> blockOffsets(getBlockCount(count));
+    parallelForBlocks(
+        count,
+        [&](size_t blockIndex, size_t begin, size_t end)
+        {
+            double sum = 0.0;
+            for (size_t i = begin; i < end; ++i)
+                sum += value(i);
+            blockOffsets[blockIndex] = sum;
+        }
+    );
+
+    double total = 0.0;
+    for (double& offset : blockOffsets)
+    {
+        double sum = offset;
+        offset = total;
+        total += sum;
+    }
+
+    std::vector<double> prefix(count + 1);
+    parallelForBlocks(
+        count,
+        [&](size_t blockIndex, size_t begin, size_t end)
+        {
+            double sum = blockOffsets[blockIndex];
+            for (size_t i = begin; i < end; ++i)
+            {
+                prefix[i] = sum;
+                sum += value(i);
+            }
+        }
+    );
+    prefix[count] = total;
+
+    return prefix;
+}
+} // namespace
+
+// This builds an alias table with the parallel sweeping construction from Hübschle-Schneider and Sanders 2019,
+// "Parallel Weighted Random Sampling," ESA 2019. The resulting table is equivalent to the sequential O(N) algorithm
+// from Vose 1991, "A linear algorithm for generating random numbers with a given distribution," IEEE Transactions
+// on Software Engineering 17(9), 972-975.
 //
-// Basic idea:  creating each alias table entry combines one overweighted sample and one underweighted sample
-// into one alias table entry plus a residual sample (the overweighted sample minus some of its weight).
+// Basic idea:  the weights are normalized to an average of one and split into light (< 1) and heavy (>= 1) items.
+// Sweeping through both lists, each light item fills its bucket with the current heavy item. Once the current heavy
+// item has given away its excess weight, its residual forms a bucket that is filled by the next heavy item.
 //
-// By first separating all inputs into 2 temporary buffer (one overweighted set, with weights above the
-// average; one underweighted set, with weights below average), we can simply walk through the lists once,
-// merging the first elements in each temporary buffer.  The residual sample is interted into either the
-// overweighted or underweighted set, depending on its residual weight.
+// Instead of tracking the residual weights during the sweep, the state of the sweep is fully determined by the prefix
+// sums D of the light item deficits (1 - w) and E of the heavy item excesses (w - 1): light item l is emitted before
+// heavy item h iff D[l] <= E[h + 1]. The sweep is therefore a merge of two sorted sequences, which is split into
+// independent chunks by a binary search over the prefix sums. All passes run in parallel and the table is built in
+// O(N) work.
 //
-// The main complexity is dealing with corner cases, thanks to numerical precision issues, where you don't
-// have 2 valid entries to combine.  By definition, in these corner cases, all remaining unhandled samples
-// actually have the average weight (within numerical precision limits)
+// Corner cases stem from numerical precision, where one of the lists runs out before the other. By definition, all
+// remaining items then have the average weight (within numerical precision limits) and get a bucket of their own.
 AliasTable::AliasTable(ref<Device> pDevice, std::vector<float> weights, std::mt19937& rng) : mCount((uint32_t)weights.size())
 {
-    // Use >= since we reserve 0xFFFFFFFFu as an invalid flag marker during construction.
     if (weights.size() >= std::numeric_limits<uint32_t>::max())
         FALCOR_THROW("Too many entries for alias table.");
 
-    std::uniform_int_distribution<uint32_t> rngDist;
-
     mpWeights =
         pDevice->createStructuredBuffer(sizeof(float), mCount, ResourceBindFlags::ShaderResource, MemoryType::DeviceLocal, weights.data());
 
-    // Our working set / intermediate buffers (underweight & overweight); initialize to "invalid"
-    std::vector<uint32_t> lowIdx(mCount, 0xFFFFFFFFu);
-    std::vector<uint32_t> highIdx(mCount, 0xFFFFFFFFu);
-
     // Sum element weights, use double to minimize precision issues
-    mWeightSum = 0.0;
-    for (float f : weights)
-        mWeightSum += f;
-
-    // Find the average weight
-    float avgWeight = float(mWeightSum / double(mCount));
+    mWeightSum = computeWeightSum(weights);
 
-    // Initialize working set. Inset inputs into our lists of above-average or below-average weight elements.
-    int lowCount = 0;
-    int highCount = 0;
-    for (uint32_t i = 0; i < mCount; ++i)
-    {
-        if (weights[i] < avgWeight)
-            lowIdx[lowCount++] = i;
-        else
-            highIdx[highCount++] = i;
-    }
+    // Build the alias table and stash it in our GPU buffer
+    std::vector<AliasTable::Item> items = buildItems(weights, mWeightSum);
+    mpItems = pDevice->createStructuredBuffer(
+        sizeof(AliasTable::Item), mCount, ResourceBindFlags::ShaderResource, MemoryType::DeviceLocal, items.data()
+    );
+}
 
-    // Create alias table entries by merging above- and below-average samples
-    std::vector<AliasTable::Item> items(mCount);
-    for (uint32_t i = 0; i < mCount; ++i)
-    {
-        // Usual case:  We have an above-average and below-average sample we can combine into one alias table entry
-        if ((lowIdx[i] != 0xFFFFFFFFu) && (highIdx[i] != 0xFFFFFFFFu))
+double AliasTable::computeWeightSum(fstd::span<const float> weights)
+{
+    // Sum each block in parallel, then add up the block sums in order.
+    // For tables with a single block this is identical to a sequential sum.
+    std::vector<double> blockSums(getBlockCount(weights.size()));
+    parallelForBlocks(
+        weights.size(),
+        [&](size_t blockIndex, size_t begin, size_t end)
         {
-            // Create an alias table tuple:
-            items[i] = {weights[lowIdx[i]] / avgWeight, highIdx[i], lowIdx[i], 0};
-
-            // We've removed some weight from element highIdx[i]; update it's weight, then re-enter it
-            // on the end of either the above-average or below-average lists.
-            float updatedWeight = (weights[lowIdx[i]] + weights[highIdx[i]]) - avgWeight;
-            weights[highIdx[i]] = updatedWeight;
-            if (updatedWeight < avgWeight)
-                lowIdx[lowCount++] = highIdx[i];
-            else
-                highIdx[highCount++] = highIdx[i];
+            double sum = 0.0;
+            for (size_t i = begin; i < end; ++i)
+                sum += weights[i];
+            blockSums[blockIndex] = sum;
         }
+    );
 
-        // The next two cases can only occur towards the end of table creation, because either:
-        //    (a) all the remaining possible alias table entries have weight *exactly* equal to avgWeight,
-        //        which means these alias table entries only have one input item that is selected
-        //        with 100% probability
-        //    (b) all the remaining alias table entires have *almost* avgWeight, but due to (compounding)
-        //        precision issues throughout the process, they don't have *quite* that value.  In this case
-        //        treating these entries as having exactly avgWeight (as in case (a)) is the only right
-        //        thing to do mathematically (other than re-generating the alias table using higher precision
-        //        or trying to reduce catasrophic numerical cancellation in the "updatedWeight" computation above).
-        else if (highIdx[i] != 0xFFFFFFFFu)
-        {
-            items[i] = {1.0f, highIdx[i], highIdx[i], 0};
-        }
-        else if (lowIdx[i] != 0xFFFFFFFFu)
+    double weightSum = 0.0;
+    for (double sum : blockSums)
+        weightSum += sum;
+    return weightSum;
+}
+
+std::vector<AliasTable::Item> AliasTable::buildItems(fstd::span<const float> weights, double weightSum)
+{
+    FALCOR_CHECK(weights.size() < std::numeric_limits<uint32_t>::max(), "Too many entries for alias table.");
+
+    const size_t count = weights.size();
+    std::vector<Item> items(count);
+    if (count == 0)
+        return items;
+
+    // Normalize the weights to an average of one. If all weights are zero, fall back to a uniform table.
+    const double scale = weightSum > 0.0 ? double(count) / weightSum : 0.0;
+    auto getWeight = [&](size_t i) { return scale > 0.0 ? weights[i] * scale : 1.0; };
+
+    // Stable partition of the items into light and heavy items.
+    // Count the light items per block, compute the block offsets and then scatter the indices.
+    std::vector<size_t> blockLightOffsets(getBlockCount(count));
+    parallelForBlocks(
+        count,
+        [&](size_t blockIndex, size_t begin, size_t end)
         {
-            items[i] = {1.0f, lowIdx[i], lowIdx[i], 0};
+            size_t lightCount = 0;
+            for (size_t i = begin; i < end; ++i)
+                lightCount += getWeight(i) < 1.0 ? 1 : 0;
+            blockLightOffsets[blockIndex] = lightCount;
         }
+    );
 
-        // If there is neither a highIdx[i] or lowIdx[i] for some array element(s).  By construction,
-        // this cannot occur (without some logic bug above).
-        else
+    size_t lightCount = 0;
+    for (size_t& offset : blockLightOffsets)
+    {
+        size_t blockLightCount = offset;
+        offset = lightCount;
+        lightCount += blockLightCount;
+    }
+    const size_t heavyCount = count - lightCount;
+
+    std::vector<uint32_t> lightIdx(lightCount);
+    std::vector<uint32_t> heavyIdx(heavyCount);
+    parallelForBlocks(
+        count,
+        [&](size_t blockIndex, size_t begin, size_t end)
         {
-            FALCOR_ASSERT(false); // Should not occur
+            size_t light = blockLightOffsets[blockIndex];
+            size_t heavy = begin - light;
+            for (size_t i = begin; i < end; ++i)
+            {
+                if (getWeight(i) < 1.0)
+                    lightIdx[light++] = (uint32_t)i;
+                else
+                    heavyIdx[heavy++] = (uint32_t)i;
+            }
         }
-    }
+    );
 
-    // TODO: We can simplify the alias table to implicitly store indexB (aka lowIdx[i]), so the AliasTable::Item
-    // structure would be 1 float + 1 uint32_t, rather than 128 bits.  This, of course, would change usage in shaders
-    // and elsewhere.  To do this, here you'd need to sort elements by indexB so that when looking up mpItems[j],
-    // indexB==j.  This works since, by construction, only one element in the table has indexB==j (for any j
-    // in [0...mCount-1]).  Alternatively, during the loop above, you could directly enter elements into the
-    // correct location in the alias table.
+    // Prefix sums of the light item deficits and heavy item excesses.
+    const std::vector<double> D = computePrefixSum(lightCount, [&](size_t l) { return 1.0 - getWeight(lightIdx[l]); });
+    const std::vector<double> E = computePrefixSum(heavyCount, [&](size_t h) { return getWeight(heavyIdx[h]) - 1.0; });
 
-    // Stash the alias table in our GPU buffer
-    mpItems = pDevice->createStructuredBuffer(
-        sizeof(AliasTable::Item), mCount, ResourceBindFlags::ShaderResource, MemoryType::DeviceLocal, items.data()
+    // Returns true if light item l is emitted before heavy item h in the sweep.
+    auto isLightNext = [&](size_t l, size_t h) { return h == heavyCount || (l < lightCount && D[l] <= E[h + 1]); };
+
+    // Sweep over the buckets in independent chunks. The state (l, h) at the start of chunk i is found by a
+    // binary search for the number of light items among the first i buckets of the merged sequence.
+    parallelForBlocks(
+        count,
+        [&](size_t blockIndex, size_t begin, size_t end)
+        {
+            size_t lo = begin > heavyCount ? begin - heavyCount : 0;
+            size_t hi = std::min(begin, lightCount);
+            while (lo < hi)
+            {
+                const size_t mid = lo + (hi - lo + 1) / 2;
+                if (isLightNext(mid - 1, begin - mid))
+                    lo = mid;
+                else
+                    hi = mid - 1;
+            }
+            size_t l = lo;
+            size_t h = begin - lo;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                if (isLightNext(l, h))
+                {
+                    // Fill the bucket of the light item with the current heavy item.
+                    const uint32_t light = lightIdx[l++];
+                    if (h < heavyCount)
+                        items[i] = {(float)getWeight(light), heavyIdx[h], light, 0};
+                    else
+                        items[i] = {1.0f, light, light, 0};
+                }
+                else
+                {
+                    // The heavy item has given away all its excess weight. Fill the bucket of its residual weight
+                    // with the next heavy item.
+                    const uint32_t heavy = heavyIdx[h++];
+                    if (h < heavyCount)
+                    {
+                        const double residual = 1.0 + E[h] - D[l];
+                        items[i] = {(float)std::clamp(residual, 0.0, 1.0), heavyIdx[h], heavy, 0};
+                    }
+                    else
+                    {
+                        items[i] = {1.0f, heavy, heavy, 0};
+                    }
+                }
+            }
+        }
     );
+
+    return items;
 }
 
 void AliasTable::bindShaderData(const ShaderVar& var) const
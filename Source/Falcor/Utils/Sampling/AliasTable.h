@@ -29,8 +29,10 @@
 #include "Core/Macros.h"
 #include "Core/API/Buffer.h"
 #include "Core/Program/ShaderVar.h"
+#include <fstd/span.h>
 #include <memory>
 #include <random>
+#include <vector>
 
 namespace Falcor
 {
@@ -65,7 +67,6 @@ public:
      */
     double getWeightSum() const { return mWeightSum; }
 
-private:
     // Item structure for the mpItems buffer.
     struct Item
     {
@@ -75,6 +76,24 @@ private:
         uint32_t _pad;
     };
 
+    /**
+     * Compute the sum of the weights in double precision.
+     * The sum is computed in parallel over fixed-size blocks, so the result is deterministic.
+     * @param[in] weights The weights.
+     * @return Sum of the weights.
+     */
+    static double computeWeightSum(fstd::span<const float> weights);
+
+    /**
+     * Build the alias table items on the CPU.
+     * This is the construction used by the constructor, exposed for reuse and testing.
+     * @param[in] weights The weights, don't need to be normalized.
+     * @param[in] weightSum Sum of the weights as returned by computeWeightSum().
+     * @return List of table items, one per weight. If all weights are zero, the table samples uniformly.
+     */
+    static std::vector<Item> buildItems(fstd::span<const float> weights, double weightSum);
+
+private:
     uint32_t mCount;       ///< Number of items in the alias table.
     double mWeightSum;     ///< Total weight of all elements used to create the alias table.
     ref<Buffer> mpItems;   ///< Buffer containing table items.
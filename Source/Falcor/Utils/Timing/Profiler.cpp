@@ -31,6 +31,8 @@
 #include "Utils/Logger.h"
 #include "Utils/Scripting/ScriptBindings.h"
 
+#include <nlohmann/json.hpp>
+
 #include <fstream>
 
 namespace Falcor
@@ -131,7 +133,8 @@ Profiler::Stats Profiler::Stats::compute(const float* data, size_t len)
 
 // Profiler::Event
 
-Profiler::Event::Event(const std::string& name) : mName(name), mCpuTimeHistory(kMaxHistorySize, 0.f), mGpuTimeHistory(kMaxHistorySize, 0.f)
+Profiler::Event::Event(const std::string& name, uint32_t nameId)
+    : mName(name), mNameId(nameId), mCpuTimeHistory(kMaxHistorySize, 0.f), mGpuTimeHistory(kMaxHistorySize, 0.f)
 {}
 
 Profiler::Stats Profiler::Event::computeCpuTimeStats() const
@@ -183,7 +186,10 @@ void Profiler::Event::end(uint32_t frameIndex)
     auto& frameData = mFrameData[frameIndex % 2];
 
     // Update CPU time.
-    frameData.cpuTotalTime += (float)CpuTimer::calcDuration(frameData.cpuStartTime, CpuTimer::getCurrentTimePoint());
+    auto cpuEndTime = CpuTimer::getCurrentTimePoint();
+    frameData.cpuTotalTime += (float)CpuTimer::calcDuration(frameData.cpuStartTime, cpuEndTime);
+    if (TraceRecorder::isEnabled())
+        TraceRecorder::record(mNameId, frameData.cpuStartTime, cpuEndTime);
 
     // Update GPU time.
     FALCOR_ASSERT(frameData.pActiveTimer != nullptr);
@@ -242,12 +248,28 @@ void Profiler::Event::resetStats()
 
 std::string Profiler::Capture::toJsonString() const
 {
-    using namespace pybind11::literals;
+    // Use an ordered JSON object to match the layout of the Python dictionary returned by toPython().
+    nlohmann::ordered_json events = nlohmann::ordered_json::object();
+    for (const auto& lane : mLanes)
+    {
+        nlohmann::ordered_json stats = {
+            {"min", lane.stats.min},
+            {"max", lane.stats.max},
+            {"mean", lane.stats.mean},
+            {"std_dev", lane.stats.stdDev},
+        };
+        events[lane.name] = {
+            {"name", lane.name},
+            {"stats", std::move(stats)},
+            {"records", lane.records},
+        };
+    }
 
-    // We use pythons JSON encoder to encode the python dictionary to a JSON string.
-    pybind11::module json = pybind11::module::import("json");
-    pybind11::object dumps = json.attr("dumps");
-    return pybind11::cast<std::string>(dumps(toPython(*this), "indent"_a = 2));
+    nlohmann::ordered_json capture = {
+        {"frame_count", mFrameCount},
+        {"events", std::move(events)},
+    };
+    return capture.dump(2);
 }
 
 void Profiler::Capture::writeToFile(const std::filesystem::path& path) const
@@ -315,52 +337,68 @@ Profiler::Profiler(ref<Device> pDevice) : mpDevice(pDevice)
 {
     mpFence = mpDevice->createFence();
     mpFence->breakStrongReferenceToDevice();
+
+    mpRootEvent = std::unique_ptr<Event>(new Event("", TraceRecorder::internName("")->id));
+    mpCurrentEvent = mpRootEvent.get();
 }
 
 void Profiler::startEvent(RenderContext* pRenderContext, const std::string& name, Flags flags)
+{
+    startEvent(pRenderContext, *TraceRecorder::internName(name), flags);
+}
+
+void Profiler::startEvent(RenderContext* pRenderContext, const TraceEventName& name, Flags flags)
 {
     if (mEnabled && is_set(flags, Flags::Internal))
     {
-        // '/' is used as a "path delimiter", so it cannot be used in the event name.
-        if (name.find('/') != std::string::npos)
+        Event* pEvent = getChildEvent(name);
+        if (pEvent)
         {
-            logWarning("Profiler event names must not contain '/'. Ignoring this profiler event.");
-            return;
-        }
-
-        mCurrentEventName = mCurrentEventName + "/" + name;
-
-        Event* pEvent = getEvent(mCurrentEventName);
-        FALCOR_ASSERT(pEvent != nullptr);
-        if (!mPaused)
-            pEvent->start(*this, mFrameIndex);
-
-        if (std::find(mCurrentFrameEvents.begin(), mCurrentFrameEvents.end(), pEvent) == mCurrentFrameEvents.end())
-        {
-            mCurrentFrameEvents.push_back(pEvent);
+            mpCurrentEvent = pEvent;
+            if (!mPaused)
+                pEvent->start(*this, mFrameIndex);
+
+            if (pEvent->mRegisteredFrame != mFrameIndex)
+            {
+                pEvent->mRegisteredFrame = mFrameIndex;
+                mCurrentFrameEvents.push_back(pEvent);
+            }
         }
     }
     if (is_set(flags, Flags::Pix))
     {
         FALCOR_ASSERT(pRenderContext);
-        pRenderContext->getLowLevelData()->beginDebugEvent(name.c_str());
+        pRenderContext->getLowLevelData()->beginDebugEvent(name.name.c_str());
     }
 }
 
 void Profiler::endEvent(RenderContext* pRenderContext, const std::string& name, Flags flags)
+{
+    endEvent(pRenderContext, *TraceRecorder::internName(name), flags);
+}
+
+void Profiler::endEvent(RenderContext* pRenderContext, const TraceEventName& name, Flags flags)
 {
     if (mEnabled && is_set(flags, Flags::Internal))
     {
-        // '/' is used as a "path delimiter", so it cannot be used in the event name.
-        if (name.find('/') != std::string::npos)
-            return;
-
-        Event* pEvent = getEvent(mCurrentEventName);
-        FALCOR_ASSERT(pEvent != nullptr);
-        if (!mPaused)
-            pEvent->end(mFrameIndex);
+        // Events with invalid names (containing '/') were never started and are ignored.
+        // Any other mismatch means the start/end calls are unbalanced.
+        if (mpCurrentEvent != mpRootEvent.get() && mpCurrentEvent->mNameId == name.id)
+        {
+            if (!mPaused)
+                mpCurrentEvent->end(mFrameIndex);
 
-        mCurrentEventName.erase(mCurrentEventName.find_last_of("/"));
+            mpCurrentEvent = mpCurrentEvent->mpParent;
+        }
+        else
+        {
+            FALCOR_ASSERT(
+                name.name.find('/') != std::string::npos,
+                "Profiler event '{}' ended without a matching start (current event is '{}').",
+                name.name,
+                mpCurrentEvent->mName
+            );
+        }
     }
 
     if (is_set(flags, Flags::Pix))
@@ -370,10 +408,40 @@ void Profiler::endEvent(RenderContext* pRenderContext, const std::string& name,
     }
 }
 
+Profiler::Event* Profiler::getChildEvent(const TraceEventName& name)
+{
+    for (const auto& [nameId, pChild] : mpCurrentEvent->mChildren)
+    {
+        if (nameId == name.id)
+            return pChild;
+    }
+
+    // '/' is used as a "path delimiter", so it cannot be used in the event name.
+    // Invalid names are recorded as null children to only issue the warning once.
+    Event* pChild = nullptr;
+    if (name.name.find('/') != std::string::npos)
+    {
+        logWarning("Profiler event names must not contain '/'. Ignoring profiler event '{}'.", name.name);
+    }
+    else
+    {
+        std::string path = mpCurrentEvent->mName + "/" + name.name;
+        pChild = findEvent(path);
+        if (!pChild)
+            pChild = createEvent(path, name.id);
+        pChild->mpParent = mpCurrentEvent;
+    }
+    mpCurrentEvent->mChildren.emplace_back(name.id, pChild);
+    return pChild;
+}
+
 Profiler::Event* Profiler::getEvent(const std::string& name)
 {
     auto event = findEvent(name);
-    return event ? event : createEvent(name);
+    if (event)
+        return event;
+    auto pos = name.find_last_of('/');
+    return createEvent(name, TraceRecorder::internName(pos == std::string::npos ? name : name.substr(pos + 1))->id);
 }
 
 void Profiler::endFrame(RenderContext* pRenderContext)
@@ -435,9 +503,9 @@ bool Profiler::isCapturing() const
     return mpCapture != nullptr;
 }
 
-Profiler::Event* Profiler::createEvent(const std::string& name)
+Profiler::Event* Profiler::createEvent(const std::string& name, uint32_t nameId)
 {
-    auto pEvent = std::shared_ptr<Event>(new Event(name));
+    auto pEvent = std::shared_ptr<Event>(new Event(name, nameId));
     mEvents.emplace(name, pEvent);
     return pEvent.get();
 }
@@ -454,6 +522,10 @@ void Profiler::breakStrongReferenceToDevice()
 }
 
 ScopedProfilerEvent::ScopedProfilerEvent(RenderContext* pRenderContext, const std::string& name, Profiler::Flags flags)
+    : ScopedProfilerEvent(pRenderContext, *TraceRecorder::internName(name), flags)
+{}
+
+ScopedProfilerEvent::ScopedProfilerEvent(RenderContext* pRenderContext, const TraceEventName& name, Profiler::Flags flags)
     : mpRenderContext(pRenderContext), mName(name), mFlags(flags)
 {
     FALCOR_ASSERT(mpRenderContext);
@@ -502,6 +574,9 @@ FALCOR_SCRIPT_BINDING(Profiler)
     profiler.def("end_capture", endCapture);
     profiler.def("end_frame", [](Profiler& self) { self.endFrame(self.getDevice()->getRenderContext()); });
     profiler.def("reset_stats", &Profiler::resetStats);
+    profiler.def_property_readonly_static("is_tracing", [](pybind11::object) { return TraceRecorder::isEnabled(); });
+    profiler.def_static("start_trace", &TraceRecorder::startTrace);
+    profiler.def_static("end_trace", &TraceRecorder::endTrace, "path"_a);
 
     pybind11::class_<PythonProfilerEvent>(m, "ProfilerEvent")
         .def(pybind11::init<RenderContext*, std::string_view>())
@@ -27,6 +27,7 @@
  **************************************************************************/
 #pragma once
 #include "CpuTimer.h"
+#include "TraceRecorder.h"
 #include "Core/Macros.h"
 #include "Core/API/GpuTimer.h"
 #include "Core/API/Fence.h"
@@ -86,13 +87,17 @@ public:
         void resetStats();
 
     private:
-        Event(const std::string& name);
+        Event(const std::string& name, uint32_t nameId);
 
         void start(Profiler& profiler, uint32_t frameIndex);
         void end(uint32_t frameIndex);
         void endFrame(uint32_t frameIndex);
 
-        std::string mName; ///< Nested event name.
+        std::string mName;                                  ///< Nested event name.
+        uint32_t mNameId;                                   ///< Interned name ID of the last path component.
+        Event* mpParent = nullptr;                          ///< Parent event in the hierarchy.
+        std::vector<std::pair<uint32_t, Event*>> mChildren; ///< Child events by interned name ID.
+        uint32_t mRegisteredFrame = uint32_t(-1);           ///< Last frame index this event was registered in.
 
         float mCpuTime = 0.0; ///< CPU time (previous frame).
         float mGpuTime = 0.0; ///< GPU time (previous frame).
@@ -217,6 +222,15 @@ public:
      */
     void startEvent(RenderContext* pRenderContext, const std::string& name, Flags flags = Flags::Default);
 
+    /**
+     * Start profiling a new event and update the events hierarchies.
+     * This variant avoids string operations by using an interned name.
+     * @param[in] pRenderContext Render context for measuring GPU time.
+     * @param[in] name The interned event name.
+     * @param[in] flags The event flags.
+     */
+    void startEvent(RenderContext* pRenderContext, const TraceEventName& name, Flags flags = Flags::Default);
+
     /**
      * Finish profiling a new event and update the events hierarchies.
      * @param[in] pRenderContext Render context for measuring GPU time.
@@ -225,6 +239,14 @@ public:
      */
     void endEvent(RenderContext* pRenderContext, const std::string& name, Flags flags = Flags::Default);
 
+    /**
+     * Finish profiling a new event and update the events hierarchies.
+     * @param[in] pRenderContext Render context for measuring GPU time.
+     * @param[in] name The interned event name.
+     * @param[in] flags The event flags.
+     */
+    void endEvent(RenderContext* pRenderContext, const TraceEventName& name, Flags flags = Flags::Default);
+
     /**
      * Get the event, or create a new one if the event does not yet exist.
      * This is a public interface to facilitate more complicated construction of event names and finegrained control over the profiled
@@ -252,7 +274,14 @@ private:
      * @param[in] name The event name.
      * @return Returns the new event.
      */
-    Event* createEvent(const std::string& name);
+    Event* createEvent(const std::string& name, uint32_t nameId);
+
+    /**
+     * Get the child event of the current event, or create a new one if it does not yet exist.
+     * @param[in] name The interned event name.
+     * @return Returns the child event or nullptr if the name is invalid.
+     */
+    Event* getChildEvent(const TraceEventName& name);
 
     /**
      * Find an event that was previously created.
@@ -269,8 +298,8 @@ private:
     std::unordered_map<std::string, std::shared_ptr<Event>> mEvents; ///< Events by name.
     std::vector<Event*> mCurrentFrameEvents;                         ///< Events registered for current frame.
     std::vector<Event*> mLastFrameEvents;                            ///< Events from last frame.
-    std::string mCurrentEventName;                                   ///< Current nested event name.
-    uint32_t mCurrentLevel = 0;                                      ///< Current nesting level.
+    std::unique_ptr<Event> mpRootEvent;                              ///< Root of the event hierarchy (not a real event).
+    Event* mpCurrentEvent = nullptr;                                 ///< Current nested event.
     uint32_t mFrameIndex = 0;                                        ///< Current frame index.
     bool mPendingReset = false;                                      ///< Reset profiler stats at the next call to endFrame().
 
@@ -292,20 +321,28 @@ class FALCOR_API ScopedProfilerEvent
 {
 public:
     ScopedProfilerEvent(RenderContext* pRenderContext, const std::string& name, Profiler::Flags flags = Profiler::Flags::Default);
+    ScopedProfilerEvent(RenderContext* pRenderContext, const TraceEventName& name, Profiler::Flags flags = Profiler::Flags::Default);
     ~ScopedProfilerEvent();
 
 private:
     RenderContext* mpRenderContext;
-    const std::string mName;
+    const TraceEventName& mName;
     Profiler::Flags mFlags;
 };
 } // namespace Falcor
 
 #if FALCOR_ENABLE_PROFILER
-#define FALCOR_PROFILE(_pRenderContext, _name) \
-    Falcor::ScopedProfilerEvent FALCOR_CONCAT_STRINGS(_profileEvent, __LINE__)(_pRenderContext, _name)
-#define FALCOR_PROFILE_CUSTOM(_pRenderContext, _name, _flags) \
-    Falcor::ScopedProfilerEvent FALCOR_CONCAT_STRINGS(_profileEvent, __LINE__)(_pRenderContext, _name, _flags)
+// The event name is interned once per call site. Dynamic names are resolved through a per-thread name cache.
+#define FALCOR_PROFILE(_pRenderContext, _name)                                                           \
+    static thread_local Falcor::TraceRecorder::NameCache FALCOR_CONCAT_STRINGS(_profileName, __LINE__); \
+    Falcor::ScopedProfilerEvent FALCOR_CONCAT_STRINGS(_profileEvent, __LINE__)(                          \
+        _pRenderContext, FALCOR_CONCAT_STRINGS(_profileName, __LINE__).get(_name)                       \
+    )
+#define FALCOR_PROFILE_CUSTOM(_pRenderContext, _name, _flags)                                            \
+    static thread_local Falcor::TraceRecorder::NameCache FALCOR_CONCAT_STRINGS(_profileName, __LINE__); \
+    Falcor::ScopedProfilerEvent FALCOR_CONCAT_STRINGS(_profileEvent, __LINE__)(                          \
+        _pRenderContext, FALCOR_CONCAT_STRINGS(_profileName, __LINE__).get(_name), _flags                \
+    )
 #else
 #define FALCOR_PROFILE(_pRenderContext, _name)
 #define FALCOR_PROFILE_CUSTOM(_pRenderContext, _name, _flags)
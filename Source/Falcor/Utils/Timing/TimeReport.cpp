@@ -52,26 +52,27 @@ void TimeReport::resetTimer()
 
 void TimeReport::printToLog()
 {
-    for (const auto& [task, duration] : mMeasurements)
+    for (const auto& [task, duration, note] : mMeasurements)
     {
         logInfo(
             padStringToLength(task + ":", 25) + " " + std::to_string(duration) + " s" +
-            (mTotal > 0.0 && !mMeasurements.empty() ? ", " + std::to_string(100.0 * duration / mTotal) + "% of total" : "")
+            (mTotal > 0.0 && !mMeasurements.empty() ? ", " + std::to_string(100.0 * duration / mTotal) + "% of total" : "") +
+            (note.empty() ? "" : " (" + note + ")")
         );
     }
 }
 
-void TimeReport::measure(const std::string& name)
+void TimeReport::measure(const std::string& name, const std::string& note)
 {
     auto currentTime = CpuTimer::getCurrentTimePoint();
     std::chrono::duration<double> duration = currentTime - mLastMeasureTime;
     mLastMeasureTime = currentTime;
-    mMeasurements.push_back({name, duration.count()});
+    mMeasurements.push_back({name, duration.count(), note});
 }
 
 void TimeReport::addTotal(const std::string name)
 {
-    mTotal = std::accumulate(mMeasurements.begin(), mMeasurements.end(), 0.0, [](double t, auto&& m) { return t + m.second; });
-    mMeasurements.push_back({"Total", mTotal});
+    mTotal = std::accumulate(mMeasurements.begin(), mMeasurements.end(), 0.0, [](double t, auto&& m) { return t + m.duration; });
+    mMeasurements.push_back({"Total", mTotal, ""});
 }
 } // namespace Falcor
@@ -62,8 +62,9 @@ public:
      * Records a time measurement.
      * Measures time since last call to reset() or measure(), whichever happened more recently.
      * @param[in] name Name of the record.
+     * @param[in] note Optional note printed after the measurement (e.g. statistics of the measured task).
      */
-    void measure(const std::string& name);
+    void measure(const std::string& name, const std::string& note = "");
 
     /**
      * Add a record containing the total of all measurements.
@@ -72,8 +73,15 @@ public:
     void addTotal(const std::string name = "Total");
 
 private:
+    struct Measurement
+    {
+        std::string name;
+        double duration = 0.0;
+        std::string note;
+    };
+
     CpuTimer::TimePoint mLastMeasureTime;
-    std::vector<std::pair<std::string, double>> mMeasurements;
+    std::vector<Measurement> mMeasurements;
     double mTotal = 0.0;
 };
 } // namespace Falcor
@@ -0,0 +1,350 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "TraceRecorder.h"
+#include "Core/Error.h"
+#include "Utils/Logger.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Falcor
+{
+namespace
+{
+/// Number of events per chunk in the per-thread event buffers.
+constexpr uint32_t kChunkCapacity = 1024;
+
+/**
+ * Fixed-size chunk of events.
+ * Chunks form a singly linked list that is written by a single producer (the owning thread)
+ * and read by a single consumer (collect()), which makes it safe to use without locks.
+ */
+struct Chunk
+{
+    TraceRecorder::Event events[kChunkCapacity];
+    std::atomic<uint32_t> count{0};
+    std::atomic<Chunk*> pNext{nullptr};
+};
+
+struct ThreadBuffer
+{
+    uint32_t threadId = 0;
+    Chunk* pHead = nullptr;           ///< First chunk not fully consumed (consumer side).
+    Chunk* pTail = nullptr;           ///< Chunk currently written to (producer side).
+    uint32_t readPos = 0;             ///< Read position in head chunk (consumer side).
+    std::atomic<bool> retired{false}; ///< True once the owning thread has exited.
+
+    ThreadBuffer() { pHead = pTail = new Chunk; }
+
+    ~ThreadBuffer()
+    {
+        Chunk* pChunk = pHead;
+        while (pChunk)
+        {
+            Chunk* pNext = pChunk->pNext.load(std::memory_order_relaxed);
+            delete pChunk;
+            pChunk = pNext;
+        }
+    }
+
+    void push(const TraceRecorder::Event& event)
+    {
+        Chunk* pChunk = pTail;
+        uint32_t count = pChunk->count.load(std::memory_order_relaxed);
+        if (count == kChunkCapacity)
+        {
+            Chunk* pNewChunk = new Chunk;
+            pChunk->pNext.store(pNewChunk, std::memory_order_release);
+            pTail = pChunk = pNewChunk;
+            count = 0;
+        }
+        pChunk->events[count] = event;
+        pChunk->count.store(count + 1, std::memory_order_release);
+    }
+
+    /// Move all committed events to the output vector (events are discarded if pEvents is nullptr).
+    void drain(std::vector<TraceRecorder::Event>* pEvents)
+    {
+        while (true)
+        {
+            Chunk* pChunk = pHead;
+            uint32_t count = pChunk->count.load(std::memory_order_acquire);
+            if (pEvents)
+                pEvents->insert(pEvents->end(), pChunk->events + readPos, pChunk->events + count);
+            readPos = count;
+            if (count < kChunkCapacity)
+                break;
+            Chunk* pNext = pChunk->pNext.load(std::memory_order_acquire);
+            if (!pNext)
+                break;
+            // The producer has moved on to the next chunk, so this one can be released.
+            delete pChunk;
+            pHead = pNext;
+            readPos = 0;
+        }
+    }
+};
+
+struct Registry
+{
+    std::mutex mutex;
+    std::deque<TraceEventName> names; ///< Interned names (deque for stable addresses).
+    std::unordered_map<std::string, const TraceEventName*> nameMap;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::map<uint32_t, std::string> threadNames;
+    uint32_t nextThreadId = 0;
+    std::atomic<bool> enabled{false};
+};
+
+Registry& getRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+/// Thread-local handle to the thread's event buffer. Marks the buffer as retired on thread exit.
+struct ThreadBufferHandle
+{
+    ThreadBuffer* pBuffer = nullptr;
+
+    ~ThreadBufferHandle()
+    {
+        if (pBuffer)
+            pBuffer->retired.store(true, std::memory_order_release);
+    }
+
+    ThreadBuffer& get()
+    {
+        if (!pBuffer)
+        {
+            auto& registry = getRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            auto buffer = std::make_unique<ThreadBuffer>();
+            buffer->threadId = registry.nextThreadId++;
+            pBuffer = buffer.get();
+            registry.buffers.push_back(std::move(buffer));
+        }
+        return *pBuffer;
+    }
+};
+
+thread_local ThreadBufferHandle tThreadBuffer;
+
+int64_t toNanoseconds(CpuTimer::TimePoint t)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+/// Drains all thread buffers and releases buffers of exited threads. Must be called with the registry mutex held.
+void drainBuffers(Registry& registry, std::vector<TraceRecorder::Event>* pEvents)
+{
+    auto& buffers = registry.buffers;
+    for (auto& buffer : buffers)
+    {
+        // Check for retirement before draining so that no events are lost.
+        bool retired = buffer->retired.load(std::memory_order_acquire);
+        buffer->drain(pEvents);
+        if (retired)
+            buffer.reset();
+    }
+    buffers.erase(std::remove(buffers.begin(), buffers.end(), nullptr), buffers.end());
+}
+
+void appendJsonString(fmt::memory_buffer& out, std::string_view str)
+{
+    out.push_back('"');
+    for (char c : str)
+    {
+        switch (c)
+        {
+        case '"':
+            fmt::format_to(std::back_inserter(out), "\\\"");
+            break;
+        case '\\':
+            fmt::format_to(std::back_inserter(out), "\\\\");
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+                fmt::format_to(std::back_inserter(out), "\\u{:04x}", (int)c);
+            else
+                out.push_back(c);
+        }
+    }
+    out.push_back('"');
+}
+} // namespace
+
+const TraceEventName* TraceRecorder::internName(std::string_view name)
+{
+    // Per-thread cache in front of the registry, so that dynamic names (e.g. per-pass names) are
+    // looked up without locking or allocating once they have been interned.
+    // The keys point to the interned strings, which are never released.
+    thread_local std::unordered_map<std::string_view, const TraceEventName*> tNameCache;
+    if (auto it = tNameCache.find(name); it != tNameCache.end())
+        return it->second;
+
+    const TraceEventName* pName = nullptr;
+    {
+        auto& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        std::string key(name);
+        auto it = registry.nameMap.find(key);
+        if (it != registry.nameMap.end())
+        {
+            pName = it->second;
+        }
+        else
+        {
+            pName = &registry.names.emplace_back(TraceEventName{(uint32_t)registry.names.size(), key});
+            registry.nameMap.emplace(std::move(key), pName);
+        }
+    }
+    tNameCache.emplace(pName->name, pName);
+    return pName;
+}
+
+const TraceEventName& TraceRecorder::getName(uint32_t id)
+{
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    FALCOR_CHECK(id < registry.names.size(), "Invalid trace event name ID {}.", id);
+    return registry.names[id];
+}
+
+void TraceRecorder::setEnabled(bool enabled)
+{
+    getRegistry().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool TraceRecorder::isEnabled()
+{
+    return getRegistry().enabled.load(std::memory_order_relaxed);
+}
+
+void TraceRecorder::setThreadName(std::string_view name)
+{
+    ThreadBuffer& buffer = tThreadBuffer.get();
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threadNames[buffer.threadId] = name;
+}
+
+void TraceRecorder::record(uint32_t nameId, CpuTimer::TimePoint start, CpuTimer::TimePoint end)
+{
+    ThreadBuffer& buffer = tThreadBuffer.get();
+    buffer.push(Event{nameId, buffer.threadId, toNanoseconds(start), toNanoseconds(end)});
+}
+
+std::vector<TraceRecorder::Event> TraceRecorder::collect()
+{
+    std::vector<Event> events;
+    {
+        auto& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        drainBuffers(registry, &events);
+    }
+    std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.startTime < b.startTime; });
+    return events;
+}
+
+void TraceRecorder::startTrace()
+{
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    drainBuffers(registry, nullptr);
+    registry.enabled.store(true, std::memory_order_relaxed);
+}
+
+void TraceRecorder::endTrace(const std::filesystem::path& path)
+{
+    setEnabled(false);
+    writeChromeTrace(path, collect());
+}
+
+void TraceRecorder::writeChromeTrace(const std::filesystem::path& path, const std::vector<Event>& events)
+{
+    auto& registry = getRegistry();
+
+    // Snapshot names while holding the lock.
+    std::vector<std::string> names;
+    std::map<uint32_t, std::string> threadNames;
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        names.reserve(registry.names.size());
+        for (const auto& name : registry.names)
+            names.push_back(name.name);
+        threadNames = registry.threadNames;
+    }
+
+    int64_t baseTime = events.empty() ? 0 : events.front().startTime;
+    for (const auto& event : events)
+        baseTime = std::min(baseTime, event.startTime);
+
+    fmt::memory_buffer out;
+    auto it = std::back_inserter(out);
+    fmt::format_to(it, "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    for (const auto& [threadId, threadName] : threadNames)
+    {
+        fmt::format_to(it, "{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{},\"args\":{{\"name\":", first ? "" : ",\n", threadId);
+        appendJsonString(out, threadName);
+        fmt::format_to(it, "}}}}");
+        first = false;
+    }
+    for (const auto& event : events)
+    {
+        FALCOR_ASSERT(event.nameId < names.size());
+        fmt::format_to(it, "{}{{\"name\":", first ? "" : ",\n");
+        appendJsonString(out, names[event.nameId]);
+        // Timestamps are in microseconds.
+        fmt::format_to(
+            it,
+            ",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+            event.threadId,
+            (event.startTime - baseTime) * 1e-3,
+            (event.endTime - event.startTime) * 1e-3
+        );
+        first = false;
+    }
+    fmt::format_to(it, "\n]}}\n");
+
+    std::ofstream ofs(path, std::ios::binary);
+    if (!ofs)
+        FALCOR_THROW("Failed to open trace file '{}' for writing.", path);
+    ofs.write(out.data(), out.size());
+    logInfo("Wrote {} trace events to '{}'.", events.size(), path);
+}
+} // namespace Falcor
@@ -0,0 +1,181 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "CpuTimer.h"
+#include "Core/Macros.h"
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace Falcor
+{
+/**
+ * Interned event name.
+ * Names are interned once and never released, so pointers to TraceEventName stay valid for the lifetime of the process.
+ */
+struct TraceEventName
+{
+    uint32_t id;      ///< Unique name ID.
+    std::string name; ///< Name string.
+};
+
+/**
+ * Low-overhead CPU event tracer.
+ * Events can be recorded from any thread. Each thread appends to its own lock-free event buffer,
+ * which is drained by collect(). Recorded events can be exported in the Chrome trace event format
+ * (viewable in chrome://tracing or https://ui.perfetto.dev).
+ */
+class FALCOR_API TraceRecorder
+{
+public:
+    struct Event
+    {
+        uint32_t nameId;   ///< Interned name ID.
+        uint32_t threadId; ///< Sequential thread ID assigned on first use.
+        int64_t startTime; ///< Start time in nanoseconds.
+        int64_t endTime;   ///< End time in nanoseconds.
+    };
+
+    /**
+     * Caches the interned name of a call site.
+     * Used by the FALCOR_PROFILE macros to avoid interning the name on every call.
+     * If the name changes, it is resolved through the per-thread name cache of internName().
+     */
+    class NameCache
+    {
+    public:
+        const TraceEventName& get(std::string_view name)
+        {
+            if (!mpName || name != mpName->name)
+                mpName = internName(name);
+            return *mpName;
+        }
+
+    private:
+        const TraceEventName* mpName = nullptr;
+    };
+
+    /**
+     * Intern an event name.
+     * Names that were already interned by the calling thread are found in a per-thread cache without locking.
+     * @param[in] name Event name.
+     * @return Returns the interned name (never nullptr).
+     */
+    static const TraceEventName* internName(std::string_view name);
+
+    /**
+     * Get an interned name by ID.
+     * @param[in] id Name ID.
+     * @return Returns the interned name.
+     */
+    static const TraceEventName& getName(uint32_t id);
+
+    /**
+     * Enable/disable recording of events.
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * Check if recording of events is enabled.
+     */
+    static bool isEnabled();
+
+    /**
+     * Set the name of the calling thread as shown in exported traces.
+     */
+    static void setThreadName(std::string_view name);
+
+    /**
+     * Record an event on the calling thread.
+     * @param[in] nameId Interned name ID.
+     * @param[in] start Start time.
+     * @param[in] end End time.
+     */
+    static void record(uint32_t nameId, CpuTimer::TimePoint start, CpuTimer::TimePoint end);
+
+    /**
+     * Drain all events recorded so far from all threads.
+     * @return Returns the recorded events sorted by start time.
+     */
+    static std::vector<Event> collect();
+
+    /**
+     * Start a new trace. Discards all previously recorded events and enables recording.
+     */
+    static void startTrace();
+
+    /**
+     * End the current trace. Disables recording and writes all recorded events to a file.
+     * @param[in] path Output path of the Chrome trace JSON file.
+     */
+    static void endTrace(const std::filesystem::path& path);
+
+    /**
+     * Write events in Chrome trace event format.
+     * @param[in] path Output path of the JSON file.
+     * @param[in] events Events to write.
+     */
+    static void writeChromeTrace(const std::filesystem::path& path, const std::vector<Event>& events);
+};
+
+/**
+ * Helper class for recording CPU trace events using RAII.
+ * The FALCOR_PROFILE_CPU macro should be used instead of directly creating ScopedTraceEvent objects.
+ */
+class ScopedTraceEvent
+{
+public:
+    ScopedTraceEvent(const TraceEventName& name) : mNameId(name.id), mActive(TraceRecorder::isEnabled())
+    {
+        if (mActive)
+            mStartTime = CpuTimer::getCurrentTimePoint();
+    }
+
+    ~ScopedTraceEvent()
+    {
+        if (mActive)
+            TraceRecorder::record(mNameId, mStartTime, CpuTimer::getCurrentTimePoint());
+    }
+
+private:
+    uint32_t mNameId;
+    bool mActive;
+    CpuTimer::TimePoint mStartTime;
+};
+} // namespace Falcor
+
+#if FALCOR_ENABLE_PROFILER
+/// Records a CPU-only trace event for the enclosing scope. Can be used from any thread.
+#define FALCOR_PROFILE_CPU(_name)                                                                   \
+    static thread_local Falcor::TraceRecorder::NameCache FALCOR_CONCAT_STRINGS(_traceName, __LINE__); \
+    Falcor::ScopedTraceEvent FALCOR_CONCAT_STRINGS(_traceEvent, __LINE__)(FALCOR_CONCAT_STRINGS(_traceName, __LINE__).get(_name))
+#else
+#define FALCOR_PROFILE_CPU(_name)
+#endif
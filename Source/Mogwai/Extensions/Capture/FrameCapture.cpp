@@ -27,6 +27,7 @@
  **************************************************************************/
 #include "Falcor.h"
 #include "FrameCapture.h"
+#include "Utils/Image/ExrWriter.h"
 #include "Utils/Scripting/ScriptWriter.h"
 #include <filesystem>
 
@@ -63,6 +64,7 @@ namespace Mogwai
         : CaptureTrigger(pRenderer, "Frame Capture")
     {
         mpImageProcessing = std::make_unique<ImageProcessing>(pRenderer->getDevice());
+        mpCapture = std::make_unique<AsyncTextureCapture>(pRenderer->getDevice());
     }
 
     void FrameCapture::renderUI(Gui* pGui)
@@ -76,6 +78,9 @@ namespace Mogwai
             w.checkbox("Capture All Outputs", mCaptureAllOutputs);
             w.tooltip("Capture all available outputs instead of the marked ones only.");
 
+            w.checkbox("Multi-Layer EXR", mMultiLayerExr);
+            w.tooltip("Write all floating-point outputs of a frame to a single multi-layer EXR file.");
+
             if (w.button("Capture Current Frame")) capture();
         }
     }
@@ -111,6 +116,12 @@ namespace Mogwai
         frameCapture.def_property("captureAllOutputs",
             [](FrameCapture* pFC){ return pFC->mCaptureAllOutputs;},
             [](FrameCapture* pFC, bool all){ pFC->mCaptureAllOutputs = all; });
+
+        frameCapture.def_property("multiLayerExr",
+            [](FrameCapture* pFC){ return pFC->mMultiLayerExr;},
+            [](FrameCapture* pFC, bool enable){ pFC->mMultiLayerExr = enable; });
+
+        frameCapture.def("flush", [](FrameCapture* pFC) { pFC->mpCapture->flush(); });
     }
 
     std::string FrameCapture::getScriptVar() const
@@ -144,8 +155,12 @@ namespace Mogwai
             pGraph->execute(pRenderContext);
         }
 
+        std::vector<uint32_t> capturedOutputs;
+        if (mMultiLayerExr) capturedOutputs = captureMultiLayerExr(pRenderContext, pGraph);
+
         for (uint32_t i = 0 ; i < pGraph->getOutputCount() ; i++)
         {
+            if (std::find(capturedOutputs.begin(), capturedOutputs.end(), i) != capturedOutputs.end()) continue;
             captureOutput(pRenderContext, pGraph, i);
         }
 
@@ -154,6 +169,35 @@ namespace Mogwai
             for (const auto& output : unmarkedOutputs) pGraph->unmarkOutput(output);
             pGraph->compile(pRenderContext);
         }
+
+        mpCapture->endFrame();
+    }
+
+    std::vector<uint32_t> FrameCapture::captureMultiLayerExr(RenderContext* pRenderContext, RenderGraph* pGraph)
+    {
+        // Gather all outputs that can be stored in an EXR file. Other outputs are captured to separate files.
+        std::vector<uint32_t> outputIndices;
+        std::vector<AsyncTextureCapture::Layer> layers;
+        for (uint32_t i = 0 ; i < pGraph->getOutputCount() ; i++)
+        {
+            const ref<Texture> pOutput = pGraph->getOutput(i)->asTexture();
+            if (!pOutput || !ExrWriter::isFormatSupported(pOutput->getFormat())) continue;
+            if (!layers.empty() && (pOutput->getWidth() != layers[0].pTexture->getWidth() || pOutput->getHeight() != layers[0].pTexture->getHeight())) continue;
+
+            // Write the union of the output masks. Each channel is stored once as '<output>.<channel>'.
+            TextureChannelFlags mask = TextureChannelFlags::None;
+            for (auto outputMask : pGraph->getOutputMasks(i)) mask |= outputMask;
+            mask &= TextureChannelFlags((1u << getFormatChannelCount(pOutput->getFormat())) - 1);
+            if (mask == TextureChannelFlags::None) continue;
+
+            outputIndices.push_back(i);
+            layers.push_back({ pGraph->getOutputName(i), pOutput, mask });
+        }
+        if (layers.empty()) return {};
+
+        auto path = getOutputPath() / (mBaseFilename + "." + std::to_string(mpRenderer->getGlobalClock().getFrame()) + ".exr");
+        mpCapture->captureToMultiLayerExr(pRenderContext, layers, path);
+        return outputIndices;
     }
 
     void FrameCapture::captureOutput(RenderContext* pRenderContext, RenderGraph* pGraph, const uint32_t outputIndex)
@@ -248,7 +292,7 @@ namespace Mogwai
             Bitmap::ExportFlags flags = Bitmap::ExportFlags::None;
             if (mask == TextureChannelFlags::RGBA) flags |= Bitmap::ExportFlags::ExportAlpha;
 
-            pTex->captureToFile(0, 0, filename, fileformat, flags);
+            mpCapture->captureToFile(pRenderContext, pTex, filename, fileformat, flags);
         }
     }
 
@@ -28,6 +28,7 @@
 #pragma once
 #include "../../Mogwai.h"
 #include "CaptureTrigger.h"
+#include "Utils/Image/AsyncTextureCapture.h"
 #include "Utils/Image/ImageProcessing.h"
 
 namespace Mogwai
@@ -51,8 +52,11 @@ namespace Mogwai
         void addFrames(const std::string& graphName, const uint64_vec& frames);
         std::string graphFramesStr(const RenderGraph* pGraph);
         void captureOutput(RenderContext* pRenderContext, RenderGraph* pGraph, const uint32_t outputIndex);
+        std::vector<uint32_t> captureMultiLayerExr(RenderContext* pRenderContext, RenderGraph* pGraph);
 
         bool mCaptureAllOutputs = false;
+        bool mMultiLayerExr = false;
         std::unique_ptr<ImageProcessing> mpImageProcessing;
+        std::unique_ptr<AsyncTextureCapture> mpCapture;
     };
 }
@@ -27,6 +27,8 @@
  **************************************************************************/
 #include "Testing/UnitTest.h"
 #include "Core/AssetResolver.h"
+#include "Utils/Timing/CpuTimer.h"
+#include <chrono>
 #include <fstream>
 
 namespace Falcor
@@ -195,4 +197,95 @@ CPU_TEST(AssetResolver)
     removeTestFiles(ctx);
 }
 
+CPU_TEST(AssetResolver_DirectoryCache)
+{
+    using std::filesystem::canonical;
+
+    createTestFiles(ctx);
+
+    AssetResolver cached;
+    AssetResolver uncached;
+    uncached.setDirectoryCacheEnabled(false);
+    for (auto* pResolver : {&cached, &uncached})
+    {
+        pResolver->addSearchPath(kTestRoot / "media1");
+        pResolver->addSearchPath(kTestRoot / "media2");
+        pResolver->addSearchPath(kTestRoot / "media4");
+    }
+
+    // Cached and uncached lookups must agree.
+    for (const char* path : {"asset1", "asset2", "asset3", "textures", "textures/mip2.png", "textures/../asset1", "missing/asset1"})
+        EXPECT_EQ(cached.resolvePath(path), uncached.resolvePath(path)) << path;
+
+    auto resolved = cached.resolvePathPattern("textures", R"(mip[0-9]\.png)");
+    EXPECT_EQ(resolved.size(), 4);
+
+    // Repeated lookups are served from the cache.
+    AssetResolver::resetStats();
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(cached.resolvePath("textures/mip3.png"), canonical(kTestRoot / "media4/textures/mip3.png"));
+    EXPECT_EQ(AssetResolver::getStats().directoryScans, 0);
+    EXPECT_GT(AssetResolver::getStats().cacheHits, 0);
+
+    // Files created after a directory has been cached are found.
+    std::ofstream(kTestRoot / "media2/asset3").close();
+    EXPECT_EQ(cached.resolvePath("asset3"), canonical(kTestRoot / "media2/asset3"));
+
+    removeTestFiles(ctx);
+    AssetResolver::clearDirectoryCache();
+}
+
+CPU_TEST(AssetResolver_Benchmark, TAGS("benchmark"))
+{
+    // Simulate a scene with many textures found in the last of several search paths.
+    const std::filesystem::path root = getRuntimeDirectory() / "asset_benchmark_root";
+    const uint32_t kSearchPathCount = 4;
+    const uint32_t kFileCount = 5000;
+
+    std::vector<std::filesystem::path> files;
+    for (uint32_t i = 0; i < kSearchPathCount; ++i)
+        std::filesystem::create_directories(root / fmt::format("media{}", i) / "textures");
+    for (uint32_t i = 0; i < kFileCount; ++i)
+    {
+        files.push_back(std::filesystem::path("textures") / fmt::format("texture{}.png", i));
+        std::ofstream(root / fmt::format("media{}", kSearchPathCount - 1) / files.back()).close();
+    }
+    // Pretend the directories were written a while ago (directories modified just now are always re-checked).
+    for (uint32_t i = 0; i < kSearchPathCount; ++i)
+    {
+        std::filesystem::last_write_time(
+            root / fmt::format("media{}", i) / "textures", std::filesystem::file_time_type::clock::now() - std::chrono::hours(1)
+        );
+    }
+
+    for (bool useCache : {false, true})
+    {
+        AssetResolver resolver;
+        resolver.setDirectoryCacheEnabled(useCache);
+        for (uint32_t i = 0; i < kSearchPathCount; ++i)
+            resolver.addSearchPath(root / fmt::format("media{}", i));
+
+        AssetResolver::clearDirectoryCache();
+        AssetResolver::resetStats();
+        auto startTime = CpuTimer::getCurrentTimePoint();
+        for (const auto& file : files)
+            EXPECT(!resolver.resolvePath(file).empty());
+        double ms = CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint());
+
+        auto stats = AssetResolver::getStats();
+        logInfo(
+            "AssetResolver ({} files, {} search paths, cache {}): {:.1f} ms, {} filesystem calls, {} directory scans",
+            kFileCount,
+            kSearchPathCount,
+            useCache ? "enabled" : "disabled",
+            ms,
+            stats.filesystemCalls,
+            stats.directoryScans
+        );
+    }
+
+    std::filesystem::remove_all(root);
+    AssetResolver::clearDirectoryCache();
+}
+
 } // namespace Falcor
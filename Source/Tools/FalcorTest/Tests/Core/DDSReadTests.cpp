@@ -28,6 +28,10 @@
 #include "Testing/UnitTest.h"
 #include "Utils/Image/ImageIO.h"
 #include "Utils/Image/TextureAnalyzer.h"
+#include "Utils/Math/Common.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
 
 namespace Falcor
 {
@@ -39,6 +43,38 @@ std::ostream& operator<<(std::ostream& os, const ResourceFormat fmt)
 
 namespace
 {
+/// Check that the texture subresources match the raw data stored in the DDS file byte by byte.
+void checkSubresourceData(GPUUnitTestContext& ctx, const std::filesystem::path& ddsPath, const ref<Texture>& pTex)
+{
+    std::ifstream stream(ddsPath, std::ios::binary);
+    std::vector<uint8_t> file((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    ASSERT_GE(file.size(), size_t(128));
+
+    // Magic (4 bytes) + DDS_HEADER (124 bytes), followed by DDS_HEADER_DXT10 (20 bytes) if the fourCC is 'DX10'.
+    size_t offset = 128;
+    if (std::memcmp(file.data() + 84, "DX10", 4) == 0)
+        offset += 20;
+
+    const ResourceFormat format = pTex->getFormat();
+    for (uint32_t arraySlice = 0; arraySlice < pTex->getArraySize(); ++arraySlice)
+    {
+        for (uint32_t mipLevel = 0; mipLevel < pTex->getMipCount(); ++mipLevel)
+        {
+            size_t blocksX = div_round_up(pTex->getWidth(mipLevel), getFormatWidthCompressionRatio(format));
+            size_t blocksY = div_round_up(pTex->getHeight(mipLevel), getFormatHeightCompressionRatio(format));
+            size_t size = blocksX * blocksY * pTex->getDepth(mipLevel) * getFormatBytesPerBlock(format);
+            ASSERT_LE(offset + size, file.size());
+
+            std::vector<uint8_t> data =
+                ctx.getRenderContext()->readTextureSubresource(pTex.get(), pTex->getSubresourceIndex(arraySlice, mipLevel));
+            ASSERT_EQ(data.size(), size);
+            EXPECT(std::memcmp(data.data(), file.data() + offset, size) == 0)
+                << "arraySlice = " << arraySlice << ", mipLevel = " << mipLevel;
+            offset += size;
+        }
+    }
+}
+
 void testDDS(GPUUnitTestContext& ctx, const std::string& testName, ResourceFormat fmt, bool expectLoadFailure)
 {
     ref<Device> pDevice = ctx.getDevice();
@@ -82,6 +118,9 @@ void testDDS(GPUUnitTestContext& ctx, const std::string& testName, ResourceForma
 
     EXPECT_EQ(pDDSTex->getFormat(), fmt);
 
+    // Check that all mips and array slices were uploaded unmodified.
+    checkSubresourceData(ctx, ddsPath, pDDSTex);
+
     // Create uncompressed destination texture
     ref<Texture> pSrcTex = pDDSTex;
     ResourceFormat destFormat = ResourceFormat::RGBA32Float;
@@ -189,4 +228,23 @@ GPU_TEST(BC7UnormBroken)
 {
     testDDS(ctx, std::string("BC7UnormBroken"), ResourceFormat::BC7Unorm, true);
 }
+
+GPU_TEST(DDSParallelLoad)
+{
+    ref<Device> pDevice = ctx.getDevice();
+
+    std::vector<std::filesystem::path> paths;
+    for (const char* name : {"BC1Unorm", "BC3UnormSrgbOdd", "BC5UnormTiny", "BC7Unorm", "BC7UnormBroken", "BC7UnormTiny"})
+        paths.push_back(getRuntimeDirectory() / fmt::format("data/tests/{}.dds", name));
+
+    auto textures = ImageIO::loadTexturesFromDDS(pDevice, paths, false);
+    ASSERT_EQ(textures.size(), paths.size());
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        bool isBroken = paths[i].stem() == "BC7UnormBroken";
+        EXPECT_EQ(textures[i] == nullptr, isBroken) << paths[i];
+        if (textures[i])
+            checkSubresourceData(ctx, paths[i], textures[i]);
+    }
+}
 } // namespace Falcor
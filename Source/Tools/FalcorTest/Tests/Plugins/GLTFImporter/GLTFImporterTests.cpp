@@ -0,0 +1,446 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Core/Plugin.h"
+#include "Core/Platform/OS.h"
+#include "Scene/Importer.h"
+#include "Scene/SceneBuilder.h"
+#include "Utils/StringUtils.h"
+#include "Utils/Timing/CpuTimer.h"
+#include "importers/GLTFImporter/GLTFAsset.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+using GLTF::json;
+
+const std::vector<float3> kPositions = {{0.f, 0.f, 0.f}, {1.f, 0.f, 0.f}, {0.f, 1.f, 0.f}};
+const std::vector<float3> kNormals = {{0.f, 0.f, 1.f}, {0.f, 0.5f, 0.5f}, {1.f, 0.f, 0.f}};
+
+template<typename T>
+void append(std::vector<uint8_t>& buffer, const T& value)
+{
+    const uint8_t* pData = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), pData, pData + sizeof(T));
+}
+
+void align(std::vector<uint8_t>& buffer, uint8_t padding = 0)
+{
+    buffer.resize((buffer.size() + 3) & ~size_t(3), padding);
+}
+
+/**
+ * Create a binary buffer holding interleaved positions and normals, 16-bit indices, normalized 16-bit texture coordinates
+ * and sparse substitution data, along with the JSON describing it.
+ */
+std::vector<uint8_t> createTestData(json& j)
+{
+    std::vector<uint8_t> buffer;
+    for (size_t i = 0; i < kPositions.size(); ++i)
+    {
+        append(buffer, kPositions[i]);
+        append(buffer, kNormals[i]);
+    }
+    for (uint16_t index : {0, 1, 2})
+        append(buffer, index);
+    align(buffer);
+    for (uint16_t texCrd : {0, 0, 65535, 0, 0, 65535})
+        append(buffer, texCrd);
+    append(buffer, uint8_t(1));
+    align(buffer);
+    append(buffer, float3(5.f, 6.f, 7.f));
+
+    j = {
+        {"asset", {{"version", "2.0"}}},
+        {"buffers", {{{"byteLength", buffer.size()}}}},
+        {"bufferViews",
+         {
+             {{"buffer", 0}, {"byteOffset", 0}, {"byteLength", 72}, {"byteStride", 24}},
+             {{"buffer", 0}, {"byteOffset", 72}, {"byteLength", 6}},
+             {{"buffer", 0}, {"byteOffset", 80}, {"byteLength", 12}},
+             {{"buffer", 0}, {"byteOffset", 92}, {"byteLength", 1}},
+             {{"buffer", 0}, {"byteOffset", 96}, {"byteLength", 12}},
+         }},
+        {"accessors",
+         {
+             {{"bufferView", 0}, {"componentType", 5126}, {"count", 3}, {"type", "VEC3"}},
+             {{"bufferView", 0}, {"byteOffset", 12}, {"componentType", 5126}, {"count", 3}, {"type", "VEC3"}},
+             {{"bufferView", 1}, {"componentType", 5123}, {"count", 3}, {"type", "SCALAR"}},
+             {{"bufferView", 2}, {"componentType", 5123}, {"normalized", true}, {"count", 3}, {"type", "VEC2"}},
+             {{"componentType", 5126},
+              {"count", 3},
+              {"type", "VEC3"},
+              {"sparse", {{"count", 1}, {"indices", {{"bufferView", 3}, {"componentType", 5121}}}, {"values", {{"bufferView", 4}}}}}},
+             {{"bufferView", 0}, {"byteOffset", 60}, {"componentType", 5126}, {"count", 3}, {"type", "VEC3"}},
+         }},
+    };
+    return buffer;
+}
+
+std::vector<uint8_t> createGLB(const json& j, std::vector<uint8_t> bin)
+{
+    std::string text = j.dump();
+    text.resize((text.size() + 3) & ~size_t(3), ' ');
+    align(bin);
+
+    std::vector<uint8_t> glb;
+    append(glb, uint32_t(0x46546C67));
+    append(glb, uint32_t(2));
+    append(glb, uint32_t(12 + 8 + text.size() + 8 + bin.size()));
+    append(glb, uint32_t(text.size()));
+    append(glb, uint32_t(0x4E4F534A));
+    glb.insert(glb.end(), text.begin(), text.end());
+    append(glb, uint32_t(bin.size()));
+    append(glb, uint32_t(0x004E4942));
+    glb.insert(glb.end(), bin.begin(), bin.end());
+    return glb;
+}
+
+template<typename T>
+bool isEqual(const std::vector<T>& a, const std::vector<T>& b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const T& x, const T& y) { return all(x == y); });
+}
+
+void checkAccessors(CPUUnitTestContext& ctx, const GLTF::Asset& asset)
+{
+    // Interleaved float attributes are used in place.
+    uint32_t stride = 0;
+    const float3* pPositions = asset.getInPlaceData<float3>(0, stride);
+    EXPECT(pPositions != nullptr);
+    EXPECT_EQ(stride, 24u);
+    const float3* pNormals = asset.getInPlaceData<float3>(1, stride);
+    EXPECT(pNormals != nullptr);
+    EXPECT_EQ(stride, 24u);
+    for (size_t i = 0; pPositions && pNormals && i < kPositions.size(); ++i)
+    {
+        EXPECT(all(*reinterpret_cast<const float3*>(reinterpret_cast<const uint8_t*>(pPositions) + i * 24) == kPositions[i]));
+        EXPECT(all(*reinterpret_cast<const float3*>(reinterpret_cast<const uint8_t*>(pNormals) + i * 24) == kNormals[i]));
+    }
+    EXPECT(isEqual(asset.read<float3>(0), kPositions));
+    EXPECT(isEqual(asset.read<float3>(1), kNormals));
+
+    // 16-bit indices need conversion.
+    EXPECT(asset.getInPlaceData<uint32_t>(2, stride) == nullptr);
+    EXPECT(asset.read<uint32_t>(2) == std::vector<uint32_t>({0, 1, 2}));
+
+    // Normalized integers are mapped to [0,1].
+    EXPECT(asset.getInPlaceData<float2>(3, stride) == nullptr);
+    EXPECT(isEqual(asset.read<float2>(3), {{0.f, 0.f}, {1.f, 0.f}, {0.f, 1.f}}));
+
+    // Sparse accessors without a buffer view are zero-initialized before substitution.
+    EXPECT(asset.getInPlaceData<float3>(4, stride) == nullptr);
+    EXPECT(isEqual(asset.read<float3>(4), {{0.f, 0.f, 0.f}, {5.f, 6.f, 7.f}, {0.f, 0.f, 0.f}}));
+
+    // Out of range data and mismatching types are rejected.
+    EXPECT_THROW(asset.getAccessor(5));
+    EXPECT_THROW(asset.getAccessor(6));
+    EXPECT_THROW(asset.read<float2>(0));
+}
+
+void saveFile(const std::filesystem::path& path, const std::vector<uint8_t>& data)
+{
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+/// Create a GLB with `meshCount` instanced grid meshes of `resolution` x `resolution` vertices with interleaved attributes.
+std::vector<uint8_t> createGridScene(uint32_t meshCount, uint32_t resolution)
+{
+    std::vector<uint8_t> bin;
+    json j = {{"asset", {{"version", "2.0"}}}, {"scenes", {{{"nodes", json::array()}}}}};
+
+    for (uint32_t m = 0; m < meshCount; ++m)
+    {
+        const size_t vertexOffset = bin.size();
+        for (uint32_t y = 0; y < resolution; ++y)
+        {
+            for (uint32_t x = 0; x < resolution; ++x)
+            {
+                float2 uv = float2(x, y) / float(resolution - 1);
+                append(bin, float3(uv.x, 0.1f * std::sin(10.f * uv.x + m), uv.y));
+                append(bin, float3(0.f, 1.f, 0.f));
+                append(bin, uv);
+            }
+        }
+        const size_t indexOffset = bin.size();
+        for (uint32_t y = 0; y + 1 < resolution; ++y)
+        {
+            for (uint32_t x = 0; x + 1 < resolution; ++x)
+            {
+                uint32_t i = y * resolution + x;
+                for (uint32_t index : {i, i + resolution, i + 1, i + 1, i + resolution, i + resolution + 1})
+                    append(bin, index);
+            }
+        }
+
+        const uint32_t vertexCount = resolution * resolution;
+        const uint32_t indexCount = (resolution - 1) * (resolution - 1) * 6;
+        const uint32_t view = m * 2;
+        const uint32_t accessor = m * 4;
+        j["bufferViews"].push_back({{"buffer", 0}, {"byteOffset", vertexOffset}, {"byteLength", vertexCount * 32}, {"byteStride", 32}});
+        j["bufferViews"].push_back({{"buffer", 0}, {"byteOffset", indexOffset}, {"byteLength", indexCount * 4}});
+        auto addAccessor = [&](uint32_t bufferView, uint32_t byteOffset, uint32_t componentType, uint32_t count, const char* type)
+        {
+            j["accessors"].push_back(
+                {{"bufferView", bufferView}, {"byteOffset", byteOffset}, {"componentType", componentType}, {"count", count}, {"type", type}}
+            );
+        };
+        addAccessor(view, 0, 5126, vertexCount, "VEC3");
+        addAccessor(view, 12, 5126, vertexCount, "VEC3");
+        addAccessor(view, 24, 5126, vertexCount, "VEC2");
+        addAccessor(view + 1, 0, 5125, indexCount, "SCALAR");
+        json attributes = {{"POSITION", accessor}, {"NORMAL", accessor + 1}, {"TEXCOORD_0", accessor + 2}};
+        j["meshes"].push_back({{"primitives", {{{"attributes", attributes}, {"indices", accessor + 3}}}}});
+        j["nodes"].push_back({{"mesh", m}, {"translation", {float(m % 8), 0.f, float(m / 8)}}});
+        j["scenes"][0]["nodes"].push_back(m);
+    }
+
+    j["buffers"] = {{{"byteLength", bin.size()}}};
+    return createGLB(j, bin);
+}
+} // namespace
+
+CPU_TEST(GLTFAsset_GLB)
+{
+    json j;
+    std::vector<uint8_t> bin = createTestData(j);
+    std::vector<uint8_t> glb = createGLB(j, bin);
+
+    auto pAsset = GLTF::Asset::createFromMemory(glb.data(), glb.size(), {});
+    checkAccessors(ctx, *pAsset);
+
+    // Data is referenced in place in the binary chunk.
+    uint32_t stride = 0;
+    const uint8_t* pPositions = reinterpret_cast<const uint8_t*>(pAsset->getInPlaceData<float3>(0, stride));
+    EXPECT(pPositions >= glb.data() && pPositions < glb.data() + glb.size());
+
+    // Same through a memory-mapped file.
+    std::filesystem::path path = getTempFilePath();
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(glb.data()), glb.size());
+    }
+    checkAccessors(ctx, *GLTF::Asset::createFromFile(path));
+    std::filesystem::remove(path);
+}
+
+CPU_TEST(GLTFAsset_Buffers)
+{
+    json j;
+    std::vector<uint8_t> bin = createTestData(j);
+
+    // Embedded buffer.
+    j["buffers"][0]["uri"] = "data:application/octet-stream;base64," + encodeBase64(bin);
+    std::string text = j.dump();
+    checkAccessors(ctx, *GLTF::Asset::createFromMemory(text.data(), text.size(), {}));
+
+    // External buffer, relative to the asset.
+    std::filesystem::path directory = getTempFilePath();
+    std::filesystem::remove(directory);
+    std::filesystem::create_directories(directory);
+    {
+        std::ofstream file(directory / "test data.bin", std::ios::binary);
+        file.write(reinterpret_cast<const char*>(bin.data()), bin.size());
+    }
+    j["buffers"][0]["uri"] = "test%20data.bin";
+    {
+        std::ofstream file(directory / "test.gltf");
+        file << j.dump();
+    }
+    checkAccessors(ctx, *GLTF::Asset::createFromFile(directory / "test.gltf"));
+
+    // Missing buffer.
+    j["buffers"][0]["uri"] = "missing.bin";
+    text = j.dump();
+    EXPECT_THROW(GLTF::Asset::createFromMemory(text.data(), text.size(), directory));
+
+    std::filesystem::remove_all(directory);
+}
+
+CPU_TEST(GLTFAsset_InvalidData)
+{
+    std::string text = "not a glTF file";
+    EXPECT_THROW(GLTF::Asset::createFromMemory(text.data(), text.size(), {}));
+
+    text = R"({"asset": {"version": "1.0"}})";
+    EXPECT_THROW(GLTF::Asset::createFromMemory(text.data(), text.size(), {}));
+
+    // Truncated GLB.
+    json j;
+    std::vector<uint8_t> bin = createTestData(j);
+    std::vector<uint8_t> glb = createGLB(j, bin);
+    EXPECT_THROW(GLTF::Asset::createFromMemory(glb.data(), glb.size() - 16, {}));
+
+    // Buffer view exceeding its buffer.
+    j["bufferViews"][0]["byteLength"] = 1000;
+    glb = createGLB(j, bin);
+    auto pAsset = GLTF::Asset::createFromMemory(glb.data(), glb.size(), {});
+    EXPECT_THROW(pAsset->getAccessor(0));
+}
+
+GPU_TEST(GLTFImporter_ImportScene)
+{
+    std::vector<uint8_t> bin;
+    for (float3 p : {float3(0.f, 0.f, 0.f), float3(1.f, 0.f, 0.f), float3(0.f, 1.f, 0.f), float3(1.f, 1.f, 0.f)})
+        append(bin, p);
+    for (float3 p : {float3(0.f, 0.f, 1.f), float3(1.f, 0.f, 1.f), float3(0.f, 1.f, 1.f)})
+        append(bin, p);
+    for (uint8_t index : {0, 1, 2, 3})
+        append(bin, index);
+
+    // A triangle strip with 8-bit indices and a non-indexed triangle without normals, instanced twice in a node hierarchy.
+    json j = {
+        {"asset", {{"version", "2.0"}}},
+        {"extensionsUsed", {"KHR_lights_punctual"}},
+        {"extensions", {{"KHR_lights_punctual", {{"lights", {{{"type", "spot"}, {"intensity", 10.f}}}}}}}},
+        {"buffers", {{{"byteLength", bin.size()}}}},
+        {"bufferViews",
+         {
+             {{"buffer", 0}, {"byteOffset", 0}, {"byteLength", 48}},
+             {{"buffer", 0}, {"byteOffset", 48}, {"byteLength", 36}},
+             {{"buffer", 0}, {"byteOffset", 84}, {"byteLength", 4}},
+         }},
+        {"accessors",
+         {
+             {{"bufferView", 0}, {"componentType", 5126}, {"count", 4}, {"type", "VEC3"}},
+             {{"bufferView", 1}, {"componentType", 5126}, {"count", 3}, {"type", "VEC3"}},
+             {{"bufferView", 2}, {"componentType", 5121}, {"count", 4}, {"type", "SCALAR"}},
+         }},
+        {"materials", {{{"name", "Red"}, {"pbrMetallicRoughness", {{"baseColorFactor", {1.f, 0.f, 0.f, 1.f}}}}}}},
+        {"meshes",
+         {{{"name", "Mesh"},
+           {"primitives",
+            {
+                {{"attributes", {{"POSITION", 0}}}, {"indices", 2}, {"mode", 5}, {"material", 0}},
+                {{"attributes", {{"POSITION", 1}}}},
+            }}}}},
+        {"cameras", {{{"type", "perspective"}, {"perspective", {{"yfov", 0.8f}, {"znear", 0.1f}}}}}},
+        {"nodes",
+         {
+             {{"children", {1, 2}}, {"translation", {1.f, 2.f, 3.f}}},
+             {{"mesh", 0}},
+             {{"mesh", 0}, {"rotation", {0.f, 0.7071068f, 0.f, 0.7071068f}}, {"scale", {2.f, 2.f, 2.f}}},
+             {{"camera", 0}, {"translation", {0.f, 0.f, 5.f}}},
+             {{"extensions", {{"KHR_lights_punctual", {{"light", 0}}}}}},
+         }},
+        {"scenes", {{{"nodes", {0, 3, 4}}}}},
+    };
+
+    std::filesystem::path path = getTempFilePath();
+    path.replace_extension("glb");
+    saveFile(path, createGLB(j, bin));
+
+    PluginManager::instance().loadPluginByName("GLTFImporter");
+    auto pImporter = PluginManager::instance().createClass<Importer>("GLTFImporter");
+    EXPECT(pImporter != nullptr);
+    if (pImporter)
+    {
+        SceneBuilder builder(ctx.getDevice(), Settings());
+        pImporter->importScene(path, builder, {});
+        ref<Scene> pScene = builder.getScene();
+
+        const auto& stats = pScene->getSceneStats();
+        EXPECT_EQ(stats.instancedTriangleCount, 6u);
+        EXPECT_EQ(pScene->getMaterialCount(), 2u);
+        EXPECT_EQ(pScene->getCameras().size(), 1u);
+        EXPECT_EQ(pScene->getLightCount(), 1u);
+    }
+
+    std::filesystem::remove(path);
+}
+
+GPU_TEST(GLTFImporter_InvalidFile)
+{
+    std::filesystem::path path = getTempFilePath();
+    path.replace_extension("gltf");
+    std::string text = R"({"asset": {"version": "2.0"}, "nodes": [{"mesh": 3}], "scenes": [{"nodes": [0]}]})";
+    saveFile(path, std::vector<uint8_t>(text.begin(), text.end()));
+
+    PluginManager::instance().loadPluginByName("GLTFImporter");
+    auto pImporter = PluginManager::instance().createClass<Importer>("GLTFImporter");
+    EXPECT(pImporter != nullptr);
+    if (pImporter)
+    {
+        SceneBuilder builder(ctx.getDevice(), Settings());
+        EXPECT_THROW_AS(pImporter->importScene(path, builder, {}), ImporterError);
+    }
+
+    std::filesystem::remove(path);
+}
+
+/// Compare load times of the native importer against AssimpImporter on a large GLB.
+GPU_TEST(GLTFImporter_Benchmark, TAGS("benchmark"))
+{
+    const uint32_t kMeshCount = 64;
+    const uint32_t kResolution = 256;
+
+    std::filesystem::path path = getTempFilePath();
+    path.replace_extension("glb");
+    std::vector<uint8_t> glb = createGridScene(kMeshCount, kResolution);
+    saveFile(path, glb);
+
+    std::vector<uint64_t> triangleCounts;
+    for (const char* importerName : {"GLTFImporter", "AssimpImporter"})
+    {
+        PluginManager::instance().loadPluginByName(importerName);
+        auto pImporter = PluginManager::instance().createClass<Importer>(importerName);
+        EXPECT(pImporter != nullptr);
+        if (!pImporter)
+            continue;
+
+        auto startTime = CpuTimer::getCurrentTimePoint();
+        SceneBuilder builder(ctx.getDevice(), Settings());
+        pImporter->importScene(path, builder, {});
+        double importMs = CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint());
+        ref<Scene> pScene = builder.getScene();
+        double totalMs = CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint());
+
+        triangleCounts.push_back(pScene->getSceneStats().instancedTriangleCount);
+        logInfo(
+            "GLTFImporter_Benchmark: {} ({:.1f} MB, {} triangles): import {:.1f} ms, total {:.1f} ms",
+            importerName,
+            glb.size() / (1024.0 * 1024.0),
+            triangleCounts.back(),
+            importMs,
+            totalMs
+        );
+    }
+
+    if (triangleCounts.size() == 2)
+        EXPECT_EQ(triangleCounts[0], triangleCounts[1]);
+
+    std::filesystem::remove(path);
+}
+} // namespace Falcor
@@ -0,0 +1,212 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Core/Platform/OS.h"
+#include "importers/MitsubaImporter/SerializedMesh.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+const uint16_t kFileFormatID = 0x041C;
+
+const std::vector<float3> kPositions = {{0.f, 0.f, 0.f}, {1.f, 0.f, 0.f}, {0.f, 1.f, 0.f}, {0.f, 0.f, 1.f}};
+const std::vector<uint32_t> kIndices = {0, 2, 1, 0, 1, 3, 0, 3, 2, 1, 2, 3};
+
+/// Writes shapes in the `.serialized` format as written by Mitsuba.
+class SerializedWriter
+{
+public:
+    explicit SerializedWriter(uint16_t version) : mVersion(version) {}
+
+    template<typename T>
+    void write(const T& value)
+    {
+        const uint8_t* pData = reinterpret_cast<const uint8_t*>(&value);
+        mStream.insert(mStream.end(), pData, pData + sizeof(T));
+    }
+
+    template<typename T>
+    void writeVectors(const std::vector<T>& values, bool doublePrecision)
+    {
+        for (const T& v : values)
+        {
+            for (size_t i = 0; i < sizeof(T) / sizeof(float); ++i)
+            {
+                float f = reinterpret_cast<const float*>(&v)[i];
+                if (doublePrecision)
+                    write((double)f);
+                else
+                    write(f);
+            }
+        }
+    }
+
+    void addShape(const std::string& name, uint32_t flags, bool doublePrecision, const std::vector<float2>& texCoords = {})
+    {
+        mStream.clear();
+        write(flags | (doublePrecision ? 0x2000u : 0x1000u) | (texCoords.empty() ? 0u : 0x0002u));
+        if (mVersion == 4)
+            mStream.insert(mStream.end(), name.c_str(), name.c_str() + name.size() + 1);
+        write((uint64_t)kPositions.size());
+        write((uint64_t)(kIndices.size() / 3));
+        writeVectors(kPositions, doublePrecision);
+        writeVectors(texCoords, doublePrecision);
+        for (uint32_t index : kIndices)
+            write(index);
+
+        uLongf compressedSize = compressBound((uLong)mStream.size());
+        std::vector<uint8_t> compressed(compressedSize);
+        compress(compressed.data(), &compressedSize, mStream.data(), (uLong)mStream.size());
+
+        mOffsets.push_back(mFile.size());
+        const uint16_t header[2] = {kFileFormatID, mVersion};
+        mFile.insert(mFile.end(), reinterpret_cast<const uint8_t*>(header), reinterpret_cast<const uint8_t*>(header) + sizeof(header));
+        mFile.insert(mFile.end(), compressed.begin(), compressed.begin() + compressedSize);
+    }
+
+    void save(const std::filesystem::path& path)
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(mFile.data()), mFile.size());
+        for (uint64_t offset : mOffsets)
+        {
+            if (mVersion == 4)
+                file.write(reinterpret_cast<const char*>(&offset), sizeof(uint64_t));
+            else
+                file.write(reinterpret_cast<const char*>(&offset), sizeof(uint32_t));
+        }
+        uint32_t shapeCount = (uint32_t)mOffsets.size();
+        file.write(reinterpret_cast<const char*>(&shapeCount), sizeof(uint32_t));
+    }
+
+private:
+    uint16_t mVersion;
+    std::vector<uint8_t> mStream;
+    std::vector<uint8_t> mFile;
+    std::vector<uint64_t> mOffsets;
+};
+
+void checkShape(CPUUnitTestContext& ctx, const Mitsuba::SerializedShape& shape)
+{
+    EXPECT_EQ(shape.positions.size(), kPositions.size());
+    EXPECT(std::equal(
+        shape.positions.begin(), shape.positions.end(), kPositions.begin(), kPositions.end(), [](auto a, auto b) { return all(a == b); }
+    ));
+    EXPECT(shape.indices == kIndices);
+    EXPECT_EQ(shape.normals.size(), shape.faceNormals ? kIndices.size() / 3 : kPositions.size());
+    for (const float3& n : shape.normals)
+        EXPECT_LT(std::abs(length(n) - 1.f), 1e-5f);
+}
+} // namespace
+
+CPU_TEST(SerializedMesh_ReadShapes)
+{
+    for (uint16_t version : {3, 4})
+    {
+        SerializedWriter writer(version);
+        writer.addShape("tet", 0, false, {{0.f, 0.f}, {1.f, 0.f}, {0.f, 1.f}, {0.f, 0.25f}});
+        writer.addShape("tetDouble", 0, true);
+        writer.addShape("tetFaceNormals", 0x0010, false);
+
+        std::filesystem::path path = getTempFilePath();
+        writer.save(path);
+
+        Mitsuba::SerializedFile file(path);
+        EXPECT_EQ(file.getShapeCount(), 3u);
+
+        // Read shapes out of order.
+        for (uint32_t i : {2u, 0u, 1u})
+        {
+            Mitsuba::SerializedShape shape = file.readShape(i);
+            checkShape(ctx, shape);
+            EXPECT_EQ(shape.faceNormals, i == 2);
+            if (version == 4)
+                EXPECT_EQ(shape.name, std::string(i == 0 ? "tet" : i == 1 ? "tetDouble" : "tetFaceNormals"));
+        }
+
+        // Texture coordinates are flipped to Falcor's convention.
+        Mitsuba::SerializedShape shape = file.readShape(0);
+        EXPECT_EQ(shape.texCoords.size(), 4u);
+        EXPECT(all(shape.texCoords[3] == float2(0.f, 0.75f)));
+
+        // Generated vertex normals are area-weighted, the normal at vertex 1 is (1,0,0).
+        EXPECT_LT(std::abs(shape.normals[1].x - 1.f), 1e-5f);
+
+        // Face normals can be forced by the caller.
+        shape = file.readShape(1, true);
+        checkShape(ctx, shape);
+        EXPECT(shape.faceNormals);
+        EXPECT(all(shape.normals[0] == float3(0.f, 0.f, -1.f)));
+
+        EXPECT_THROW(file.readShape(3));
+
+        std::filesystem::remove(path);
+    }
+}
+
+CPU_TEST(SerializedMesh_InvalidFile)
+{
+    std::filesystem::path path = getTempFilePath();
+    EXPECT_THROW(Mitsuba::SerializedFile file(path));
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "not a serialized file";
+    }
+    EXPECT_THROW(Mitsuba::SerializedFile file(path));
+
+    // Truncate a valid file in the middle of the compressed stream.
+    SerializedWriter writer(4);
+    writer.addShape("tet", 0, false);
+    writer.save(path);
+    auto size = std::filesystem::file_size(path);
+    std::vector<char> data(size);
+    {
+        std::ifstream file(path, std::ios::binary);
+        file.read(data.data(), size);
+    }
+    {
+        // Keep the offset table intact but drop the end of the compressed stream.
+        std::ofstream file(path, std::ios::binary);
+        file.write(data.data(), size - 24);
+        file.write(data.data() + size - 12, 12);
+    }
+    Mitsuba::SerializedFile file(path);
+    EXPECT_THROW(file.readShape(0));
+
+    std::filesystem::remove(path);
+}
+} // namespace Falcor
@@ -0,0 +1,333 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "importers/PBRTImporter/LoopSubdivide.h"
+#include "Utils/Timing/CpuTimer.h"
+#include "Core/Platform/OS.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+struct ControlMesh
+{
+    std::vector<float3> positions;
+    std::vector<uint32_t> indices;
+};
+
+ControlMesh createIcosahedron()
+{
+    const float t = (1.f + std::sqrt(5.f)) / 2.f;
+    return {
+        {{-1, t, 0}, {1, t, 0}, {-1, -t, 0}, {1, -t, 0}, {0, -1, t}, {0, 1, t}, {0, -1, -t}, {0, 1, -t}, {t, 0, -1}, {t, 0, 1}, {-t, 0, -1}, {-t, 0, 1}},
+        {0, 11, 5, 0, 5, 1,  0, 1, 7,  0, 7, 10, 0, 10, 11, 1, 5, 9, 5, 11, 4, 11, 10, 2, 10, 7, 6, 7, 1, 8,
+         3, 9,  4, 3, 4, 2, 3, 2, 6, 3, 6, 8,  3, 8,  9,  4, 9, 5, 2, 4,  11, 6,  2,  10, 8, 6, 7, 9, 8, 1},
+    };
+}
+
+ControlMesh createTetrahedron()
+{
+    return {
+        {{1, 1, 1}, {1, -1, -1}, {-1, 1, -1}, {-1, -1, 1}},
+        {0, 1, 2, 0, 3, 1, 0, 2, 3, 1, 3, 2},
+    };
+}
+
+ControlMesh createOctahedron()
+{
+    return {
+        {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}},
+        {0, 2, 4, 2, 1, 4, 1, 3, 4, 3, 0, 4, 2, 0, 5, 1, 2, 5, 3, 1, 5, 0, 3, 5},
+    };
+}
+
+/// Creates a flat open grid in the xy-plane with n x n quads.
+ControlMesh createGrid(uint32_t n)
+{
+    ControlMesh mesh;
+    for (uint32_t y = 0; y <= n; y++)
+        for (uint32_t x = 0; x <= n; x++)
+            mesh.positions.push_back(float3(float(x), float(y), 0.f));
+    for (uint32_t y = 0; y < n; y++)
+    {
+        for (uint32_t x = 0; x < n; x++)
+        {
+            uint32_t a = y * (n + 1) + x, b = a + 1, c = a + n + 1, d = c + 1;
+            mesh.indices.insert(mesh.indices.end(), {a, b, d, a, d, c});
+        }
+    }
+    return mesh;
+}
+
+/// Creates a closed UV sphere with su segments and sv rings. The poles have valence su.
+ControlMesh createSphere(uint32_t su, uint32_t sv)
+{
+    ControlMesh mesh;
+    mesh.positions.push_back(float3(0.f, 1.f, 0.f));
+    for (uint32_t v = 1; v < sv; ++v)
+    {
+        for (uint32_t u = 0; u < su; ++u)
+        {
+            float theta = u / float(su) * 6.2831853f, phi = v / float(sv) * 3.14159265f;
+            mesh.positions.push_back(float3(std::cos(theta) * std::sin(phi), std::cos(phi), std::sin(theta) * std::sin(phi)));
+        }
+    }
+    mesh.positions.push_back(float3(0.f, -1.f, 0.f));
+    uint32_t bottom = (uint32_t)mesh.positions.size() - 1;
+
+    auto index = [&](uint32_t v, uint32_t u) { return 1 + (v - 1) * su + u % su; };
+    for (uint32_t u = 0; u < su; u++)
+        mesh.indices.insert(mesh.indices.end(), {0, index(1, u + 1), index(1, u)});
+    for (uint32_t v = 1; v + 1 < sv; v++)
+    {
+        for (uint32_t u = 0; u < su; u++)
+        {
+            mesh.indices.insert(
+                mesh.indices.end(), {index(v, u), index(v, u + 1), index(v + 1, u), index(v + 1, u), index(v, u + 1), index(v + 1, u + 1)}
+            );
+        }
+    }
+    for (uint32_t u = 0; u < su; u++)
+        mesh.indices.insert(mesh.indices.end(), {bottom, index(sv - 1, u), index(sv - 1, u + 1)});
+    return mesh;
+}
+
+size_t countEdges(const std::vector<uint32_t>& indices)
+{
+    std::set<std::pair<uint32_t, uint32_t>> edges;
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        for (size_t j = 0; j < 3; j++)
+        {
+            uint32_t v0 = indices[i + j], v1 = indices[i + (j + 1) % 3];
+            edges.emplace(std::min(v0, v1), std::max(v0, v1));
+        }
+    }
+    return edges.size();
+}
+
+/// Checks the topology of the subdivided mesh: every level adds one vertex per edge and splits every triangle into four.
+void checkTopology(CPUUnitTestContext& ctx, const ControlMesh& mesh, uint32_t levels, const pbrt::LoopSubdivideResult& result)
+{
+    size_t vertexCount = mesh.positions.size();
+    size_t edgeCount = countEdges(mesh.indices);
+    size_t faceCount = mesh.indices.size() / 3;
+    for (uint32_t level = 0; level < levels; level++)
+    {
+        vertexCount += edgeCount;
+        edgeCount = 2 * edgeCount + 3 * faceCount;
+        faceCount *= 4;
+    }
+
+    EXPECT_EQ(result.positions.size(), vertexCount);
+    EXPECT_EQ(result.normals.size(), vertexCount);
+    EXPECT_EQ(result.indices.size(), 3 * faceCount);
+    EXPECT_EQ(countEdges(result.indices), edgeCount);
+    EXPECT(std::all_of(result.indices.begin(), result.indices.end(), [&](uint32_t i) { return i < vertexCount; }));
+}
+
+bool isIdentical(const pbrt::LoopSubdivideResult& a, const pbrt::LoopSubdivideResult& b)
+{
+    return a.indices == b.indices && a.positions.size() == b.positions.size() && a.normals.size() == b.normals.size() &&
+           std::memcmp(a.positions.data(), b.positions.data(), a.positions.size() * sizeof(float3)) == 0 &&
+           std::memcmp(a.normals.data(), b.normals.data(), a.normals.size() * sizeof(float3)) == 0;
+}
+
+struct GoldenCase
+{
+    const char* name;
+    ControlMesh (*createMesh)();
+    uint32_t maxLevel;
+};
+
+/// Control meshes of the golden data, in file order. Each mesh is stored for levels 1 to maxLevel.
+/// Closed meshes with vertices of valence 3, 4 and 5, and an open mesh with boundary and corner vertices.
+const GoldenCase kGoldenCases[] = {
+    {"tetrahedron", createTetrahedron, 4},
+    {"octahedron", createOctahedron, 4},
+    {"icosahedron", createIcosahedron, 3},
+    {"grid", []() { return createGrid(4); }, 3},
+};
+
+/// Reads the next result from the golden data file.
+/// Each result is stored as vertex count and index count (uint32), followed by positions, normals and indices.
+bool readGoldenResult(std::ifstream& stream, pbrt::LoopSubdivideResult& result)
+{
+    uint32_t vertexCount = 0, indexCount = 0;
+    stream.read(reinterpret_cast<char*>(&vertexCount), sizeof(uint32_t));
+    stream.read(reinterpret_cast<char*>(&indexCount), sizeof(uint32_t));
+    result.positions.resize(vertexCount);
+    result.normals.resize(vertexCount);
+    result.indices.resize(indexCount);
+    stream.read(reinterpret_cast<char*>(result.positions.data()), vertexCount * sizeof(float3));
+    stream.read(reinterpret_cast<char*>(result.normals.data()), vertexCount * sizeof(float3));
+    stream.read(reinterpret_cast<char*>(result.indices.data()), indexCount * sizeof(uint32_t));
+    return bool(stream);
+}
+} // namespace
+
+CPU_TEST(LoopSubdivide_Golden)
+{
+    // Golden data was generated with the previous pointer-based implementation (a port of pbrt-v3).
+    // The results must match bit for bit.
+    std::ifstream stream(getRuntimeDirectory() / "data/tests/loop_subdivide_golden.bin", std::ios::binary);
+    ASSERT(stream.good());
+
+    for (const auto& goldenCase : kGoldenCases)
+    {
+        ControlMesh mesh = goldenCase.createMesh();
+        for (uint32_t levels = 1; levels <= goldenCase.maxLevel; levels++)
+        {
+            pbrt::LoopSubdivideResult expected;
+            ASSERT(readGoldenResult(stream, expected)) << goldenCase.name << " levels = " << levels;
+            auto result = pbrt::loopSubdivide(levels, mesh.positions, mesh.indices);
+            EXPECT(isIdentical(result, expected)) << goldenCase.name << " levels = " << levels;
+        }
+    }
+}
+
+CPU_TEST(LoopSubdivide_ClosedMesh)
+{
+    ControlMesh mesh = createIcosahedron();
+    for (uint32_t levels = 0; levels <= 4; levels++)
+    {
+        auto result = pbrt::loopSubdivide(levels, mesh.positions, mesh.indices);
+        checkTopology(ctx, mesh, levels, result);
+
+        // The limit surface of the icosahedron is convex and centered at the origin,
+        // so all (unnormalized) normals point consistently away from (or towards) the origin.
+        uint32_t outward = 0;
+        for (size_t i = 0; i < result.positions.size(); i++)
+        {
+            EXPECT_GT(length(result.normals[i]), 0.f);
+            if (dot(result.normals[i], result.positions[i]) > 0.f)
+                outward++;
+        }
+        EXPECT(outward == 0 || outward == result.positions.size());
+
+        // All control vertices are regular and symmetric, so their limit positions have the same distance to the origin.
+        float radius = length(result.positions[0]);
+        for (size_t i = 0; i < mesh.positions.size(); i++)
+            EXPECT_LT(std::abs(length(result.positions[i]) - radius), 1e-5f);
+    }
+}
+
+CPU_TEST(LoopSubdivide_OpenMesh)
+{
+    ControlMesh mesh = createGrid(6);
+    for (uint32_t levels = 0; levels <= 3; levels++)
+    {
+        auto result = pbrt::loopSubdivide(levels, mesh.positions, mesh.indices);
+        checkTopology(ctx, mesh, levels, result);
+
+        // The grid is flat, so the limit surface stays in the plane and is bounded by the control mesh.
+        for (size_t i = 0; i < result.positions.size(); i++)
+        {
+            EXPECT_EQ(result.positions[i].z, 0.f);
+            EXPECT_GE(result.positions[i].x, 0.f);
+            EXPECT_LE(result.positions[i].x, 6.f);
+            EXPECT_LT(std::abs(std::abs(normalize(result.normals[i]).z) - 1.f), 1e-5f);
+            EXPECT_EQ(result.normals[i].z > 0.f, result.normals[0].z > 0.f);
+        }
+    }
+}
+
+CPU_TEST(LoopSubdivide_HighValence)
+{
+    // The poles have a valence larger than the fixed ring size of the previous implementation.
+    ControlMesh mesh = createSphere(40, 6);
+    auto result = pbrt::loopSubdivide(2, mesh.positions, mesh.indices);
+    checkTopology(ctx, mesh, 2, result);
+
+    // Both poles end up on the y-axis with vertical normals.
+    for (uint32_t pole : {0u, (uint32_t)mesh.positions.size() - 1})
+    {
+        EXPECT_LT(std::abs(result.positions[pole].x), 1e-5f);
+        EXPECT_LT(std::abs(result.positions[pole].z), 1e-5f);
+        EXPECT_GT(std::abs(normalize(result.normals[pole]).y), 0.9999f);
+    }
+}
+
+CPU_TEST(LoopSubdivide_Deterministic)
+{
+    // Subdivision runs in parallel, results must not depend on scheduling.
+    ControlMesh mesh = createSphere(15, 40);
+    auto a = pbrt::loopSubdivide(3, mesh.positions, mesh.indices);
+    auto b = pbrt::loopSubdivide(3, mesh.positions, mesh.indices);
+    EXPECT(isIdentical(a, b));
+}
+
+CPU_TEST(LoopSubdivide_InvalidInput)
+{
+    ControlMesh mesh = createIcosahedron();
+
+    std::vector<uint32_t> indices = mesh.indices;
+    indices.pop_back();
+    EXPECT_THROW(pbrt::loopSubdivide(1, mesh.positions, indices));
+
+    indices = mesh.indices;
+    indices[5] = (uint32_t)mesh.positions.size();
+    EXPECT_THROW(pbrt::loopSubdivide(1, mesh.positions, indices));
+
+    std::vector<float3> positions = mesh.positions;
+    positions.push_back(float3(0.f));
+    EXPECT_THROW(pbrt::loopSubdivide(1, positions, mesh.indices));
+}
+
+CPU_TEST(LoopSubdivide_Benchmark, TAGS("benchmark"))
+{
+    // Subdivide the golden data control meshes to the levels where the previous implementation was slow.
+    for (const auto& goldenCase : kGoldenCases)
+    {
+        ControlMesh mesh = goldenCase.createMesh();
+        for (uint32_t levels : {4u, 6u, 8u})
+        {
+            auto startTime = CpuTimer::getCurrentTimePoint();
+            auto result = pbrt::loopSubdivide(levels, mesh.positions, mesh.indices);
+            double subdivideMs = CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint());
+
+            logInfo(
+                "LoopSubdivide {} ({} control triangles), {} levels: {} triangles in {:.1f} ms",
+                goldenCase.name,
+                mesh.indices.size() / 3,
+                levels,
+                result.indices.size() / 3,
+                subdivideMs
+            );
+        }
+    }
+}
+} // namespace Falcor
@@ -0,0 +1,128 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "RenderGraph/RenderGraph.h"
+
+namespace Falcor
+{
+namespace
+{
+/// Pass with an optional input and an output of configurable format. Counts the calls to compile().
+class CountingPass : public RenderPass
+{
+public:
+    FALCOR_PLUGIN_CLASS(CountingPass, "CountingPass", "Render pass that counts compilations.");
+
+    CountingPass(ref<Device> pDevice, bool hasInput) : RenderPass(pDevice), mHasInput(hasInput) {}
+
+    RenderPassReflection reflect(const CompileData& compileData) override
+    {
+        RenderPassReflection reflector;
+        if (mHasInput)
+            reflector.addInput("input", "Input").texture2D(16, 16);
+        reflector.addOutput("output", "Output").format(mFormat).texture2D(16, 16);
+        return reflector;
+    }
+
+    void compile(RenderContext* pRenderContext, const CompileData& compileData) override { mCompileCount++; }
+
+    void execute(RenderContext* pRenderContext, const RenderData& renderData) override {}
+
+    void setFormat(ResourceFormat format)
+    {
+        mFormat = format;
+        requestRecompile();
+    }
+
+    /// Request a recompile without changing the I/O requirements.
+    void touch() { requestRecompile(); }
+
+    uint32_t getCompileCount() const { return mCompileCount; }
+
+private:
+    bool mHasInput;
+    ResourceFormat mFormat = ResourceFormat::RGBA32Float;
+    uint32_t mCompileCount = 0;
+};
+} // namespace
+
+GPU_TEST(RenderGraph_IncrementalRecompile)
+{
+    ref<Device> pDevice = ctx.getDevice();
+    RenderContext* pRenderContext = ctx.getRenderContext();
+
+    // Chain A -> B -> C.
+    ref<CountingPass> pA = make_ref<CountingPass>(pDevice, false);
+    ref<CountingPass> pB = make_ref<CountingPass>(pDevice, true);
+    ref<CountingPass> pC = make_ref<CountingPass>(pDevice, true);
+    ref<RenderGraph> pGraph = RenderGraph::create(pDevice, "Incremental");
+    pGraph->addPass(pA, "A");
+    pGraph->addPass(pB, "B");
+    pGraph->addPass(pC, "C");
+    pGraph->addEdge("A.output", "B.input");
+    pGraph->addEdge("B.output", "C.input");
+    pGraph->markOutput("A.output");
+    pGraph->markOutput("B.output");
+    pGraph->markOutput("C.output");
+
+    ASSERT(pGraph->compile(pRenderContext));
+    EXPECT_EQ(pA->getCompileCount(), 1u);
+    EXPECT_EQ(pB->getCompileCount(), 1u);
+    EXPECT_EQ(pC->getCompileCount(), 1u);
+    ref<Resource> pOutputA = pGraph->getOutput("A.output");
+    ref<Resource> pOutputB = pGraph->getOutput("B.output");
+    ref<Resource> pOutputC = pGraph->getOutput("C.output");
+
+    // Edit B without changing its I/O. Only B is compiled, all resources are kept.
+    pB->touch();
+    ASSERT(pGraph->compile(pRenderContext));
+    EXPECT_EQ(pA->getCompileCount(), 1u);
+    EXPECT_EQ(pB->getCompileCount(), 2u);
+    EXPECT_EQ(pC->getCompileCount(), 1u);
+    EXPECT(pGraph->getOutput("A.output") == pOutputA);
+    EXPECT(pGraph->getOutput("B.output") == pOutputB);
+    EXPECT(pGraph->getOutput("C.output") == pOutputC);
+
+    // Change the output format of B. B and the pass after it are compiled, A is not.
+    // Only the resource of the changed field is reallocated.
+    pB->setFormat(ResourceFormat::RGBA16Float);
+    ASSERT(pGraph->compile(pRenderContext));
+    EXPECT_EQ(pA->getCompileCount(), 1u);
+    EXPECT_EQ(pB->getCompileCount(), 3u);
+    EXPECT_EQ(pC->getCompileCount(), 2u);
+    EXPECT(pGraph->getOutput("A.output") == pOutputA);
+    EXPECT(pGraph->getOutput("C.output") == pOutputC);
+    ref<Resource> pNewOutputB = pGraph->getOutput("B.output");
+    ASSERT(pNewOutputB != nullptr);
+    EXPECT(pNewOutputB != pOutputB);
+    EXPECT_EQ((uint32_t)pNewOutputB->asTexture()->getFormat(), (uint32_t)ResourceFormat::RGBA16Float);
+
+    // Executing the graph after an incremental recompile works as usual.
+    pGraph->execute(pRenderContext);
+}
+} // namespace Falcor
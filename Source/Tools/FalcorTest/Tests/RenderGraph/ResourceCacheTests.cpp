@@ -0,0 +1,119 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "RenderGraph/ResourceCache.h"
+#include "Core/API/Texture.h"
+
+namespace Falcor
+{
+GPU_TEST(ResourceCache_Slots)
+{
+    ref<Device> pDevice = ctx.getDevice();
+
+    RenderPassReflection reflection;
+    reflection.addOutput("output", "Output").format(ResourceFormat::RGBA32Float);
+    reflection.addInput("input", "Input");
+
+    ResourceCache cache;
+    cache.registerField("A.output", *reflection.getField("output"), 0);
+    cache.registerField("B.input", *reflection.getField("input"), 1, "A.output");
+
+    const uint32_t outputSlot = cache.getSlot("A.output");
+    const uint32_t inputSlot = cache.getSlot("B.input");
+    const uint32_t unknownSlot = cache.getSlot("B.unknown");
+    EXPECT_EQ(cache.getSlot("A.output"), outputSlot);
+    EXPECT_NE(outputSlot, inputSlot);
+    EXPECT(cache.getSlotResource(outputSlot) == nullptr);
+
+    // Slots are resolved when resources are allocated. Aliased fields resolve to the same resource.
+    cache.allocateResources(pDevice, {uint2(16, 16), ResourceFormat::RGBA8Unorm});
+    EXPECT(cache.getSlotResource(outputSlot) != nullptr);
+    EXPECT(cache.getSlotResource(outputSlot) == cache.getResource("A.output"));
+    EXPECT(cache.getSlotResource(inputSlot) == cache.getSlotResource(outputSlot));
+    EXPECT(cache.getSlotResource(unknownSlot) == nullptr);
+
+    // External resources take precedence and update the slots when registered or removed.
+    ref<Texture> pExternal = pDevice->createTexture2D(16, 16, ResourceFormat::RGBA8Unorm, 1, 1);
+    cache.registerExternalResource("B.input", pExternal);
+    cache.registerExternalResource("B.unknown", pExternal);
+    EXPECT(cache.getSlotResource(inputSlot) == ref<Resource>(pExternal));
+    EXPECT(cache.getSlotResource(unknownSlot) == ref<Resource>(pExternal));
+    EXPECT(cache.getSlotResource(outputSlot) == cache.getResource("A.output"));
+
+    cache.registerExternalResource("B.input", nullptr);
+    cache.registerExternalResource("B.unknown", nullptr);
+    EXPECT(cache.getSlotResource(inputSlot) == cache.getSlotResource(outputSlot));
+    EXPECT(cache.getSlotResource(unknownSlot) == nullptr);
+}
+
+GPU_TEST(ResourceCache_ReuseResources)
+{
+    ref<Device> pDevice = ctx.getDevice();
+
+    RenderPassReflection reflection;
+    reflection.addOutput("fixed", "Fixed size output").format(ResourceFormat::RGBA32Float).texture2D(64, 64);
+    reflection.addOutput("screen", "Screen size output").format(ResourceFormat::RGBA32Float);
+    reflection.addOutput("changed", "Changed output").format(ResourceFormat::RGBA32Float).texture2D(64, 64);
+
+    auto registerFields = [&](ResourceCache& cache)
+    {
+        cache.registerField("A.fixed", *reflection.getField("fixed"), 0);
+        cache.registerField("A.screen", *reflection.getField("screen"), 0);
+        cache.registerField("A.changed", *reflection.getField("changed"), 0);
+    };
+
+    ResourceCache prevCache;
+    registerFields(prevCache);
+    auto stats = prevCache.allocateResources(pDevice, {uint2(32, 32), ResourceFormat::RGBA8Unorm});
+    EXPECT_EQ(stats.allocatedCount, 3u);
+    EXPECT_EQ(stats.reusedCount, 0u);
+    ref<Resource> pFixed = prevCache.getResource("A.fixed");
+    ref<Resource> pScreen = prevCache.getResource("A.screen");
+
+    // Same default properties, one changed field. The unchanged resources are taken over.
+    reflection.getField("changed")->format(ResourceFormat::R32Float);
+    ResourceCache cache;
+    registerFields(cache);
+    stats = cache.allocateResources(pDevice, {uint2(32, 32), ResourceFormat::RGBA8Unorm}, &prevCache);
+    EXPECT_EQ(stats.allocatedCount, 1u);
+    EXPECT_EQ(stats.reusedCount, 2u);
+    EXPECT(cache.getResource("A.fixed") == pFixed);
+    EXPECT(cache.getResource("A.screen") == pScreen);
+    EXPECT(prevCache.getResource("A.fixed") == nullptr);
+
+    // Resize. Only the resources with an explicit size are taken over.
+    ResourceCache resizedCache;
+    registerFields(resizedCache);
+    stats = resizedCache.allocateResources(pDevice, {uint2(48, 48), ResourceFormat::RGBA8Unorm}, &cache);
+    EXPECT_EQ(stats.allocatedCount, 1u);
+    EXPECT_EQ(stats.reusedCount, 2u);
+    EXPECT(resizedCache.getResource("A.fixed") == pFixed);
+    EXPECT(resizedCache.getResource("A.screen") != pScreen);
+    EXPECT_EQ(resizedCache.getResource("A.screen")->asTexture()->getWidth(), 48u);
+}
+} // namespace Falcor
@@ -27,15 +27,70 @@
  **************************************************************************/
 #include "Testing/UnitTest.h"
 #include "Utils/Sampling/AliasTable.h"
+#include "Utils/Timing/CpuTimer.h"
 
 #include <hypothesis/hypothesis.h>
 
 #include <iostream>
+#include <numeric>
 
 namespace Falcor
 {
 namespace
 {
+std::vector<float> generateWeights(size_t N, uint32_t seed, float zeroFraction, float skew)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> uniform;
+
+    // Pseudo-random weights, optionally skewed towards small values and with a fraction of zero weights.
+    std::vector<float> weights(N);
+    for (auto& weight : weights)
+        weight = uniform(rng) < zeroFraction ? 0.f : std::pow(uniform(rng), skew);
+    return weights;
+}
+
+/// Returns the probability of sampling each item implied by the alias table items.
+std::vector<double> computeProbabilities(const std::vector<AliasTable::Item>& items)
+{
+    const double bucketProbability = 1.0 / items.size();
+    std::vector<double> probabilities(items.size(), 0.0);
+    for (const auto& item : items)
+    {
+        probabilities[item.indexB] += bucketProbability * item.threshold;
+        probabilities[item.indexA] += bucketProbability * (1.0 - item.threshold);
+    }
+    return probabilities;
+}
+
+void testAliasTableItems(CPUUnitTestContext& ctx, const std::vector<float>& weights)
+{
+    const size_t N = weights.size();
+    const double weightSum = AliasTable::computeWeightSum(weights);
+    const std::vector<AliasTable::Item> items = AliasTable::buildItems(weights, weightSum);
+    ASSERT_EQ(items.size(), N);
+
+    // Each item owns exactly one bucket.
+    std::vector<uint32_t> bucketCount(N, 0);
+    for (const auto& item : items)
+    {
+        ASSERT_LT(item.indexA, N);
+        ASSERT_LT(item.indexB, N);
+        EXPECT(item.threshold >= 0.f && item.threshold <= 1.f);
+        bucketCount[item.indexB]++;
+    }
+    for (uint32_t count : bucketCount)
+        EXPECT_EQ(count, 1u);
+
+    // The table has to reproduce the normalized weights up to the precision of the thresholds.
+    const std::vector<double> probabilities = computeProbabilities(items);
+    for (size_t i = 0; i < N; ++i)
+    {
+        const double expected = weightSum > 0.0 ? weights[i] / weightSum : 1.0 / N;
+        EXPECT_LE_MSG(std::abs(probabilities[i] - expected), 1e-6 * std::max(expected, 1.0 / N), fmt::format("i = {}", i));
+    }
+}
+
 void testAliasTable(GPUUnitTestContext& ctx, uint32_t N, std::vector<float> specificWeights = {})
 {
     ref<Device> pDevice = ctx.getDevice();
@@ -146,4 +201,72 @@ GPU_TEST(AliasTable)
     testAliasTable(ctx, 100);
     testAliasTable(ctx, 1000);
 }
+
+CPU_TEST(AliasTable_BuildItems)
+{
+    testAliasTableItems(ctx, {1.f});
+    testAliasTableItems(ctx, {1.f, 2.f});
+    testAliasTableItems(ctx, {0.f, 0.f, 0.f});
+    testAliasTableItems(ctx, {1.f, 1.f, 1.f, 1.f});
+    testAliasTableItems(ctx, {0.f, 0.f, 5.f, 0.f});
+    testAliasTableItems(ctx, generateWeights(1000, 1, 0.f, 1.f));
+    testAliasTableItems(ctx, generateWeights(1000, 2, 0.5f, 1.f));
+    testAliasTableItems(ctx, generateWeights(10000, 3, 0.01f, 8.f));
+
+    // Large enough to split the construction into multiple parallel blocks.
+    testAliasTableItems(ctx, generateWeights(300000, 4, 0.01f, 1.f));
+    testAliasTableItems(ctx, generateWeights(300000, 5, 0.f, 16.f));
+    std::vector<float> weights = generateWeights(300000, 6, 0.f, 1.f);
+    weights[12345] = 1e5f;
+    testAliasTableItems(ctx, weights);
+}
+
+CPU_TEST(AliasTable_BuildItemsSampling)
+{
+    const uint32_t N = 1000;
+    const uint32_t samplesPerWeight = 1000;
+    std::vector<float> weights = generateWeights(N, 7, 0.01f, 2.f);
+    const double weightSum = AliasTable::computeWeightSum(weights);
+    EXPECT_EQ(weightSum, std::accumulate(weights.begin(), weights.end(), 0.0));
+    const std::vector<AliasTable::Item> items = AliasTable::buildItems(weights, weightSum);
+
+    // Sample the table the same way as AliasTable.slang.
+    std::mt19937 rng;
+    std::uniform_real_distribution<float> uniform;
+    std::vector<double> obsFrequencies(N, 0.0);
+    for (uint32_t i = 0; i < N * samplesPerWeight; ++i)
+    {
+        const uint32_t index = std::min(uint32_t(uniform(rng) * N), N - 1);
+        const AliasTable::Item& item = items[index];
+        obsFrequencies[uniform(rng) >= item.threshold ? item.indexA : item.indexB] += 1.0;
+    }
+
+    std::vector<double> expFrequencies(N);
+    for (uint32_t i = 0; i < N; ++i)
+        expFrequencies[i] = (weights[i] / weightSum) * N * samplesPerWeight;
+
+    const auto& [success, report] = hypothesis::chi2_test(N, obsFrequencies.data(), expFrequencies.data(), N * samplesPerWeight, 5, 0.1);
+    if (!success)
+        std::cout << report << std::endl;
+    EXPECT(success);
+}
+
+CPU_TEST(AliasTable_BuildBenchmark, TAGS("benchmark"))
+{
+    for (size_t N : {1000000ull, 10000000ull, 100000000ull})
+    {
+        std::vector<float> weights = generateWeights(N, 8, 0.01f, 4.f);
+
+        auto startTime = CpuTimer::getCurrentTimePoint();
+        const double weightSum = AliasTable::computeWeightSum(weights);
+        double sumMs = CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint());
+
+        startTime = CpuTimer::getCurrentTimePoint();
+        const std::vector<AliasTable::Item> items = AliasTable::buildItems(weights, weightSum);
+        double buildMs = CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint());
+
+        EXPECT_EQ(items.size(), N);
+        logInfo("AliasTable {} weights: weight sum {:.1f} ms, build {:.1f} ms", N, sumMs, buildMs);
+    }
+}
 } // namespace Falcor
@@ -0,0 +1,155 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/SceneTypes.slang"
+#include "Utils/Math/MathConstants.slangh"
+
+#include <random>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+std::vector<StaticVertexData> createRandomVertices(uint32_t count, float3 minPoint, float3 maxPoint)
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> u(0.f, 1.f);
+    auto randomDir = [&]()
+    {
+        float z = 1.f - 2.f * u(rng);
+        float r = std::sqrt(std::max(0.f, 1.f - z * z));
+        float phi = 2.f * (float)M_PI * u(rng);
+        return float3(r * std::cos(phi), r * std::sin(phi), z);
+    };
+
+    std::vector<StaticVertexData> vertices(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        auto& v = vertices[i];
+        v.position = minPoint + (maxPoint - minPoint) * float3(u(rng), u(rng), u(rng));
+        v.normal = randomDir();
+        v.tangent = float4(randomDir(), i % 3 == 0 ? 1.f : (i % 3 == 1 ? -1.f : 0.f));
+        v.texCrd = float2(4.f * u(rng) - 2.f, u(rng));
+        v.curveRadius = 0.f;
+    }
+    return vertices;
+}
+
+float angleDegrees(float3 a, float3 b)
+{
+    return std::acos(std::clamp(dot(normalize(a), normalize(b)), -1.f, 1.f)) * 180.f / (float)M_PI;
+}
+} // namespace
+
+CPU_TEST(CompressedVertexRoundTrip)
+{
+    const float3 minPoint(-10.f, 0.5f, 100.f);
+    const float3 maxPoint(30.f, 0.75f, 200.f);
+    const auto vertices = createRandomVertices(100000, minPoint, maxPoint);
+    const VertexQuantization quantization = VertexQuantization::fromBounds(minPoint, maxPoint);
+
+    // Positions are stored in snorm16, so the error is at most half a quantization step plus float rounding.
+    const float3 maxPositionError = quantization.halfExtent * (0.5f / 32767.f) * 1.01f;
+    float maxNormalAngle = 0.f;
+    float maxTangentAngle = 0.f;
+    uint32_t positionErrors = 0;
+    uint32_t texCrdErrors = 0;
+    uint32_t signErrors = 0;
+
+    for (const auto& v : vertices)
+    {
+        const CompressedStaticVertexData packed(v, quantization);
+        const StaticVertexData u = packed.unpack(quantization);
+
+        if (any(abs(u.position - v.position) > maxPositionError))
+            positionErrors++;
+        if (any(packed.unpackPosition(quantization) != u.position))
+            positionErrors++;
+        if (any(u.texCrd != f16tof32(f32tof16(v.texCrd))) || any(packed.unpackTexCrd() != u.texCrd))
+            texCrdErrors++;
+        if (u.tangent.w != v.tangent.w)
+            signErrors++;
+
+        maxNormalAngle = std::max(maxNormalAngle, angleDegrees(u.normal, v.normal));
+        if (v.tangent.w != 0.f)
+            maxTangentAngle = std::max(maxTangentAngle, angleDegrees(u.tangent.xyz(), v.tangent.xyz()));
+        EXPECT_EQ(u.curveRadius, 0.f);
+    }
+
+    EXPECT_EQ(positionErrors, 0u);
+    EXPECT_EQ(texCrdErrors, 0u);
+    EXPECT_EQ(signErrors, 0u);
+    // Octahedral encoding with 12 and 11 bits per component.
+    EXPECT_LE(maxNormalAngle, 0.075f);
+    EXPECT_LE(maxTangentAngle, 0.15f);
+}
+
+CPU_TEST(CompressedVertexDegenerateBounds)
+{
+    // Planar mesh with zero extent in y.
+    const float3 minPoint(-1.f, 2.f, -1.f);
+    const float3 maxPoint(1.f, 2.f, 1.f);
+    const auto vertices = createRandomVertices(1000, minPoint, maxPoint);
+    const VertexQuantization quantization = VertexQuantization::fromBounds(minPoint, maxPoint);
+
+    for (const auto& v : vertices)
+    {
+        const StaticVertexData u = CompressedStaticVertexData(v, quantization).unpack(quantization);
+        EXPECT_EQ(u.position.y, 2.f);
+        EXPECT_LE(std::abs(u.position.x - v.position.x), 1.f / 32767.f);
+        EXPECT_LE(std::abs(u.position.z - v.position.z), 1.f / 32767.f);
+    }
+
+    // Zero vectors decode to a valid direction and an invalid tangent is preserved.
+    StaticVertexData v = {};
+    const StaticVertexData u = CompressedStaticVertexData(v, quantization).unpack(quantization);
+    EXPECT_EQ(u.tangent.w, 0.f);
+    EXPECT_LE(std::abs(length(u.normal) - 1.f), 1e-5f);
+}
+
+CPU_TEST(CompressedVertexAxisDirections)
+{
+    // Axis-aligned normals and tangents are represented exactly.
+    const VertexQuantization quantization = VertexQuantization::fromBounds(float3(-1.f), float3(1.f));
+    const float3 axes[] = {{1.f, 0.f, 0.f}, {-1.f, 0.f, 0.f}, {0.f, 1.f, 0.f}, {0.f, -1.f, 0.f}, {0.f, 0.f, 1.f}, {0.f, 0.f, -1.f}};
+    for (const float3& n : axes)
+    {
+        for (const float3& t : axes)
+        {
+            StaticVertexData v = {};
+            v.normal = n;
+            v.tangent = float4(t, -1.f);
+            const StaticVertexData u = CompressedStaticVertexData(v, quantization).unpack(quantization);
+            EXPECT(all(u.normal == n));
+            EXPECT(all(u.tangent == v.tangent));
+            EXPECT(all(u.position == float3(0.f)));
+        }
+    }
+}
+} // namespace Falcor
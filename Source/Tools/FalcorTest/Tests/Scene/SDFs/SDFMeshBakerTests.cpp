@@ -0,0 +1,222 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/SDFs/SDFMeshBaker.h"
+#include "Scene/TriangleMesh.h"
+#include "Utils/Math/MathConstants.slangh"
+#include "Utils/Timing/CpuTimer.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+// The default padding places a unit sphere with radius 0.5 at the origin into the grid with a radius of 0.45.
+const float kSphereRadius = 0.45f;
+
+float3 getCornerPosition(const uint3& coords, uint32_t gridWidth)
+{
+    return float3(coords) / float(gridWidth) - 0.5f;
+}
+
+/// Checks the baked sphere against the analytic distance, accounting for the tessellation of the sphere.
+void checkSphere(CPUUnitTestContext& ctx, const SDFSparseValues& values, float tolerance)
+{
+    uint32_t gridWidth = values.getGridWidth();
+    uint32_t signErrors = 0;
+    float maxError = 0.f;
+    for (uint32_t z = 0; z <= gridWidth; z++)
+    {
+        for (uint32_t y = 0; y <= gridWidth; y++)
+        {
+            for (uint32_t x = 0; x <= gridWidth; x++)
+            {
+                float expected = length(getCornerPosition(uint3(x, y, z), gridWidth)) - kSphereRadius;
+                float value = values.getValue(uint3(x, y, z));
+                if (std::abs(expected) > tolerance && (value < 0.f) != (expected < 0.f)) signErrors++;
+                if (std::abs(expected) < values.getBandWidth()) maxError = std::max(maxError, std::abs(value - expected));
+            }
+        }
+    }
+    EXPECT_EQ(signErrors, 0u);
+    EXPECT_LE(maxError, tolerance);
+}
+} // namespace
+
+CPU_TEST(SDFMeshBaker_Queries)
+{
+    SDFMeshBaker baker(*TriangleMesh::createSphere(0.5f, 64, 32));
+
+    EXPECT(baker.isInside(float3(0.f), SDFMeshBaker::SignMethod::WindingNumber));
+    EXPECT(baker.isInside(float3(0.f), SDFMeshBaker::SignMethod::RayParity));
+    EXPECT(!baker.isInside(float3(0.6f, 0.f, 0.f), SDFMeshBaker::SignMethod::WindingNumber));
+    EXPECT(!baker.isInside(float3(0.6f, 0.f, 0.f), SDFMeshBaker::SignMethod::RayParity));
+    EXPECT_GE(baker.getWindingNumber(float3(0.1f, 0.2f, 0.f)), 0.95f);
+    EXPECT_LE(std::abs(baker.getWindingNumber(float3(2.f, 0.f, 0.f))), 0.05f);
+    EXPECT_LE(std::abs(baker.getDistance(float3(1.f, 0.f, 0.f)) - 0.5f), 0.01f);
+    EXPECT_LE(std::abs(baker.getDistance(float3(0.f)) - 0.5f), 0.01f);
+
+    // Flipping the winding order must not change the inside.
+    auto pMesh = TriangleMesh::createSphere(0.5f, 64, 32);
+    auto indices = pMesh->getIndices();
+    for (size_t i = 0; i < indices.size(); i += 3) std::swap(indices[i + 1], indices[i + 2]);
+    SDFMeshBaker flippedBaker(*TriangleMesh::create(pMesh->getVertices(), indices, true));
+    EXPECT(flippedBaker.isInside(float3(0.f), SDFMeshBaker::SignMethod::WindingNumber));
+}
+
+CPU_TEST(SDFMeshBaker_OpenMesh)
+{
+    // The winding number still classifies the inside of a sphere with a missing cap, a ray may escape through the hole.
+    auto pMesh = TriangleMesh::createSphere(0.5f, 64, 32);
+    auto indices = pMesh->getIndices();
+    indices.erase(indices.begin(), indices.begin() + 3 * 64);
+    SDFMeshBaker baker(*TriangleMesh::create(pMesh->getVertices(), indices));
+
+    EXPECT_GE(baker.getWindingNumber(float3(0.f)), 0.8f);
+    EXPECT(baker.isInside(float3(0.f, -0.2f, 0.f), SDFMeshBaker::SignMethod::WindingNumber));
+}
+
+CPU_TEST(SDFMeshBaker_Sphere)
+{
+    const uint32_t gridWidth = 64;
+    SDFMeshBaker baker(*TriangleMesh::createSphere(0.5f, 128, 64));
+
+    for (auto signMethod : {SDFMeshBaker::SignMethod::WindingNumber, SDFMeshBaker::SignMethod::RayParity})
+    {
+        for (bool fastSweeping : {false, true})
+        {
+            SDFMeshBaker::Options options;
+            options.gridWidth = gridWidth;
+            options.signMethod = signMethod;
+            options.fastSweeping = fastSweeping;
+            SDFSparseValues values = baker.bake(options);
+            EXPECT_EQ(values.getGridWidth(), gridWidth);
+            EXPECT_GT(values.getDenseBrickCount(), 0u);
+            checkSphere(ctx, values, 1.f / gridWidth);
+        }
+    }
+}
+
+CPU_TEST(SDFMeshBaker_Cube)
+{
+    // The cube's faces are parallel to grid planes and consist of pairs of triangles sharing a diagonal edge.
+    const uint32_t gridWidth = 32;
+    SDFMeshBaker baker(*TriangleMesh::createCube(float3(1.f)));
+
+    for (auto signMethod : {SDFMeshBaker::SignMethod::WindingNumber, SDFMeshBaker::SignMethod::RayParity})
+    {
+        SDFMeshBaker::Options options;
+        options.gridWidth = gridWidth;
+        options.signMethod = signMethod;
+        SDFSparseValues values = baker.bake(options);
+
+        const float halfSize = 0.45f;
+        uint32_t errors = 0;
+        for (uint32_t z = 0; z <= gridWidth; z++)
+        {
+            for (uint32_t y = 0; y <= gridWidth; y++)
+            {
+                for (uint32_t x = 0; x <= gridWidth; x++)
+                {
+                    float3 q = abs(getCornerPosition(uint3(x, y, z), gridWidth)) - halfSize;
+                    float expected = length(max(q, float3(0.f))) + std::min(std::max(q.x, std::max(q.y, q.z)), 0.f);
+                    if (std::abs(expected) < values.getBandWidth() && std::abs(values.getValue(uint3(x, y, z)) - expected) > 1e-4f) errors++;
+                }
+            }
+        }
+        EXPECT_EQ(errors, 0u);
+    }
+}
+
+CPU_TEST(SDFMeshBaker_Cache)
+{
+    SDFMeshBaker baker(*TriangleMesh::createSphere(0.5f, 32, 16));
+    SDFMeshBaker::Options options;
+    options.gridWidth = 32;
+
+    std::filesystem::path cacheDirectory = getTempFilePath();
+    std::filesystem::path cachePath = cacheDirectory / baker.getCacheFileName(options);
+
+    SDFSparseValues baked = baker.bake(options, cacheDirectory);
+    EXPECT(std::filesystem::exists(cachePath));
+
+    // The cached file is a regular .sdfg file.
+    SDFSparseValues loaded;
+    EXPECT(loaded.loadFromFile(cachePath));
+    SDFSparseValues cached = baker.bake(options, cacheDirectory);
+    for (uint32_t z = 0; z <= options.gridWidth; z++)
+    {
+        for (uint32_t y = 0; y <= options.gridWidth; y++)
+        {
+            for (uint32_t x = 0; x <= options.gridWidth; x++)
+            {
+                EXPECT_EQ(cached.getValue(uint3(x, y, z)), baked.getValue(uint3(x, y, z)));
+                EXPECT_EQ(loaded.getValue(uint3(x, y, z)), baked.getValue(uint3(x, y, z)));
+            }
+        }
+    }
+
+    // Different options use a different file.
+    SDFMeshBaker::Options otherOptions = options;
+    otherOptions.signMethod = SDFMeshBaker::SignMethod::RayParity;
+    EXPECT_NE(baker.getCacheFileName(otherOptions), baker.getCacheFileName(options));
+
+    std::filesystem::remove_all(cacheDirectory);
+}
+
+CPU_TEST(SDFMeshBaker_Benchmark, TAGS("benchmark"))
+{
+    SDFMeshBaker baker(*TriangleMesh::createSphere(0.5f, 512, 256));
+
+    for (uint32_t gridWidth : {256u, 512u, 1024u})
+    {
+        for (bool fastSweeping : {false, true})
+        {
+            SDFMeshBaker::Options options;
+            options.gridWidth = gridWidth;
+            options.fastSweeping = fastSweeping;
+
+            auto startTime = CpuTimer::getCurrentTimePoint();
+            SDFSparseValues values = baker.bake(options);
+            double bakeMs = CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint());
+
+            logInfo(
+                "SDFMeshBaker {} triangles at {}^3 (fast sweeping {}): {:.1f} ms, {} dense bricks",
+                baker.getTriangleCount(),
+                gridWidth,
+                fastSweeping,
+                bakeMs,
+                values.getDenseBrickCount()
+            );
+        }
+    }
+}
+} // namespace Falcor
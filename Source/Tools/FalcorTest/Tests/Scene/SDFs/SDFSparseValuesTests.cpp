@@ -0,0 +1,308 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/SDFs/SDFSparseValues.h"
+#include "Scene/SDFs/SparseBrickSet/SDFSBS.h"
+#include "Scene/SDFs/SparseVoxelSet/SDFSVS.h"
+#include "Utils/Math/MathConstants.slangh"
+#include "Utils/Timing/CpuTimer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+/// Distance to a sphere with a smaller sphere carved out of it, clamped like SDFGrid::generateCheeseValues().
+float evalDistance(const float3& p)
+{
+    float d = std::max(length(p) - 0.3f, -(length(p - float3(0.f, 0.3f, 0.f)) - 0.1f));
+    return std::clamp(d, -float(M_SQRT3), float(M_SQRT3));
+}
+
+float3 getCornerPosition(const uint3& coords, uint32_t gridWidth)
+{
+    return float3(coords) / float(gridWidth) - 0.5f;
+}
+
+std::vector<float> createDenseValues(uint32_t gridWidth)
+{
+    uint32_t gridWidthInValues = gridWidth + 1;
+    std::vector<float> values(gridWidthInValues * gridWidthInValues * gridWidthInValues);
+    for (uint32_t z = 0; z < gridWidthInValues; z++)
+        for (uint32_t y = 0; y < gridWidthInValues; y++)
+            for (uint32_t x = 0; x < gridWidthInValues; x++)
+                values[x + gridWidthInValues * (y + gridWidthInValues * z)] = evalDistance(getCornerPosition(uint3(x, y, z), gridWidth));
+    return values;
+}
+
+/// Creates sparse values brick by brick, only evaluating the bricks close to the surface.
+SDFSparseValues createSparseValues(uint32_t gridWidth)
+{
+    const uint32_t kBrickWidth = SDFSparseValues::kBrickWidth;
+    SDFSparseValues values(gridWidth);
+    float brickRadius = 0.5f * float(M_SQRT3) * kBrickWidth / gridWidth;
+
+    std::vector<float> brick(SDFSparseValues::kBrickValueCount);
+    for (uint32_t z = 0; z < values.getBricksPerAxis(); z++)
+    {
+        for (uint32_t y = 0; y < values.getBricksPerAxis(); y++)
+        {
+            for (uint32_t x = 0; x < values.getBricksPerAxis(); x++)
+            {
+                uint3 origin = uint3(x, y, z) * kBrickWidth;
+                float centerDistance = evalDistance(getCornerPosition(origin, gridWidth) + brickRadius / float(M_SQRT3));
+                if (std::abs(centerDistance) > brickRadius + values.getBandWidth())
+                {
+                    values.setTile(uint3(x, y, z), centerDistance);
+                    continue;
+                }
+
+                for (uint32_t i = 0; i < SDFSparseValues::kBrickValueCount; i++)
+                {
+                    uint3 local(i % kBrickWidth, (i / kBrickWidth) % kBrickWidth, i / (kBrickWidth * kBrickWidth));
+                    brick[i] = evalDistance(getCornerPosition(origin + local, gridWidth));
+                }
+                values.setBrick(uint3(x, y, z), brick.data());
+            }
+        }
+    }
+
+    return values;
+}
+
+std::vector<int8_t> quantize(const std::vector<float>& cornerValues, uint32_t gridWidth)
+{
+    float normalizationMultiplier = 2.0f * gridWidth / float(M_SQRT3);
+    std::vector<int8_t> result(cornerValues.size());
+    for (size_t i = 0; i < cornerValues.size(); i++)
+        result[i] = SDFSparseValues::quantizeValue(cornerValues[i], normalizationMultiplier);
+    return result;
+}
+
+std::vector<int8_t> quantize(const SDFSparseValues& values)
+{
+    uint32_t gridWidthInValues = values.getGridWidth() + 1;
+    std::vector<int8_t> result(gridWidthInValues * gridWidthInValues * gridWidthInValues);
+    values.quantize(2.0f * values.getGridWidth() / float(M_SQRT3), 1, 0, gridWidthInValues, result.data());
+    return result;
+}
+} // namespace
+
+CPU_TEST(SDFSparseValues_FromDense)
+{
+    for (uint32_t gridWidth : {37u, 64u})
+    {
+        auto dense = createDenseValues(gridWidth);
+        auto values = SDFSparseValues::createFromDense(dense, gridWidth);
+
+        uint32_t brickCount = values.getBricksPerAxis() * values.getBricksPerAxis() * values.getBricksPerAxis();
+        EXPECT_GT(values.getDenseBrickCount(), 0u);
+        EXPECT_LT(values.getDenseBrickCount(), brickCount / 2);
+
+        // Values inside the narrow band are stored exactly, everything quantizes identically.
+        auto sparseDense = values.toDense();
+        for (size_t i = 0; i < dense.size(); i++)
+        {
+            if (std::abs(dense[i]) < values.getBandWidth())
+                EXPECT_EQ(sparseDense[i], dense[i]);
+        }
+        EXPECT(quantize(dense, gridWidth) == quantize(values));
+    }
+}
+
+CPU_TEST(SDFSparseValues_Bricks)
+{
+    const uint32_t gridWidth = 64;
+    auto dense = createDenseValues(gridWidth);
+    auto values = createSparseValues(gridWidth);
+    EXPECT(quantize(dense, gridWidth) == quantize(values));
+
+    // Strided quantization samples every stride-th value.
+    const uint32_t stride = 16;
+    uint32_t lodWidthInValues = gridWidth / stride + 1;
+    std::vector<int8_t> lod(lodWidthInValues * lodWidthInValues * lodWidthInValues);
+    values.quantize(1.f, stride, 0, lodWidthInValues, lod.data());
+    for (uint32_t z = 0; z < lodWidthInValues; z++)
+        for (uint32_t y = 0; y < lodWidthInValues; y++)
+            for (uint32_t x = 0; x < lodWidthInValues; x++)
+                EXPECT_EQ(
+                    lod[x + lodWidthInValues * (y + lodWidthInValues * z)],
+                    SDFSparseValues::quantizeValue(values.getValue(uint3(x, y, z) * stride), 1.f)
+                );
+}
+
+CPU_TEST(SDFSparseValues_NarrowBandPoints)
+{
+    const uint32_t gridWidth = 64;
+    auto dense = createDenseValues(gridWidth);
+
+    // Only pass the values inside the narrow band, the signs of all others are found by the flood fill.
+    SDFSparseValues values(gridWidth);
+    std::vector<uint3> coords;
+    std::vector<float> distances;
+    uint32_t gridWidthInValues = gridWidth + 1;
+    for (uint32_t i = 0; i < dense.size(); i++)
+    {
+        if (std::abs(dense[i]) < values.getBandWidth())
+        {
+            coords.push_back(uint3(i % gridWidthInValues, (i / gridWidthInValues) % gridWidthInValues, i / (gridWidthInValues * gridWidthInValues)));
+            distances.push_back(dense[i]);
+        }
+    }
+    values.setValues(coords, distances);
+    values.signedFloodFill();
+    values.prune();
+
+    EXPECT(quantize(dense, gridWidth) == quantize(values));
+    EXPECT_EQ(values.getValue(uint3(gridWidth / 2)), -float(M_SQRT3));
+    EXPECT_EQ(values.getValue(uint3(0)), float(M_SQRT3));
+}
+
+CPU_TEST(SDFSparseValues_LoadFromFile)
+{
+    const uint32_t gridWidth = 40;
+    auto dense = createDenseValues(gridWidth);
+
+    auto path = getTempFilePath();
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&gridWidth), sizeof(uint32_t));
+        file.write(reinterpret_cast<const char*>(dense.data()), dense.size() * sizeof(float));
+    }
+
+    SDFSparseValues values;
+    EXPECT(values.loadFromFile(path));
+    EXPECT_EQ(values.getGridWidth(), gridWidth);
+    EXPECT(values.toDense() == SDFSparseValues::createFromDense(dense, gridWidth).toDense());
+
+    // Truncated files are rejected.
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - sizeof(float));
+    EXPECT(!values.loadFromFile(path));
+
+    std::filesystem::remove(path);
+}
+
+GPU_TEST(SDFSparseValues_MatchesDense)
+{
+    ref<Device> pDevice = ctx.getDevice();
+    if (!pDevice->isShaderModelSupported(ShaderModel::SM6_5))
+        ctx.skip("SDF grids require Shader Model 6.5.");
+
+    const uint32_t gridWidth = 64;
+    auto dense = createDenseValues(gridWidth);
+
+    auto sortedAABBs = [](const ref<SDFGrid>& pGrid)
+    {
+        auto aabbs = pGrid->getAABBBuffer()->getElements<AABB>(0, pGrid->getAABBCount());
+        std::sort(
+            aabbs.begin(),
+            aabbs.end(),
+            [](const AABB& a, const AABB& b)
+            { return std::make_tuple(a.minPoint.z, a.minPoint.y, a.minPoint.x) < std::make_tuple(b.minPoint.z, b.minPoint.y, b.minPoint.x); }
+        );
+        return aabbs;
+    };
+
+    // The SVS is built on the CPU from sparse values, compare against the GPU voxelizer.
+    {
+        ref<SDFGrid> pDenseGrid = SDFSVS::create(pDevice);
+        pDenseGrid->setValues(dense, gridWidth);
+        pDenseGrid->createResources(ctx.getRenderContext());
+
+        ref<SDFGrid> pSparseGrid = SDFSVS::create(pDevice);
+        pSparseGrid->setValues(createSparseValues(gridWidth));
+        pSparseGrid->createResources(ctx.getRenderContext());
+
+        ASSERT_EQ(pSparseGrid->getAABBCount(), pDenseGrid->getAABBCount());
+        auto denseAABBs = sortedAABBs(pDenseGrid);
+        auto sparseAABBs = sortedAABBs(pSparseGrid);
+        for (size_t i = 0; i < denseAABBs.size(); i++)
+        {
+            EXPECT(all(sparseAABBs[i].minPoint == denseAABBs[i].minPoint));
+            EXPECT(all(sparseAABBs[i].maxPoint == denseAABBs[i].maxPoint));
+        }
+    }
+
+    // The SBS uploads the grid texture brick layer by brick layer.
+    {
+        ref<SDFGrid> pDenseGrid = SDFSBS::create(pDevice);
+        pDenseGrid->setValues(dense, gridWidth);
+        pDenseGrid->createResources(ctx.getRenderContext());
+
+        ref<SDFGrid> pSparseGrid = SDFSBS::create(pDevice);
+        pSparseGrid->setValues(createSparseValues(gridWidth));
+        pSparseGrid->createResources(ctx.getRenderContext());
+
+        EXPECT_EQ(pSparseGrid->getAABBCount(), pDenseGrid->getAABBCount());
+    }
+}
+
+CPU_TEST(SDFSparseValues_Benchmark, TAGS("benchmark"))
+{
+    for (uint32_t gridWidth : {512u, 1024u, 2048u})
+    {
+        auto startTime = CpuTimer::getCurrentTimePoint();
+        auto values = createSparseValues(gridWidth);
+        double ingestMs = CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint());
+
+        startTime = CpuTimer::getCurrentTimePoint();
+        std::vector<AABB> voxelAABBs;
+        std::vector<SDFSVSVoxel> voxels;
+        SDFSVS::createVoxels(values, voxelAABBs, voxels);
+        double voxelizeMs = CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint());
+
+        // Quantization cost of the brick layer uploads done by the SVO and SBS.
+        uint32_t gridWidthInValues = gridWidth + 1;
+        std::vector<int8_t> slab(size_t(SDFSparseValues::kBrickWidth) * gridWidthInValues * gridWidthInValues);
+        startTime = CpuTimer::getCurrentTimePoint();
+        for (uint32_t z = 0; z < gridWidthInValues; z += SDFSparseValues::kBrickWidth)
+        {
+            uint32_t zEnd = std::min(z + SDFSparseValues::kBrickWidth, gridWidthInValues);
+            values.quantize(2.0f * gridWidth / float(M_SQRT3), 1, z, zEnd, slab.data());
+        }
+        double quantizeMs = CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint());
+
+        double denseMB = double(gridWidthInValues) * gridWidthInValues * gridWidthInValues * sizeof(float) / (1 << 20);
+        logInfo(
+            "SDFSparseValues {}^3: {:.1f} MB sparse ({} dense bricks) vs {:.1f} MB dense, ingest {:.1f} ms, SVS voxelize {:.1f} ms ({} voxels), "
+            "quantize {:.1f} ms",
+            gridWidth,
+            double(values.getMemoryUsage()) / (1 << 20),
+            values.getDenseBrickCount(),
+            denseMB,
+            ingestMs,
+            voxelizeMs,
+            voxels.size(),
+            quantizeMs
+        );
+    }
+}
+} // namespace Falcor
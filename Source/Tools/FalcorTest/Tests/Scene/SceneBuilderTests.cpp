@@ -0,0 +1,394 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/SceneBuilder.h"
+#include "Scene/Material/StandardMaterial.h"
+#include "Utils/Timing/CpuTimer.h"
+
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+/**
+ * Grid mesh with texture coordinate seams, mirrored texture coordinates, duplicated vertices and degenerate triangles.
+ */
+struct TangentTestMesh
+{
+    std::vector<float3> positions;
+    std::vector<float3> normals;
+    std::vector<float2> texCrds;
+    std::vector<uint32_t> indices;
+
+    TangentTestMesh(uint32_t size, bool shuffleFaces)
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> u(0.f, 1.f);
+
+        for (uint32_t y = 0; y <= size; y++)
+        {
+            for (uint32_t x = 0; x <= size; x++)
+            {
+                float height = 0.2f * std::sin(x * 0.1f) * std::cos(y * 0.13f) + 0.01f * u(rng);
+                positions.push_back(float3(float(x), height, float(y)));
+                normals.push_back(normalize(float3(-0.1f * u(rng), 1.f, 0.1f * u(rng))));
+                texCrds.push_back(float2((x % 50 < 25 ? 0.1f : -0.1f) * x, 0.1f * y));
+            }
+        }
+
+        // Duplicate some vertices with identical attributes, which MikkTSpace welds.
+        const uint32_t duplicateOffset = (uint32_t)positions.size();
+        for (uint32_t y = 0; y < size; y += 3)
+        {
+            uint32_t i = y * (size + 1) + size / 2;
+            positions.push_back(positions[i]);
+            normals.push_back(normals[i]);
+            texCrds.push_back(texCrds[i]);
+        }
+
+        for (uint32_t y = 0; y < size; y++)
+        {
+            for (uint32_t x = 0; x < size; x++)
+            {
+                uint32_t i0 = y * (size + 1) + x;
+                uint32_t i1 = i0 + 1;
+                uint32_t i2 = i0 + size + 1;
+                uint32_t i3 = i2 + 1;
+                if (x == size / 2 && y % 3 == 0) i0 = duplicateOffset + y / 3;
+                indices.insert(indices.end(), {i0, i1, i3, i0, i3, i2});
+                if ((x * 7 + y * 13) % 101 == 0) indices.insert(indices.end(), {i0, i0, i1});
+            }
+        }
+
+        if (shuffleFaces)
+        {
+            std::vector<uint32_t> faces(indices.size() / 3);
+            std::iota(faces.begin(), faces.end(), 0);
+            std::shuffle(faces.begin(), faces.end(), rng);
+            std::vector<uint32_t> shuffled;
+            for (uint32_t face : faces) shuffled.insert(shuffled.end(), indices.begin() + face * 3, indices.begin() + face * 3 + 3);
+            indices = std::move(shuffled);
+        }
+    }
+
+    SceneBuilder::Mesh getMesh() const
+    {
+        SceneBuilder::Mesh mesh;
+        mesh.name = "TangentTestMesh";
+        mesh.faceCount = (uint32_t)indices.size() / 3;
+        mesh.indexCount = (uint32_t)indices.size();
+        mesh.vertexCount = (uint32_t)positions.size();
+        mesh.pIndices = indices.data();
+        mesh.topology = Vao::Topology::TriangleList;
+        mesh.positions = {positions.data(), SceneBuilder::Mesh::AttributeFrequency::Vertex};
+        mesh.normals = {normals.data(), SceneBuilder::Mesh::AttributeFrequency::Vertex};
+        mesh.texCrds = {texCrds.data(), SceneBuilder::Mesh::AttributeFrequency::Vertex};
+        return mesh;
+    }
+};
+
+/**
+ * Build a scene with two identical cubes, a rotated and translated copy and a scaled copy of the cube.
+ */
+ref<Scene> createDuplicateMeshScene(ref<Device> pDevice, SceneBuilder::Flags flags)
+{
+    SceneBuilder builder(pDevice, Settings(), flags);
+    auto pMaterial = StandardMaterial::create(pDevice, "Material");
+
+    auto addCube = [&](const float4x4& meshTransform, const float4x4& nodeTransform)
+    {
+        auto pMesh = TriangleMesh::createCube(float3(1.f, 2.f, 3.f));
+        pMesh->applyTransform(meshTransform);
+        NodeID nodeID = builder.addNode(SceneBuilder::Node{"Cube", nodeTransform, float4x4::identity()});
+        builder.addMeshInstance(nodeID, builder.addTriangleMesh(pMesh, pMaterial));
+    };
+
+    float4x4 rigid = mul(
+        math::matrixFromTranslation(float3(10.f, -5.f, 2.f)), math::matrixFromRotation(0.7f, normalize(float3(1.f, 2.f, 3.f)))
+    );
+    addCube(float4x4::identity(), math::matrixFromTranslation(float3(-4.f, 0.f, 0.f)));
+    addCube(float4x4::identity(), math::matrixFromTranslation(float3(4.f, 0.f, 0.f)));
+    addCube(rigid, float4x4::identity());
+    addCube(math::matrixFromScaling(float3(2.f)), float4x4::identity());
+
+    return builder.getScene();
+}
+
+/**
+ * Build a scene with a single grid mesh of 513x513 vertices and 512x512x2 triangles using the given memory budget.
+ * The estimated scene memory is 46 MB with packed vertices and 42 MB with compressed vertices.
+ */
+ref<Scene> createMemoryBudgetScene(ref<Device> pDevice, uint64_t budgetMB, bool allowCompression)
+{
+    const uint32_t size = 512;
+
+    std::vector<float3> positions;
+    std::vector<float3> normals;
+    std::vector<float2> texCrds;
+    std::vector<uint32_t> indices;
+    for (uint32_t y = 0; y <= size; y++)
+    {
+        for (uint32_t x = 0; x <= size; x++)
+        {
+            positions.push_back(float3(float(x), 0.f, float(y)));
+            normals.push_back(float3(0.f, 1.f, 0.f));
+            // Multiples of 1/1024 are exactly representable in fp16, which allows storing the mesh in compressed format.
+            texCrds.push_back(float2(float(x), float(y)) / 1024.f);
+        }
+    }
+    for (uint32_t y = 0; y < size; y++)
+    {
+        for (uint32_t x = 0; x < size; x++)
+        {
+            uint32_t i0 = y * (size + 1) + x;
+            uint32_t i2 = i0 + size + 1;
+            indices.insert(indices.end(), {i0, i0 + 1, i2 + 1, i0, i2 + 1, i2});
+        }
+    }
+
+    SceneBuilder::Mesh mesh;
+    mesh.name = "Grid";
+    mesh.faceCount = (uint32_t)indices.size() / 3;
+    mesh.indexCount = (uint32_t)indices.size();
+    mesh.vertexCount = (uint32_t)positions.size();
+    mesh.pIndices = indices.data();
+    mesh.topology = Vao::Topology::TriangleList;
+    mesh.positions = {positions.data(), SceneBuilder::Mesh::AttributeFrequency::Vertex};
+    mesh.normals = {normals.data(), SceneBuilder::Mesh::AttributeFrequency::Vertex};
+    mesh.texCrds = {texCrds.data(), SceneBuilder::Mesh::AttributeFrequency::Vertex};
+    mesh.pMaterial = StandardMaterial::create(pDevice, "Material");
+
+    Settings settings;
+    settings.addOptions(nlohmann::json{{"SceneBuilder", {{"memoryBudgetMB", budgetMB}, {"memoryBudgetCompress", allowCompression}}}});
+
+    SceneBuilder builder(pDevice, settings);
+    NodeID nodeID = builder.addNode(SceneBuilder::Node{"Grid", float4x4::identity(), float4x4::identity()});
+    builder.addMeshInstance(nodeID, builder.addMesh(mesh));
+    return builder.getScene();
+}
+} // namespace
+
+GPU_TEST(SceneBuilder_InstanceDuplicateMeshes)
+{
+    ref<Scene> pReference = createDuplicateMeshScene(ctx.getDevice(), SceneBuilder::Flags::None);
+    ref<Scene> pExact = createDuplicateMeshScene(ctx.getDevice(), SceneBuilder::Flags::InstanceDuplicateMeshes);
+    ref<Scene> pRigid = createDuplicateMeshScene(ctx.getDevice(), SceneBuilder::Flags::InstanceRigidDuplicateMeshes);
+
+    EXPECT_EQ(pReference->getMeshCount(), 4u);
+    EXPECT_EQ(pExact->getMeshCount(), 3u);
+    EXPECT_EQ(pRigid->getMeshCount(), 2u);
+
+    // Instancing must not change the rendered geometry.
+    const auto& referenceStats = pReference->getSceneStats();
+    for (const auto& pScene : {pExact, pRigid})
+    {
+        const auto& stats = pScene->getSceneStats();
+        EXPECT_EQ(stats.meshInstanceCount, 4u);
+        EXPECT_EQ(stats.instancedTriangleCount, referenceStats.instancedTriangleCount);
+        EXPECT_LT(stats.uniqueTriangleCount, referenceStats.uniqueTriangleCount);
+
+        const AABB& bounds = pScene->getSceneBounds();
+        const AABB& referenceBounds = pReference->getSceneBounds();
+        EXPECT_LE(length(bounds.minPoint - referenceBounds.minPoint), 1e-4f);
+        EXPECT_LE(length(bounds.maxPoint - referenceBounds.maxPoint), 1e-4f);
+    }
+}
+
+GPU_TEST(SceneBuilder_MemoryBudget)
+{
+    ref<Device> pDevice = ctx.getDevice();
+
+    // No budget and a budget that fits the packed vertices keep the build flags.
+    for (uint64_t budgetMB : {0, 64})
+    {
+        ref<Scene> pScene = createMemoryBudgetScene(pDevice, budgetMB, true);
+        EXPECT(!pScene->getMesh(MeshID{0}).useCompressedVertices());
+    }
+
+    // A budget that only fits the compressed vertices switches to compressed vertices, unless disabled.
+    ref<Scene> pScene = createMemoryBudgetScene(pDevice, 44, true);
+    EXPECT(pScene->getMesh(MeshID{0}).useCompressedVertices());
+    EXPECT_THROW(createMemoryBudgetScene(pDevice, 44, false));
+
+    // A budget that does not fit the scene fails the build.
+    EXPECT_THROW(createMemoryBudgetScene(pDevice, 40, true));
+
+    // The memory report adds up to the scene memory usage and lists the mesh.
+    Scene::MemoryReport report = pScene->getMemoryReport();
+    EXPECT_EQ(report.getTotal(), pScene->getMemoryUsageInBytes());
+    size_t meshAssetCount = 0;
+    for (const auto& asset : report.assets)
+    {
+        if (asset.category != "meshes")
+            continue;
+        meshAssetCount++;
+        EXPECT_EQ(asset.name, "Grid");
+        EXPECT_EQ(asset.bytes, 513ull * 513 * sizeof(CompressedStaticVertexData) + 512ull * 512 * 6 * sizeof(uint32_t));
+    }
+    EXPECT_EQ(meshAssetCount, 1u);
+}
+
+CPU_TEST(SceneBuilder_GenerateTangents)
+{
+    // The parallel path must produce the same tangents as running MikkTSpace on the whole mesh.
+    for (bool shuffleFaces : {false, true})
+    {
+        TangentTestMesh testMesh(300, shuffleFaces);
+        SceneBuilder::Mesh mesh = testMesh.getMesh();
+        std::vector<float4> reference;
+        SceneBuilder::generateTangents(mesh, reference, false);
+
+        mesh = testMesh.getMesh();
+        std::vector<float4> tangents;
+        SceneBuilder::generateTangents(mesh, tangents, true);
+
+        EXPECT_EQ(tangents.size(), reference.size());
+        size_t mismatchCount = 0;
+        for (size_t i = 0; i < std::min(tangents.size(), reference.size()); i++)
+        {
+            if (std::memcmp(&tangents[i], &reference[i], sizeof(float4)) != 0) mismatchCount++;
+        }
+        EXPECT_EQ(mismatchCount, 0u) << "shuffleFaces=" << shuffleFaces;
+    }
+}
+
+CPU_TEST(SceneBuilder_GenerateTangentsBenchmark, TAGS("benchmark"))
+{
+    TangentTestMesh testMesh(700, false);
+
+    for (bool parallel : {false, true})
+    {
+        SceneBuilder::Mesh mesh = testMesh.getMesh();
+        std::vector<float4> tangents;
+
+        auto startTime = CpuTimer::getCurrentTimePoint();
+        SceneBuilder::generateTangents(mesh, tangents, parallel);
+        double durationMs = CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint());
+
+        EXPECT_EQ(tangents.size(), testMesh.indices.size());
+        logInfo("SceneBuilder::generateTangents() {} faces: {} {:.1f} ms", mesh.faceCount, parallel ? "parallel" : "serial", durationMs);
+    }
+}
+CPU_TEST(SceneBuilder_PartitionMeshesSAH)
+{
+    const size_t kLimit = SceneBuilder::kMaxTrianglesPerBLAS;
+
+    auto checkPartition = [&](const std::vector<AABB>& meshBounds,
+                              const std::vector<size_t>& triangleCounts,
+                              const std::vector<std::vector<uint32_t>>& groups,
+                              std::vector<AABB>& groupBounds)
+    {
+        // Every mesh must be assigned to exactly one group and every group must stay under the limit.
+        std::vector<uint32_t> assignCount(meshBounds.size(), 0);
+        groupBounds.clear();
+        for (const auto& group : groups)
+        {
+            size_t groupTriangleCount = 0;
+            AABB bb;
+            for (uint32_t mesh : group)
+            {
+                assignCount[mesh]++;
+                groupTriangleCount += triangleCounts[mesh];
+                bb.include(meshBounds[mesh]);
+            }
+            EXPECT_LE(groupTriangleCount, kLimit);
+            groupBounds.push_back(bb);
+        }
+        for (uint32_t count : assignCount)
+            EXPECT_EQ(count, 1u);
+    };
+
+    // A 12x4 grid of separated meshes with 1/16 of the limit each must split into the minimal 3 groups.
+    // Splitting the grid in the middle would be cheaper by SAH cost alone, but would result in 4 groups.
+    {
+        std::vector<AABB> meshBounds;
+        std::vector<size_t> triangleCounts;
+        for (uint32_t y = 0; y < 4; y++)
+        {
+            for (uint32_t x = 0; x < 12; x++)
+            {
+                float3 p(2.f * x, 2.f * y, 0.f);
+                meshBounds.push_back(AABB(p, p + float3(1.f)));
+                triangleCounts.push_back(kLimit / 16);
+            }
+        }
+        size_t triangleCount = std::accumulate(triangleCounts.begin(), triangleCounts.end(), size_t(0));
+        EXPECT_GT(triangleCount, kLimit);
+
+        auto groups = SceneBuilder::partitionMeshesSAH(meshBounds, triangleCounts, kLimit);
+        EXPECT_EQ(groups.size(), div_round_up(triangleCount, kLimit));
+
+        std::vector<AABB> groupBounds;
+        checkPartition(meshBounds, triangleCounts, groups, groupBounds);
+        EXPECT_EQ(SceneBuilder::calculateOverlap(groupBounds), 0.f);
+    }
+
+    // Two well-separated clusters of randomly placed meshes must be split into one group per cluster with zero overlap.
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> u(0.f, 1.f);
+
+        const uint32_t kMeshesPerCluster = 100;
+        std::vector<AABB> meshBounds;
+        std::vector<size_t> triangleCounts;
+        for (uint32_t cluster = 0; cluster < 2; cluster++)
+        {
+            float3 origin(100.f * cluster, 0.f, 0.f);
+            for (uint32_t i = 0; i < kMeshesPerCluster; i++)
+            {
+                float3 p = origin + float3(u(rng), u(rng), u(rng));
+                meshBounds.push_back(AABB(p, p + 0.2f * float3(u(rng), u(rng), u(rng))));
+                triangleCounts.push_back(kLimit * 3 / (4 * kMeshesPerCluster));
+            }
+        }
+
+        auto groups = SceneBuilder::partitionMeshesSAH(meshBounds, triangleCounts, kLimit);
+        EXPECT_EQ(groups.size(), 2u);
+
+        std::vector<AABB> groupBounds;
+        checkPartition(meshBounds, triangleCounts, groups, groupBounds);
+        EXPECT_EQ(SceneBuilder::calculateOverlap(groupBounds), 0.f);
+
+        for (const auto& group : groups)
+        {
+            uint32_t cluster = group.empty() ? 0 : group[0] / kMeshesPerCluster;
+            for (uint32_t mesh : group)
+                EXPECT_EQ(mesh / kMeshesPerCluster, cluster);
+        }
+    }
+
+    // Half of the first box overlaps the second box.
+    std::vector<AABB> boxes = {AABB(float3(0.f), float3(1.f)), AABB(float3(0.5f, 0.f, 0.f), float3(1.5f, 1.f, 1.f))};
+    EXPECT_EQ(SceneBuilder::calculateOverlap(boxes), 0.5f);
+}
+} // namespace Falcor
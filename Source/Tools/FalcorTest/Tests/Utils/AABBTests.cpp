@@ -26,6 +26,9 @@
  # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  **************************************************************************/
 #include "Testing/UnitTest.h"
+#include "Utils/Math/AABB.h"
+
+#include <random>
 
 namespace Falcor
 {
@@ -212,4 +215,37 @@ GPU_TEST(AABB)
 
     FALCOR_ASSERT(i <= resultSize);
 }
+
+CPU_TEST(AABB_transform)
+{
+    // Compare against the bounds of the transformed corners.
+    std::mt19937 rng;
+    std::uniform_real_distribution<float> uniform(-4.f, 4.f);
+    for (int i = 0; i < 1000; ++i)
+    {
+        float4x4 m;
+        for (int r = 0; r < 3; ++r)
+            for (int c = 0; c < 4; ++c)
+                m[r][c] = uniform(rng);
+
+        AABB box(float3(uniform(rng), uniform(rng), uniform(rng)));
+        box.include(float3(uniform(rng), uniform(rng), uniform(rng)));
+        AABB expected;
+        for (uint32_t corner = 0; corner < 8; ++corner)
+        {
+            float3 p(
+                (corner & 1) ? box.maxPoint.x : box.minPoint.x,
+                (corner & 2) ? box.maxPoint.y : box.minPoint.y,
+                (corner & 4) ? box.maxPoint.z : box.minPoint.z
+            );
+            expected.include(transformPoint(m, p));
+        }
+
+        AABB result = box.transform(m);
+        EXPECT_TRUE(all(abs(result.minPoint - expected.minPoint) < float3(1e-4f)));
+        EXPECT_TRUE(all(abs(result.maxPoint - expected.maxPoint) < float3(1e-4f)));
+    }
+
+    EXPECT_FALSE(AABB().transform(float4x4::identity()).valid());
+}
 } // namespace Falcor
@@ -0,0 +1,219 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Geometry/MeshOptimizer.h"
+#include "Utils/Timing/CpuTimer.h"
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+/// Create a regular grid of (size x size) quads, each split into two triangles.
+std::vector<uint32_t> createGrid(uint32_t size)
+{
+    std::vector<uint32_t> indices;
+    indices.reserve(size * size * 6);
+    for (uint32_t y = 0; y < size; ++y)
+    {
+        for (uint32_t x = 0; x < size; ++x)
+        {
+            uint32_t v0 = y * (size + 1) + x;
+            uint32_t v1 = v0 + 1;
+            uint32_t v2 = v0 + size + 1;
+            uint32_t v3 = v2 + 1;
+            indices.insert(indices.end(), {v0, v1, v2, v2, v1, v3});
+        }
+    }
+    return indices;
+}
+
+/// Shuffle the triangle order and the vertex numbering to destroy any locality.
+void shuffleMesh(std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<std::array<uint32_t, 3>> triangles(indices.size() / 3);
+    for (size_t i = 0; i < triangles.size(); ++i)
+        triangles[i] = {indices[3 * i], indices[3 * i + 1], indices[3 * i + 2]};
+    std::shuffle(triangles.begin(), triangles.end(), rng);
+
+    std::vector<uint32_t> remap(vertexCount);
+    for (uint32_t i = 0; i < vertexCount; ++i)
+        remap[i] = i;
+    std::shuffle(remap.begin(), remap.end(), rng);
+
+    for (size_t i = 0; i < triangles.size(); ++i)
+        for (uint32_t j = 0; j < 3; ++j)
+            indices[3 * i + j] = remap[triangles[i][j]];
+}
+
+/// Get the sorted list of triangles, each rotated so that the smallest index comes first (preserving winding).
+std::vector<std::array<uint32_t, 3>> getCanonicalTriangles(const std::vector<uint32_t>& indices)
+{
+    std::vector<std::array<uint32_t, 3>> triangles(indices.size() / 3);
+    for (size_t i = 0; i < triangles.size(); ++i)
+    {
+        std::array<uint32_t, 3> t = {indices[3 * i], indices[3 * i + 1], indices[3 * i + 2]};
+        std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+        triangles[i] = t;
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+} // namespace
+
+CPU_TEST(MeshOptimizer_AnalyzeVertexCache)
+{
+    // Two triangles sharing an edge transform 4 vertices.
+    std::vector<uint32_t> indices = {0, 1, 2, 2, 1, 3};
+    VertexCacheStats stats = analyzeVertexCache(indices, 4);
+    EXPECT_EQ(stats.triangleCount, 2u);
+    EXPECT_EQ(stats.vertexCount, 4u);
+    EXPECT_EQ(stats.transformCount, 4u);
+    EXPECT_EQ(stats.getACMR(), 2.f);
+    EXPECT_EQ(stats.getATVR(), 1.f);
+
+    // With a cache of 3 entries, vertex 0 is evicted before it is reused.
+    indices = {0, 1, 2, 3, 4, 5, 0, 1, 2};
+    stats = analyzeVertexCache(indices, 6, 3);
+    EXPECT_EQ(stats.vertexCount, 6u);
+    EXPECT_EQ(stats.transformCount, 9u);
+
+    stats = analyzeVertexCache(indices, 6, 6);
+    EXPECT_EQ(stats.transformCount, 6u);
+
+    // Unreferenced vertices are not counted.
+    stats = analyzeVertexCache(indices, 100);
+    EXPECT_EQ(stats.vertexCount, 6u);
+
+    // Accumulation.
+    VertexCacheStats total;
+    total += analyzeVertexCache(std::vector<uint32_t>{0, 1, 2}, 3);
+    total += analyzeVertexCache(std::vector<uint32_t>{0, 1, 2, 2, 1, 3}, 4);
+    EXPECT_EQ(total.triangleCount, 3u);
+    EXPECT_EQ(total.vertexCount, 7u);
+    EXPECT_EQ(total.transformCount, 7u);
+
+    // Empty input.
+    stats = analyzeVertexCache({}, 0);
+    EXPECT_EQ(stats.getACMR(), 0.f);
+    EXPECT_EQ(stats.getATVR(), 0.f);
+}
+
+CPU_TEST(MeshOptimizer_OptimizeVertexCache)
+{
+    const uint32_t size = 64;
+    const uint32_t vertexCount = (size + 1) * (size + 1);
+    std::vector<uint32_t> indices = createGrid(size);
+    shuffleMesh(indices, vertexCount, 1);
+
+    const auto trianglesBefore = getCanonicalTriangles(indices);
+    const VertexCacheStats statsBefore = analyzeVertexCache(indices, vertexCount);
+
+    optimizeVertexCache(indices, vertexCount);
+
+    // The same triangles with the same winding must be present.
+    EXPECT(getCanonicalTriangles(indices) == trianglesBefore);
+
+    // A shuffled grid has ACMR close to 3, an optimized grid is expected to be well below 1.
+    const VertexCacheStats statsAfter = analyzeVertexCache(indices, vertexCount);
+    EXPECT_EQ(statsAfter.vertexCount, statsBefore.vertexCount);
+    EXPECT_GT(statsBefore.getACMR(), 2.5f);
+    EXPECT_LT(statsAfter.getACMR(), 0.9f);
+    EXPECT_LT(statsAfter.getATVR(), 1.8f);
+
+    // Degenerate triangles and empty input are handled.
+    std::vector<uint32_t> degenerate = {0, 0, 1, 1, 2, 2, 0, 1, 2};
+    optimizeVertexCache(degenerate, 3);
+    EXPECT(getCanonicalTriangles(degenerate) == getCanonicalTriangles({0, 0, 1, 1, 2, 2, 0, 1, 2}));
+    optimizeVertexCache({}, 0);
+
+    // Invalid input.
+    std::vector<uint32_t> invalid = {0, 1, 3};
+    EXPECT_THROW(optimizeVertexCache(invalid, 3));
+    invalid = {0, 1};
+    EXPECT_THROW(optimizeVertexCache(invalid, 3));
+}
+
+CPU_TEST(MeshOptimizer_OptimizeVertexFetch)
+{
+    std::vector<uint32_t> indices = {4, 2, 0, 0, 2, 5};
+    const std::vector<uint32_t> original = indices;
+    std::vector<uint32_t> remap = optimizeVertexFetch(indices, 7);
+
+    // Vertices are numbered in first-use order, unreferenced vertices follow in their original order.
+    EXPECT(indices == std::vector<uint32_t>({0, 1, 2, 2, 1, 3}));
+    EXPECT(remap == std::vector<uint32_t>({2, 4, 1, 5, 0, 3, 6}));
+    for (size_t i = 0; i < indices.size(); ++i)
+        EXPECT_EQ(indices[i], remap[original[i]]);
+
+    // The remap of a larger mesh must be a permutation.
+    const uint32_t size = 32;
+    const uint32_t vertexCount = (size + 1) * (size + 1);
+    indices = createGrid(size);
+    shuffleMesh(indices, vertexCount, 2);
+    remap = optimizeVertexFetch(indices, vertexCount);
+    std::vector<uint32_t> sorted = remap;
+    std::sort(sorted.begin(), sorted.end());
+    for (uint32_t i = 0; i < vertexCount; ++i)
+        EXPECT_EQ(sorted[i], i);
+}
+
+CPU_TEST(MeshOptimizer_Benchmark, TAGS("benchmark"))
+{
+    const uint32_t size = 1024;
+    const uint32_t vertexCount = (size + 1) * (size + 1);
+    std::vector<uint32_t> indices = createGrid(size);
+    shuffleMesh(indices, vertexCount, 3);
+    const VertexCacheStats statsBefore = analyzeVertexCache(indices, vertexCount);
+
+    auto startTime = CpuTimer::getCurrentTimePoint();
+    optimizeVertexCache(indices, vertexCount);
+    double cacheMs = CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint());
+
+    startTime = CpuTimer::getCurrentTimePoint();
+    optimizeVertexFetch(indices, vertexCount);
+    double fetchMs = CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint());
+
+    const VertexCacheStats statsAfter = analyzeVertexCache(indices, vertexCount);
+    logInfo(
+        "MeshOptimizer {} triangles: vertex cache {:.1f} ms, vertex fetch {:.1f} ms, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+        statsAfter.triangleCount,
+        cacheMs,
+        fetchMs,
+        statsBefore.getACMR(),
+        statsAfter.getACMR(),
+        statsBefore.getATVR(),
+        statsAfter.getATVR()
+    );
+}
+} // namespace Falcor
@@ -0,0 +1,239 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Image/Bitmap.h"
+#include "Utils/Image/CookedTextureCache.h"
+#include "Utils/Image/ImageIO.h"
+#include "Core/Platform/OS.h"
+
+#include <random>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+const uint32_t kWidth = 64;
+const uint32_t kHeight = 48;
+
+std::filesystem::path createCacheDirectory()
+{
+    auto path = getTempFilePath();
+    std::filesystem::create_directories(path);
+    return path;
+}
+
+std::filesystem::path createTestImage(const std::filesystem::path& directory, const std::string& name, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> data(kWidth * kHeight * 4);
+    for (auto& v : data)
+        v = uint8_t(rng());
+
+    auto path = directory / name;
+    Bitmap::saveImage(
+        path, kWidth, kHeight, Bitmap::FileFormat::PngFile, Bitmap::ExportFlags::ExportAlpha, ResourceFormat::RGBA8Unorm, true, data.data()
+    );
+    return path;
+}
+
+void checkTexturesEqual(GPUUnitTestContext& ctx, const ref<Texture>& pExpected, const ref<Texture>& pTexture)
+{
+    ASSERT(pTexture != nullptr);
+    EXPECT_EQ(pTexture->getWidth(), pExpected->getWidth());
+    EXPECT_EQ(pTexture->getHeight(), pExpected->getHeight());
+    EXPECT_EQ((uint32_t)pTexture->getFormat(), (uint32_t)pExpected->getFormat());
+    ASSERT_EQ(pTexture->getMipCount(), pExpected->getMipCount());
+
+    for (uint32_t mip = 0; mip < pExpected->getMipCount(); ++mip)
+    {
+        auto expected = ctx.getRenderContext()->readTextureSubresource(pExpected.get(), pExpected->getSubresourceIndex(0, mip));
+        auto data = ctx.getRenderContext()->readTextureSubresource(pTexture.get(), pTexture->getSubresourceIndex(0, mip));
+        EXPECT(data == expected) << "mip = " << mip;
+    }
+}
+} // namespace
+
+GPU_TEST(CookedTextureCache_RoundTrip)
+{
+    ref<Device> pDevice = ctx.getDevice();
+    auto directory = createCacheDirectory();
+    auto path = createTestImage(directory, "image.png", 0);
+
+    CookedTextureCache::Options options;
+    options.directory = directory / "cache";
+
+    {
+        CookedTextureCache cache(pDevice, options);
+
+        // First load imports the source file and cooks it.
+        auto pSource = cache.loadFromFile(path, true, true);
+        ASSERT(pSource != nullptr);
+        EXPECT_GT(pSource->getMipCount(), 1u);
+        EXPECT_EQ(cache.getStats().misses, 1);
+        EXPECT_EQ(cache.getStats().cooked, 1);
+        EXPECT_EQ(cache.getEntryCount(), 1);
+
+        // Second load is served from the cache and matches the source texture, including all mips.
+        auto pCached = cache.loadFromFile(path, true, true);
+        EXPECT_EQ(cache.getStats().hits, 1);
+        checkTexturesEqual(ctx, pSource, pCached);
+        EXPECT_EQ(pCached->getSourcePath(), path);
+
+        // Different import parameters use a separate entry.
+        auto pNoMips = cache.loadFromFile(path, false, true);
+        ASSERT(pNoMips != nullptr);
+        EXPECT_EQ(pNoMips->getMipCount(), 1);
+        EXPECT_EQ(cache.getStats().misses, 2);
+        EXPECT_EQ(cache.getEntryCount(), 2);
+
+        // The unchanged source file is hashed only once.
+        EXPECT_EQ(cache.getStats().hashed, 1);
+    }
+
+    {
+        // The cache persists across instances.
+        CookedTextureCache cache(pDevice, options);
+        EXPECT_EQ(cache.getEntryCount(), 2);
+        auto pCached = cache.loadFromFile(path, true, true);
+        ASSERT(pCached != nullptr);
+        EXPECT_EQ(cache.getStats().hits, 1);
+        EXPECT_EQ(cache.getStats().misses, 0);
+        EXPECT_EQ(cache.getStats().hashed, 0);
+
+        // Modifying the source file invalidates the entry.
+        createTestImage(directory, "image.png", 1);
+        auto pModified = cache.loadFromFile(path, true, true);
+        ASSERT(pModified != nullptr);
+        EXPECT_EQ(cache.getStats().misses, 1);
+        EXPECT_EQ(cache.getStats().hashed, 1);
+        EXPECT_EQ(cache.getEntryCount(), 3);
+
+        cache.clear();
+        EXPECT_EQ(cache.getEntryCount(), 0);
+        EXPECT_EQ(cache.getSize(), 0);
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+GPU_TEST(CookedTextureCache_Eviction)
+{
+    ref<Device> pDevice = ctx.getDevice();
+    auto directory = createCacheDirectory();
+    auto pathA = createTestImage(directory, "a.png", 0);
+    auto pathB = createTestImage(directory, "b.png", 1);
+    auto pathC = createTestImage(directory, "c.png", 2);
+
+    // Cooked files without mips hold the DDS header and the raw RGBA8 image.
+    const uint64_t entrySize = 4 + 124 + 20 + kWidth * kHeight * 4;
+
+    CookedTextureCache::Options options;
+    options.directory = directory / "cache";
+    options.maxSize = 2 * entrySize;
+    CookedTextureCache cache(pDevice, options);
+
+    EXPECT(cache.loadFromFile(pathA, false, false) != nullptr);
+    EXPECT(cache.loadFromFile(pathB, false, false) != nullptr);
+    EXPECT_EQ(cache.getSize(), 2 * entrySize);
+
+    // Touch A so that B becomes the least recently used entry.
+    EXPECT(cache.loadFromFile(pathA, false, false) != nullptr);
+    EXPECT_EQ(cache.getStats().hits, 1);
+
+    EXPECT(cache.loadFromFile(pathC, false, false) != nullptr);
+    EXPECT_EQ(cache.getEntryCount(), 2);
+    EXPECT_EQ(cache.getStats().evicted, 1);
+    EXPECT_LE(cache.getSize(), options.maxSize);
+
+    // A is still cached, B was evicted.
+    EXPECT(cache.loadFromFile(pathA, false, false) != nullptr);
+    EXPECT_EQ(cache.getStats().hits, 2);
+    EXPECT(cache.loadFromFile(pathB, false, false) != nullptr);
+    EXPECT_EQ(cache.getStats().misses, 4);
+
+    std::filesystem::remove_all(directory);
+}
+GPU_TEST(CookedTextureCache_Compression)
+{
+    ref<Device> pDevice = ctx.getDevice();
+    auto directory = createCacheDirectory();
+    auto path = createTestImage(directory, "image.png", 0);
+
+    CookedTextureCache::Options options;
+    options.directory = directory / "cache";
+    options.compression = ImageIO::CompressionMode::BC7;
+
+    {
+        CookedTextureCache cache(pDevice, options);
+
+        // First load imports the source file uncompressed and cooks it in compressed form.
+        auto pSource = cache.loadFromFile(path, true, false);
+        ASSERT(pSource != nullptr);
+        EXPECT(!isCompressedFormat(pSource->getFormat()));
+        EXPECT_GT(pSource->getMipCount(), 1u);
+        EXPECT_EQ(cache.getStats().misses, 1);
+        EXPECT_EQ(cache.getStats().cooked, 1);
+        EXPECT_EQ(cache.getEntryCount(), 1);
+
+        // Only the renamed cache entry is left in the cache directory.
+        size_t fileCount = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(options.directory))
+        {
+            if (entry.path().extension() == ".dds")
+            {
+                EXPECT_EQ(entry.path().stem().extension(), "") << entry.path();
+                fileCount++;
+            }
+        }
+        EXPECT_EQ(fileCount, 1);
+
+        // Second load is served from the cache as a block-compressed texture with the full mip chain.
+        auto pCached = cache.loadFromFile(path, true, false);
+        ASSERT(pCached != nullptr);
+        EXPECT_EQ(cache.getStats().hits, 1);
+        EXPECT(isCompressedFormat(pCached->getFormat()));
+        EXPECT_EQ(pCached->getWidth(), pSource->getWidth());
+        EXPECT_EQ(pCached->getHeight(), pSource->getHeight());
+        EXPECT_EQ(pCached->getMipCount(), pSource->getMipCount());
+        EXPECT_EQ(pCached->getSourcePath(), path);
+    }
+
+    {
+        // Entries cooked with compression are not used when compression is disabled.
+        options.compression = ImageIO::CompressionMode::None;
+        CookedTextureCache cache(pDevice, options);
+        auto pTexture = cache.loadFromFile(path, true, false);
+        ASSERT(pTexture != nullptr);
+        EXPECT(!isCompressedFormat(pTexture->getFormat()));
+        EXPECT_EQ(cache.getStats().misses, 1);
+    }
+
+    std::filesystem::remove_all(directory);
+}
+} // namespace Falcor
@@ -0,0 +1,216 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Image/CpuMipGenerator.h"
+#include "Utils/Timing/CpuTimer.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+std::vector<uint8_t> createRandomImage(uint32_t width, uint32_t height, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> data(width * height * 4);
+    for (auto& v : data)
+        v = uint8_t(rng());
+    return data;
+}
+
+float getAlphaCoverage(const uint8_t* pData, uint32_t pixelCount, uint8_t cutoff)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < pixelCount; ++i)
+        count += pData[i * 4 + 3] >= cutoff ? 1 : 0;
+    return float(count) / pixelCount;
+}
+} // namespace
+
+CPU_TEST(CpuMipGenerator_Box)
+{
+    const uint32_t width = 8;
+    const uint32_t height = 4;
+    auto data = createRandomImage(width, height, 0);
+
+    auto mips = CpuMipGenerator::generate(width, height, ResourceFormat::RGBA8Unorm, data.data());
+    ASSERT_EQ(CpuMipGenerator::getMipCount(width, height), 4);
+    ASSERT_EQ(mips.size(), (8 * 4 + 4 * 2 + 2 * 1 + 1 * 1) * 4);
+
+    // Base level is copied as-is.
+    EXPECT(std::equal(data.begin(), data.end(), mips.begin()));
+
+    // Mip 1 is the 2x2 average of the base level.
+    const uint8_t* pMip1 = mips.data() + width * height * 4;
+    for (uint32_t y = 0; y < height / 2; ++y)
+    {
+        for (uint32_t x = 0; x < width / 2; ++x)
+        {
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                auto texel = [&](uint32_t sx, uint32_t sy) { return float(data[(sy * width + sx) * 4 + c]); };
+                float expected =
+                    0.25f * (texel(2 * x, 2 * y) + texel(2 * x + 1, 2 * y) + texel(2 * x, 2 * y + 1) + texel(2 * x + 1, 2 * y + 1));
+                EXPECT_LE(std::abs(float(pMip1[(y * width / 2 + x) * 4 + c]) - expected), 0.51f) << "x = " << x << " y = " << y;
+            }
+        }
+    }
+}
+
+CPU_TEST(CpuMipGenerator_Srgb)
+{
+    // Checkerboard of black and white averages to 0.5 in linear space, which is 188 in sRGB.
+    std::vector<uint8_t> data = {255, 255, 255, 255, 0, 0, 0, 255, 0, 0, 0, 255, 255, 255, 255, 255};
+
+    auto srgbMips = CpuMipGenerator::generate(2, 2, ResourceFormat::RGBA8UnormSrgb, data.data());
+    ASSERT_EQ(srgbMips.size(), 20);
+    EXPECT_EQ(srgbMips[16], 188);
+    EXPECT_EQ(srgbMips[17], 188);
+    EXPECT_EQ(srgbMips[18], 188);
+    EXPECT_EQ(srgbMips[19], 255);
+
+    auto linearMips = CpuMipGenerator::generate(2, 2, ResourceFormat::RGBA8Unorm, data.data());
+    EXPECT_EQ(linearMips[16], 128);
+}
+
+CPU_TEST(CpuMipGenerator_Filters)
+{
+    // A constant image stays constant for non-power-of-two sizes and all filters.
+    const uint32_t width = 37;
+    const uint32_t height = 11;
+    std::vector<float> data(width * height, 0.75f);
+
+    for (auto filter : {CpuMipGenerator::Filter::Box, CpuMipGenerator::Filter::Kaiser})
+    {
+        CpuMipGenerator::Options options;
+        options.filter = filter;
+        auto mips = CpuMipGenerator::generate(width, height, ResourceFormat::R32Float, data.data(), options);
+
+        uint32_t mipCount = CpuMipGenerator::getMipCount(width, height);
+        EXPECT_EQ(mipCount, 6);
+
+        size_t expectedSize = 0;
+        for (uint32_t mip = 0; mip < mipCount; ++mip)
+            expectedSize += std::max(1u, width >> mip) * std::max(1u, height >> mip) * sizeof(float);
+        ASSERT_EQ(mips.size(), expectedSize);
+
+        const float* pValues = reinterpret_cast<const float*>(mips.data());
+        for (size_t i = 0; i < mips.size() / sizeof(float); ++i)
+            EXPECT_LE(std::abs(pValues[i] - 0.75f), 1e-5f) << "i = " << i;
+    }
+
+    EXPECT(!CpuMipGenerator::isFormatSupported(ResourceFormat::BC1Unorm));
+    EXPECT_THROW(CpuMipGenerator::generate(4, 4, ResourceFormat::BC1Unorm, data.data()));
+}
+
+CPU_TEST(CpuMipGenerator_AlphaCoverage)
+{
+    // Sparse alpha-tested texels (like foliage) disappear in lower mips unless alpha is rescaled.
+    const uint32_t size = 256;
+    std::mt19937 rng(1);
+    std::vector<uint8_t> data(size * size * 4);
+    for (uint32_t i = 0; i < size * size; ++i)
+    {
+        data[i * 4 + 0] = data[i * 4 + 1] = data[i * 4 + 2] = 128;
+        data[i * 4 + 3] = rng() % 4 == 0 ? 255 : 0;
+    }
+    const float baseCoverage = getAlphaCoverage(data.data(), size * size, 128);
+
+    CpuMipGenerator::Options options;
+    options.alphaCutoff = 0.5f;
+    auto plainMips = CpuMipGenerator::generate(size, size, ResourceFormat::RGBA8Unorm, data.data());
+    auto mips = CpuMipGenerator::generate(size, size, ResourceFormat::RGBA8Unorm, data.data(), options);
+
+    size_t offset = size * size * 4;
+    for (uint32_t mip = 1; mip <= 5; ++mip)
+    {
+        uint32_t mipSize = size >> mip;
+        float coverage = getAlphaCoverage(mips.data() + offset, mipSize * mipSize, 128);
+        EXPECT_LE(std::abs(coverage - baseCoverage), 0.1f) << "mip = " << mip;
+        offset += mipSize * mipSize * 4;
+    }
+
+    // Without coverage preservation, coverage collapses.
+    offset = size * size * 4 + (size / 2) * (size / 2) * 4;
+    EXPECT_LE(getAlphaCoverage(plainMips.data() + offset, (size / 4) * (size / 4), 128), 0.1f);
+}
+
+GPU_TEST(CpuMipGenerator_MatchesGpu)
+{
+    ref<Device> pDevice = ctx.getDevice();
+
+    const uint32_t size = 64;
+    auto data = createRandomImage(size, size, 2);
+    auto pTexture = pDevice->createTexture2D(size, size, ResourceFormat::RGBA8Unorm, 1, Texture::kMaxPossible, data.data());
+    auto mips = CpuMipGenerator::generate(size, size, ResourceFormat::RGBA8Unorm, data.data());
+
+    ASSERT_EQ(pTexture->getMipCount(), CpuMipGenerator::getMipCount(size, size));
+
+    // The GPU filters each level from the quantized previous level, allow small rounding differences.
+    size_t offset = 0;
+    for (uint32_t mip = 0; mip < pTexture->getMipCount(); ++mip)
+    {
+        auto gpuData = ctx.getRenderContext()->readTextureSubresource(pTexture.get(), pTexture->getSubresourceIndex(0, mip));
+        for (size_t i = 0; i < gpuData.size(); ++i)
+        {
+            EXPECT_LE(std::abs(int(gpuData[i]) - int(mips[offset + i])), 2) << "mip = " << mip << " i = " << i;
+        }
+        offset += gpuData.size();
+    }
+    EXPECT_EQ(offset, mips.size());
+}
+
+CPU_TEST(CpuMipGenerator_Benchmark, TAGS("benchmark"))
+{
+    const uint32_t size = 2048;
+    auto data = createRandomImage(size, size, 3);
+
+    for (auto format : {ResourceFormat::RGBA8Unorm, ResourceFormat::RGBA8UnormSrgb})
+    {
+        for (auto filter : {CpuMipGenerator::Filter::Box, CpuMipGenerator::Filter::Kaiser})
+        {
+            CpuMipGenerator::Options options;
+            options.filter = filter;
+            auto startTime = CpuTimer::getCurrentTimePoint();
+            auto mips = CpuMipGenerator::generate(size, size, format, data.data(), options);
+            double ms = CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint());
+            logInfo(
+                "CpuMipGenerator {}x{} {} {}: {:.1f} ms",
+                size,
+                size,
+                to_string(format),
+                filter == CpuMipGenerator::Filter::Box ? "box" : "kaiser",
+                ms
+            );
+        }
+    }
+}
+} // namespace Falcor
@@ -0,0 +1,267 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Image/Bitmap.h"
+#include "Utils/Image/ExrWriter.h"
+#include "Utils/Math/Float16.h"
+#include "Utils/Timing/CpuTimer.h"
+#include "Core/Platform/OS.h"
+
+#include <FreeImage.h>
+
+#include <random>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+std::vector<float> createTestImage(uint32_t width, uint32_t height, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(0.f, 100.f);
+    std::vector<float> data(width * height * 4);
+    for (auto& v : data)
+        v = dist(rng);
+    return data;
+}
+
+std::filesystem::path getTempExrPath()
+{
+    auto path = getTempFilePath();
+    path += ".exr";
+    return path;
+}
+
+/// Load the default layer (R, G, B, A) of an EXR file and compare it to the expected values.
+void checkDefaultLayer(CPUUnitTestContext& ctx, const std::filesystem::path& path, uint32_t width, uint32_t height, const float* pExpected, bool isHalf)
+{
+    auto pBitmap = Bitmap::createFromFile(path, true);
+    ASSERT(pBitmap != nullptr);
+    EXPECT_EQ(pBitmap->getWidth(), width);
+    EXPECT_EQ(pBitmap->getHeight(), height);
+    ASSERT_EQ((uint32_t)pBitmap->getFormat(), (uint32_t)(isHalf ? ResourceFormat::RGBA16Float : ResourceFormat::RGBA32Float));
+
+    for (uint32_t i = 0; i < width * height * 4; ++i)
+    {
+        float expected = isHalf ? float(float16_t(pExpected[i])) : pExpected[i];
+        float value = isHalf ? float(reinterpret_cast<const float16_t*>(pBitmap->getData())[i])
+                             : reinterpret_cast<const float*>(pBitmap->getData())[i];
+        EXPECT_EQ(value, expected) << "i = " << i;
+        if (value != expected)
+            break;
+    }
+}
+} // namespace
+
+CPU_TEST(ExrWriter_Lossless)
+{
+    const uint32_t width = 123;
+    const uint32_t height = 67;
+    auto data = createTestImage(width, height, 0);
+
+    for (auto compression : {ExrWriter::Compression::None, ExrWriter::Compression::Zip, ExrWriter::Compression::Piz})
+    {
+        auto path = getTempExrPath();
+        ExrWriter::Layer layer{"", ResourceFormat::RGBA32Float, TextureChannelFlags::RGBA, data.data()};
+        ExrWriter::Options options;
+        options.compression = compression;
+        ExrWriter::write(path, width, height, fstd::span<const ExrWriter::Layer>(&layer, 1), options);
+        checkDefaultLayer(ctx, path, width, height, data.data(), false);
+        std::filesystem::remove(path);
+    }
+}
+
+CPU_TEST(ExrWriter_Half)
+{
+    const uint32_t width = 64;
+    const uint32_t height = 48;
+    auto data = createTestImage(width, height, 1);
+
+    // Float data stored as half-float channels.
+    {
+        auto path = getTempExrPath();
+        ExrWriter::Layer layer{"", ResourceFormat::RGBA32Float, TextureChannelFlags::RGBA, data.data(), true};
+        ExrWriter::write(path, width, height, fstd::span<const ExrWriter::Layer>(&layer, 1));
+        checkDefaultLayer(ctx, path, width, height, data.data(), true);
+        std::filesystem::remove(path);
+    }
+
+    // Half-float data written in place.
+    {
+        std::vector<float16_t> halfData(data.size());
+        for (size_t i = 0; i < data.size(); ++i)
+            halfData[i] = float16_t(data[i]);
+
+        auto path = getTempExrPath();
+        ExrWriter::Layer layer{"", ResourceFormat::RGBA16Float, TextureChannelFlags::RGBA, halfData.data()};
+        ExrWriter::write(path, width, height, fstd::span<const ExrWriter::Layer>(&layer, 1));
+        checkDefaultLayer(ctx, path, width, height, data.data(), true);
+        std::filesystem::remove(path);
+    }
+}
+
+CPU_TEST(ExrWriter_MultiLayer)
+{
+    const uint32_t width = 80;
+    const uint32_t height = 40;
+    auto color = createTestImage(width, height, 2);
+    auto normal = createTestImage(width, height, 3);
+    std::vector<float> depth(width * height, 1.f);
+
+    std::vector<ExrWriter::Layer> layers = {
+        {"", ResourceFormat::RGBA32Float, TextureChannelFlags::RGBA, color.data()},
+        {"normal", ResourceFormat::RGBA32Float, TextureChannelFlags::RGB, normal.data(), true},
+        {"depth", ResourceFormat::R32Float, TextureChannelFlags::Red, depth.data()},
+    };
+
+    // The default layer is stored in the first part, so it can be read back in both modes.
+    for (bool multiPart : {false, true})
+    {
+        auto path = getTempExrPath();
+        ExrWriter::Options options;
+        options.multiPart = multiPart;
+        ExrWriter::write(path, width, height, layers, options);
+        checkDefaultLayer(ctx, path, width, height, color.data(), false);
+        std::filesystem::remove(path);
+    }
+
+    // Layers without any channel of the format in their mask are rejected.
+    layers.push_back({"empty", ResourceFormat::R32Float, TextureChannelFlags::Green, depth.data()});
+    EXPECT_THROW(ExrWriter::write(getTempExrPath(), width, height, layers));
+    layers.pop_back();
+
+    // Duplicate channel names are rejected.
+    layers.push_back({"depth", ResourceFormat::R32Float, TextureChannelFlags::Red, depth.data()});
+    EXPECT_THROW(ExrWriter::write(getTempExrPath(), width, height, layers));
+}
+
+CPU_TEST(ExrWriter_SaveImage)
+{
+    const uint32_t width = 32;
+    const uint32_t height = 16;
+    auto data = createTestImage(width, height, 4);
+
+    auto path = getTempExrPath();
+    Bitmap::saveImage(
+        path,
+        width,
+        height,
+        Bitmap::FileFormat::ExrFile,
+        Bitmap::ExportFlags::Uncompressed | Bitmap::ExportFlags::ExportAlpha,
+        ResourceFormat::RGBA32Float,
+        true,
+        data.data()
+    );
+    checkDefaultLayer(ctx, path, width, height, data.data(), false);
+    std::filesystem::remove(path);
+}
+
+CPU_TEST(ExrWriter_Throughput, TAGS("benchmark"))
+{
+    // Stack of 4K float AOVs, similar to what batch renders write per frame.
+    const uint32_t width = 3840;
+    const uint32_t height = 2160;
+    struct Aov
+    {
+        const char* name;
+        TextureChannelFlags channelMask;
+        std::vector<float> data;
+    };
+    std::vector<Aov> aovs = {
+        {"color", TextureChannelFlags::RGBA, createTestImage(width, height, 5)},
+        {"albedo", TextureChannelFlags::RGB, createTestImage(width, height, 6)},
+        {"normal", TextureChannelFlags::RGB, createTestImage(width, height, 7)},
+        {"depth", TextureChannelFlags::Red, createTestImage(width, height, 8)},
+        {"motion", TextureChannelFlags::Red | TextureChannelFlags::Green, createTestImage(width, height, 9)},
+    };
+    std::vector<ExrWriter::Layer> layers;
+    for (const auto& aov : aovs)
+        layers.push_back({aov.name, ResourceFormat::RGBA32Float, aov.channelMask, aov.data.data(), true});
+    const double megabytes = 5.0 * width * height * 4 * sizeof(float) / (1024.0 * 1024.0);
+
+    auto measure = [&](auto func)
+    {
+        auto startTime = CpuTimer::getCurrentTimePoint();
+        func();
+        return megabytes / (CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint()) * 1e-3);
+    };
+
+    // Baseline: the previous FreeImage export, which writes one RGB(A) half-float file per AOV on a single thread.
+    // The data is copied into a bottom-up FreeImage bitmap first, as Bitmap::saveImage used to do.
+    auto writeFreeImage = [&](int flags)
+    {
+        for (const auto& aov : aovs)
+        {
+            const bool hasAlpha = aov.channelMask == TextureChannelFlags::RGBA;
+            const uint32_t channels = hasAlpha ? 4 : 3;
+            FIBITMAP* pImage = FreeImage_AllocateT(hasAlpha ? FIT_RGBAF : FIT_RGBF, width, height);
+            for (uint32_t y = 0; y < height; ++y)
+            {
+                float* pDst = reinterpret_cast<float*>(FreeImage_GetScanLine(pImage, height - y - 1));
+                const float* pSrc = aov.data.data() + y * width * 4;
+                for (uint32_t x = 0; x < width; ++x)
+                    for (uint32_t c = 0; c < channels; ++c)
+                        pDst[x * channels + c] = pSrc[x * 4 + c];
+            }
+            auto path = getTempExrPath();
+            FreeImage_Save(FIF_EXR, pImage, path.string().c_str(), flags);
+            FreeImage_Unload(pImage);
+            std::filesystem::remove(path);
+        }
+    };
+
+    auto path = getTempExrPath();
+    const std::pair<ExrWriter::Compression, int> compressions[] = {
+        {ExrWriter::Compression::Piz, EXR_PIZ},
+        {ExrWriter::Compression::Zip, EXR_ZIP},
+    };
+    for (const auto& [compression, freeImageFlags] : compressions)
+    {
+        double freeImageRate = measure([&]() { writeFreeImage(freeImageFlags); });
+        ExrWriter::Options options;
+        options.compression = compression;
+        double exrWriterRate = measure([&]() { ExrWriter::write(path, width, height, layers, options); });
+        logInfo(
+            "EXR throughput (compression {}): FreeImage {:.0f} MB/s, ExrWriter {:.0f} MB/s ({:.1f}x)",
+            (uint32_t)compression,
+            freeImageRate,
+            exrWriterRate,
+            exrWriterRate / freeImageRate
+        );
+    }
+
+    // DWAA is not supported by FreeImage.
+    ExrWriter::Options options;
+    options.compression = ExrWriter::Compression::Dwaa;
+    double dwaaRate = measure([&]() { ExrWriter::write(path, width, height, layers, options); });
+    logInfo("EXR throughput (compression {}): ExrWriter {:.0f} MB/s", (uint32_t)options.compression, dwaaRate);
+
+    std::filesystem::remove(path);
+}
+} // namespace Falcor
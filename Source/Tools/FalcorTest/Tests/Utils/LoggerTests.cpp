@@ -0,0 +1,214 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Logger.h"
+#include "Utils/Timing/CpuTimer.h"
+#include "Core/Platform/OS.h"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+/// Redirects the log to a temporary file for the lifetime of the object.
+/// The previous logger state is restored on destruction.
+class LogCapture
+{
+public:
+    LogCapture()
+        : mPrevVerbosity(Logger::getVerbosity())
+        , mPrevOutputs(Logger::getOutputs())
+        , mPrevPath(Logger::getLogFilePath())
+        , mPrevAsync(Logger::isAsync())
+        , mPrevQueueCapacity(Logger::getAsyncQueueCapacity())
+        , mPrevOverflowPolicy(Logger::getAsyncOverflowPolicy())
+        , mPath(getTempFilePath())
+    {
+        Logger::setVerbosity(Logger::Level::Info);
+        Logger::setOutputs(Logger::OutputFlags::File);
+        Logger::setLogFilePath(mPath);
+    }
+
+    ~LogCapture()
+    {
+        Logger::setAsync(mPrevAsync, mPrevQueueCapacity, mPrevOverflowPolicy);
+        Logger::setLogFilePath(mPrevPath);
+        Logger::setOutputs(mPrevOutputs);
+        Logger::setVerbosity(mPrevVerbosity);
+        std::filesystem::remove(mPath);
+    }
+
+    std::vector<std::string> readLines() const
+    {
+        Logger::flush();
+        std::vector<std::string> lines;
+        std::ifstream ifs(mPath);
+        std::string line;
+        while (std::getline(ifs, line))
+            lines.push_back(line);
+        return lines;
+    }
+
+private:
+    Logger::Level mPrevVerbosity;
+    Logger::OutputFlags mPrevOutputs;
+    std::filesystem::path mPrevPath;
+    bool mPrevAsync;
+    size_t mPrevQueueCapacity;
+    Logger::OverflowPolicy mPrevOverflowPolicy;
+    std::filesystem::path mPath;
+};
+
+/// Log messages from multiple threads. Returns the throughput in messages/s.
+double logFromThreads(size_t threadCount, size_t messagesPerThread)
+{
+    auto startTime = CpuTimer::getCurrentTimePoint();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back(
+            [i, messagesPerThread]()
+            {
+                for (size_t j = 0; j < messagesPerThread; ++j)
+                    logInfo("LoggerTest thread {} message {}", i, j);
+            }
+        );
+    }
+    for (auto& thread : threads)
+        thread.join();
+    Logger::flush();
+    double seconds = CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint()) * 1e-3;
+    return (threadCount * messagesPerThread) / seconds;
+}
+} // namespace
+
+CPU_TEST(Logger_Async)
+{
+    const size_t kThreadCount = 8;
+    const size_t kMessagesPerThread = 1000;
+
+    LogCapture capture;
+    // Use a small queue to exercise the blocking overflow policy.
+    Logger::setAsync(true, 64, Logger::OverflowPolicy::Block);
+    EXPECT(Logger::isAsync());
+
+    logFromThreads(kThreadCount, kMessagesPerThread);
+
+    auto lines = capture.readLines();
+    ASSERT_EQ(lines.size(), kThreadCount * kMessagesPerThread);
+
+    // Messages from each thread must appear in order.
+    std::vector<size_t> nextMessage(kThreadCount, 0);
+    for (const auto& line : lines)
+    {
+        size_t threadIndex, messageIndex;
+        ASSERT_EQ(std::sscanf(line.c_str(), "(Info) LoggerTest thread %zu message %zu", &threadIndex, &messageIndex), 2);
+        ASSERT_LT(threadIndex, kThreadCount);
+        EXPECT_EQ(messageIndex, nextMessage[threadIndex]);
+        nextMessage[threadIndex] = messageIndex + 1;
+    }
+}
+
+CPU_TEST(Logger_AsyncToggle)
+{
+    const size_t kThreadCount = 4;
+    const size_t kMessagesPerThread = 5000;
+
+    LogCapture capture;
+
+    // Toggle asynchronous logging while other threads are logging. Producers that race with
+    // stopping the writer must fall back to synchronous writes, so no message may be lost.
+    std::atomic<bool> done{false};
+    std::thread toggleThread(
+        [&]()
+        {
+            bool enabled = true;
+            while (!done.load())
+            {
+                Logger::setAsync(enabled, 16, Logger::OverflowPolicy::Block);
+                enabled = !enabled;
+                std::this_thread::yield();
+            }
+        }
+    );
+    logFromThreads(kThreadCount, kMessagesPerThread);
+    done.store(true);
+    toggleThread.join();
+
+    EXPECT_EQ(capture.readLines().size(), kThreadCount * kMessagesPerThread);
+}
+
+CPU_TEST(Logger_AsyncDrop)
+{
+    LogCapture capture;
+    Logger::setAsync(true, 16, Logger::OverflowPolicy::Drop);
+
+    logFromThreads(4, 10000);
+
+    // Dropped messages are reported by a warning.
+    auto lines = capture.readLines();
+    size_t infoCount = 0;
+    size_t warningCount = 0;
+    for (const auto& line : lines)
+    {
+        if (line.rfind("(Info)", 0) == 0)
+            infoCount++;
+        else if (line.rfind("(Warning) Logger dropped", 0) == 0)
+            warningCount++;
+    }
+    EXPECT_LE(infoCount, 40000);
+    EXPECT(infoCount == 40000 || warningCount > 0);
+}
+
+CPU_TEST(Logger_Throughput, TAGS("benchmark"))
+{
+    const size_t kThreadCount = 16;
+    const size_t kMessagesPerThread = 20000;
+
+    double syncRate, asyncRate;
+    {
+        LogCapture capture;
+
+        Logger::setAsync(false);
+        syncRate = logFromThreads(kThreadCount, kMessagesPerThread);
+
+        Logger::setAsync(true);
+        asyncRate = logFromThreads(kThreadCount, kMessagesPerThread);
+
+        EXPECT_EQ(capture.readLines().size(), 2 * kThreadCount * kMessagesPerThread);
+    }
+
+    logInfo("Logger throughput ({} threads): sync {:.0f} messages/s, async {:.0f} messages/s", kThreadCount, syncRate, asyncRate);
+}
+} // namespace Falcor
@@ -28,9 +28,12 @@
 #include "Testing/UnitTest.h"
 #include "Utils/Math/Matrix.h"
 #include "Utils/Math/MatrixJson.h"
+#include "Utils/Timing/CpuTimer.h"
 
 #include <fmt/format.h>
 #include <iostream>
+#include <random>
+#include <vector>
 
 namespace Falcor
 {
@@ -49,6 +52,52 @@ bool almostEqual(math::quat<T> a, math::quat<T> b, T epsilon = T(1e-5))
 
 #define EXPECT_ALMOST_EQ(a, b) EXPECT_TRUE(almostEqual(a, b)) << fmt::format("{} != {}", a, b)
 
+namespace
+{
+/// Compare with a tolerance relative to the magnitude of the expected values.
+template<int R, int C>
+bool almostEqualRel(const math::matrix<float, R, C>& a, const math::matrix<float, R, C>& b, float epsilon = 1e-5f)
+{
+    for (int r = 0; r < R; ++r)
+        for (int c = 0; c < C; ++c)
+            if (std::abs(a[r][c] - b[r][c]) > epsilon * std::max(1.f, std::abs(b[r][c])))
+                return false;
+    return true;
+}
+
+template<int N>
+bool almostEqualRel(const math::vector<float, N>& a, const math::vector<float, N>& b, float epsilon = 1e-5f)
+{
+    return all(abs(a - b) <= epsilon * max(math::vector<float, N>(1.f), abs(b)));
+}
+
+/// Create a random well-conditioned matrix. Affine matrices have (0, 0, 0, 1) as the last row.
+float4x4 createRandomMatrix(std::mt19937& rng, bool affine)
+{
+    std::uniform_real_distribution<float> uniform(-1.f, 1.f);
+    float4x4 m;
+    for (int r = 0; r < 4; ++r)
+        for (int c = 0; c < 4; ++c)
+            m[r][c] = uniform(rng) + (r == c ? 3.f : 0.f);
+    if (affine)
+        m.setRow(3, float4(0.f, 0.f, 0.f, 1.f));
+    return m;
+}
+
+const char* getSIMDBackendName()
+{
+#if FALCOR_MATH_SIMD_AVX2
+    return "AVX2";
+#elif FALCOR_MATH_SIMD_SSE
+    return "SSE";
+#elif FALCOR_MATH_SIMD_NEON
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+} // namespace
+
 CPU_TEST(Matrix_Constructor)
 {
     // Default constructor
@@ -282,6 +331,90 @@ CPU_TEST(Matrix_inverse)
     }
 }
 
+CPU_TEST(Matrix_inverseAffine)
+{
+    float4x4 m = float4x4({2, 0, 0, 1, 0, 4, 0, 2, 0, 0, 8, 3, 0, 0, 0, 1});
+    float4x4 inv = inverseAffine(m);
+    EXPECT_ALMOST_EQ(inv[0], float4(0.5f, 0, 0, -0.5f));
+    EXPECT_ALMOST_EQ(inv[1], float4(0, 0.25f, 0, -0.5f));
+    EXPECT_ALMOST_EQ(inv[2], float4(0, 0, 0.125f, -0.375f));
+    EXPECT_ALMOST_EQ(inv[3], float4(0, 0, 0, 1));
+
+    std::mt19937 rng;
+    for (int i = 0; i < 100; ++i)
+    {
+        float4x4 a = createRandomMatrix(rng, true);
+        EXPECT_TRUE(almostEqualRel(inverseAffine(a), inverse(a)));
+        EXPECT_TRUE(almostEqualRel(math::inverseAffine<float>(a), math::inverse<float>(a)));
+    }
+}
+
+CPU_TEST(Matrix_SIMD)
+{
+    // Compare the float4x4 overloads (SIMD if available) against the scalar templates.
+    std::mt19937 rng;
+    std::uniform_real_distribution<float> uniform(-10.f, 10.f);
+    for (int i = 0; i < 1000; ++i)
+    {
+        const bool affine = (i % 2) == 0;
+        float4x4 a = createRandomMatrix(rng, affine);
+        float4x4 b = createRandomMatrix(rng, affine);
+        float4 v(uniform(rng), uniform(rng), uniform(rng), uniform(rng));
+        float3 p(uniform(rng), uniform(rng), uniform(rng));
+
+        EXPECT_TRUE(almostEqualRel(mul(a, b), math::mul<float, 4, 4, 4>(a, b)));
+        EXPECT_TRUE(almostEqualRel(mul(a, v), math::mul<float, 4, 4>(a, v)));
+        EXPECT_TRUE(almostEqualRel(transformPoint(a, p), math::transformPoint<float>(a, p)));
+        EXPECT_TRUE(almostEqualRel(transformVector(a, p), math::transformVector<float>(a, p)));
+        EXPECT_TRUE((transpose(a) == math::transpose<float, 4, 4>(a)));
+        EXPECT_TRUE(almostEqualRel(inverse(a), math::inverse<float>(a), 1e-4f));
+        if (affine)
+            EXPECT_TRUE(almostEqualRel(inverseAffine(a), math::inverseAffine<float>(a), 1e-4f));
+    }
+}
+
+CPU_TEST(Matrix_Benchmark, TAGS("benchmark"))
+{
+    const size_t count = 100000;
+    const int iterations = 10;
+
+    std::mt19937 rng;
+    std::vector<float4x4> a(count), b(count), result(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        a[i] = createRandomMatrix(rng, true);
+        b[i] = createRandomMatrix(rng, true);
+    }
+
+    auto measure = [&](auto func)
+    {
+        auto startTime = CpuTimer::getCurrentTimePoint();
+        for (int j = 0; j < iterations; ++j)
+            for (size_t i = 0; i < count; ++i)
+                result[i] = func(a[i], b[i]);
+        return CpuTimer::calcDuration(startTime, CpuTimer::getCurrentTimePoint());
+    };
+
+    double mulScalar = measure([](const float4x4& x, const float4x4& y) { return math::mul<float, 4, 4, 4>(x, y); });
+    double mulSIMD = measure([](const float4x4& x, const float4x4& y) { return mul(x, y); });
+    double invScalar = measure([](const float4x4& x, const float4x4&) { return math::transpose<float, 4, 4>(math::inverse<float>(x)); });
+    double invSIMD = measure([](const float4x4& x, const float4x4&) { return transpose(inverse(x)); });
+    double invAffineScalar = measure([](const float4x4& x, const float4x4&) { return math::inverseAffine<float>(x); });
+    double invAffineSIMD = measure([](const float4x4& x, const float4x4&) { return inverseAffine(x); });
+
+    logInfo(
+        "float4x4 x{} ({}): mul {:.1f} -> {:.1f} ms, transpose(inverse) {:.1f} -> {:.1f} ms, inverseAffine {:.1f} -> {:.1f} ms",
+        count * iterations,
+        getSIMDBackendName(),
+        mulScalar,
+        mulSIMD,
+        invScalar,
+        invSIMD,
+        invAffineScalar,
+        invAffineSIMD
+    );
+}
+
 CPU_TEST(Matrix_extractEulerAngleXYZ)
 {
     {
@@ -0,0 +1,199 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Timing/TraceRecorder.h"
+#include "Core/Platform/OS.h"
+
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+#include <map>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+void recordEvents(const std::string& name, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        FALCOR_PROFILE_CPU(name);
+    }
+}
+
+void recordDynamicEvents(const std::vector<std::string>& names, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        FALCOR_PROFILE_CPU(names[i % names.size()]);
+    }
+}
+} // namespace
+
+CPU_TEST(TraceRecorder_InternName)
+{
+    const TraceEventName* pA = TraceRecorder::internName("TraceRecorder_A");
+    const TraceEventName* pB = TraceRecorder::internName("TraceRecorder_B");
+    EXPECT_NE(pA->id, pB->id);
+    EXPECT_EQ(pA, TraceRecorder::internName(std::string("TraceRecorder_A")));
+    EXPECT_EQ(TraceRecorder::getName(pB->id).name, "TraceRecorder_B");
+
+    TraceRecorder::NameCache cache;
+    EXPECT_EQ(&cache.get("TraceRecorder_A"), pA);
+    EXPECT_EQ(&cache.get("TraceRecorder_A"), pA);
+    EXPECT_EQ(&cache.get("TraceRecorder_B"), pB);
+}
+
+CPU_TEST(TraceRecorder_MultiThreaded)
+{
+    const size_t kThreadCount = 8;
+    // Use enough events to span multiple buffer chunks.
+    const size_t kEventsPerThread = 10000;
+
+    TraceRecorder::startTrace();
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kThreadCount; ++i)
+        threads.emplace_back([i, kEventsPerThread]() { recordEvents(fmt::format("TraceRecorder_Thread{}", i), kEventsPerThread); });
+    for (auto& thread : threads)
+        thread.join();
+
+    TraceRecorder::setEnabled(false);
+    auto events = TraceRecorder::collect();
+
+    std::set<uint32_t> threadIds;
+    std::map<uint32_t, size_t> countPerName;
+    for (const auto& event : events)
+    {
+        EXPECT_LE(event.startTime, event.endTime);
+        threadIds.insert(event.threadId);
+        countPerName[event.nameId]++;
+    }
+    EXPECT_EQ(events.size(), kThreadCount * kEventsPerThread);
+    EXPECT_EQ(threadIds.size(), kThreadCount);
+    EXPECT_EQ(countPerName.size(), kThreadCount);
+    for (const auto& [nameId, count] : countPerName)
+        EXPECT_EQ(count, kEventsPerThread);
+
+    // All events were drained.
+    EXPECT(TraceRecorder::collect().empty());
+}
+
+CPU_TEST(TraceRecorder_ChromeTrace)
+{
+    TraceRecorder::startTrace();
+    TraceRecorder::setThreadName("Test \"main\" thread");
+    {
+        FALCOR_PROFILE_CPU("outer");
+        FALCOR_PROFILE_CPU("inner");
+    }
+
+    std::filesystem::path path = getTempFilePath();
+    TraceRecorder::endTrace(path);
+
+    std::ifstream ifs(path);
+    nlohmann::json trace = nlohmann::json::parse(ifs);
+    ifs.close();
+    std::filesystem::remove(path);
+
+    ASSERT(trace.contains("traceEvents"));
+    std::set<std::string> names;
+    bool foundThreadName = false;
+    for (const auto& event : trace["traceEvents"])
+    {
+        if (event["ph"] == "X")
+        {
+            names.insert(event["name"].get<std::string>());
+            EXPECT_GE(event["dur"].get<double>(), 0.0);
+        }
+        else if (event["ph"] == "M" && event["args"]["name"] == "Test \"main\" thread")
+        {
+            foundThreadName = true;
+        }
+    }
+    EXPECT_EQ(names, std::set<std::string>({"outer", "inner"}));
+    EXPECT(foundThreadName);
+}
+
+CPU_TEST(TraceRecorder_Overhead, TAGS("benchmark"))
+{
+    // Budget per scope, including the two clock reads.
+    const double kBudgetNs = 50.0;
+    const size_t kIterations = 1000000;
+
+    // Alternating names as used by per-pass profiler events, which defeat the per-call-site name cache.
+    std::vector<std::string> dynamicNames;
+    for (size_t i = 0; i < 8; ++i)
+        dynamicNames.push_back(fmt::format("TraceRecorder_Pass{}", i));
+
+    auto measure = [&](bool dynamic)
+    {
+        auto start = CpuTimer::getCurrentTimePoint();
+        if (dynamic)
+            recordDynamicEvents(dynamicNames, kIterations);
+        else
+            recordEvents("TraceRecorder_Overhead", kIterations);
+        auto end = CpuTimer::getCurrentTimePoint();
+        return CpuTimer::calcDuration(start, end) * 1e6 / kIterations; // ns per scope
+    };
+
+    // Cost of the two clock reads, logged to help interpret results on machines with slow clocks.
+    auto clockStart = CpuTimer::getCurrentTimePoint();
+    for (size_t i = 0; i < kIterations; ++i)
+        CpuTimer::getCurrentTimePoint();
+    double clockNs = CpuTimer::calcDuration(clockStart, CpuTimer::getCurrentTimePoint()) * 2e6 / kIterations;
+
+    for (bool dynamic : {false, true})
+    {
+        // Warm up the name caches.
+        recordDynamicEvents(dynamicNames, dynamicNames.size());
+
+        TraceRecorder::setEnabled(false);
+        double disabledNs = measure(dynamic);
+        TraceRecorder::startTrace();
+        double enabledNs = measure(dynamic);
+        TraceRecorder::setEnabled(false);
+        size_t eventCount = TraceRecorder::collect().size();
+
+        // Timings depend on the machine and its load, so the budget is only reported, not enforced.
+        EXPECT_EQ(eventCount, kIterations);
+        if (enabledNs >= kBudgetNs || disabledNs >= kBudgetNs)
+            logWarning("TraceRecorder overhead per scope exceeds the budget of {:.1f} ns.", kBudgetNs);
+        logInfo(
+            "TraceRecorder overhead per scope ({} names): {:.1f} ns (disabled: {:.1f} ns, clock reads: {:.1f} ns)",
+            dynamic ? "dynamic" : "static",
+            enabledNs,
+            disabledNs,
+            clockNs
+        );
+    }
+}
+} // namespace Falcor
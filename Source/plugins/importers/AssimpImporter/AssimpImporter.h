@@ -42,8 +42,8 @@ public:
         PluginInfo(
             {"Importer for Assimp supported assets",
              {
-                 "fbx", "gltf", "obj", "dae",  "x",   "md5mesh", "ply", "3ds", "blend", "ase", "ifc", "xgl", "zgl", "dxf", "lwo", "lws",
-                 "lxo", "stl",  "ac",  "ms3d", "cob", "scn",     "3d",  "mdl", "mdl2",  "pk3", "smd", "vta", "raw", "ter", "glb",
+                 "fbx", "obj", "dae", "x",    "md5mesh", "ply", "3ds", "blend", "ase", "ifc", "xgl", "zgl", "dxf", "lwo", "lws",
+                 "lxo", "stl", "ac",  "ms3d", "cob",     "scn", "3d",  "mdl",   "mdl2", "pk3", "smd", "vta", "raw", "ter",
              }}
         )
     );
@@ -0,0 +1,408 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "GLTFAsset.h"
+#include "Utils/StringUtils.h"
+#include "Utils/StringFormatters.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace Falcor
+{
+namespace GLTF
+{
+namespace
+{
+constexpr uint32_t kGLBMagic = 0x46546C67; // "glTF"
+constexpr uint32_t kGLBVersion = 2;
+constexpr uint32_t kChunkTypeJSON = 0x4E4F534A; // "JSON"
+constexpr uint32_t kChunkTypeBIN = 0x004E4942;  // "BIN\0"
+
+uint32_t readU32(const uint8_t* pData)
+{
+    uint32_t value;
+    std::memcpy(&value, pData, sizeof(value));
+    return value;
+}
+
+const json& getArrayElement(const json& j, const char* name, uint32_t index)
+{
+    auto it = j.find(name);
+    FALCOR_CHECK(it != j.end() && it->is_array() && index < it->size(), "Invalid index {} into '{}'.", index, name);
+    return (*it)[index];
+}
+
+template<typename T>
+T getRequired(const json& j, const char* name)
+{
+    auto it = j.find(name);
+    FALCOR_CHECK(it != j.end(), "Missing required property '{}'.", name);
+    if constexpr (std::is_arithmetic_v<T>)
+        FALCOR_CHECK(it->is_number(), "Property '{}' must be a number.", name);
+    else
+        FALCOR_CHECK(it->is_string(), "Property '{}' must be a string.", name);
+    return it->get<T>();
+}
+
+uint32_t getComponentCount(const std::string& type)
+{
+    if (type == "SCALAR")
+        return 1;
+    if (type == "VEC2")
+        return 2;
+    if (type == "VEC3")
+        return 3;
+    if (type == "VEC4" || type == "MAT2")
+        return 4;
+    if (type == "MAT3")
+        return 9;
+    if (type == "MAT4")
+        return 16;
+    FALCOR_THROW("Unknown accessor type '{}'.", type);
+}
+
+template<typename T, typename S>
+T convertComponent(S value, bool normalized)
+{
+    if constexpr (std::is_same_v<T, float> && std::is_integral_v<S>)
+    {
+        if (normalized)
+        {
+            float result = float(value) / float(std::numeric_limits<S>::max());
+            return std::is_signed_v<S> ? std::max(result, -1.f) : result;
+        }
+    }
+    return T(value);
+}
+
+template<typename T, typename S>
+void convertElements(const uint8_t* pSrc, uint32_t stride, bool normalized, uint32_t count, uint32_t componentCount, T* pDst)
+{
+    if constexpr (std::is_same_v<T, S>)
+    {
+        if (stride == sizeof(S) * componentCount)
+        {
+            std::memcpy(pDst, pSrc, size_t(count) * stride);
+            return;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; ++i, pSrc += stride)
+    {
+        for (uint32_t c = 0; c < componentCount; ++c)
+        {
+            S value;
+            std::memcpy(&value, pSrc + c * sizeof(S), sizeof(S));
+            *pDst++ = convertComponent<T>(value, normalized);
+        }
+    }
+}
+
+template<typename T>
+void convertElements(
+    const uint8_t* pSrc,
+    uint32_t stride,
+    ComponentType type,
+    bool normalized,
+    uint32_t count,
+    uint32_t componentCount,
+    T* pDst
+)
+{
+    switch (type)
+    {
+    case ComponentType::Int8:
+        return convertElements<T, int8_t>(pSrc, stride, normalized, count, componentCount, pDst);
+    case ComponentType::UInt8:
+        return convertElements<T, uint8_t>(pSrc, stride, normalized, count, componentCount, pDst);
+    case ComponentType::Int16:
+        return convertElements<T, int16_t>(pSrc, stride, normalized, count, componentCount, pDst);
+    case ComponentType::UInt16:
+        return convertElements<T, uint16_t>(pSrc, stride, normalized, count, componentCount, pDst);
+    case ComponentType::UInt32:
+        return convertElements<T, uint32_t>(pSrc, stride, normalized, count, componentCount, pDst);
+    case ComponentType::Float:
+        return convertElements<T, float>(pSrc, stride, normalized, count, componentCount, pDst);
+    }
+    FALCOR_THROW("Unknown component type {}.", (uint32_t)type);
+}
+} // namespace
+
+uint32_t getComponentSize(ComponentType type)
+{
+    switch (type)
+    {
+    case ComponentType::Int8:
+    case ComponentType::UInt8:
+        return 1;
+    case ComponentType::Int16:
+    case ComponentType::UInt16:
+        return 2;
+    case ComponentType::UInt32:
+    case ComponentType::Float:
+        return 4;
+    }
+    FALCOR_THROW("Unknown component type {}.", (uint32_t)type);
+}
+
+std::unique_ptr<Asset> Asset::createFromFile(const std::filesystem::path& path)
+{
+    auto pFile = std::make_unique<MemoryMappedFile>(path, MemoryMappedFile::kWholeFile, MemoryMappedFile::AccessHint::RandomAccess);
+    FALCOR_CHECK(pFile->isOpen(), "Failed to open '{}'.", path);
+
+    std::unique_ptr<Asset> pAsset(new Asset());
+    pAsset->mBaseDirectory = path.parent_path();
+    pAsset->parse(static_cast<const uint8_t*>(pFile->getData()), pFile->getMappedSize());
+    pAsset->mMappedFiles.push_back(std::move(pFile));
+    pAsset->loadBuffers();
+    return pAsset;
+}
+
+std::unique_ptr<Asset> Asset::createFromMemory(const void* pData, size_t size, const std::filesystem::path& baseDirectory)
+{
+    FALCOR_CHECK(pData != nullptr && size > 0, "Invalid buffer.");
+
+    std::unique_ptr<Asset> pAsset(new Asset());
+    pAsset->mBaseDirectory = baseDirectory;
+    pAsset->parse(static_cast<const uint8_t*>(pData), size);
+    pAsset->loadBuffers();
+    return pAsset;
+}
+
+Accessor Asset::getAccessor(uint32_t index) const
+{
+    const json& accessor = getArrayElement(mJson, "accessors", index);
+
+    Accessor result;
+    result.count = getRequired<uint32_t>(accessor, "count");
+    result.componentType = ComponentType(getRequired<uint32_t>(accessor, "componentType"));
+    result.componentCount = getComponentCount(getRequired<std::string>(accessor, "type"));
+    result.normalized = accessor.value("normalized", false);
+    result.sparse = accessor.contains("sparse");
+
+    const uint32_t elementSize = result.getElementSize();
+    result.stride = elementSize;
+
+    if (auto it = accessor.find("bufferView"); it != accessor.end())
+    {
+        const uint32_t viewIndex = it->get<uint32_t>();
+        fstd::span<const uint8_t> viewData = getBufferViewData(viewIndex);
+        const uint32_t byteStride = mJson["bufferViews"][viewIndex].value("byteStride", 0u);
+        if (byteStride != 0)
+        {
+            FALCOR_CHECK(byteStride >= elementSize, "Accessor {} has a byte stride smaller than its element size.", index);
+            result.stride = byteStride;
+        }
+
+        const size_t byteOffset = accessor.value("byteOffset", size_t(0));
+        if (result.count > 0)
+        {
+            const size_t byteEnd = byteOffset + size_t(result.stride) * (result.count - 1) + elementSize;
+            FALCOR_CHECK(byteEnd <= viewData.size(), "Accessor {} exceeds its buffer view.", index);
+        }
+        result.pData = viewData.data() + byteOffset;
+    }
+
+    return result;
+}
+
+fstd::span<const uint8_t> Asset::getBufferViewData(uint32_t index) const
+{
+    const json& view = getArrayElement(mJson, "bufferViews", index);
+    const uint32_t bufferIndex = getRequired<uint32_t>(view, "buffer");
+    FALCOR_CHECK(bufferIndex < mBuffers.size(), "Buffer view {} references invalid buffer {}.", index, bufferIndex);
+
+    const size_t byteOffset = view.value("byteOffset", size_t(0));
+    const size_t byteLength = getRequired<size_t>(view, "byteLength");
+    const fstd::span<const uint8_t>& buffer = mBuffers[bufferIndex];
+    FALCOR_CHECK(byteOffset + byteLength <= buffer.size(), "Buffer view {} exceeds its buffer.", index);
+    return fstd::span<const uint8_t>(buffer.data() + byteOffset, byteLength);
+}
+
+void Asset::parse(const uint8_t* pData, size_t size)
+{
+    if (size >= 12 && readU32(pData) == kGLBMagic)
+    {
+        // Binary glTF: 12 byte header followed by a JSON chunk and an optional binary chunk.
+        const uint32_t version = readU32(pData + 4);
+        FALCOR_CHECK(version == kGLBVersion, "Unsupported GLB version {}.", version);
+        const size_t length = readU32(pData + 8);
+        FALCOR_CHECK(length <= size, "GLB length exceeds data size.");
+
+        bool hasJSON = false;
+        size_t offset = 12;
+        while (offset + 8 <= length)
+        {
+            const size_t chunkLength = readU32(pData + offset);
+            const uint32_t chunkType = readU32(pData + offset + 4);
+            offset += 8;
+            FALCOR_CHECK(chunkLength <= length - offset, "GLB chunk exceeds data size.");
+
+            if (chunkType == kChunkTypeJSON && !hasJSON)
+            {
+                mJson = json::parse(pData + offset, pData + offset + chunkLength, nullptr, false);
+                hasJSON = true;
+            }
+            else if (chunkType == kChunkTypeBIN && mBinaryChunk.empty())
+            {
+                mBinaryChunk = fstd::span<const uint8_t>(pData + offset, chunkLength);
+            }
+            // Unknown chunks must be ignored.
+            offset += (chunkLength + 3) & ~size_t(3);
+        }
+        FALCOR_CHECK(hasJSON, "GLB data has no JSON chunk.");
+    }
+    else
+    {
+        mJson = json::parse(pData, pData + size, nullptr, false);
+    }
+
+    FALCOR_CHECK(!mJson.is_discarded() && mJson.is_object(), "Failed to parse glTF JSON.");
+
+    auto asset = mJson.find("asset");
+    FALCOR_CHECK(asset != mJson.end() && asset->is_object(), "Missing 'asset' property.");
+    const std::string version = asset->value("version", "");
+    FALCOR_CHECK(version.size() >= 1 && version[0] == '2', "Unsupported glTF version '{}'.", version);
+}
+
+void Asset::loadBuffers()
+{
+    auto buffers = mJson.find("buffers");
+    if (buffers == mJson.end())
+        return;
+    FALCOR_CHECK(buffers->is_array(), "Property 'buffers' must be an array.");
+
+    for (size_t i = 0; i < buffers->size(); ++i)
+    {
+        const json& buffer = (*buffers)[i];
+        const size_t byteLength = getRequired<size_t>(buffer, "byteLength");
+
+        fstd::span<const uint8_t> data;
+        auto uri = buffer.find("uri");
+        if (uri == buffer.end())
+        {
+            // Only the first buffer of a GLB file may omit the URI, it refers to the binary chunk.
+            FALCOR_CHECK(i == 0 && !mBinaryChunk.empty(), "Buffer {} has no URI.", i);
+            data = mBinaryChunk;
+        }
+        else if (const std::string& uriString = uri->get_ref<const std::string&>(); hasPrefix(uriString, "data:"))
+        {
+            const size_t separator = uriString.find(',');
+            FALCOR_CHECK(
+                separator != std::string::npos && hasSuffix(uriString.substr(0, separator), ";base64"),
+                "Buffer {} has an unsupported data URI.",
+                i
+            );
+            mDecodedBuffers.push_back(decodeBase64(uriString.substr(separator + 1)));
+            data = fstd::span<const uint8_t>(mDecodedBuffers.back().data(), mDecodedBuffers.back().size());
+        }
+        else
+        {
+            const std::filesystem::path path = mBaseDirectory / decodeURI(uriString);
+            auto pFile = std::make_unique<MemoryMappedFile>(path, MemoryMappedFile::kWholeFile, MemoryMappedFile::AccessHint::RandomAccess);
+            FALCOR_CHECK(pFile->isOpen(), "Failed to open buffer '{}'.", path);
+            data = fstd::span<const uint8_t>(static_cast<const uint8_t*>(pFile->getData()), pFile->getMappedSize());
+            mMappedFiles.push_back(std::move(pFile));
+        }
+
+        FALCOR_CHECK(data.size() >= byteLength, "Buffer {} is smaller than its byte length.", i);
+        mBuffers.push_back(fstd::span<const uint8_t>(data.data(), byteLength));
+    }
+}
+
+template<typename T>
+void Asset::readComponentsImpl(uint32_t index, T* pDst, uint32_t componentCount) const
+{
+    const Accessor accessor = getAccessor(index);
+    FALCOR_CHECK(
+        accessor.componentCount == componentCount,
+        "Accessor {} has {} components, expected {}.",
+        index,
+        accessor.componentCount,
+        componentCount
+    );
+
+    if (accessor.pData)
+        convertElements(accessor.pData, accessor.stride, accessor.componentType, accessor.normalized, accessor.count, componentCount, pDst);
+    else
+        std::fill(pDst, pDst + size_t(accessor.count) * componentCount, T(0));
+
+    if (!accessor.sparse)
+        return;
+
+    // Apply sparse substitutions.
+    const json& sparse = mJson["accessors"][index]["sparse"];
+    const uint32_t sparseCount = getRequired<uint32_t>(sparse, "count");
+    FALCOR_CHECK(sparse.contains("indices") && sparse.contains("values"), "Accessor {} has invalid sparse data.", index);
+    const json& indices = sparse["indices"];
+    const json& values = sparse["values"];
+
+    const ComponentType indexType = ComponentType(getRequired<uint32_t>(indices, "componentType"));
+    const uint32_t indexSize = getComponentSize(indexType);
+    const uint32_t elementSize = accessor.getElementSize();
+
+    fstd::span<const uint8_t> indexData = getBufferViewData(getRequired<uint32_t>(indices, "bufferView"));
+    fstd::span<const uint8_t> valueData = getBufferViewData(getRequired<uint32_t>(values, "bufferView"));
+    const size_t indexOffset = indices.value("byteOffset", size_t(0));
+    const size_t valueOffset = values.value("byteOffset", size_t(0));
+    FALCOR_CHECK(indexOffset + size_t(indexSize) * sparseCount <= indexData.size(), "Accessor {} has invalid sparse indices.", index);
+    FALCOR_CHECK(valueOffset + size_t(elementSize) * sparseCount <= valueData.size(), "Accessor {} has invalid sparse values.", index);
+
+    std::vector<uint32_t> sparseIndices(sparseCount);
+    convertElements(indexData.data() + indexOffset, indexSize, indexType, false, sparseCount, 1, sparseIndices.data());
+    std::vector<T> sparseValues(size_t(sparseCount) * componentCount);
+    convertElements(
+        valueData.data() + valueOffset,
+        elementSize,
+        accessor.componentType,
+        accessor.normalized,
+        sparseCount,
+        componentCount,
+        sparseValues.data()
+    );
+
+    for (uint32_t i = 0; i < sparseCount; ++i)
+    {
+        FALCOR_CHECK(sparseIndices[i] < accessor.count, "Accessor {} has an out of range sparse index.", index);
+        std::copy_n(sparseValues.data() + size_t(i) * componentCount, componentCount, pDst + size_t(sparseIndices[i]) * componentCount);
+    }
+}
+
+void Asset::readComponents(uint32_t index, float* pDst, uint32_t componentCount) const
+{
+    readComponentsImpl(index, pDst, componentCount);
+}
+
+void Asset::readComponents(uint32_t index, uint32_t* pDst, uint32_t componentCount) const
+{
+    readComponentsImpl(index, pDst, componentCount);
+}
+
+} // namespace GLTF
+
+} // namespace Falcor
@@ -0,0 +1,205 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Error.h"
+#include "Core/Platform/MemoryMappedFile.h"
+#include "Utils/Math/Vector.h"
+#include <fstd/span.h>
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Falcor
+{
+namespace GLTF
+{
+using json = nlohmann::json;
+
+/// Accessor component types, values match the glTF specification.
+enum class ComponentType : uint32_t
+{
+    Int8 = 5120,
+    UInt8 = 5121,
+    Int16 = 5122,
+    UInt16 = 5123,
+    UInt32 = 5125,
+    Float = 5126,
+};
+
+/// Get the size of a component type in bytes. Throws a RuntimeError for unknown types.
+uint32_t getComponentSize(ComponentType type);
+
+/**
+ * Resolved accessor, describing where the elements of an accessor are stored.
+ */
+struct Accessor
+{
+    const uint8_t* pData = nullptr; ///< Pointer to the first element, or nullptr if there is no buffer view (all elements are zero).
+    uint32_t count = 0;             ///< Number of elements.
+    uint32_t stride = 0;            ///< Byte stride between elements.
+    ComponentType componentType = ComponentType::Float;
+    uint32_t componentCount = 0; ///< Number of components per element (1 for SCALAR, 2 for VEC2 etc.).
+    bool normalized = false;
+    bool sparse = false; ///< True if the accessor has sparse substitutions (these are not reflected in `pData`).
+
+    uint32_t getElementSize() const { return getComponentSize(componentType) * componentCount; }
+};
+
+namespace detail
+{
+template<typename T>
+struct ElementTraits
+{
+    using Scalar = T;
+    static constexpr uint32_t kComponentCount = 1;
+};
+
+template<typename T, int N>
+struct ElementTraits<math::vector<T, N>>
+{
+    using Scalar = T;
+    static constexpr uint32_t kComponentCount = N;
+};
+
+template<typename T>
+constexpr ComponentType getComponentType()
+{
+    if constexpr (std::is_same_v<T, float>)
+        return ComponentType::Float;
+    else if constexpr (std::is_same_v<T, uint32_t>)
+        return ComponentType::UInt32;
+    else if constexpr (std::is_same_v<T, uint16_t>)
+        return ComponentType::UInt16;
+    else if constexpr (std::is_same_v<T, uint8_t>)
+        return ComponentType::UInt8;
+    else if constexpr (std::is_same_v<T, int16_t>)
+        return ComponentType::Int16;
+    else
+    {
+        static_assert(std::is_same_v<T, int8_t>, "Unsupported component type");
+        return ComponentType::Int8;
+    }
+}
+} // namespace detail
+
+/**
+ * Parsed glTF 2.0 asset (`.gltf` or `.glb`).
+ *
+ * The asset holds the JSON document and the binary buffers. Buffers stored in external files and the binary chunk
+ * of `.glb` files are memory-mapped and accessor data is referenced in place whenever possible.
+ * All accessor functions are const and can be called concurrently.
+ */
+class Asset
+{
+public:
+    /**
+     * Load an asset from a `.gltf` or `.glb` file. Throws a RuntimeError if the file is invalid.
+     */
+    static std::unique_ptr<Asset> createFromFile(const std::filesystem::path& path);
+
+    /**
+     * Load an asset from memory. The memory must stay valid for the lifetime of the asset.
+     * @param[in] pData Pointer to the `.gltf` or `.glb` file contents.
+     * @param[in] size Size of the data in bytes.
+     * @param[in] baseDirectory Directory used for resolving relative buffer URIs.
+     * @return The asset. Throws a RuntimeError if the data is invalid.
+     */
+    static std::unique_ptr<Asset> createFromMemory(const void* pData, size_t size, const std::filesystem::path& baseDirectory);
+
+    const json& getJson() const { return mJson; }
+
+    const std::filesystem::path& getBaseDirectory() const { return mBaseDirectory; }
+
+    /// Resolve an accessor. Throws a RuntimeError if the accessor references data outside of its buffer view.
+    Accessor getAccessor(uint32_t index) const;
+
+    /// Get the data of a buffer view.
+    fstd::span<const uint8_t> getBufferViewData(uint32_t index) const;
+
+    /**
+     * Get a strided pointer to the accessor elements if they can be used in place without conversion.
+     * @param[in] index Accessor index.
+     * @param[out] stride Byte stride between elements.
+     * @return Pointer to the first element, or nullptr if the data needs to be converted (use `read` instead).
+     */
+    template<typename T>
+    const T* getInPlaceData(uint32_t index, uint32_t& stride) const
+    {
+        using Traits = detail::ElementTraits<T>;
+        using Scalar = typename Traits::Scalar;
+        Accessor accessor = getAccessor(index);
+        if (!accessor.pData || accessor.sparse || accessor.normalized)
+            return nullptr;
+        if (accessor.componentType != detail::getComponentType<Scalar>() || accessor.componentCount != Traits::kComponentCount)
+            return nullptr;
+        if (reinterpret_cast<uintptr_t>(accessor.pData) % alignof(Scalar) != 0 || accessor.stride % alignof(Scalar) != 0)
+            return nullptr;
+        stride = accessor.stride;
+        return reinterpret_cast<const T*>(accessor.pData);
+    }
+
+    /**
+     * Read the accessor elements into a tightly packed array.
+     * Components are converted to the destination type, normalized integers are mapped to [0,1] or [-1,1] and sparse
+     * substitutions are applied. Throws a RuntimeError if the number of components does not match.
+     */
+    template<typename T>
+    std::vector<T> read(uint32_t index) const
+    {
+        using Traits = detail::ElementTraits<T>;
+        using Scalar = typename Traits::Scalar;
+        static_assert(std::is_same_v<Scalar, float> || std::is_same_v<Scalar, uint32_t>, "Only float and uint32_t components can be read");
+        static_assert(sizeof(T) == sizeof(Scalar) * Traits::kComponentCount);
+        std::vector<T> result(getAccessor(index).count);
+        readComponents(index, reinterpret_cast<Scalar*>(result.data()), Traits::kComponentCount);
+        return result;
+    }
+
+private:
+    Asset() = default;
+
+    void parse(const uint8_t* pData, size_t size);
+    void loadBuffers();
+    void readComponents(uint32_t index, float* pDst, uint32_t componentCount) const;
+    void readComponents(uint32_t index, uint32_t* pDst, uint32_t componentCount) const;
+    template<typename T>
+    void readComponentsImpl(uint32_t index, T* pDst, uint32_t componentCount) const;
+
+    json mJson;
+    std::filesystem::path mBaseDirectory;
+    fstd::span<const uint8_t> mBinaryChunk; ///< Binary chunk of a `.glb` file.
+    std::vector<std::unique_ptr<MemoryMappedFile>> mMappedFiles;
+    std::vector<std::vector<uint8_t>> mDecodedBuffers; ///< Buffers decoded from data URIs.
+    std::vector<fstd::span<const uint8_t>> mBuffers;
+};
+
+} // namespace GLTF
+
+} // namespace Falcor
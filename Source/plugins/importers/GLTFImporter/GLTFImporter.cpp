@@ -0,0 +1,888 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "GLTFImporter.h"
+#include "GLTFAsset.h"
+#include "Core/Error.h"
+#include "Core/API/Device.h"
+#include "Core/Platform/OS.h"
+#include "Utils/CryptoUtils.h"
+#include "Utils/Logger.h"
+#include "Utils/StringUtils.h"
+#include "Utils/StringFormatters.h"
+#include "Utils/NumericRange.h"
+#include "Utils/Timing/TimeReport.h"
+#include "Utils/Math/FalcorMath.h"
+#include "Scene/Importer.h"
+#include "Scene/SceneBuilder.h"
+#include "Scene/Transform.h"
+#include "Scene/Camera/Camera.h"
+#include "Scene/Lights/Light.h"
+#include "Scene/Material/StandardMaterial.h"
+
+#include <exception>
+#include <execution>
+#include <fstream>
+#include <numeric>
+#include <optional>
+#include <set>
+
+namespace Falcor
+{
+
+namespace
+{
+using GLTF::json;
+
+/// Extensions that are handled by this importer. Assets that require any other extension are imported through Assimp.
+const std::set<std::string> kSupportedExtensions = {
+    "KHR_lights_punctual",
+    "KHR_materials_emissive_strength",
+    "KHR_materials_ior",
+    "KHR_materials_transmission",
+    "KHR_texture_transform",
+};
+
+/// Primitive modes, values match the glTF specification.
+enum class PrimitiveMode : uint32_t
+{
+    Points = 0,
+    Lines = 1,
+    LineLoop = 2,
+    LineStrip = 3,
+    Triangles = 4,
+    TriangleStrip = 5,
+    TriangleFan = 6,
+};
+
+struct PrimitiveDesc
+{
+    std::string name;
+    const json* pPrimitive = nullptr;
+    ref<Material> pMaterial;
+    PrimitiveMode mode = PrimitiveMode::Triangles;
+};
+
+/**
+ * Temporary directory for the images embedded in an asset.
+ * Embedded images are written to files so they can be loaded by the asynchronous texture loader like external images.
+ * The directory is created on first use and removed with its contents once the material textures have been loaded.
+ */
+class EmbeddedImageDirectory
+{
+public:
+    explicit EmbeddedImageDirectory(SceneBuilder& builder) : mBuilder(builder) {}
+
+    ~EmbeddedImageDirectory()
+    {
+        if (mPath.empty())
+            return;
+
+        // The texture loader reads the files asynchronously, wait for it before removing them.
+        try
+        {
+            mBuilder.waitForMaterialTextureLoading();
+        }
+        catch (const std::exception& e)
+        {
+            logWarning("GLTFImporter: Failed to load embedded images: {}", e.what());
+        }
+        std::error_code ec;
+        std::filesystem::remove_all(mPath, ec);
+    }
+
+    EmbeddedImageDirectory(const EmbeddedImageDirectory&) = delete;
+    EmbeddedImageDirectory& operator=(const EmbeddedImageDirectory&) = delete;
+
+    /**
+     * Write embedded image data to a file in the directory.
+     * Files are named after the hash of their contents, so identical images share a file.
+     */
+    std::filesystem::path writeImage(fstd::span<const uint8_t> data, const std::string& mimeType)
+    {
+        std::string extension = "png";
+        if (mimeType == "image/jpeg" || (data.size() >= 2 && data[0] == 0xff && data[1] == 0xd8))
+            extension = "jpg";
+
+        if (mPath.empty())
+        {
+            mPath = getTempFilePath();
+            std::filesystem::create_directories(mPath);
+        }
+
+        const std::string hash = SHA1::toString(SHA1::compute(data.data(), data.size()));
+        const std::filesystem::path path = mPath / fmt::format("{}.{}", hash, extension);
+        if (std::filesystem::exists(path))
+            return path;
+
+        std::ofstream stream(path, std::ios::binary);
+        stream.write(reinterpret_cast<const char*>(data.data()), data.size());
+        FALCOR_CHECK(stream.good(), "Failed to write image '{}'.", path);
+        return path;
+    }
+
+private:
+    SceneBuilder& mBuilder;
+    std::filesystem::path mPath;
+};
+
+struct ImporterData
+{
+    ImporterData(const std::filesystem::path& path, const GLTF::Asset& asset, SceneBuilder& builder)
+        : path(path), asset(asset), gltf(asset.getJson()), builder(builder), embeddedImages(builder)
+    {}
+
+    const std::filesystem::path& path;
+    const GLTF::Asset& asset;
+    const json& gltf; ///< Root of the glTF document.
+    SceneBuilder& builder;
+    EmbeddedImageDirectory embeddedImages;
+
+    std::vector<ref<Material>> materials;
+    ref<Material> pDefaultMaterial;
+    std::map<uint32_t, std::filesystem::path> imagePaths; ///< Resolved paths of the images that are in use.
+    std::vector<std::vector<MeshID>> meshes;              ///< Falcor meshes (one per primitive) of every glTF mesh in use.
+    std::set<std::string> warnings;
+
+    void logWarningOnce(const std::string& message)
+    {
+        if (warnings.insert(message).second)
+            logWarning("GLTFImporter: {}", message);
+    }
+
+    const json& getArray(const char* name) const
+    {
+        static const json kEmptyArray = json::array();
+        auto it = gltf.find(name);
+        return it != gltf.end() && it->is_array() ? *it : kEmptyArray;
+    }
+};
+
+template<typename T>
+T getVector(const json& j, const char* name, const T& defaultValue)
+{
+    auto it = j.find(name);
+    if (it == j.end())
+        return defaultValue;
+    FALCOR_CHECK(it->is_array() && it->size() == T::dimension, "Property '{}' must be an array of {} numbers.", name, T::dimension);
+    T result;
+    for (int i = 0; i < T::dimension; ++i)
+        result[i] = (*it)[i].template get<float>();
+    return result;
+}
+
+bool hasElements(const json& j, const char* name)
+{
+    auto it = j.find(name);
+    return it != j.end() && it->is_array() && !it->empty();
+}
+
+/**
+ * Check if the asset needs features that are not supported by this importer.
+ * @return Description of the first unsupported feature, or an empty string if the asset is supported.
+ */
+std::string findUnsupportedFeature(const json& j)
+{
+    if (hasElements(j, "skins"))
+        return "skinning";
+    if (hasElements(j, "animations"))
+        return "animations";
+    if (auto it = j.find("extensionsRequired"); it != j.end() && it->is_array())
+    {
+        for (const auto& extension : *it)
+        {
+            std::string name = extension.get<std::string>();
+            if (kSupportedExtensions.count(name) == 0)
+                return fmt::format("required extension '{}'", name);
+        }
+    }
+    return {};
+}
+
+std::filesystem::path getImagePath(ImporterData& data, uint32_t imageIndex)
+{
+    if (auto it = data.imagePaths.find(imageIndex); it != data.imagePaths.end())
+        return it->second;
+
+    const auto& images = data.getArray("images");
+    FALCOR_CHECK(imageIndex < images.size(), "Invalid image index {}.", imageIndex);
+    const json& image = images[imageIndex];
+    const std::string mimeType = image.value("mimeType", "");
+
+    std::filesystem::path path;
+    if (auto bufferView = image.find("bufferView"); bufferView != image.end())
+    {
+        path = data.embeddedImages.writeImage(data.asset.getBufferViewData(bufferView->get<uint32_t>()), mimeType);
+    }
+    else if (auto uri = image.find("uri"); uri != image.end())
+    {
+        const std::string uriString = uri->get<std::string>();
+        if (hasPrefix(uriString, "data:"))
+        {
+            const size_t separator = uriString.find(',');
+            FALCOR_CHECK(
+                separator != std::string::npos && hasSuffix(uriString.substr(0, separator), ";base64"),
+                "Image {} has an unsupported data URI.",
+                imageIndex
+            );
+            std::vector<uint8_t> bytes = decodeBase64(uriString.substr(separator + 1));
+            path = data.embeddedImages.writeImage(fstd::span<const uint8_t>(bytes.data(), bytes.size()), uriString.substr(5, separator - 12));
+        }
+        else
+        {
+            path = data.asset.getBaseDirectory() / decodeURI(uriString);
+        }
+    }
+
+    data.imagePaths[imageIndex] = path;
+    return path;
+}
+
+void loadTexture(ImporterData& data, const ref<Material>& pMaterial, const json& parent, const char* name, Material::TextureSlot slot)
+{
+    auto it = parent.find(name);
+    if (it == parent.end())
+        return;
+    const json& textureInfo = *it;
+
+    if (textureInfo.value("texCoord", 0u) != 0)
+        data.logWarningOnce(fmt::format("Material '{}' uses a texture coordinate set other than 0, ignoring.", pMaterial->getName()));
+    if (auto extensions = textureInfo.find("extensions"); extensions != textureInfo.end() && extensions->contains("KHR_texture_transform"))
+        data.logWarningOnce(fmt::format("Material '{}' uses KHR_texture_transform, which is ignored.", pMaterial->getName()));
+
+    const auto& textures = data.getArray("textures");
+    const uint32_t textureIndex = textureInfo.value("index", ~0u);
+    FALCOR_CHECK(textureIndex < textures.size(), "Material '{}' references invalid texture {}.", pMaterial->getName(), textureIndex);
+
+    auto source = textures[textureIndex].find("source");
+    if (source == textures[textureIndex].end())
+    {
+        data.logWarningOnce(fmt::format("Texture {} has no supported image source, ignoring.", textureIndex));
+        return;
+    }
+
+    std::filesystem::path path = getImagePath(data, source->get<uint32_t>());
+    if (!path.empty())
+        data.builder.loadMaterialTexture(pMaterial, slot, path);
+}
+
+void createMaterials(ImporterData& data)
+{
+    const auto& materials = data.getArray("materials");
+    data.materials.reserve(materials.size());
+
+    for (size_t i = 0; i < materials.size(); ++i)
+    {
+        const json& material = materials[i];
+        const std::string name = material.value("name", fmt::format("Material{}", i));
+        ref<StandardMaterial> pMaterial = StandardMaterial::create(data.builder.getDevice(), name, ShadingModel::MetalRough);
+
+        // Metallic-roughness parameters. The metallic-roughness texture stores roughness in G and metallic in B,
+        // which matches the layout of the specular texture in the MetalRough shading model.
+        float4 baseColor = float4(1.f);
+        float metallic = 1.f;
+        float roughness = 1.f;
+        if (auto pbr = material.find("pbrMetallicRoughness"); pbr != material.end())
+        {
+            baseColor = getVector(*pbr, "baseColorFactor", baseColor);
+            metallic = pbr->value("metallicFactor", metallic);
+            roughness = pbr->value("roughnessFactor", roughness);
+            loadTexture(data, pMaterial, *pbr, "baseColorTexture", Material::TextureSlot::BaseColor);
+            loadTexture(data, pMaterial, *pbr, "metallicRoughnessTexture", Material::TextureSlot::Specular);
+        }
+        pMaterial->setBaseColor(baseColor);
+        pMaterial->setMetallic(metallic);
+        pMaterial->setRoughness(roughness);
+
+        loadTexture(data, pMaterial, material, "normalTexture", Material::TextureSlot::Normal);
+        loadTexture(data, pMaterial, material, "emissiveTexture", Material::TextureSlot::Emissive);
+        pMaterial->setEmissiveColor(getVector(material, "emissiveFactor", float3(0.f)));
+        pMaterial->setDoubleSided(material.value("doubleSided", false));
+
+        const std::string alphaMode = material.value("alphaMode", "OPAQUE");
+        if (alphaMode == "OPAQUE")
+        {
+            pMaterial->setAlphaMode(AlphaMode::Opaque);
+        }
+        else
+        {
+            if (alphaMode == "BLEND")
+                data.logWarningOnce("Alpha blending is not supported, using alpha masking instead.");
+            pMaterial->setAlphaMode(AlphaMode::Mask);
+            pMaterial->setAlphaThreshold(material.value("alphaCutoff", 0.5f));
+        }
+
+        if (auto extensions = material.find("extensions"); extensions != material.end())
+        {
+            if (auto it = extensions->find("KHR_materials_emissive_strength"); it != extensions->end())
+                pMaterial->setEmissiveFactor(it->value("emissiveStrength", 1.f));
+            if (auto it = extensions->find("KHR_materials_ior"); it != extensions->end())
+                pMaterial->setIndexOfRefraction(it->value("ior", 1.5f));
+            if (auto it = extensions->find("KHR_materials_transmission"); it != extensions->end())
+            {
+                pMaterial->setSpecularTransmission(it->value("transmissionFactor", 0.f));
+                if (it->contains("transmissionTexture"))
+                    data.logWarningOnce("Transmission textures are not supported, using the transmission factor only.");
+            }
+        }
+
+        data.materials.push_back(pMaterial);
+    }
+}
+
+const ref<Material>& getDefaultMaterial(ImporterData& data)
+{
+    if (!data.pDefaultMaterial)
+        data.pDefaultMaterial = StandardMaterial::create(data.builder.getDevice(), "Default", ShadingModel::MetalRough);
+    return data.pDefaultMaterial;
+}
+
+/**
+ * Reference accessor data in place if its layout allows it, otherwise convert it into `storage`.
+ * @return Number of elements.
+ */
+template<typename T>
+uint32_t setAttribute(
+    const GLTF::Asset& asset,
+    uint32_t accessorIndex,
+    SceneBuilder::Mesh::Attribute<T>& attribute,
+    std::vector<T>& storage
+)
+{
+    uint32_t stride = 0;
+    if (const T* pData = asset.getInPlaceData<T>(accessorIndex, stride))
+    {
+        attribute.pData = pData;
+        attribute.stride = stride == sizeof(T) ? 0 : stride;
+    }
+    else
+    {
+        storage = asset.read<T>(accessorIndex);
+        attribute.pData = storage.data();
+        attribute.stride = 0;
+    }
+    attribute.frequency = SceneBuilder::Mesh::AttributeFrequency::Vertex;
+    return asset.getAccessor(accessorIndex).count;
+}
+
+/// Convert triangle strips and fans to triangle lists.
+std::vector<uint32_t> triangulate(const uint32_t* pIndices, uint32_t indexCount, PrimitiveMode mode)
+{
+    std::vector<uint32_t> triangles;
+    if (indexCount < 3)
+        return triangles;
+    triangles.reserve((indexCount - 2) * 3);
+    for (uint32_t i = 0; i + 2 < indexCount; ++i)
+    {
+        if (mode == PrimitiveMode::TriangleStrip)
+        {
+            // Every other triangle is flipped to preserve the winding order.
+            triangles.push_back(pIndices[i]);
+            triangles.push_back(pIndices[i + 1 + i % 2]);
+            triangles.push_back(pIndices[i + 2 - i % 2]);
+        }
+        else
+        {
+            triangles.push_back(pIndices[i + 1]);
+            triangles.push_back(pIndices[i + 2]);
+            triangles.push_back(pIndices[0]);
+        }
+    }
+    return triangles;
+}
+
+SceneBuilder::ProcessedMesh processPrimitive(const ImporterData& data, const PrimitiveDesc& desc)
+{
+    const GLTF::Asset& asset = data.asset;
+    const json& primitive = *desc.pPrimitive;
+    const json& attributes = primitive["attributes"];
+    auto getAccessorIndex = [&](const char* name) -> std::optional<uint32_t>
+    {
+        auto it = attributes.find(name);
+        return it != attributes.end() ? std::optional<uint32_t>(it->get<uint32_t>()) : std::nullopt;
+    };
+
+    SceneBuilder::Mesh mesh;
+    mesh.name = desc.name;
+    mesh.topology = Vao::Topology::TriangleList;
+    mesh.pMaterial = desc.pMaterial;
+
+    // Storage for attributes that can't be used in place.
+    std::vector<float3> positions, normals;
+    std::vector<float4> tangents;
+    std::vector<float2> texCrds;
+    std::vector<uint32_t> indices;
+
+    mesh.vertexCount = setAttribute(asset, *getAccessorIndex("POSITION"), mesh.positions, positions);
+
+    if (auto index = getAccessorIndex("NORMAL"))
+    {
+        uint32_t count = setAttribute(asset, *index, mesh.normals, normals);
+        FALCOR_CHECK(count == mesh.vertexCount, "Mesh '{}' has an invalid number of normals.", desc.name);
+    }
+
+    if (auto index = getAccessorIndex("TEXCOORD_0"))
+    {
+        uint32_t count = setAttribute(asset, *index, mesh.texCrds, texCrds);
+        FALCOR_CHECK(count == mesh.vertexCount, "Mesh '{}' has an invalid number of texture coordinates.", desc.name);
+    }
+
+    // Tangents are only used if requested, otherwise the tangent space is generated by the scene builder.
+    auto tangentIndex = getAccessorIndex("TANGENT");
+    if (tangentIndex && is_set(data.builder.getFlags(), SceneBuilder::Flags::UseOriginalTangentSpace))
+    {
+        uint32_t count = setAttribute(asset, *tangentIndex, mesh.tangents, tangents);
+        FALCOR_CHECK(count == mesh.vertexCount, "Mesh '{}' has an invalid number of tangents.", desc.name);
+        mesh.useOriginalTangentSpace = true;
+    }
+
+    // Indices. Non-indexed primitives use sequential indices.
+    if (auto it = primitive.find("indices"); it == primitive.end())
+    {
+        indices.resize(mesh.vertexCount);
+        std::iota(indices.begin(), indices.end(), 0u);
+    }
+    else
+    {
+        const uint32_t accessorIndex = it->get<uint32_t>();
+        uint32_t stride = 0;
+        const uint32_t* pIndices = asset.getInPlaceData<uint32_t>(accessorIndex, stride);
+        if (pIndices && stride == sizeof(uint32_t))
+        {
+            mesh.pIndices = pIndices;
+            mesh.indexCount = asset.getAccessor(accessorIndex).count;
+        }
+        else
+        {
+            indices = asset.read<uint32_t>(accessorIndex);
+        }
+    }
+
+    if (!mesh.pIndices)
+    {
+        mesh.pIndices = indices.data();
+        mesh.indexCount = (uint32_t)indices.size();
+    }
+
+    if (desc.mode != PrimitiveMode::Triangles)
+    {
+        indices = triangulate(mesh.pIndices, mesh.indexCount, desc.mode);
+        mesh.pIndices = indices.data();
+        mesh.indexCount = (uint32_t)indices.size();
+    }
+
+    FALCOR_CHECK(mesh.indexCount % 3 == 0, "Mesh '{}' has an index count that is not a multiple of 3.", desc.name);
+    mesh.faceCount = mesh.indexCount / 3;
+    for (uint32_t i = 0; i < mesh.indexCount; ++i)
+        FALCOR_CHECK(mesh.pIndices[i] < mesh.vertexCount, "Mesh '{}' has out of range indices.", desc.name);
+
+    // Use flat shading if the primitive has no normals, as mandated by the specification.
+    if (!mesh.normals.pData)
+    {
+        normals.resize(mesh.faceCount);
+        for (uint32_t f = 0; f < mesh.faceCount; ++f)
+        {
+            const float3 p0 = mesh.positions[mesh.pIndices[f * 3 + 0]];
+            const float3 p1 = mesh.positions[mesh.pIndices[f * 3 + 1]];
+            const float3 p2 = mesh.positions[mesh.pIndices[f * 3 + 2]];
+            const float3 n = cross(p1 - p0, p2 - p0);
+            const float len = length(n);
+            normals[f] = len > 0.f ? n / len : float3(0.f, 0.f, 1.f);
+        }
+        mesh.normals = {normals.data(), SceneBuilder::Mesh::AttributeFrequency::Uniform};
+    }
+
+    return data.builder.processMesh(mesh);
+}
+
+void createMeshes(ImporterData& data, const std::vector<uint32_t>& meshIndices)
+{
+    const auto& meshes = data.getArray("meshes");
+    data.meshes.resize(meshes.size());
+
+    // Gather the primitives to create. Materials are resolved here as the default material is created on demand.
+    std::vector<std::pair<uint32_t, PrimitiveDesc>> primitives;
+    for (uint32_t meshIndex : meshIndices)
+    {
+        const json& mesh = meshes[meshIndex];
+        const std::string name = mesh.value("name", fmt::format("Mesh{}", meshIndex));
+        const auto& meshPrimitives = mesh.at("primitives");
+        for (size_t i = 0; i < meshPrimitives.size(); ++i)
+        {
+            const json& primitive = meshPrimitives[i];
+            PrimitiveDesc desc;
+            desc.name = meshPrimitives.size() > 1 ? fmt::format("{}.{}", name, i) : name;
+            desc.pPrimitive = &primitive;
+            desc.mode = PrimitiveMode(primitive.value("mode", (uint32_t)PrimitiveMode::Triangles));
+            if (desc.mode != PrimitiveMode::Triangles && desc.mode != PrimitiveMode::TriangleStrip &&
+                desc.mode != PrimitiveMode::TriangleFan)
+            {
+                data.logWarningOnce("Point and line primitives are not supported, ignoring.");
+                continue;
+            }
+            FALCOR_CHECK(
+                primitive.contains("attributes") && primitive["attributes"].contains("POSITION"), "Mesh '{}' has no positions.", name
+            );
+
+            if (auto material = primitive.find("material"); material != primitive.end())
+            {
+                const uint32_t materialIndex = material->get<uint32_t>();
+                FALCOR_CHECK(materialIndex < data.materials.size(), "Mesh '{}' references invalid material {}.", name, materialIndex);
+                desc.pMaterial = data.materials[materialIndex];
+            }
+            else
+            {
+                desc.pMaterial = getDefaultMaterial(data);
+            }
+
+            primitives.emplace_back(meshIndex, std::move(desc));
+        }
+    }
+
+    std::vector<SceneBuilder::ProcessedMesh> processedMeshes(primitives.size());
+    std::vector<std::exception_ptr> exceptions(primitives.size());
+    auto range = NumericRange<size_t>(0, primitives.size());
+    std::for_each(
+        std::execution::par,
+        range.begin(),
+        range.end(),
+        [&](size_t i)
+        {
+            // Exceptions can't propagate out of a parallel algorithm, they are rethrown below.
+            try
+            {
+                processedMeshes[i] = processPrimitive(data, primitives[i].second);
+            }
+            catch (...)
+            {
+                exceptions[i] = std::current_exception();
+            }
+        }
+    );
+
+    for (size_t i = 0; i < primitives.size(); ++i)
+    {
+        if (exceptions[i])
+            std::rethrow_exception(exceptions[i]);
+        data.meshes[primitives[i].first].push_back(data.builder.addProcessedMesh(processedMeshes[i]));
+    }
+}
+
+float4x4 getNodeTransform(const json& node)
+{
+    if (auto it = node.find("matrix"); it != node.end())
+    {
+        FALCOR_CHECK(it->is_array() && it->size() == 16, "Node matrix must be an array of 16 numbers.");
+        // glTF matrices are stored in column-major order.
+        float4x4 transform;
+        for (int r = 0; r < 4; ++r)
+            for (int c = 0; c < 4; ++c)
+                transform[r][c] = (*it)[c * 4 + r].get<float>();
+        return transform;
+    }
+
+    const float4 rotation = getVector(node, "rotation", float4(0.f, 0.f, 0.f, 1.f));
+    Transform transform;
+    transform.setTranslation(getVector(node, "translation", float3(0.f)));
+    transform.setRotation(normalize(quatf(rotation.x, rotation.y, rotation.z, rotation.w)));
+    transform.setScaling(getVector(node, "scale", float3(1.f)));
+    return transform.getMatrix();
+}
+
+void addCamera(ImporterData& data, const json& camera, const std::string& name, NodeID nodeID)
+{
+    if (camera.value("type", "") != "perspective" || !camera.contains("perspective"))
+    {
+        data.logWarningOnce("Only perspective cameras are supported, ignoring orthographic cameras.");
+        return;
+    }
+    const json& perspective = camera["perspective"];
+
+    // The camera looks down the negative z-axis of its node, matching the Falcor convention.
+    ref<Camera> pCamera = Camera::create(name);
+    pCamera->setPosition(float3(0.f));
+    pCamera->setTarget(float3(0.f, 0.f, -1.f));
+    pCamera->setUpVector(float3(0.f, 1.f, 0.f));
+    if (auto aspectRatio = perspective.find("aspectRatio"); aspectRatio != perspective.end())
+        pCamera->setAspectRatio(aspectRatio->get<float>());
+    pCamera->setFocalLength(fovYToFocalLength(perspective.value("yfov", 0.8f), pCamera->getFrameHeight()));
+    pCamera->setDepthRange(perspective.value("znear", pCamera->getNearPlane()), perspective.value("zfar", pCamera->getFarPlane()));
+    pCamera->setNodeID(nodeID);
+    data.builder.addCamera(pCamera);
+}
+
+void addLight(ImporterData& data, const json& light, const std::string& name, NodeID nodeID)
+{
+    const std::string type = light.value("type", "");
+    const float3 intensity = getVector(light, "color", float3(1.f)) * light.value("intensity", 1.f);
+
+    // Lights point down the negative z-axis of their node, matching the Falcor convention.
+    ref<Light> pLight;
+    if (type == "directional")
+    {
+        ref<DirectionalLight> pDirLight = DirectionalLight::create(name);
+        pDirLight->setWorldDirection(float3(0.f, 0.f, -1.f));
+        pLight = pDirLight;
+    }
+    else if (type == "point" || type == "spot")
+    {
+        ref<PointLight> pPointLight = PointLight::create(name);
+        pPointLight->setWorldPosition(float3(0.f));
+        pPointLight->setWorldDirection(float3(0.f, 0.f, -1.f));
+        if (auto spot = light.find("spot"); type == "spot" && spot != light.end())
+        {
+            const float innerConeAngle = spot->value("innerConeAngle", 0.f);
+            const float outerConeAngle = spot->value("outerConeAngle", float(M_PI) / 4.f);
+            pPointLight->setOpeningAngle(outerConeAngle);
+            pPointLight->setPenumbraAngle(outerConeAngle - innerConeAngle);
+        }
+        pLight = pPointLight;
+    }
+    else
+    {
+        data.logWarningOnce(fmt::format("Light '{}' has unsupported type '{}', ignoring.", name, type));
+        return;
+    }
+
+    pLight->setIntensity(intensity);
+    pLight->setHasAnimation(true);
+    pLight->setNodeID(nodeID);
+    data.builder.addLight(pLight);
+}
+
+/**
+ * Add the nodes of the scene graph, depth first so that parents are added before their children.
+ * @return Indices of the glTF meshes that are instanced by the nodes.
+ */
+std::vector<uint32_t> createSceneGraph(ImporterData& data, std::vector<std::pair<NodeID, uint32_t>>& meshInstances)
+{
+    const auto& nodes = data.getArray("nodes");
+
+    // Select the root nodes of the default scene. Assets without scenes instantiate all nodes without a parent.
+    std::vector<uint32_t> roots;
+    const auto& scenes = data.getArray("scenes");
+    if (!scenes.empty())
+    {
+        const uint32_t sceneIndex = data.gltf.value("scene", 0u);
+        FALCOR_CHECK(sceneIndex < scenes.size(), "Invalid scene index {}.", sceneIndex);
+        roots = scenes[sceneIndex].value("nodes", std::vector<uint32_t>());
+    }
+    else
+    {
+        std::vector<bool> isChild(nodes.size(), false);
+        for (const auto& node : nodes)
+            for (uint32_t child : node.value("children", std::vector<uint32_t>()))
+                if (child < nodes.size())
+                    isChild[child] = true;
+        for (uint32_t i = 0; i < nodes.size(); ++i)
+            if (!isChild[i])
+                roots.push_back(i);
+    }
+
+    const json* pLights = nullptr;
+    if (auto extensions = data.gltf.find("extensions"); extensions != data.gltf.end())
+    {
+        if (auto lights = extensions->find("KHR_lights_punctual"); lights != extensions->end() && lights->contains("lights"))
+            pLights = &(*lights)["lights"];
+    }
+    const auto& cameras = data.getArray("cameras");
+    const auto& meshes = data.getArray("meshes");
+
+    std::vector<bool> meshUsed(meshes.size(), false);
+    std::vector<bool> visited(nodes.size(), false);
+    std::vector<std::pair<uint32_t, NodeID>> stack;
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it)
+        stack.emplace_back(*it, NodeID::Invalid());
+
+    while (!stack.empty())
+    {
+        auto [nodeIndex, parentID] = stack.back();
+        stack.pop_back();
+        FALCOR_CHECK(nodeIndex < nodes.size(), "Invalid node index {}.", nodeIndex);
+        FALCOR_CHECK(!visited[nodeIndex], "Node {} has multiple parents or is part of a cycle.", nodeIndex);
+        visited[nodeIndex] = true;
+
+        const json& node = nodes[nodeIndex];
+        SceneBuilder::Node falcorNode;
+        falcorNode.name = node.value("name", fmt::format("Node{}", nodeIndex));
+        falcorNode.transform = getNodeTransform(node);
+        falcorNode.parent = parentID;
+        const NodeID nodeID = data.builder.addNode(falcorNode);
+
+        if (auto mesh = node.find("mesh"); mesh != node.end())
+        {
+            const uint32_t meshIndex = mesh->get<uint32_t>();
+            FALCOR_CHECK(meshIndex < meshes.size(), "Node '{}' references invalid mesh {}.", falcorNode.name, meshIndex);
+            meshUsed[meshIndex] = true;
+            meshInstances.emplace_back(nodeID, meshIndex);
+        }
+
+        if (auto camera = node.find("camera"); camera != node.end())
+        {
+            const uint32_t cameraIndex = camera->get<uint32_t>();
+            FALCOR_CHECK(cameraIndex < cameras.size(), "Node '{}' references invalid camera {}.", falcorNode.name, cameraIndex);
+            addCamera(data, cameras[cameraIndex], cameras[cameraIndex].value("name", falcorNode.name), nodeID);
+        }
+
+        if (auto extensions = node.find("extensions"); extensions != node.end() && extensions->contains("KHR_lights_punctual"))
+        {
+            const uint32_t lightIndex = (*extensions)["KHR_lights_punctual"].value("light", ~0u);
+            FALCOR_CHECK(pLights && lightIndex < pLights->size(), "Node '{}' references invalid light {}.", falcorNode.name, lightIndex);
+            addLight(data, (*pLights)[lightIndex], (*pLights)[lightIndex].value("name", falcorNode.name), nodeID);
+        }
+
+        const auto children = node.value("children", std::vector<uint32_t>());
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+            stack.emplace_back(*it, nodeID);
+    }
+
+    std::vector<uint32_t> meshIndices;
+    for (uint32_t i = 0; i < meshUsed.size(); ++i)
+        if (meshUsed[i])
+            meshIndices.push_back(i);
+    return meshIndices;
+}
+
+void importInternal(const GLTF::Asset& asset, const std::filesystem::path& path, SceneBuilder& builder, TimeReport& timeReport)
+{
+    ImporterData data(path, asset, builder);
+
+    createMaterials(data);
+    timeReport.measure("Creating materials");
+
+    std::vector<std::pair<NodeID, uint32_t>> meshInstances;
+    std::vector<uint32_t> meshIndices = createSceneGraph(data, meshInstances);
+    timeReport.measure("Creating scene graph");
+
+    createMeshes(data, meshIndices);
+    for (const auto& [nodeID, meshIndex] : meshInstances)
+        for (MeshID meshID : data.meshes[meshIndex])
+            builder.addMeshInstance(nodeID, meshID);
+    timeReport.measure("Creating meshes");
+
+    timeReport.printToLog();
+}
+
+/// Import through AssimpImporter, which supports skinning and animations.
+void importWithAssimp(
+    const std::filesystem::path& path,
+    const void* buffer,
+    size_t byteSize,
+    std::string_view extension,
+    SceneBuilder& builder,
+    const std::map<std::string, std::string>& materialToShortName,
+    const std::string& reason
+)
+{
+    logInfo("GLTFImporter: Asset uses {}, importing with AssimpImporter.", reason);
+    auto pImporter = PluginManager::instance().createClass<Importer>("AssimpImporter");
+    if (!pImporter)
+        throw ImporterError(path, "Asset uses {}, which requires AssimpImporter.", reason);
+    if (buffer)
+        pImporter->importSceneFromMemory(buffer, byteSize, extension, builder, materialToShortName);
+    else
+        pImporter->importScene(path, builder, materialToShortName);
+}
+
+} // namespace
+
+std::unique_ptr<Importer> GLTFImporter::create()
+{
+    return std::make_unique<GLTFImporter>();
+}
+
+void GLTFImporter::importScene(
+    const std::filesystem::path& path,
+    SceneBuilder& builder,
+    const std::map<std::string, std::string>& materialToShortName
+)
+{
+    if (!path.is_absolute())
+        throw ImporterError(path, "Expected absolute path.");
+
+    TimeReport timeReport;
+    try
+    {
+        std::unique_ptr<GLTF::Asset> pAsset = GLTF::Asset::createFromFile(path);
+        timeReport.measure("Loading asset file");
+
+        if (std::string feature = findUnsupportedFeature(pAsset->getJson()); !feature.empty())
+        {
+            pAsset.reset();
+            return importWithAssimp(path, nullptr, 0, getExtensionFromPath(path), builder, materialToShortName, feature);
+        }
+
+        importInternal(*pAsset, path, builder, timeReport);
+    }
+    catch (const RuntimeError& e)
+    {
+        throw ImporterError(path, e.what());
+    }
+    catch (const json::exception& e)
+    {
+        throw ImporterError(path, "Invalid glTF: {}", e.what());
+    }
+}
+
+void GLTFImporter::importSceneFromMemory(
+    const void* buffer,
+    size_t byteSize,
+    std::string_view extension,
+    SceneBuilder& builder,
+    const std::map<std::string, std::string>& materialToShortName
+)
+{
+    TimeReport timeReport;
+    try
+    {
+        std::unique_ptr<GLTF::Asset> pAsset = GLTF::Asset::createFromMemory(buffer, byteSize, std::filesystem::current_path());
+        timeReport.measure("Loading asset file");
+
+        if (std::string feature = findUnsupportedFeature(pAsset->getJson()); !feature.empty())
+        {
+            pAsset.reset();
+            return importWithAssimp({}, buffer, byteSize, extension, builder, materialToShortName, feature);
+        }
+
+        importInternal(*pAsset, {}, builder, timeReport);
+    }
+    catch (const RuntimeError& e)
+    {
+        throw ImporterError({}, e.what());
+    }
+    catch (const json::exception& e)
+    {
+        throw ImporterError({}, "Invalid glTF: {}", e.what());
+    }
+}
+
+extern "C" FALCOR_API_EXPORT void registerPlugin(Falcor::PluginRegistry& registry)
+{
+    registry.registerClass<Importer, GLTFImporter>();
+}
+
+} // namespace Falcor
@@ -27,16 +27,21 @@
  **************************************************************************/
 #include "MitsubaImporter.h"
 #include "Parser.h"
+#include "SerializedMesh.h"
 #include "Tables.h"
 #include "Utils/Math/Common.h"
 #include "Utils/Math/FalcorMath.h"
 #include "Utils/Math/MathHelpers.h"
+#include "Utils/NumericRange.h"
 #include "Scene/Material/PBRT/PBRTDiffuseMaterial.h"
 #include "Scene/Material/PBRT/PBRTDielectricMaterial.h"
 #include "Scene/Material/PBRT/PBRTConductorMaterial.h"
 
 #include <pybind11/pybind11.h>
 
+#include <exception>
+#include <execution>
+#include <map>
 #include <unordered_map>
 
 namespace Falcor
@@ -114,6 +119,9 @@ struct BuilderContext
 struct ShapeInfo
 {
     ref<TriangleMesh> pMesh;
+    std::filesystem::path serializedPath; ///< Set for shapes stored in a `.serialized` file, these are loaded in parallel in addShapes().
+    uint32_t serializedShapeIndex = 0;
+    bool faceNormals = false;
     float4x4 transform;
     ref<Material> pMaterial;
 };
@@ -135,7 +143,10 @@ struct TextureInfo
 {
     float4 value;
     ref<Texture> pTexture;
+    std::filesystem::path path; ///< Set for bitmaps that are loaded asynchronously through the material texture loader.
     float4x4 transform;
+
+    bool hasTexture() const { return pTexture || !path.empty(); }
 };
 
 struct BSDFInfo
@@ -190,7 +201,12 @@ TextureInfo buildTexture(BuilderContext& ctx, const XMLObject& inst)
         if (props.hasString("wrap_mode"))
             ctx.unsupportedParameter("wrap_mode");
 
-        texture.pTexture = Texture::createFromFile(ctx.builder.getDevice(), filename, true, !raw);
+        // The material texture loader picks the color space from the texture slot,
+        // so only raw (linear) bitmaps are loaded synchronously.
+        if (raw)
+            texture.pTexture = Texture::createFromFile(ctx.builder.getDevice(), filename, true, false);
+        else
+            texture.path = filename;
         texture.transform = toUV;
     }
     else if (inst.type == "checkerboard")
@@ -246,6 +262,15 @@ TextureInfo lookupTexture(BuilderContext& ctx, const Properties& props, const st
     }
 }
 
+void setMaterialTexture(BuilderContext& ctx, const ref<Material>& pMaterial, Material::TextureSlot slot, const TextureInfo& texture)
+{
+    if (!texture.path.empty())
+        ctx.builder.loadMaterialTexture(pMaterial, slot, texture.path);
+    else
+        pMaterial->setTexture(slot, texture.pTexture);
+    pMaterial->setTextureTransform(transformFromMatrix4x4(texture.transform));
+}
+
 void setMicrofacetProperties(ref<StandardMaterial> pMaterial, BuilderContext& ctx, const Properties& props, float defaultAlpha = 0.1f)
 {
     if (props.hasString("distribution"))
@@ -253,9 +278,9 @@ void setMicrofacetProperties(ref<StandardMaterial> pMaterial, BuilderContext& ct
     if (props.hasBool("sample_visible"))
         ctx.unsupportedParameter("sample_visible");
     auto alpha = lookupTexture(ctx, props, "alpha", float4(defaultAlpha));
-    if (alpha.pTexture)
+    if (alpha.hasTexture())
         ctx.logWarningOnce("Microfacet alpha texture is not supported.");
-    pMaterial->setRoughness(std::sqrt(alpha.pTexture ? defaultAlpha : alpha.value.x));
+    pMaterial->setRoughness(std::sqrt(alpha.hasTexture() ? defaultAlpha : alpha.value.x));
     // TODO: set roughness texture
 }
 
@@ -271,10 +296,9 @@ BSDFInfo buildBSDF(BuilderContext& ctx, const XMLObject& inst)
     {
         auto pPBRTMaterial = PBRTDiffuseMaterial::create(ctx.builder.getDevice(), inst.id);
         auto reflectance = lookupTexture(ctx, props, "reflectance", float4(0.5f));
-        if (reflectance.pTexture)
+        if (reflectance.hasTexture())
         {
-            pPBRTMaterial->setTexture(Material::TextureSlot::BaseColor, reflectance.pTexture);
-            pPBRTMaterial->setTextureTransform(transformFromMatrix4x4(reflectance.transform));
+            setMaterialTexture(ctx, pPBRTMaterial, Material::TextureSlot::BaseColor, reflectance);
         }
         else
         {
@@ -343,9 +367,9 @@ BSDFInfo buildBSDF(BuilderContext& ctx, const XMLObject& inst)
         {
             const float defaultAlpha = 0.1f;
             auto alpha = lookupTexture(ctx, props, "alpha", float4(defaultAlpha));
-            if (alpha.pTexture)
+            if (alpha.hasTexture())
                 ctx.logWarningOnce("Microfacet alpha texture is not supported.");
-            pPBRTMaterial->setRoughness(alpha.pTexture ? float2(defaultAlpha) : alpha.value.xy());
+            pPBRTMaterial->setRoughness(alpha.hasTexture() ? float2(defaultAlpha) : alpha.value.xy());
         }
 
         pMaterial = pPBRTMaterial;
@@ -354,10 +378,9 @@ BSDFInfo buildBSDF(BuilderContext& ctx, const XMLObject& inst)
     {
         auto pStandardMaterial = StandardMaterial::create(ctx.builder.getDevice(), inst.id);
         auto diffuseReflectance = lookupTexture(ctx, props, "diffuse_reflectance", float4(0.5f));
-        if (diffuseReflectance.pTexture)
+        if (diffuseReflectance.hasTexture())
         {
-            pStandardMaterial->setTexture(Material::TextureSlot::BaseColor, diffuseReflectance.pTexture);
-            pStandardMaterial->setTextureTransform(transformFromMatrix4x4(diffuseReflectance.transform));
+            setMaterialTexture(ctx, pStandardMaterial, Material::TextureSlot::BaseColor, diffuseReflectance);
         }
         else
         {
@@ -490,6 +513,17 @@ ShapeInfo buildShape(BuilderContext& ctx, const XMLObject& inst)
             shape.pMesh->setName(inst.id);
         shape.transform = toWorld;
     }
+    else if (inst.type == "serialized")
+    {
+        auto shapeIndex = props.getInt("shape_index", 0);
+        if (shapeIndex < 0)
+            FALCOR_THROW("'shape_index' must not be negative.");
+
+        shape.serializedPath = props.getString("filename");
+        shape.serializedShapeIndex = (uint32_t)shapeIndex;
+        shape.faceNormals = props.getBool("face_normals", false);
+        shape.transform = toWorld;
+    }
     else if (inst.type == "sphere")
     {
         auto center = props.getFloat3("center", float3(0.f));
@@ -723,11 +757,94 @@ EmitterInfo buildEmitter(BuilderContext& ctx, const XMLObject& inst)
     return emitter;
 }
 
+/**
+ * Add shapes to the scene.
+ * Shapes stored in `.serialized` files are decompressed and preprocessed in parallel.
+ * Meshes are added in the original order to keep the scene deterministic.
+ */
+void addShapes(BuilderContext& ctx, const std::vector<std::pair<std::string, ShapeInfo>>& shapes)
+{
+    // Open each serialized file once to read its shape offset table.
+    std::map<std::filesystem::path, std::unique_ptr<SerializedFile>> serializedFiles;
+    for (const auto& [id, shape] : shapes)
+    {
+        if (!shape.serializedPath.empty() && serializedFiles.find(shape.serializedPath) == serializedFiles.end())
+            serializedFiles.emplace(shape.serializedPath, std::make_unique<SerializedFile>(shape.serializedPath));
+    }
+
+    std::vector<SceneBuilder::ProcessedMesh> processedMeshes(shapes.size());
+    std::vector<std::exception_ptr> exceptions(shapes.size());
+    std::vector<uint8_t> hasVertexColors(shapes.size(), 0);
+    auto range = NumericRange<size_t>(0, shapes.size());
+    std::for_each(
+        std::execution::par,
+        range.begin(),
+        range.end(),
+        [&](size_t i)
+        {
+            const auto& [id, shape] = shapes[i];
+            if (shape.serializedPath.empty() || !shape.pMaterial)
+                return;
+
+            // Exceptions can't propagate out of a parallel algorithm, they are rethrown below.
+            try
+            {
+                const SerializedFile& file = *serializedFiles.at(shape.serializedPath);
+                SerializedShape serialized = file.readShape(shape.serializedShapeIndex, shape.faceNormals);
+                hasVertexColors[i] = serialized.hasVertexColors;
+
+                SceneBuilder::Mesh mesh;
+                mesh.name = id;
+                mesh.faceCount = (uint32_t)(serialized.indices.size() / 3);
+                mesh.vertexCount = (uint32_t)serialized.positions.size();
+                mesh.indexCount = (uint32_t)serialized.indices.size();
+                mesh.pIndices = serialized.indices.data();
+                mesh.topology = Vao::Topology::TriangleList;
+                mesh.pMaterial = shape.pMaterial;
+                mesh.positions = {serialized.positions.data(), SceneBuilder::Mesh::AttributeFrequency::Vertex};
+                mesh.normals.pData = serialized.normals.data();
+                mesh.normals.frequency =
+                    serialized.faceNormals ? SceneBuilder::Mesh::AttributeFrequency::Uniform : SceneBuilder::Mesh::AttributeFrequency::Vertex;
+                if (!serialized.texCoords.empty())
+                    mesh.texCrds = {serialized.texCoords.data(), SceneBuilder::Mesh::AttributeFrequency::Vertex};
+
+                processedMeshes[i] = ctx.builder.processMesh(mesh);
+            }
+            catch (...)
+            {
+                exceptions[i] = std::current_exception();
+            }
+        }
+    );
+
+    for (size_t i = 0; i < shapes.size(); ++i)
+    {
+        if (exceptions[i])
+            std::rethrow_exception(exceptions[i]);
+        if (hasVertexColors[i])
+            ctx.logWarningOnce("Vertex colors in serialized meshes are not supported.");
+    }
+
+    for (size_t i = 0; i < shapes.size(); ++i)
+    {
+        const auto& [id, shape] = shapes[i];
+        if (!shape.pMaterial || (!shape.pMesh && shape.serializedPath.empty()))
+            continue;
+
+        SceneBuilder::Node node{id, shape.transform};
+        auto nodeID = ctx.builder.addNode(node);
+        auto meshID =
+            shape.pMesh ? ctx.builder.addTriangleMesh(shape.pMesh, shape.pMaterial) : ctx.builder.addProcessedMesh(processedMeshes[i]);
+        ctx.builder.addMeshInstance(nodeID, meshID);
+    }
+}
+
 void buildScene(BuilderContext& ctx, const XMLObject& inst)
 {
     FALCOR_ASSERT(inst.cls == Class::Scene);
 
     const auto& props = inst.props;
+    std::vector<std::pair<std::string, ShapeInfo>> shapes;
 
     for (const auto& [name, id] : props.getNamedReferences())
     {
@@ -771,19 +888,13 @@ void buildScene(BuilderContext& ctx, const XMLObject& inst)
 
         case Class::Shape:
         {
-            auto shape = buildShape(ctx, child);
-
-            if (shape.pMesh && shape.pMaterial)
-            {
-                SceneBuilder::Node node{id, shape.transform};
-                auto nodeID = ctx.builder.addNode(node);
-                auto meshID = ctx.builder.addTriangleMesh(shape.pMesh, shape.pMaterial);
-                ctx.builder.addMeshInstance(nodeID, meshID);
-            }
+            shapes.emplace_back(id, buildShape(ctx, child));
         }
         break;
         }
     }
+
+    addShapes(ctx, shapes);
 }
 
 } // namespace Mitsuba
@@ -0,0 +1,327 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "SerializedMesh.h"
+#include "Core/Error.h"
+#include "Utils/StringFormatters.h"
+#include "Utils/Math/VectorMath.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace Falcor
+{
+namespace Mitsuba
+{
+namespace
+{
+const uint16_t kFileFormatID = 0x041C;
+const uint16_t kVersionV3 = 0x0003;
+const uint16_t kVersionV4 = 0x0004;
+
+// Maximum compression ratio of the deflate algorithm, used to reject corrupt element counts before allocating.
+const uint64_t kMaxDeflateRatio = 1032;
+
+enum ShapeFlags : uint32_t
+{
+    HasNormals = 0x0001,
+    HasTexCoords = 0x0002,
+    HasTangents = 0x0004, // Unused.
+    HasColors = 0x0008,
+    FaceNormals = 0x0010,
+    SinglePrecision = 0x1000,
+    DoublePrecision = 0x2000,
+};
+
+/**
+ * Reads from a zlib-compressed memory buffer.
+ */
+class InflateStream
+{
+public:
+    InflateStream(const uint8_t* pData, size_t size, const std::filesystem::path& path) : mPath(path)
+    {
+        // MAX_WBITS | 32 to support both zlib or gzip streams.
+        if (inflateInit2(&mStream, MAX_WBITS | 32) != Z_OK)
+            FALCOR_THROW("inflateInit2 failed while decompressing '{}'.", mPath);
+        mStream.next_in = const_cast<Bytef*>(pData);
+        mStream.avail_in = (uInt)std::min<size_t>(size, std::numeric_limits<uInt>::max());
+    }
+
+    ~InflateStream() { inflateEnd(&mStream); }
+
+    InflateStream(const InflateStream&) = delete;
+    InflateStream& operator=(const InflateStream&) = delete;
+
+    void read(void* pDst, size_t size)
+    {
+        uint8_t* pOut = static_cast<uint8_t*>(pDst);
+        while (size > 0)
+        {
+            if (mEnd)
+                FALCOR_THROW("Unexpected end of compressed stream in '{}'.", mPath);
+
+            uInt chunk = (uInt)std::min<size_t>(size, 1u << 30);
+            mStream.next_out = pOut;
+            mStream.avail_out = chunk;
+            int ret = inflate(&mStream, Z_NO_FLUSH);
+            if (ret == Z_STREAM_END)
+                mEnd = true;
+            else if (ret != Z_OK)
+                FALCOR_THROW("Failed to decompress '{}' (error: {}).", mPath, ret);
+
+            size_t written = chunk - mStream.avail_out;
+            pOut += written;
+            size -= written;
+        }
+    }
+
+    template<typename T>
+    T read()
+    {
+        T value;
+        read(&value, sizeof(T));
+        return value;
+    }
+
+    /// Read `count` vectors of N components stored in single or double precision.
+    template<typename T>
+    void readVectors(std::vector<T>& dst, size_t count, bool doublePrecision)
+    {
+        dst.resize(count);
+        if (!doublePrecision)
+        {
+            read(dst.data(), count * sizeof(T));
+            return;
+        }
+
+        constexpr size_t N = sizeof(T) / sizeof(float);
+        std::vector<double> buffer(std::min<size_t>(count, 65536) * N);
+        for (size_t i = 0; i < count;)
+        {
+            size_t n = std::min(count - i, buffer.size() / N);
+            read(buffer.data(), n * N * sizeof(double));
+            float* pDst = reinterpret_cast<float*>(dst.data() + i);
+            for (size_t j = 0; j < n * N; ++j)
+                pDst[j] = (float)buffer[j];
+            i += n;
+        }
+    }
+
+    void skip(size_t size)
+    {
+        uint8_t buffer[4096];
+        while (size > 0)
+        {
+            size_t n = std::min(size, sizeof(buffer));
+            read(buffer, n);
+            size -= n;
+        }
+    }
+
+private:
+    z_stream mStream = {};
+    std::filesystem::path mPath;
+    bool mEnd = false;
+};
+
+float3 safeNormalize(const float3& v)
+{
+    float len = length(v);
+    return len > 0.f ? v / len : float3(0.f, 0.f, 1.f);
+}
+} // namespace
+
+SerializedFile::SerializedFile(const std::filesystem::path& path) : mPath(path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        FALCOR_THROW("Failed to open serialized mesh '{}'.", path);
+    const uint64_t fileSize = (uint64_t)file.tellg();
+
+    auto readAt = [&](uint64_t offset, void* pDst, size_t size)
+    {
+        file.seekg((std::streamoff)offset);
+        file.read(reinterpret_cast<char*>(pDst), (std::streamsize)size);
+        if (!file)
+            FALCOR_THROW("Failed to read serialized mesh '{}'.", path);
+    };
+
+    if (fileSize < 8)
+        FALCOR_THROW("Serialized mesh '{}' is too small.", path);
+
+    uint16_t header[2];
+    readAt(0, header, sizeof(header));
+    if (header[0] != kFileFormatID || (header[1] != kVersionV3 && header[1] != kVersionV4))
+        FALCOR_THROW("'{}' is not a serialized mesh (format ID {:#x}, version {}).", path, header[0], header[1]);
+
+    // The file ends with a table of shape offsets followed by the shape count.
+    // Version 3 stores 32-bit offsets, version 4 stores 64-bit offsets.
+    uint32_t shapeCount = 0;
+    readAt(fileSize - sizeof(uint32_t), &shapeCount, sizeof(uint32_t));
+    const uint64_t offsetSize = header[1] == kVersionV4 ? sizeof(uint64_t) : sizeof(uint32_t);
+    if (shapeCount == 0 || (uint64_t)shapeCount * offsetSize > fileSize - sizeof(uint32_t))
+        FALCOR_THROW("Serialized mesh '{}' has an invalid shape offset table.", path);
+    const uint64_t tableOffset = fileSize - sizeof(uint32_t) - shapeCount * offsetSize;
+
+    std::vector<uint64_t> offsets(shapeCount);
+    if (offsetSize == sizeof(uint64_t))
+    {
+        readAt(tableOffset, offsets.data(), shapeCount * sizeof(uint64_t));
+    }
+    else
+    {
+        std::vector<uint32_t> offsets32(shapeCount);
+        readAt(tableOffset, offsets32.data(), shapeCount * sizeof(uint32_t));
+        std::copy(offsets32.begin(), offsets32.end(), offsets.begin());
+    }
+
+    mShapes.resize(shapeCount);
+    for (uint32_t i = 0; i < shapeCount; ++i)
+    {
+        mShapes[i].begin = offsets[i];
+        mShapes[i].end = i + 1 < shapeCount ? offsets[i + 1] : tableOffset;
+        if (mShapes[i].begin + 2 * sizeof(uint16_t) >= mShapes[i].end || mShapes[i].end > tableOffset)
+            FALCOR_THROW("Serialized mesh '{}' has an invalid offset for shape {}.", path, i);
+    }
+}
+
+SerializedShape SerializedFile::readShape(uint32_t shapeIndex, bool faceNormals) const
+{
+    FALCOR_CHECK(
+        shapeIndex < mShapes.size(), "Shape index {} is out of range, '{}' contains {} shapes.", shapeIndex, mPath, mShapes.size()
+    );
+    const ShapeRange& range = mShapes[shapeIndex];
+
+    // Each thread reads the compressed stream of its shape with a separate file handle.
+    std::vector<uint8_t> data(range.end - range.begin);
+    {
+        std::ifstream file(mPath, std::ios::binary);
+        file.seekg((std::streamoff)range.begin);
+        file.read(reinterpret_cast<char*>(data.data()), (std::streamsize)data.size());
+        if (!file)
+            FALCOR_THROW("Failed to read shape {} from serialized mesh '{}'.", shapeIndex, mPath);
+    }
+
+    uint16_t header[2];
+    std::memcpy(header, data.data(), sizeof(header));
+    if (header[0] != kFileFormatID || (header[1] != kVersionV3 && header[1] != kVersionV4))
+        FALCOR_THROW("Shape {} in serialized mesh '{}' has an invalid header.", shapeIndex, mPath);
+
+    InflateStream stream(data.data() + sizeof(header), data.size() - sizeof(header), mPath);
+    SerializedShape shape;
+
+    const uint32_t flags = stream.read<uint32_t>();
+    if (header[1] == kVersionV4)
+    {
+        for (char c = stream.read<char>(); c != '\0'; c = stream.read<char>())
+            shape.name.push_back(c);
+    }
+
+    const uint64_t vertexCount = stream.read<uint64_t>();
+    const uint64_t triangleCount = stream.read<uint64_t>();
+    if (vertexCount == 0 || triangleCount == 0)
+        FALCOR_THROW("Shape {} in serialized mesh '{}' is empty.", shapeIndex, mPath);
+    if (vertexCount > std::numeric_limits<uint32_t>::max() || 3 * triangleCount > std::numeric_limits<uint32_t>::max())
+        FALCOR_THROW(
+            "Shape {} in serialized mesh '{}' is too large ({} vertices, {} triangles).", shapeIndex, mPath, vertexCount, triangleCount
+        );
+    if ((vertexCount + triangleCount) * 3 * sizeof(float) > data.size() * kMaxDeflateRatio)
+        FALCOR_THROW("Shape {} in serialized mesh '{}' is corrupt.", shapeIndex, mPath);
+
+    const bool doublePrecision = (flags & DoublePrecision) != 0;
+    const size_t scalarSize = doublePrecision ? sizeof(double) : sizeof(float);
+    faceNormals = faceNormals || (flags & FaceNormals) != 0;
+    shape.faceNormals = faceNormals;
+    shape.hasVertexColors = (flags & HasColors) != 0;
+
+    stream.readVectors(shape.positions, vertexCount, doublePrecision);
+
+    if (flags & HasNormals)
+    {
+        if (faceNormals)
+            stream.skip(vertexCount * 3 * scalarSize);
+        else
+            stream.readVectors(shape.normals, vertexCount, doublePrecision);
+    }
+
+    if (flags & HasTexCoords)
+    {
+        // Mitsuba's texture coordinates have the origin at the bottom left.
+        stream.readVectors(shape.texCoords, vertexCount, doublePrecision);
+        for (float2& uv : shape.texCoords)
+            uv.y = 1.f - uv.y;
+    }
+
+    if (flags & HasColors)
+        stream.skip(vertexCount * 3 * scalarSize);
+
+    // Indices are 32-bit since the vertex count is limited to 32-bit above.
+    stream.readVectors(shape.indices, 3 * triangleCount, false);
+    for (uint32_t index : shape.indices)
+    {
+        if (index >= vertexCount)
+            FALCOR_THROW("Shape {} in serialized mesh '{}' has an out of bounds vertex index ({}).", shapeIndex, mPath, index);
+    }
+
+    if (faceNormals)
+    {
+        shape.normals.resize(triangleCount);
+        for (size_t i = 0; i < triangleCount; ++i)
+        {
+            const float3& p0 = shape.positions[shape.indices[3 * i + 0]];
+            const float3& p1 = shape.positions[shape.indices[3 * i + 1]];
+            const float3& p2 = shape.positions[shape.indices[3 * i + 2]];
+            shape.normals[i] = safeNormalize(cross(p1 - p0, p2 - p0));
+        }
+    }
+    else if (shape.normals.empty())
+    {
+        // Generate smooth area-weighted vertex normals.
+        shape.normals.assign(vertexCount, float3(0.f));
+        for (size_t i = 0; i < triangleCount; ++i)
+        {
+            const uint32_t* pIndices = &shape.indices[3 * i];
+            const float3& p0 = shape.positions[pIndices[0]];
+            float3 n = cross(shape.positions[pIndices[1]] - p0, shape.positions[pIndices[2]] - p0);
+            for (uint32_t j = 0; j < 3; ++j)
+                shape.normals[pIndices[j]] += n;
+        }
+        for (float3& n : shape.normals)
+            n = safeNormalize(n);
+    }
+
+    return shape;
+}
+
+} // namespace Mitsuba
+
+} // namespace Falcor
@@ -0,0 +1,94 @@
+/***************************************************************************
+ # Copyright (c) 2015-24, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Utils/Math/Vector.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Falcor
+{
+namespace Mitsuba
+{
+/**
+ * Triangle mesh loaded from a Mitsuba `.serialized` file.
+ */
+struct SerializedShape
+{
+    std::string name;
+    std::vector<float3> positions;
+    std::vector<float3> normals; ///< One normal per vertex, or one normal per face if `faceNormals` is set.
+    std::vector<float2> texCoords;
+    std::vector<uint32_t> indices;
+    bool faceNormals = false;
+    bool hasVertexColors = false; ///< True if the file stores vertex colors (these are skipped).
+};
+
+/**
+ * Reader for Mitsuba's binary `.serialized` mesh format.
+ *
+ * A file stores one or more shapes, each as a short header followed by a zlib-compressed stream.
+ * A table of shape offsets at the end of the file allows decoding the shapes independently.
+ * The constructor only reads the offset table, `readShape` can be called concurrently from multiple threads.
+ */
+class SerializedFile
+{
+public:
+    /**
+     * Open a `.serialized` file and read its shape offset table.
+     * Throws a RuntimeError if the file is not a valid `.serialized` file.
+     */
+    explicit SerializedFile(const std::filesystem::path& path);
+
+    const std::filesystem::path& getPath() const { return mPath; }
+
+    uint32_t getShapeCount() const { return (uint32_t)mShapes.size(); }
+
+    /**
+     * Read and decompress a single shape.
+     * Texture coordinates are converted to Falcor's convention. Missing normals are generated.
+     * @param[in] shapeIndex Index of the shape in the file.
+     * @param[in] faceNormals Use face normals even if the shape stores vertex normals.
+     * @return The decoded shape. Throws a RuntimeError if the shape data is invalid.
+     */
+    SerializedShape readShape(uint32_t shapeIndex, bool faceNormals = false) const;
+
+private:
+    struct ShapeRange
+    {
+        uint64_t begin; ///< Byte offset of the shape header.
+        uint64_t end;   ///< Byte offset past the end of the compressed stream.
+    };
+
+    std::filesystem::path mPath;
+    std::vector<ShapeRange> mShapes;
+};
+
+} // namespace Mitsuba
+
+} // namespace Falcor
@@ -33,130 +33,173 @@
 
 #include "LoopSubdivide.h"
 #include "Core/Error.h"
+#include "Utils/NumericRange.h"
 
 #include <algorithm>
-#include <map>
-#include <memory>
-#include <memory_resource>
-#include <set>
+#include <execution>
+#include <numeric>
+#include <unordered_map>
 
 #include <cmath>
 
 namespace Falcor::pbrt
 {
 
-struct SDFace;
-struct SDVertex;
+// The mesh is stored in flat arrays with the same topology as pbrt's pointer-based SDVertex/SDFace structure:
+// every face stores its vertices and its neighbors across each edge, and every vertex stores one of its faces.
+// The children of face i are the faces 4i..4i+3 of the next level, the child of vertex i is vertex i of the next level
+// and the new edge vertices follow in the order the edges are first seen when iterating over the faces.
+// This keeps the vertex order, the face order and the one-ring order (and therefore all rounding) identical to pbrt.
 
-#define NEXT(i) (((i) + 1) % 3)
-#define PREV(i) (((i) + 2) % 3)
-
-struct SDVertex
+namespace
 {
-    SDVertex(const float3& p = float3(0.f)) : p(p) {}
 
-    int valence();
-    void oneRing(float3* p);
+constexpr uint32_t kInvalid = 0xffffffff;
+constexpr uint32_t kLocalRingSize = 32;
 
-    float3 p;
-    SDFace* startFace = nullptr;
-    SDVertex* child = nullptr;
-    bool regular = false;
-    bool boundary = false;
-};
+inline uint32_t next(uint32_t i)
+{
+    return (i + 1) % 3;
+}
 
-struct SDFace
+inline uint32_t prev(uint32_t i)
 {
-    SDFace()
-    {
-        for (uint32_t i = 0; i < 3; ++i)
-        {
-            v[i] = nullptr;
-            f[i] = nullptr;
-        }
-        for (uint32_t i = 0; i < 4; ++i)
-        {
-            children[i] = nullptr;
-        }
-    }
+    return (i + 2) % 3;
+}
+
+struct Face
+{
+    uint32_t v[3];
+    uint32_t f[3]; ///< Neighbor face across the edge (v[i], v[next(i)]), or kInvalid on a boundary.
 
-    uint32_t vnum(SDVertex* vert) const
+    uint32_t vnum(uint32_t vertex) const
     {
-        for (int i = 0; i < 3; ++i)
-        {
-            if (v[i] == vert)
-                return i;
-        }
-        FALCOR_THROW("Basic logic error in SDFace::vnum().");
+        FALCOR_ASSERT(v[0] == vertex || v[1] == vertex || v[2] == vertex);
+        return v[0] == vertex ? 0 : (v[1] == vertex ? 1 : 2);
     }
 
-    SDFace* nextFace(SDVertex* vert) const { return f[vnum(vert)]; }
-    SDFace* prevFace(SDVertex* vert) const { return f[PREV(vnum(vert))]; }
-    SDVertex* nextVert(SDVertex* vert) const { return v[NEXT(vnum(vert))]; }
-    SDVertex* prevVert(SDVertex* vert) const { return v[PREV(vnum(vert))]; }
-    SDVertex* otherVert(SDVertex* v0, SDVertex* v1)
+    uint32_t otherVert(uint32_t v0, uint32_t v1) const
     {
         for (uint32_t i = 0; i < 3; ++i)
         {
             if (v[i] != v0 && v[i] != v1)
                 return v[i];
         }
-        FALCOR_THROW("Basic logic error in SDFace::otherVert()");
+        FALCOR_UNREACHABLE();
     }
-
-    SDVertex* v[3];
-    SDFace* f[3];
-    SDFace* children[4];
 };
 
-struct SDEdge
+struct Mesh
 {
-    SDEdge(SDVertex* v0 = nullptr, SDVertex* v1 = nullptr)
+    std::vector<float3> positions;
+    std::vector<uint32_t> startFaces;
+    std::vector<uint8_t> boundary;
+    std::vector<Face> faces;
+
+    void resize(size_t vertexCount, size_t faceCount)
     {
-        v[0] = std::min(v0, v1);
-        v[1] = std::max(v0, v1);
-        f[0] = f[1] = nullptr;
-        f0edgeNum = -1;
+        positions.resize(vertexCount);
+        startFaces.resize(vertexCount);
+        boundary.resize(vertexCount);
+        faces.resize(faceCount);
     }
 
-    bool operator<(const SDEdge& e2) const
+    void reserve(size_t vertexCount, size_t faceCount)
     {
-        if (v[0] == e2.v[0])
-            return v[1] < e2.v[1];
-        return v[0] < e2.v[0];
+        positions.reserve(vertexCount);
+        startFaces.reserve(vertexCount);
+        boundary.reserve(vertexCount);
+        faces.reserve(faceCount);
     }
 
-    SDVertex* v[2];
-    SDFace* f[2];
-    int f0edgeNum;
-};
+    uint32_t nextFace(uint32_t face, uint32_t vertex) const { return faces[face].f[faces[face].vnum(vertex)]; }
+    uint32_t prevFace(uint32_t face, uint32_t vertex) const { return faces[face].f[prev(faces[face].vnum(vertex))]; }
+    uint32_t nextVert(uint32_t face, uint32_t vertex) const { return faces[face].v[next(faces[face].vnum(vertex))]; }
+    uint32_t prevVert(uint32_t face, uint32_t vertex) const { return faces[face].v[prev(faces[face].vnum(vertex))]; }
 
-static float3 weightOneRing(SDVertex* vert, float beta);
-static float3 weightBoundary(SDVertex* vert, float beta);
+    uint32_t valence(uint32_t vertex) const
+    {
+        uint32_t startFace = startFaces[vertex];
+        uint32_t f = startFace;
+        if (!boundary[vertex])
+        {
+            // Compute valence of interior vertex.
+            uint32_t nf = 1;
+            while ((f = nextFace(f, vertex)) != startFace)
+                ++nf;
+            return nf;
+        }
+        else
+        {
+            // Compute valence of boundary vertex.
+            uint32_t nf = 1;
+            while ((f = nextFace(f, vertex)) != kInvalid)
+                ++nf;
+            f = startFace;
+            while ((f = prevFace(f, vertex)) != kInvalid)
+                ++nf;
+            return nf + 1;
+        }
+    }
 
-inline int SDVertex::valence()
-{
-    SDFace* f = startFace;
-    if (!boundary)
+    /// Calls the callback with the positions of the one-ring of a vertex, in the order used by pbrt.
+    template<typename Callback>
+    void forEachRingVertex(uint32_t vertex, Callback&& callback) const
     {
-        // Compute valence of interior vertex.
-        int nf = 1;
-        while ((f = f->nextFace(this)) != startFace)
-            ++nf;
-        return nf;
+        uint32_t face = startFaces[vertex];
+        if (!boundary[vertex])
+        {
+            // Get one-ring vertices for interior vertex.
+            do
+            {
+                callback(positions[nextVert(face, vertex)]);
+                face = nextFace(face, vertex);
+            } while (face != startFaces[vertex]);
+        }
+        else
+        {
+            // Get one-ring vertices for boundary vertex.
+            uint32_t f2;
+            while ((f2 = nextFace(face, vertex)) != kInvalid)
+                face = f2;
+            callback(positions[nextVert(face, vertex)]);
+            do
+            {
+                callback(positions[prevVert(face, vertex)]);
+                face = prevFace(face, vertex);
+            } while (face != kInvalid);
+        }
     }
-    else
+
+    float3 weightOneRing(uint32_t vertex, float beta) const
     {
-        // Compute valence of boundary vertex
-        int nf = 1;
-        while ((f = f->nextFace(this)) != nullptr)
-            ++nf;
-        f = startFace;
-        while ((f = f->prevFace(this)) != nullptr)
-            ++nf;
-        return nf + 1;
+        uint32_t valence = this->valence(vertex);
+        float3 p = (1 - valence * beta) * positions[vertex];
+        forEachRingVertex(vertex, [&](const float3& ringPosition) { p += beta * ringPosition; });
+        return p;
     }
-}
+
+    float3 weightBoundary(uint32_t vertex, float beta) const
+    {
+        // Only the first and last vertex of the one-ring are used.
+        float3 first;
+        float3 last;
+        uint32_t count = 0;
+        forEachRingVertex(
+            vertex,
+            [&](const float3& ringPosition)
+            {
+                if (count++ == 0)
+                    first = ringPosition;
+                last = ringPosition;
+            }
+        );
+        float3 p = (1 - 2 * beta) * positions[vertex];
+        p += beta * first;
+        p += beta * last;
+        return p;
+    }
+};
 
 inline float beta(uint32_t valence)
 {
@@ -171,372 +214,346 @@ inline float loopGamma(uint32_t valence)
     return 1.f / (valence + 3.f / (8.f * beta(valence)));
 }
 
-LoopSubdivideResult loopSubdivide(uint32_t levels, fstd::span<const float3> positions, fstd::span<const uint32_t> indices)
+/// Creates the control mesh, with the face neighbors found by matching edges the same way as pbrt.
+void createControlMesh(fstd::span<const float3> positions, fstd::span<const uint32_t> indices, Mesh& mesh)
 {
-    std::vector<SDVertex*> vertices;
-    std::vector<SDFace*> faces;
+    FALCOR_CHECK(indices.size() % 3 == 0, "Number of vertex indices ({}) must be a multiple of 3.", indices.size());
 
-    // Allocate vertices and faces.
-    std::unique_ptr<SDVertex[]> vertexBuffer = std::make_unique<SDVertex[]>(positions.size());
-    for (size_t i = 0; i < positions.size(); ++i)
-    {
-        vertexBuffer[i] = SDVertex(positions[i]);
-        vertices.push_back(&vertexBuffer[i]);
-    }
-    size_t faceCount = indices.size() / 3;
-    std::unique_ptr<SDFace[]> fs = std::make_unique<SDFace[]>(faceCount);
-    for (size_t i = 0; i < faceCount; ++i)
-    {
-        faces.push_back(&fs[i]);
-    }
+    const uint32_t vertexCount = uint32_t(positions.size());
+    const uint32_t faceCount = uint32_t(indices.size() / 3);
+    mesh.resize(vertexCount, faceCount);
+    std::copy(positions.begin(), positions.end(), mesh.positions.begin());
+    std::fill(mesh.startFaces.begin(), mesh.startFaces.end(), kInvalid);
 
-    // Set face to vertex pointers.
+    // Set face to vertex indices.
+    for (uint32_t i = 0; i < faceCount; ++i)
     {
-        const uint32_t* vp = indices.data();
-        for (size_t i = 0; i < faceCount; ++i, vp += 3)
+        Face& face = mesh.faces[i];
+        for (uint32_t j = 0; j < 3; ++j)
         {
-            SDFace* f = faces[i];
-            for (uint32_t j = 0; j < 3; ++j)
-            {
-                SDVertex* v = vertices[vp[j]];
-                f->v[j] = v;
-                v->startFace = f;
-            }
+            uint32_t vertex = indices[3 * i + j];
+            FALCOR_CHECK(vertex < vertexCount, "Vertex index ({}) is out of bounds.", vertex);
+            face.v[j] = vertex;
+            face.f[j] = kInvalid;
+            mesh.startFaces[vertex] = i;
         }
     }
 
-    // Set neighbor pointers in faces.
-    std::set<SDEdge> edges;
-    for (size_t i = 0; i < faceCount; ++i)
+    // Set neighbor indices in faces. An edge is paired with the next face that shares it, after which it can be seen again.
+    std::unordered_map<uint64_t, uint32_t> edges; // Edge key to face index * 3 + edge number.
+    edges.reserve(indices.size());
+    for (uint32_t i = 0; i < faceCount; ++i)
     {
-        SDFace* f = faces[i];
+        Face& face = mesh.faces[i];
         for (uint32_t edgeNum = 0; edgeNum < 3; ++edgeNum)
         {
-            // Update neighbor pointer for edgeNum.
-            int v0 = edgeNum, v1 = NEXT(edgeNum);
-            SDEdge e(f->v[v0], f->v[v1]);
-            if (edges.find(e) == edges.end())
+            uint32_t v0 = face.v[edgeNum];
+            uint32_t v1 = face.v[next(edgeNum)];
+            uint64_t key = (uint64_t(std::min(v0, v1)) << 32) | std::max(v0, v1);
+            auto it = edges.find(key);
+            if (it == edges.end())
             {
-                // Handle new edge.
-                e.f[0] = f;
-                e.f0edgeNum = edgeNum;
-                edges.insert(e);
+                edges.emplace(key, 3 * i + edgeNum);
             }
             else
             {
-                // Handle previously seen edge.
-                e = *edges.find(e);
-                e.f[0]->f[e.f0edgeNum] = f;
-                f->f[edgeNum] = e.f[0];
-                edges.erase(e);
+                mesh.faces[it->second / 3].f[it->second % 3] = i;
+                face.f[edgeNum] = it->second / 3;
+                edges.erase(it);
             }
         }
     }
 
     // Finish vertex initialization.
-    for (size_t i = 0; i < positions.size(); ++i)
+    for (uint32_t i = 0; i < vertexCount; ++i)
     {
-        SDVertex* v = vertices[i];
-        SDFace* f = v->startFace;
+        FALCOR_CHECK(mesh.startFaces[i] != kInvalid, "Vertex {} is not referenced by any face.", i);
+        uint32_t f = mesh.startFaces[i];
         do
         {
-            f = f->nextFace(v);
-        } while ((f != nullptr) && f != v->startFace);
-        v->boundary = (f == nullptr);
-        if (!v->boundary && v->valence() == 6)
-            v->regular = true;
-        else if (v->boundary && v->valence() == 4)
-            v->regular = true;
-        else
-            v->regular = false;
+            f = mesh.nextFace(f, i);
+        } while (f != kInvalid && f != mesh.startFaces[i]);
+        mesh.boundary[i] = f == kInvalid;
     }
+}
 
-    // Refine LoopSubdiv into triangles.
-    std::vector<SDFace*> f = faces;
-    std::vector<SDVertex*> v = vertices;
-
-    std::pmr::monotonic_buffer_resource buffer;
-    std::pmr::polymorphic_allocator<SDVertex> vertexAllocator(&buffer);
-    std::pmr::polymorphic_allocator<SDFace> faceAllocator(&buffer);
-
-    for (size_t i = 0; i < levels; ++i)
-    {
-        // Update f and v for next level of subdivision.
-        std::vector<SDFace*> newFaces;
-        std::vector<SDVertex*> newVertices;
-
-        // Allocate next level of children in mesh tree.
-        for (SDVertex* vertex : v)
-        {
-            vertex->child = vertexAllocator.allocate(1);
-            vertex->child->regular = vertex->regular;
-            vertex->child->boundary = vertex->boundary;
-            newVertices.push_back(vertex->child);
-        }
-        for (SDFace* face : f)
-        {
-            for (uint32_t k = 0; k < 4; ++k)
-            {
-                face->children[k] = faceAllocator.allocate(1);
-                newFaces.push_back(face->children[k]);
-            }
-        }
-
-        // Update vertex positions and create new edge vertices.
+/// Returns true if the kth edge of the face creates the new edge vertex, i.e., if the face is the first one seeing the edge.
+inline bool ownsEdge(const Face& face, uint32_t faceIndex, uint32_t k)
+{
+    return face.f[k] == kInvalid || faceIndex < face.f[k];
+}
 
-        // Update vertex positions for even vertices.
-        for (SDVertex* vertex : v)
+/// Subdivides the mesh once.
+/// @param[in] mesh The mesh to subdivide.
+/// @param[out] child The subdivided mesh.
+/// @param[in,out] edgeVertices Scratch buffer for the index of the new vertex on each face edge.
+/// @param[in,out] edgeOffsets Scratch buffer for the number of new vertices created before each face.
+void subdivide(const Mesh& mesh, Mesh& child, std::vector<uint32_t>& edgeVertices, std::vector<uint32_t>& edgeOffsets)
+{
+    const uint32_t vertexCount = uint32_t(mesh.positions.size());
+    const uint32_t faceCount = uint32_t(mesh.faces.size());
+    NumericRange<uint32_t> vertexRange(0, vertexCount);
+    NumericRange<uint32_t> faceRange(0, faceCount);
+
+    // Number the new edge vertices in the order the edges are first seen.
+    edgeOffsets.resize(faceCount);
+    std::transform(
+        std::execution::par_unseq,
+        faceRange.begin(),
+        faceRange.end(),
+        edgeOffsets.begin(),
+        [&](uint32_t i)
         {
-            if (!vertex->boundary)
-            {
-                // Apply one-ring rule for even vertex.
-                if (vertex->regular)
-                    vertex->child->p = weightOneRing(vertex, 1.f / 16.f);
-                else
-                    vertex->child->p = weightOneRing(vertex, beta(vertex->valence()));
-            }
-            else
-            {
-                // Apply boundary rule for even vertex.
-                vertex->child->p = weightBoundary(vertex, 1.f / 8.f);
-            }
+            const Face& face = mesh.faces[i];
+            return uint32_t(ownsEdge(face, i, 0)) + uint32_t(ownsEdge(face, i, 1)) + uint32_t(ownsEdge(face, i, 2));
         }
-
-        // Compute new odd edge vertices.
-        std::map<SDEdge, SDVertex*> edgeVerts;
-        for (SDFace* face : f)
+    );
+    const uint32_t lastFaceEdgeVertexCount = faceCount > 0 ? edgeOffsets.back() : 0;
+    std::exclusive_scan(edgeOffsets.begin(), edgeOffsets.end(), edgeOffsets.begin(), vertexCount);
+    const uint32_t childVertexCount = faceCount > 0 ? edgeOffsets.back() + lastFaceEdgeVertexCount : vertexCount;
+
+    child.resize(childVertexCount, size_t(faceCount) * 4);
+    edgeVertices.resize(size_t(faceCount) * 3);
+
+    // Compute new odd edge vertices. Each edge is written by the face owning it, for both faces sharing it.
+    std::for_each(
+        std::execution::par_unseq,
+        faceRange.begin(),
+        faceRange.end(),
+        [&](uint32_t i)
         {
+            const Face& face = mesh.faces[i];
+            uint32_t vertex = edgeOffsets[i];
             for (uint32_t k = 0; k < 3; ++k)
             {
-                // Compute odd vertex on kth edge.
-                SDEdge edge(face->v[k], face->v[NEXT(k)]);
-                SDVertex* vert = edgeVerts[edge];
-                if (vert == nullptr)
+                if (!ownsEdge(face, i, k))
+                    continue;
+
+                uint32_t v0 = face.v[k];
+                uint32_t v1 = face.v[next(k)];
+                edgeVertices[3 * i + k] = vertex;
+                child.startFaces[vertex] = 4 * i + 3;
+                child.boundary[vertex] = face.f[k] == kInvalid;
+
+                // Apply edge rules to compute new vertex position.
+                float3& p = child.positions[vertex];
+                if (face.f[k] == kInvalid)
                 {
-                    // Create and initialize new odd vertex
-                    vert = vertexAllocator.allocate(1);
-                    newVertices.push_back(vert);
-                    vert->regular = true;
-                    vert->boundary = (face->f[k] == nullptr);
-                    vert->startFace = face->children[3];
-
-                    // Apply edge rules to compute new vertex position
-                    if (vert->boundary)
-                    {
-                        vert->p = 0.5f * edge.v[0]->p;
-                        vert->p += 0.5f * edge.v[1]->p;
-                    }
-                    else
+                    p = 0.5f * mesh.positions[v0];
+                    p += 0.5f * mesh.positions[v1];
+                }
+                else
+                {
+                    const Face& neighbor = mesh.faces[face.f[k]];
+                    p = 3.f / 8.f * mesh.positions[v0];
+                    p += 3.f / 8.f * mesh.positions[v1];
+                    p += 1.f / 8.f * mesh.positions[face.otherVert(v0, v1)];
+                    p += 1.f / 8.f * mesh.positions[neighbor.otherVert(v0, v1)];
+
+                    for (uint32_t k2 = 0; k2 < 3; ++k2)
                     {
-                        vert->p = 3.f / 8.f * edge.v[0]->p;
-                        vert->p += 3.f / 8.f * edge.v[1]->p;
-                        vert->p += 1.f / 8.f * face->otherVert(edge.v[0], edge.v[1])->p;
-                        vert->p += 1.f / 8.f * face->f[k]->otherVert(edge.v[0], edge.v[1])->p;
+                        uint32_t n0 = neighbor.v[k2];
+                        uint32_t n1 = neighbor.v[next(k2)];
+                        if ((n0 == v0 && n1 == v1) || (n0 == v1 && n1 == v0))
+                            edgeVertices[3 * face.f[k] + k2] = vertex;
                     }
-                    edgeVerts[edge] = vert;
                 }
+                ++vertex;
             }
         }
-
-        // Update new mesh topology.
-
-        // Update even vertex face pointers.
-        for (SDVertex* vertex : v)
-        {
-            int vertNum = vertex->startFace->vnum(vertex);
-            vertex->child->startFace = vertex->startFace->children[vertNum];
-        }
-
-        // Update face neighbor pointers.
-        for (SDFace* face : f)
+    );
+
+    // Update vertex positions for even vertices.
+    std::for_each(
+        std::execution::par_unseq,
+        vertexRange.begin(),
+        vertexRange.end(),
+        [&](uint32_t i)
         {
-            for (uint32_t j = 0; j < 3; ++j)
+            if (!mesh.boundary[i])
             {
-                // Update children f pointers for siblings.
-                face->children[3]->f[j] = face->children[NEXT(j)];
-                face->children[j]->f[NEXT(j)] = face->children[3];
-
-                // Update children f pointers for neighbor children.
-                SDFace* f2 = face->f[j];
-                face->children[j]->f[j] = f2 != nullptr ? f2->children[f2->vnum(face->v[j])] : nullptr;
-                f2 = face->f[PREV(j)];
-                face->children[j]->f[PREV(j)] = f2 != nullptr ? f2->children[f2->vnum(face->v[j])] : nullptr;
+                // Apply one-ring rule for even vertex. Regular vertices (valence 6) use a weight of 1/16, which is what beta() returns.
+                child.positions[i] = mesh.weightOneRing(i, beta(mesh.valence(i)));
+            }
+            else
+            {
+                // Apply boundary rule for even vertex.
+                child.positions[i] = mesh.weightBoundary(i, 1.f / 8.f);
             }
-        }
 
-        // Update face vertex pointers.
-        for (SDFace* face : f)
+            uint32_t startFace = mesh.startFaces[i];
+            child.startFaces[i] = 4 * startFace + mesh.faces[startFace].vnum(i);
+            child.boundary[i] = mesh.boundary[i];
+        }
+    );
+
+    // Update new mesh topology.
+    std::for_each(
+        std::execution::par_unseq,
+        faceRange.begin(),
+        faceRange.end(),
+        [&](uint32_t i)
         {
+            const Face& face = mesh.faces[i];
+            Face* children = &child.faces[4 * i];
             for (uint32_t j = 0; j < 3; ++j)
             {
-                // Update child vertex pointer to new even vertex
-                face->children[j]->v[j] = face->v[j]->child;
-
-                // Update child vertex pointer to new odd vertex
-                SDVertex* vert = edgeVerts[SDEdge(face->v[j], face->v[NEXT(j)])];
-                face->children[j]->v[NEXT(j)] = vert;
-                face->children[NEXT(j)]->v[j] = vert;
-                face->children[3]->v[j] = vert;
+                // Update children f indices for siblings.
+                children[3].f[j] = 4 * i + next(j);
+                children[j].f[next(j)] = 4 * i + 3;
+
+                // Update children f indices for neighbor children.
+                uint32_t f2 = face.f[j];
+                children[j].f[j] = f2 != kInvalid ? 4 * f2 + mesh.faces[f2].vnum(face.v[j]) : kInvalid;
+                f2 = face.f[prev(j)];
+                children[j].f[prev(j)] = f2 != kInvalid ? 4 * f2 + mesh.faces[f2].vnum(face.v[j]) : kInvalid;
+
+                // Update child vertex indices to new even and odd vertices.
+                uint32_t vert = edgeVertices[3 * i + j];
+                children[j].v[j] = face.v[j];
+                children[j].v[next(j)] = vert;
+                children[next(j)].v[j] = vert;
+                children[3].v[j] = vert;
             }
         }
+    );
+}
 
-        // Prepare for next level of subdivision
-        f = newFaces;
-        v = newVertices;
-    }
-
-    // Push vertices to limit surface.
-    std::vector<float3> pLimit(v.size());
-    for (size_t i = 0; i < v.size(); ++i)
+/// Computes the limit surface normal of a vertex.
+float3 computeLimitNormal(const Mesh& mesh, uint32_t vertex)
+{
+    uint32_t valence = mesh.valence(vertex);
+    float3 localRing[kLocalRingSize];
+    std::vector<float3> heapRing;
+    float3* pRing = localRing;
+    if (valence > kLocalRingSize)
     {
-        if (v[i]->boundary)
-            pLimit[i] = weightBoundary(v[i], 1.f / 5.f);
-        else
-            pLimit[i] = weightOneRing(v[i], loopGamma(v[i]->valence()));
+        heapRing.resize(valence);
+        pRing = heapRing.data();
     }
-    for (size_t i = 0; i < v.size(); ++i)
+    uint32_t count = 0;
+    mesh.forEachRingVertex(vertex, [&](const float3& ringPosition) { pRing[count++] = ringPosition; });
+
+    const float3& p = mesh.positions[vertex];
+    float3 S(0.f);
+    float3 T(0.f);
+    if (!mesh.boundary[vertex])
     {
-        v[i]->p = pLimit[i];
+        // Compute tangents of interior face
+        for (uint32_t j = 0; j < valence; ++j)
+        {
+            S += std::cos(2.f * float(M_PI) * j / valence) * float3(pRing[j]);
+            T += std::sin(2.f * float(M_PI) * j / valence) * float3(pRing[j]);
+        }
     }
-
-    // Compute vertex tangents on limit surface.
-    std::vector<float3> Ns;
-    Ns.reserve(v.size());
-    std::vector<float3> pRing(16, float3());
-    for (SDVertex* vertex : v)
+    else
     {
-        float3 S(0.f);
-        float3 T(0.f);
-        uint32_t valence = vertex->valence();
-        if (valence > pRing.size())
-            pRing.resize(valence);
-        vertex->oneRing(&pRing[0]);
-        if (!vertex->boundary)
+        // Compute tangents of boundary face
+        S = pRing[valence - 1] - pRing[0];
+        if (valence == 2)
         {
-            // Compute tangents of interior face
-            for (uint32_t j = 0; j < valence; ++j)
-            {
-                S += std::cos(2.f * float(M_PI) * j / valence) * float3(pRing[j]);
-                T += std::sin(2.f * float(M_PI) * j / valence) * float3(pRing[j]);
-            }
+            T = float3(pRing[0] + pRing[1] - 2.f * p);
         }
-        else
+        else if (valence == 3)
         {
-            // Compute tangents of boundary face
-            S = pRing[valence - 1] - pRing[0];
-            if (valence == 2)
-            {
-                T = float3(pRing[0] + pRing[1] - 2.f * vertex->p);
-            }
-            else if (valence == 3)
-            {
-                T = pRing[1] - vertex->p;
-            }
-            else if (valence == 4) // regular
-            {
-                T = float3(-1.f * pRing[0] + 2.f * pRing[1] + 2.f * pRing[2] + -1.f * pRing[3] + -2.f * vertex->p);
-            }
-            else
-            {
-                float theta = float(M_PI) / float(valence - 1);
-                T = float3(std::sin(theta) * (pRing[0] + pRing[valence - 1]));
-                for (uint32_t k = 1; k < valence - 1; ++k)
-                {
-                    float wt = (2 * std::cos(theta) - 2) * std::sin((k)*theta);
-                    T += float3(wt * pRing[k]);
-                }
-                T = -T;
-            }
+            T = pRing[1] - p;
         }
-        Ns.push_back(cross(S, T));
-    }
-
-    // Create triangle mesh from subdivision mesh
-    {
-        size_t ntris = f.size();
-        std::vector<uint32_t> verts(3 * ntris);
-        uint32_t* vp = verts.data();
-        uint32_t totVerts = (uint32_t)v.size();
-        std::map<SDVertex*, uint32_t> usedVerts;
-        for (uint32_t i = 0; i < totVerts; ++i)
+        else if (valence == 4) // regular
         {
-            usedVerts[v[i]] = i;
+            T = float3(-1.f * pRing[0] + 2.f * pRing[1] + 2.f * pRing[2] + -1.f * pRing[3] + -2.f * p);
         }
-        for (size_t i = 0; i < ntris; ++i)
+        else
         {
-            for (uint32_t j = 0; j < 3; ++j)
+            float theta = float(M_PI) / float(valence - 1);
+            T = float3(std::sin(theta) * (pRing[0] + pRing[valence - 1]));
+            for (uint32_t k = 1; k < valence - 1; ++k)
             {
-                *vp = usedVerts[f[i]->v[j]];
-                ++vp;
+                float wt = (2 * std::cos(theta) - 2) * std::sin((k)*theta);
+                T += float3(wt * pRing[k]);
             }
+            T = -T;
         }
-
-        LoopSubdivideResult result;
-        result.positions = std::move(pLimit);
-        result.normals = std::move(Ns);
-        result.indices = std::move(verts);
-        return result;
     }
+    return cross(S, T);
 }
 
-static float3 weightOneRing(SDVertex* vert, float beta)
+} // namespace
+
+LoopSubdivideResult loopSubdivide(uint32_t levels, fstd::span<const float3> positions, fstd::span<const uint32_t> indices)
 {
-    // Put vert one-ring in pRing.
-    uint32_t valence = vert->valence();
-    FALCOR_ASSERT(valence < 16);
-    float3 pRing[16];
-
-    vert->oneRing(pRing);
-    float3 p = (1 - valence * beta) * vert->p;
-    for (uint32_t i = 0; i < valence; ++i)
+    Mesh mesh;
+    createControlMesh(positions, indices, mesh);
+
+    // Every level adds one vertex per edge, splits each edge in two and adds three edges per face.
+    // Reserve the final size up front, the two meshes swap roles on every level.
+    uint64_t vertexCount = mesh.positions.size();
+    uint64_t faceCount = mesh.faces.size();
+    uint64_t edgeCount = 0;
+    for (uint32_t i = 0; i < faceCount; ++i)
     {
-        p += beta * pRing[i];
+        for (uint32_t k = 0; k < 3; ++k)
+            edgeCount += ownsEdge(mesh.faces[i], i, k);
+    }
+    for (uint32_t i = 0; i < levels; ++i)
+    {
+        vertexCount += edgeCount;
+        edgeCount = 2 * edgeCount + 3 * faceCount;
+        faceCount *= 4;
+        FALCOR_CHECK(3 * faceCount <= kInvalid, "Too many subdivision levels ({}) for a mesh with {} triangles.", levels, indices.size() / 3);
     }
-    return p;
-}
 
-void SDVertex::oneRing(float3* p_)
-{
-    if (!boundary)
+    Mesh child;
+    std::vector<uint32_t> edgeVertices;
+    std::vector<uint32_t> edgeOffsets;
+    if (levels > 0)
     {
-        // Get one-ring vertices for interior vertex.
-        SDFace* face = startFace;
-        do
-        {
-            *p_++ = face->nextVert(this)->p;
-            face = face->nextFace(this);
-        } while (face != startFace);
+        mesh.reserve(vertexCount, faceCount);
+        child.reserve(vertexCount, faceCount);
+        edgeVertices.reserve(3 * faceCount / 4);
+        edgeOffsets.reserve(faceCount / 4);
     }
-    else
+
+    for (uint32_t i = 0; i < levels; ++i)
     {
-        // Get one-ring vertices for boundary vertex.
-        SDFace* face = startFace;
-        SDFace* f2;
-        while ((f2 = face->nextFace(this)) != nullptr)
+        subdivide(mesh, child, edgeVertices, edgeOffsets);
+        std::swap(mesh, child);
+    }
+
+    // Push vertices to limit surface.
+    const uint32_t finalVertexCount = uint32_t(mesh.positions.size());
+    NumericRange<uint32_t> vertexRange(0, finalVertexCount);
+    std::vector<float3> pLimit(finalVertexCount);
+    std::for_each(
+        std::execution::par_unseq,
+        vertexRange.begin(),
+        vertexRange.end(),
+        [&](uint32_t i)
         {
-            face = f2;
+            if (mesh.boundary[i])
+                pLimit[i] = mesh.weightBoundary(i, 1.f / 5.f);
+            else
+                pLimit[i] = mesh.weightOneRing(i, loopGamma(mesh.valence(i)));
         }
-        *p_++ = face->nextVert(this)->p;
-        do
-        {
-            *p_++ = face->prevVert(this)->p;
-            face = face->prevFace(this);
-        } while (face != nullptr);
+    );
+    std::swap(mesh.positions, pLimit);
+
+    // Compute vertex normals on limit surface.
+    std::vector<float3> Ns(finalVertexCount);
+    std::for_each(
+        std::execution::par_unseq, vertexRange.begin(), vertexRange.end(), [&](uint32_t i) { Ns[i] = computeLimitNormal(mesh, i); }
+    );
+
+    // Create triangle mesh from subdivision mesh.
+    LoopSubdivideResult result;
+    result.indices.resize(3 * mesh.faces.size());
+    for (size_t i = 0; i < mesh.faces.size(); ++i)
+    {
+        for (uint32_t j = 0; j < 3; ++j)
+            result.indices[3 * i + j] = mesh.faces[i].v[j];
     }
-}
-
-static float3 weightBoundary(SDVertex* vert, float beta)
-{
-    // Put vert one-ring in pRing.
-    uint32_t valence = vert->valence();
-    FALCOR_ASSERT(valence < 16);
-    float3 pRing[16];
-
-    vert->oneRing(pRing);
-    float3 p = (1 - 2 * beta) * vert->p;
-    p += beta * pRing[0];
-    p += beta * pRing[valence - 1];
-    return p;
+    result.positions = std::move(mesh.positions);
+    result.normals = std::move(Ns);
+    return result;
 }
 
 } // namespace Falcor::pbrt
@@ -1,5 +1,6 @@
 import sys
 import os
+import asyncio
 import unittest
 import falcor
 import numpy as np
@@ -173,6 +174,94 @@ limits.max_shader_visible_samplers={device.limits.max_shader_visible_samplers}
         b_device = b.to_numpy()
         self.assertTrue(np.all(b_device == a_host))
 
+    @for_each_device_type
+    def test_buffer_range(self, device: falcor.Device):
+        a = device.create_typed_buffer(
+            format=falcor.ResourceFormat.RG32Float, element_count=1024
+        )
+        a_host = np.reshape(np.linspace(0, 1, 2048, dtype=np.float32), (1024, 2))
+        a.from_numpy(a_host)
+
+        a_range = a.to_numpy(offset=100 * 8, size=200 * 8)
+        self.assertEqual(a_range.shape, (200, 2))
+        self.assertEqual(a_range.dtype, np.float32)
+        self.assertTrue(np.all(a_range == a_host[100:300]))
+
+        a_tail = a.to_numpy(offset=1000 * 8)
+        self.assertEqual(a_tail.shape, (24, 2))
+        self.assertTrue(np.all(a_tail == a_host[1000:]))
+
+        # Ranges must be in whole elements.
+        with self.assertRaises(Exception):
+            a.to_numpy(offset=4)
+
+    @for_each_device_type
+    def test_buffer_async(self, device: falcor.Device):
+        a = device.create_typed_buffer(
+            format=falcor.ResourceFormat.R32Uint, element_count=4096
+        )
+        a_host = np.arange(4096, dtype=np.uint32)
+        a.from_numpy(a_host)
+
+        readback = a.to_numpy_async()
+        a_device = readback.result()
+        self.assertTrue(readback.done())
+        self.assertEqual(a_device.shape, (4096,))
+        self.assertEqual(a_device.dtype, np.uint32)
+        self.assertTrue(np.all(a_device == a_host))
+
+        # Reuse the readback buffer for a ranged read.
+        readback_buffer = readback.readback_buffer
+        self.assertEqual(readback_buffer.memory_type, falcor.MemoryType.ReadBack)
+        del a_device
+        readback = a.to_numpy_async(
+            offset=16 * 4, size=32 * 4, readback_buffer=readback_buffer
+        )
+        self.assertEqual(readback.readback_buffer, readback_buffer)
+        a_device = readback.result()
+        self.assertEqual(a_device.shape, (32,))
+        self.assertTrue(np.all(a_device == a_host[16:48]))
+
+        async def read():
+            return await a.to_numpy_async(size=8 * 4)
+
+        a_device = asyncio.run(read())
+        self.assertTrue(np.all(a_device == a_host[:8]))
+
+    @for_each_device_type
+    def test_texture_async(self, device: falcor.Device):
+        # Use a width that is not a multiple of the row alignment to test row padding.
+        a = device.create_texture(
+            width=37, height=19, format=falcor.ResourceFormat.RGBA32Float
+        )
+        a_host = np.reshape(
+            np.linspace(0, 1, 37 * 19 * 4, dtype=np.float32), (19, 37, 4)
+        )
+        a.from_numpy(a_host)
+
+        readback = a.to_numpy_async()
+        a_device = readback.result()
+        self.assertEqual(a_device.shape, (19, 37, 4))
+        self.assertEqual(a_device.dtype, np.float32)
+        self.assertTrue(np.all(a_device == a_host))
+
+        b = device.create_texture(
+            width=37, height=19, depth=5, format=falcor.ResourceFormat.R16Float
+        )
+        b_host = np.reshape(
+            np.linspace(0, 1, 37 * 19 * 5, dtype=np.float16), (5, 19, 37)
+        )
+        b.from_numpy(b_host)
+
+        async def read():
+            return await b.to_numpy_async(readback_buffer=readback.readback_buffer)
+
+        del a_device
+        b_device = asyncio.run(read())
+        self.assertEqual(b_device.shape, (5, 19, 37))
+        self.assertEqual(b_device.dtype, np.float16)
+        self.assertTrue(np.all(b_device == b_host))
+
 
 if __name__ == "__main__":
     unittest.main()